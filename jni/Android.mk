@@ -20,6 +20,7 @@ LOCAL_C_INCLUDES := $(LOCAL_PATH)/include ../../../wolfssl
 LOCAL_SRC_FILES  := jni_fips.c \
 					jni_native_struct.c \
 					jni_aes.c \
+					jni_aes_xts.c \
 					jni_des3.c \
 					jni_md5.c \
 					jni_sha.c \
@@ -29,7 +30,10 @@ LOCAL_SRC_FILES  := jni_fips.c \
 					jni_dh.c \
 					jni_ecc.c \
 					jni_asn.c \
-					jni_logging.c
+					jni_logging.c \
+					jni_log.c \
+					jni_hash.c \
+					jni_sha3.c
 
 LOCAL_CFLAGS     := -DHAVE_CONFIG_H -Wall -Wno-unused
 LOCAL_LDLIBS     := -llog
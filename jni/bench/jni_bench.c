@@ -0,0 +1,528 @@
+/* jni_bench.c
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+/* Measures JNI bridge overhead of the wolfCrypt JNI wrappers.
+ *
+ * Starts a JVM through the JNI invocation API so wrapper functions can be
+ * called with a real JNIEnv and real Java objects, then times for each
+ * operation and input size:
+ *
+ *   c        wolfCrypt function called directly on native memory
+ *   jni_ptr  exported wrapper taking the native pointer (_ptr variant)
+ *   jni_obj  exported wrapper looking the pointer up from the object
+ *   struct   getNativeStruct() alone
+ *   pin      getByteArray() + releaseByteArray()
+ *   crit     getByteArrayCritical() + releaseByteArrayCritical()
+ *   exc      ExceptionOccurred() check
+ *   result   NewByteArray() + SetByteArrayRegion() of the output size
+ *   bridge   share of jni_obj time not spent in wolfCrypt, (jni_obj-c)/jni_obj
+ *
+ * Usage: jni_bench [-cp <wolfcrypt-jni.jar>] [-time <ms>] [-max <pct>]
+ *
+ * With -max, exits with failure if bridge share is above pct percent for
+ * any input of 1024 bytes or more. Smaller inputs are reported only, their
+ * cost is expected to be dominated by the bridge. */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <jni.h>
+
+#ifdef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/wolfcrypt/settings.h>
+#else
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/sha256.h>
+#include <wolfssl/wolfcrypt/hmac.h>
+#include <wolfssl/wolfcrypt/aes.h>
+#include <wolfssl/wolfcrypt/random.h>
+
+#include <com_wolfssl_wolfcrypt_Sha256.h>
+#include <com_wolfssl_wolfcrypt_Hmac.h>
+#include <com_wolfssl_wolfcrypt_Aes.h>
+#include <com_wolfssl_wolfcrypt_Rng.h>
+#include <wolfcrypt_jni_NativeStruct.h>
+
+#define BENCH_MAX_SZ    16384
+#define BENCH_OUT_SZ    BENCH_MAX_SZ
+#define BENCH_BRIDGE_SZ 1024
+
+static const int benchSizes[] = { 16, 64, 256, 1024, 4096, 16384 };
+#define BENCH_SIZE_CNT (int)(sizeof(benchSizes) / sizeof(benchSizes[0]))
+
+typedef enum {
+    BENCH_C = 0,
+    BENCH_JNI_PTR,
+    BENCH_JNI_OBJ,
+    BENCH_STRUCT,
+    BENCH_PIN,
+    BENCH_CRIT,
+    BENCH_EXC,
+    BENCH_RESULT,
+    BENCH_COLUMNS
+} BenchColumn;
+
+static const char* benchColumnNames[BENCH_COLUMNS] = {
+    "c", "jni_ptr", "jni_obj", "struct", "pin", "crit", "exc", "result"
+};
+
+typedef enum {
+    BENCH_SHA256 = 0,
+    BENCH_HMAC_SHA256,
+    BENCH_AES_CBC,
+    BENCH_RNG
+} BenchOpId;
+
+/* One wrapped operation and the state needed to run it */
+typedef struct BenchOp {
+    BenchOpId   id;
+    const char* name;
+    const char* className;
+    jobject     obj;      /* Java wrapper object */
+    void*       ptr;      /* native struct held by obj */
+    int         outSz;    /* result size, 0 if same as input size */
+} BenchOp;
+
+typedef struct BenchCtx {
+    JNIEnv*    env;
+    BenchOp*   op;
+    jbyteArray in;
+    jbyteArray out;
+    byte*      inNative;
+    byte*      outNative;
+    int        sz;
+    int        outSz;     /* size of result array a wrapper would create */
+} BenchCtx;
+
+static double benchMinNs = 200000000.0;
+
+static double nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int checkException(JNIEnv* env, const char* what)
+{
+    if ((*env)->ExceptionCheck(env)) {
+        fprintf(stderr, "Java exception during %s\n", what);
+        (*env)->ExceptionDescribe(env);
+        return -1;
+    }
+    return 0;
+}
+
+/* Run one measurement column once, returns non-zero on failure */
+static int runOnce(BenchCtx* c, BenchColumn col)
+{
+    JNIEnv* env = c->env;
+    BenchOp* op = c->op;
+    jlong ptr = (jlong)(uintptr_t)op->ptr;
+    int ret = 0;
+
+    switch (col) {
+        case BENCH_C:
+            if (op->id == BENCH_SHA256) {
+                ret = wc_Sha256Update((wc_Sha256*)op->ptr, c->inNative, c->sz);
+            }
+            else if (op->id == BENCH_HMAC_SHA256) {
+                ret = wc_HmacUpdate((Hmac*)op->ptr, c->inNative, c->sz);
+            }
+            else if (op->id == BENCH_AES_CBC) {
+                ret = wc_AesCbcEncrypt((Aes*)op->ptr, c->outNative,
+                    c->inNative, c->sz);
+            }
+            else {
+                ret = wc_RNG_GenerateBlock((WC_RNG*)op->ptr, c->outNative,
+                    c->sz);
+            }
+            break;
+
+        case BENCH_JNI_PTR:
+            if (op->id == BENCH_SHA256) {
+                Java_com_wolfssl_wolfcrypt_Sha256_native_1update_1ptr__J_3BII(
+                    env, NULL, ptr, c->in, 0, c->sz);
+            }
+            else if (op->id == BENCH_HMAC_SHA256) {
+                Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate_1ptr__J_3BII(
+                    env, NULL, ptr, c->in, 0, c->sz);
+            }
+            else if (op->id == BENCH_AES_CBC) {
+                Java_com_wolfssl_wolfcrypt_Aes_native_1update_1ptr__JI_3BII_3BI(
+                    env, NULL, ptr, AES_ENCRYPTION, c->in, 0, c->sz, c->out, 0);
+            }
+            else {
+                Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock_1ptr__J_3BII(
+                    env, NULL, ptr, c->out, 0, c->sz);
+            }
+            break;
+
+        case BENCH_JNI_OBJ:
+            if (op->id == BENCH_SHA256) {
+                Java_com_wolfssl_wolfcrypt_Sha256_native_1update_1internal___3BII(
+                    env, op->obj, c->in, 0, c->sz);
+            }
+            else if (op->id == BENCH_HMAC_SHA256) {
+                Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate___3BII(
+                    env, op->obj, c->in, 0, c->sz);
+            }
+            else if (op->id == BENCH_AES_CBC) {
+                Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__I_3BII_3BI(
+                    env, op->obj, AES_ENCRYPTION, c->in, 0, c->sz, c->out, 0);
+            }
+            else {
+                Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock___3BII(
+                    env, op->obj, c->out, 0, c->sz);
+            }
+            break;
+
+        case BENCH_STRUCT:
+            if (getNativeStruct(env, op->obj) != op->ptr) {
+                ret = -1;
+            }
+            break;
+
+        case BENCH_PIN:
+        {
+            byte* data = getByteArray(env, c->in);
+            releaseByteArray(env, c->in, data, JNI_ABORT);
+            break;
+        }
+
+        case BENCH_CRIT:
+        {
+            byte* data = getByteArrayCritical(env, c->in);
+            releaseByteArrayCritical(env, c->in, data, JNI_ABORT);
+            break;
+        }
+
+        case BENCH_EXC:
+            if ((*env)->ExceptionOccurred(env)) {
+                ret = -1;
+            }
+            break;
+
+        case BENCH_RESULT:
+        {
+            jbyteArray result = (*env)->NewByteArray(env, c->outSz);
+            if (result == NULL) {
+                ret = -1;
+                break;
+            }
+            (*env)->SetByteArrayRegion(env, result, 0, c->outSz,
+                (jbyte*)c->outNative);
+            (*env)->DeleteLocalRef(env, result);
+            break;
+        }
+
+        default:
+            ret = -1;
+    }
+
+    if (ret != 0) {
+        fprintf(stderr, "%s/%s failed: %d\n", op->name,
+            benchColumnNames[col], ret);
+        return -1;
+    }
+
+    return checkException(env, op->name);
+}
+
+/* Time column until benchMinNs has passed, returns ns per call or < 0 */
+static double measure(BenchCtx* c, BenchColumn col)
+{
+    long iters = 0;
+    long batch = 16;
+    double start, elapsed;
+    long i;
+
+    /* warm up */
+    for (i = 0; i < 64; i++) {
+        if (runOnce(c, col) != 0) {
+            return -1;
+        }
+    }
+
+    start = nowNs();
+    do {
+        for (i = 0; i < batch; i++) {
+            if (runOnce(c, col) != 0) {
+                return -1;
+            }
+        }
+        iters += batch;
+        if (batch < 65536) {
+            batch *= 2;
+        }
+        elapsed = nowNs() - start;
+    } while (elapsed < benchMinNs);
+
+    return elapsed / (double)iters;
+}
+
+static jobject newObject(JNIEnv* env, const char* className,
+    const char* ctorSig, ...)
+{
+    jclass cls;
+    jmethodID ctor;
+    jobject obj;
+    va_list args;
+
+    cls = (*env)->FindClass(env, className);
+    if (cls == NULL) {
+        return NULL;
+    }
+
+    ctor = (*env)->GetMethodID(env, cls, "<init>", ctorSig);
+    if (ctor == NULL) {
+        return NULL;
+    }
+
+    va_start(args, ctorSig);
+    obj = (*env)->NewObjectV(env, cls, ctor, args);
+    va_end(args);
+
+    if (obj == NULL) {
+        return NULL;
+    }
+
+    return (*env)->NewGlobalRef(env, obj);
+}
+
+static int callVoid(JNIEnv* env, jobject obj, const char* name)
+{
+    jclass cls = (*env)->GetObjectClass(env, obj);
+    jmethodID mid = (*env)->GetMethodID(env, cls, name, "()V");
+
+    if (mid == NULL) {
+        return -1;
+    }
+
+    (*env)->CallVoidMethod(env, obj, mid);
+
+    return checkException(env, name);
+}
+
+static jbyteArray newByteArray(JNIEnv* env, const byte* data, int sz)
+{
+    jbyteArray arr = (*env)->NewByteArray(env, sz);
+
+    if (arr != NULL) {
+        (*env)->SetByteArrayRegion(env, arr, 0, sz, (const jbyte*)data);
+        arr = (*env)->NewGlobalRef(env, arr);
+    }
+
+    return arr;
+}
+
+/* Create Java wrapper objects, keys are fixed since content does not
+ * affect timing */
+static int setupOps(JNIEnv* env, BenchOp* ops)
+{
+    byte key[32];
+    byte iv[16];
+    jclass hmacCls;
+    jfieldID sha256Field;
+    jint hmacSha256;
+    int i;
+
+    memset(key, 0x42, sizeof(key));
+    memset(iv, 0x24, sizeof(iv));
+
+    hmacCls = (*env)->FindClass(env, "com/wolfssl/wolfcrypt/Hmac");
+    if (hmacCls == NULL) {
+        return checkException(env, "FindClass(Hmac)");
+    }
+    sha256Field = (*env)->GetStaticFieldID(env, hmacCls, "SHA256", "I");
+    if (sha256Field == NULL) {
+        return checkException(env, "GetStaticFieldID(Hmac.SHA256)");
+    }
+    hmacSha256 = (*env)->GetStaticIntField(env, hmacCls, sha256Field);
+
+    ops[0].obj = newObject(env, ops[0].className, "()V");
+    if (ops[0].obj == NULL || callVoid(env, ops[0].obj, "init") != 0) {
+        return checkException(env, "new Sha256()");
+    }
+
+    ops[1].obj = newObject(env, ops[1].className, "(I[B)V", hmacSha256,
+        newByteArray(env, key, sizeof(key)));
+    if (ops[1].obj == NULL) {
+        return checkException(env, "new Hmac()");
+    }
+
+    ops[2].obj = newObject(env, ops[2].className, "([B[BI)V",
+        newByteArray(env, key, 16), newByteArray(env, iv, sizeof(iv)),
+        (jint)AES_ENCRYPTION);
+    if (ops[2].obj == NULL) {
+        return checkException(env, "new Aes()");
+    }
+
+    ops[3].obj = newObject(env, ops[3].className, "()V");
+    if (ops[3].obj == NULL || callVoid(env, ops[3].obj, "init") != 0) {
+        return checkException(env, "new Rng()");
+    }
+
+    for (i = 0; i < 4; i++) {
+        ops[i].ptr = getNativeStruct(env, ops[i].obj);
+        if (ops[i].ptr == NULL) {
+            return checkException(env, "getNativeStruct()");
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    JavaVM* jvm = NULL;
+    JNIEnv* env = NULL;
+    JavaVMInitArgs vmArgs;
+    JavaVMOption options[2];
+    char classPath[1024];
+    const char* jar = "lib/wolfcrypt-jni.jar";
+    double maxBridge = -1;
+    int failed = 0;
+    int i, j, k;
+    static byte inNative[BENCH_MAX_SZ];
+    static byte outNative[BENCH_OUT_SZ];
+    jbyteArray in, out;
+
+    BenchOp ops[] = {
+        { BENCH_SHA256, "sha256", "com/wolfssl/wolfcrypt/Sha256",
+          NULL, NULL, WC_SHA256_DIGEST_SIZE },
+        { BENCH_HMAC_SHA256, "hmac-sha256", "com/wolfssl/wolfcrypt/Hmac",
+          NULL, NULL, WC_SHA256_DIGEST_SIZE },
+        { BENCH_AES_CBC, "aes-cbc", "com/wolfssl/wolfcrypt/Aes",
+          NULL, NULL, 0 },
+        { BENCH_RNG, "rng", "com/wolfssl/wolfcrypt/Rng",
+          NULL, NULL, 0 },
+    };
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-cp") == 0 && i + 1 < argc) {
+            jar = argv[++i];
+        }
+        else if (strcmp(argv[i], "-time") == 0 && i + 1 < argc) {
+            benchMinNs = atof(argv[++i]) * 1e6;
+        }
+        else if (strcmp(argv[i], "-max") == 0 && i + 1 < argc) {
+            maxBridge = atof(argv[++i]);
+        }
+        else {
+            printf("usage: %s [-cp <wolfcrypt-jni.jar>] [-time <ms>] "
+                   "[-max <pct>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    snprintf(classPath, sizeof(classPath), "-Djava.class.path=%s", jar);
+    options[0].optionString = classPath;
+    options[1].optionString = (char*)"-Djava.library.path=lib";
+
+    memset(&vmArgs, 0, sizeof(vmArgs));
+    vmArgs.version = JNI_VERSION_1_6;
+    vmArgs.nOptions = 2;
+    vmArgs.options = options;
+    vmArgs.ignoreUnrecognized = JNI_FALSE;
+
+    if (JNI_CreateJavaVM(&jvm, (void**)&env, &vmArgs) != JNI_OK) {
+        fprintf(stderr, "Failed to create Java VM\n");
+        return 1;
+    }
+
+    if (setupOps(env, ops) != 0) {
+        (*jvm)->DestroyJavaVM(jvm);
+        return 1;
+    }
+
+    memset(inNative, 0x5a, sizeof(inNative));
+    in = newByteArray(env, inNative, BENCH_MAX_SZ);
+    out = newByteArray(env, outNative, BENCH_OUT_SZ);
+
+    printf("%-12s %6s", "op", "size");
+    for (k = 0; k < BENCH_COLUMNS; k++) {
+        printf(" %9s", benchColumnNames[k]);
+    }
+    printf(" %7s\n", "bridge");
+    printf("%-12s %6s", "", "");
+    for (k = 0; k < BENCH_COLUMNS; k++) {
+        printf(" %9s", "(ns)");
+    }
+    printf(" %7s\n", "(%)");
+
+    for (i = 0; i < (int)(sizeof(ops) / sizeof(ops[0])); i++) {
+        for (j = 0; j < BENCH_SIZE_CNT; j++) {
+            BenchCtx ctx;
+            double ns[BENCH_COLUMNS];
+            double bridge;
+
+            ctx.env = env;
+            ctx.op = &ops[i];
+            ctx.in = in;
+            ctx.out = out;
+            ctx.inNative = inNative;
+            ctx.outNative = outNative;
+            ctx.sz = benchSizes[j];
+
+            /* ciphers and RNG return output the size of the input */
+            ctx.outSz = (ops[i].outSz == 0) ? ctx.sz : ops[i].outSz;
+
+            for (k = 0; k < BENCH_COLUMNS; k++) {
+                ns[k] = measure(&ctx, (BenchColumn)k);
+                if (ns[k] < 0) {
+                    (*jvm)->DestroyJavaVM(jvm);
+                    return 1;
+                }
+            }
+
+            bridge = 100.0 * (ns[BENCH_JNI_OBJ] - ns[BENCH_C]) /
+                ns[BENCH_JNI_OBJ];
+
+            printf("%-12s %6d", ops[i].name, ctx.sz);
+            for (k = 0; k < BENCH_COLUMNS; k++) {
+                printf(" %9.1f", ns[k]);
+            }
+            printf(" %6.1f%s\n", bridge,
+                (maxBridge >= 0 && ctx.sz >= BENCH_BRIDGE_SZ &&
+                 bridge > maxBridge) ? " !" : "");
+
+            if (maxBridge >= 0 && ctx.sz >= BENCH_BRIDGE_SZ &&
+                bridge > maxBridge) {
+                failed = 1;
+            }
+        }
+    }
+
+    (*jvm)->DestroyJavaVM(jvm);
+
+    if (failed) {
+        printf("bridge overhead above %.1f%% for inputs >= %d bytes\n",
+            maxBridge, BENCH_BRIDGE_SZ);
+        return 1;
+    }
+
+    return 0;
+}
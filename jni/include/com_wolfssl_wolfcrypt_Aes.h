@@ -53,6 +53,94 @@ JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__
 JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__ILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I
   (JNIEnv *, jobject, jint, jobject, jint, jint, jobject, jint);
 
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_update_ptr
+ * Signature: (JI[BII[BI)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1update_1ptr__JI_3BII_3BI
+  (JNIEnv *, jclass, jlong, jint, jbyteArray, jint, jint, jbyteArray, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_update_ptr
+ * Signature: (JILjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1update_1ptr__JILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I
+  (JNIEnv *, jclass, jlong, jint, jobject, jint, jint, jobject, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_gcm_set_key_ptr
+ * Signature: (J[B)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1set_1key_1ptr
+  (JNIEnv *, jclass, jlong, jbyteArray);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_gcm_encrypt_ptr
+ * Signature: (J[BII[BI[B[B[B)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1encrypt_1ptr
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jbyteArray, jint, jbyteArray, jbyteArray, jbyteArray);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_gcm_decrypt_ptr
+ * Signature: (J[BII[BI[B[B[B)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1decrypt_1ptr
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jbyteArray, jint, jbyteArray, jbyteArray, jbyteArray);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_gcm_init_ptr
+ * Signature: (J[B)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1init_1ptr
+  (JNIEnv *, jclass, jlong, jbyteArray);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_gcm_update_ptr
+ * Signature: (JI[BII[BI[B)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1update_1ptr
+  (JNIEnv *, jclass, jlong, jint, jbyteArray, jint, jint, jbyteArray, jint, jbyteArray);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_gcm_final_ptr
+ * Signature: (JI[B)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1final_1ptr
+  (JNIEnv *, jclass, jlong, jint, jbyteArray);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_ctr_update_ptr
+ * Signature: (J[BII[BI)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1ctr_1update_1ptr__J_3BII_3BI
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jbyteArray, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_ctr_update_ptr
+ * Signature: (JLjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1ctr_1update_1ptr__JLjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I
+  (JNIEnv *, jclass, jlong, jobject, jint, jint, jobject, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Aes
+ * Method:    native_ctr_update_at_ptr
+ * Signature: (J[BJ[BII[BI)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Aes_native_1ctr_1update_1at_1ptr
+  (JNIEnv *, jclass, jlong, jbyteArray, jlong, jbyteArray, jint, jint, jbyteArray, jint);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,57 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_wolfssl_wolfcrypt_AesXts */
+
+#ifndef _Included_com_wolfssl_wolfcrypt_AesXts
+#define _Included_com_wolfssl_wolfcrypt_AesXts
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_wolfssl_wolfcrypt_AesXts_NULL
+#define com_wolfssl_wolfcrypt_AesXts_NULL 0LL
+#undef com_wolfssl_wolfcrypt_AesXts_KEY_SIZE_256
+#define com_wolfssl_wolfcrypt_AesXts_KEY_SIZE_256 32L
+#undef com_wolfssl_wolfcrypt_AesXts_KEY_SIZE_512
+#define com_wolfssl_wolfcrypt_AesXts_KEY_SIZE_512 64L
+#undef com_wolfssl_wolfcrypt_AesXts_MIN_SECTOR_SIZE
+#define com_wolfssl_wolfcrypt_AesXts_MIN_SECTOR_SIZE 16L
+#undef com_wolfssl_wolfcrypt_AesXts_ENCRYPT_MODE
+#define com_wolfssl_wolfcrypt_AesXts_ENCRYPT_MODE 0L
+#undef com_wolfssl_wolfcrypt_AesXts_DECRYPT_MODE
+#define com_wolfssl_wolfcrypt_AesXts_DECRYPT_MODE 1L
+/*
+ * Class:     com_wolfssl_wolfcrypt_AesXts
+ * Method:    mallocNativeStruct_internal
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_com_wolfssl_wolfcrypt_AesXts_mallocNativeStruct_1internal
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_AesXts
+ * Method:    native_set_key_ptr
+ * Signature: (J[BI)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_AesXts_native_1set_1key_1ptr
+  (JNIEnv *, jclass, jlong, jbyteArray, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_AesXts
+ * Method:    native_free_ptr
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_AesXts_native_1free_1ptr
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_AesXts
+ * Method:    native_sector_ptr
+ * Signature: (JIJ[BII[BI)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_AesXts_native_1sector_1ptr
+  (JNIEnv *, jclass, jlong, jint, jlong, jbyteArray, jint, jint, jbyteArray, jint);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -105,6 +105,14 @@ JNIEXPORT jbyteArray JNICALL Java_com_wolfssl_wolfcrypt_Curve25519_wc_1curve2551
 JNIEXPORT jbyteArray JNICALL Java_com_wolfssl_wolfcrypt_Curve25519_wc_1curve25519_1export_1public
   (JNIEnv *, jobject);
 
+/*
+ * Class:     com_wolfssl_wolfcrypt_Curve25519
+ * Method:    native_free_ptr
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Curve25519_native_1free_1ptr
+  (JNIEnv *, jclass, jlong);
+
 #ifdef __cplusplus
 }
 #endif
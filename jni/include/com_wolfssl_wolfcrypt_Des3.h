@@ -49,6 +49,22 @@ JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Des3_native_1update_1internal_
 JNIEXPORT jlong JNICALL Java_com_wolfssl_wolfcrypt_Des3_mallocNativeStruct
   (JNIEnv *, jobject);
 
+/*
+ * Class:     com_wolfssl_wolfcrypt_Des3
+ * Method:    native_update_ptr
+ * Signature: (JI[BII[BI)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Des3_native_1update_1ptr__JI_3BII_3BI
+  (JNIEnv *, jclass, jlong, jint, jbyteArray, jint, jint, jbyteArray, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Des3
+ * Method:    native_update_ptr
+ * Signature: (JILjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Des3_native_1update_1ptr__JILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I
+  (JNIEnv *, jclass, jlong, jint, jobject, jint, jint, jobject, jint);
+
 #ifdef __cplusplus
 }
 #endif
@@ -57,6 +57,14 @@ JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Dh_wc_1DhGenerateKeyPair
 JNIEXPORT jbyteArray JNICALL Java_com_wolfssl_wolfcrypt_Dh_wc_1DhAgree
   (JNIEnv *, jobject, jbyteArray, jbyteArray);
 
+/*
+ * Class:     com_wolfssl_wolfcrypt_Dh
+ * Method:    native_free_ptr
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Dh_native_1free_1ptr
+  (JNIEnv *, jclass, jlong);
+
 #ifdef __cplusplus
 }
 #endif
@@ -113,6 +113,14 @@ JNIEXPORT jbyteArray JNICALL Java_com_wolfssl_wolfcrypt_Ed25519_wc_1ed25519_1exp
 JNIEXPORT jbyteArray JNICALL Java_com_wolfssl_wolfcrypt_Ed25519_wc_1ed25519_1export_1public
   (JNIEnv *, jobject);
 
+/*
+ * Class:     com_wolfssl_wolfcrypt_Ed25519
+ * Method:    native_free_ptr
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Ed25519_native_1free_1ptr
+  (JNIEnv *, jclass, jlong);
+
 #ifdef __cplusplus
 }
 #endif
@@ -113,6 +113,38 @@ JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Hmac_getCodeBlake2b
 JNIEXPORT jlong JNICALL Java_com_wolfssl_wolfcrypt_Hmac_mallocNativeStruct
   (JNIEnv *, jobject);
 
+/*
+ * Class:     com_wolfssl_wolfcrypt_Hmac
+ * Method:    wc_HmacUpdate_ptr
+ * Signature: (JB)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate_1ptr__JB
+  (JNIEnv *, jclass, jlong, jbyte);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Hmac
+ * Method:    wc_HmacUpdate_ptr
+ * Signature: (J[BII)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate_1ptr__J_3BII
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Hmac
+ * Method:    wc_HmacUpdate_ptr
+ * Signature: (JLjava/nio/ByteBuffer;II)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate_1ptr__JLjava_nio_ByteBuffer_2II
+  (JNIEnv *, jclass, jlong, jobject, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Hmac
+ * Method:    wc_HmacFinal_ptr
+ * Signature: (J)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacFinal_1ptr
+  (JNIEnv *, jclass, jlong);
+
 #ifdef __cplusplus
 }
 #endif
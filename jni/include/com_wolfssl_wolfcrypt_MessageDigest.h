@@ -0,0 +1,53 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_wolfssl_wolfcrypt_MessageDigest */
+
+#ifndef _Included_com_wolfssl_wolfcrypt_MessageDigest
+#define _Included_com_wolfssl_wolfcrypt_MessageDigest
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_wolfssl_wolfcrypt_MessageDigest_NULL
+#define com_wolfssl_wolfcrypt_MessageDigest_NULL 0LL
+#undef com_wolfssl_wolfcrypt_MessageDigest_DEFAULT_POOL_SIZE
+#define com_wolfssl_wolfcrypt_MessageDigest_DEFAULT_POOL_SIZE 16L
+#undef com_wolfssl_wolfcrypt_MessageDigest_UPDATE_METRICS
+#define com_wolfssl_wolfcrypt_MessageDigest_UPDATE_METRICS 0L
+#undef com_wolfssl_wolfcrypt_MessageDigest_DIGEST_METRICS
+#define com_wolfssl_wolfcrypt_MessageDigest_DIGEST_METRICS 1L
+/*
+ * Class:     com_wolfssl_wolfcrypt_MessageDigest
+ * Method:    native_hash
+ * Signature: (ILjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;I)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_MessageDigest_native_1hash__ILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I
+  (JNIEnv *, jclass, jint, jobject, jint, jint, jobject, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_MessageDigest
+ * Method:    native_hash
+ * Signature: (I[BII[BI)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_MessageDigest_native_1hash__I_3BII_3BI
+  (JNIEnv *, jclass, jint, jbyteArray, jint, jint, jbyteArray, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_MessageDigest
+ * Method:    native_hash_batch
+ * Signature: (I[B[I[II[BI)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_MessageDigest_native_1hash_1batch__I_3B_3I_3II_3BI
+  (JNIEnv *, jclass, jint, jbyteArray, jintArray, jintArray, jint, jbyteArray, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_MessageDigest
+ * Method:    native_hash_batch
+ * Signature: (I[Ljava/nio/ByteBuffer;[I[IILjava/nio/ByteBuffer;I)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_MessageDigest_native_1hash_1batch__I_3Ljava_nio_ByteBuffer_2_3I_3IILjava_nio_ByteBuffer_2I
+  (JNIEnv *, jclass, jint, jobjectArray, jintArray, jintArray, jint, jobject, jint);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
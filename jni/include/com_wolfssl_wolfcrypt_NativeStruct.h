@@ -9,13 +9,29 @@ extern "C" {
 #endif
 #undef com_wolfssl_wolfcrypt_NativeStruct_NULL
 #define com_wolfssl_wolfcrypt_NativeStruct_NULL 0LL
+/*
+ * Class:     com_wolfssl_wolfcrypt_NativeStruct
+ * Method:    initNativeStructCache
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_NativeStruct_initNativeStructCache
+  (JNIEnv *, jclass);
+
 /*
  * Class:     com_wolfssl_wolfcrypt_NativeStruct
  * Method:    xfree
  * Signature: (J)V
  */
 JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_NativeStruct_xfree
-  (JNIEnv *, jobject, jlong);
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_NativeStruct
+ * Method:    xzero
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_NativeStruct_xzero
+  (JNIEnv *, jclass, jlong);
 
 #ifdef __cplusplus
 }
@@ -49,6 +49,38 @@ JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock__Ljava_ni
 JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock___3BII
   (JNIEnv *, jobject, jbyteArray, jint, jint);
 
+/*
+ * Class:     com_wolfssl_wolfcrypt_Rng
+ * Method:    rngGenerateBlock_ptr
+ * Signature: (JLjava/nio/ByteBuffer;II)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock_1ptr__JLjava_nio_ByteBuffer_2II
+  (JNIEnv *, jclass, jlong, jobject, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Rng
+ * Method:    rngGenerateBlock_ptr
+ * Signature: (J[BII)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock_1ptr__J_3BII
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Rng
+ * Method:    native_free_ptr
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Rng_native_1free_1ptr
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Rng
+ * Method:    forkGenerationBuffer
+ * Signature: ()Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_com_wolfssl_wolfcrypt_Rng_forkGenerationBuffer
+  (JNIEnv *, jclass);
+
 #ifdef __cplusplus
 }
 #endif
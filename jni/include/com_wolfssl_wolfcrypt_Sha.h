@@ -69,6 +69,46 @@ JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha_native_1final_1internal__L
 JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha_native_1final_1internal___3B
   (JNIEnv *, jobject, jbyteArray);
 
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha
+ * Method:    native_init_ptr
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha_native_1init_1ptr
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha
+ * Method:    native_update_ptr
+ * Signature: (JLjava/nio/ByteBuffer;II)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha_native_1update_1ptr__JLjava_nio_ByteBuffer_2II
+  (JNIEnv *, jclass, jlong, jobject, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha
+ * Method:    native_update_ptr
+ * Signature: (J[BII)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha_native_1update_1ptr__J_3BII
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha
+ * Method:    native_final_ptr
+ * Signature: (JLjava/nio/ByteBuffer;I)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha_native_1final_1ptr__JLjava_nio_ByteBuffer_2I
+  (JNIEnv *, jclass, jlong, jobject, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha
+ * Method:    native_final_ptr
+ * Signature: (J[B)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha_native_1final_1ptr__J_3B
+  (JNIEnv *, jclass, jlong, jbyteArray);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,95 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_wolfssl_wolfcrypt_Sha3 */
+
+#ifndef _Included_com_wolfssl_wolfcrypt_Sha3
+#define _Included_com_wolfssl_wolfcrypt_Sha3
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_wolfssl_wolfcrypt_Sha3_NULL
+#define com_wolfssl_wolfcrypt_Sha3_NULL 0LL
+#undef com_wolfssl_wolfcrypt_Sha3_SHA3_224
+#define com_wolfssl_wolfcrypt_Sha3_SHA3_224 224L
+#undef com_wolfssl_wolfcrypt_Sha3_SHA3_256
+#define com_wolfssl_wolfcrypt_Sha3_SHA3_256 256L
+#undef com_wolfssl_wolfcrypt_Sha3_SHA3_384
+#define com_wolfssl_wolfcrypt_Sha3_SHA3_384 384L
+#undef com_wolfssl_wolfcrypt_Sha3_SHA3_512
+#define com_wolfssl_wolfcrypt_Sha3_SHA3_512 512L
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha3
+ * Method:    mallocNativeStruct_internal
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_com_wolfssl_wolfcrypt_Sha3_mallocNativeStruct_1internal
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha3
+ * Method:    native_init_ptr
+ * Signature: (JI)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha3_native_1init_1ptr
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha3
+ * Method:    native_copy_ptr
+ * Signature: (JJI)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha3_native_1copy_1ptr
+  (JNIEnv *, jclass, jlong, jlong, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha3
+ * Method:    native_update_ptr
+ * Signature: (JILjava/nio/ByteBuffer;II)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha3_native_1update_1ptr__JILjava_nio_ByteBuffer_2II
+  (JNIEnv *, jclass, jlong, jint, jobject, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha3
+ * Method:    native_update_ptr
+ * Signature: (JI[BII)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha3_native_1update_1ptr__JI_3BII
+  (JNIEnv *, jclass, jlong, jint, jbyteArray, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha3
+ * Method:    native_final_ptr
+ * Signature: (JILjava/nio/ByteBuffer;I)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha3_native_1final_1ptr__JILjava_nio_ByteBuffer_2I
+  (JNIEnv *, jclass, jlong, jint, jobject, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha3
+ * Method:    native_final_ptr
+ * Signature: (JI[B)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha3_native_1final_1ptr__JI_3B
+  (JNIEnv *, jclass, jlong, jint, jbyteArray);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha3
+ * Method:    native_hash
+ * Signature: (ILjava/nio/ByteBuffer;IILjava/nio/ByteBuffer;I)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha3_native_1hash__ILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I
+  (JNIEnv *, jclass, jint, jobject, jint, jint, jobject, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Sha3
+ * Method:    native_hash
+ * Signature: (I[BII[BI)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha3_native_1hash__I_3BII_3BI
+  (JNIEnv *, jclass, jint, jbyteArray, jint, jint, jbyteArray, jint);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
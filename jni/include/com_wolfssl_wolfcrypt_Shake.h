@@ -0,0 +1,83 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_wolfssl_wolfcrypt_Shake */
+
+#ifndef _Included_com_wolfssl_wolfcrypt_Shake
+#define _Included_com_wolfssl_wolfcrypt_Shake
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_wolfssl_wolfcrypt_Shake_NULL
+#define com_wolfssl_wolfcrypt_Shake_NULL 0LL
+#undef com_wolfssl_wolfcrypt_Shake_SHAKE128
+#define com_wolfssl_wolfcrypt_Shake_SHAKE128 128L
+#undef com_wolfssl_wolfcrypt_Shake_SHAKE256
+#define com_wolfssl_wolfcrypt_Shake_SHAKE256 256L
+/*
+ * Class:     com_wolfssl_wolfcrypt_Shake
+ * Method:    mallocNativeStruct_internal
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_com_wolfssl_wolfcrypt_Shake_mallocNativeStruct_1internal
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Shake
+ * Method:    native_init_ptr
+ * Signature: (JI)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Shake_native_1init_1ptr
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Shake
+ * Method:    native_copy_ptr
+ * Signature: (JJI)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Shake_native_1copy_1ptr
+  (JNIEnv *, jclass, jlong, jlong, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Shake
+ * Method:    native_update_ptr
+ * Signature: (JILjava/nio/ByteBuffer;II)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Shake_native_1update_1ptr__JILjava_nio_ByteBuffer_2II
+  (JNIEnv *, jclass, jlong, jint, jobject, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Shake
+ * Method:    native_update_ptr
+ * Signature: (JI[BII)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Shake_native_1update_1ptr__JI_3BII
+  (JNIEnv *, jclass, jlong, jint, jbyteArray, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Shake
+ * Method:    native_final_ptr
+ * Signature: (JILjava/nio/ByteBuffer;II)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Shake_native_1final_1ptr__JILjava_nio_ByteBuffer_2II
+  (JNIEnv *, jclass, jlong, jint, jobject, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Shake
+ * Method:    native_final_ptr
+ * Signature: (JI[BII)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Shake_native_1final_1ptr__JI_3BII
+  (JNIEnv *, jclass, jlong, jint, jbyteArray, jint, jint);
+
+/*
+ * Class:     com_wolfssl_wolfcrypt_Shake
+ * Method:    native_hash
+ * Signature: (I[BII[BII)V
+ */
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Shake_native_1hash
+  (JNIEnv *, jclass, jint, jbyteArray, jint, jint, jbyteArray, jint, jint);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -26,6 +26,27 @@
 extern "C" {
 #endif
 
+/* JNI IDs cached at library load, defined in jni_native_struct.c */
+extern jclass    g_cachedWolfCryptExceptionClass;
+extern jmethodID g_cachedWolfCryptExceptionInit;
+extern jclass    g_cachedOutOfMemoryErrorClass;
+extern jclass    g_cachedNativeStructClass;
+extern jfieldID  g_cachedNativeStructPointer;
+extern jclass    g_cachedBufferClass;
+extern jmethodID g_cachedBufferGetLimit;
+extern jmethodID g_cachedBufferSetLimit;
+
+/* Allocate and free native structs wrapped by NativeStruct objects. Memory
+ * is zeroed on allocation and zeroized before being freed, structs from
+ * wolfCryptJniStructMalloc() must only be freed with
+ * wolfCryptJniStructFree() or NativeStruct.xfree(). */
+#ifndef WOLFCRYPTJNI_STRUCT_HDR_SZ
+    #define WOLFCRYPTJNI_STRUCT_HDR_SZ 16
+#endif
+
+void* wolfCryptJniStructMalloc(word32 sz);
+void wolfCryptJniStructFree(void* ptr);
+
 void* getNativeStruct(JNIEnv* env, jobject this);
 
 void setByteArrayMember(
@@ -39,6 +60,36 @@ byte* getByteArray(JNIEnv* env, jbyteArray array);
 void releaseByteArray(JNIEnv* env, jbyteArray array, byte* elements, jint abort);
 word32 getByteArrayLength(JNIEnv* env, jbyteArray array);
 
+byte* getByteArrayCritical(JNIEnv* env, jbyteArray array);
+void releaseByteArrayCritical(JNIEnv* env, jbyteArray array, byte* elements,
+    jint abort);
+
+/* byte[] inputs longer than WOLFCRYPTJNI_CRITICAL_MAX_SZ are streamed through
+ * a WOLFCRYPTJNI_CHUNK_SZ native stack buffer instead of being held in a JNI
+ * critical region, which would block garbage collection for the duration
+ * of the operation. WOLFCRYPTJNI_CHUNK_SZ must be a multiple of the largest
+ * cipher block size used with processByteArrayChunked(). */
+#ifndef WOLFCRYPTJNI_CRITICAL_MAX_SZ
+    #define WOLFCRYPTJNI_CRITICAL_MAX_SZ 65536
+#endif
+#ifndef WOLFCRYPTJNI_CHUNK_SZ
+    #define WOLFCRYPTJNI_CHUNK_SZ 4096
+#endif
+
+typedef int (*ByteArrayChunkCb)(void* ctx, byte* chunk, word32 chunkSz);
+
+/* Input and output ranges of one Java array that overlap at different
+ * offsets can not be passed to wolfCrypt from a critical region, output
+ * would overwrite input not yet read. Such calls use a copy of the input. */
+int byteArrayRangesOverlap(JNIEnv* env, jbyteArray in, jint inOffset,
+    jbyteArray out, jint outOffset, jint len);
+byte* getByteArrayRegionCopy(JNIEnv* env, jbyteArray array, jint offset,
+    jint len);
+void freeByteArrayRegionCopy(byte* copy, jint len);
+
+int processByteArrayChunked(JNIEnv* env, jbyteArray in, jint inOffset,
+    jbyteArray out, jint outOffset, jint len, ByteArrayChunkCb cb, void* ctx);
+
 #ifdef __cplusplus
 }
 #endif
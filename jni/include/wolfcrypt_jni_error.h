@@ -34,14 +34,18 @@ extern "C" {
 
 void throwWolfCryptExceptionFromError(JNIEnv* env, int code);
 
+/* return cached exception class, or look it up if not cached */
+jclass getWolfCryptExceptionClass(JNIEnv* env);
+jclass getOutOfMemoryErrorClass(JNIEnv* env);
+
 #define throwWolfCryptException(env, msg) (*env)->ThrowNew(env, \
-    (*env)->FindClass(env, "com/wolfssl/wolfcrypt/WolfCryptException"), msg)
+    getWolfCryptExceptionClass(env), msg)
 
 #define throwNotCompiledInException(env) \
     throwWolfCryptExceptionFromError(env, NOT_COMPILED_IN)
 
 #define throwOutOfMemoryException(env, msg) (*env)->ThrowNew(env, \
-    (*env)->FindClass(env, "java/lang/OutOfMemoryError"), msg)
+    getOutOfMemoryErrorClass(env), msg)
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,57 @@
+/* wolfcrypt_jni_hash.h
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfCrypt.
+ *
+ * wolfCrypt is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfCrypt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef _Included_wolfcrypt_jni_hash
+#define _Included_wolfcrypt_jni_hash
+
+#include <jni.h>
+#include <wolfssl/wolfcrypt/hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* One-shot digests over a stack allocated wc_HashAlg, used by the static
+ * hash() methods of the MessageDigest classes. Write the digest of
+ * data[offset..offset+len) to hash[hashOffset..]. Return 0 on success or a
+ * wolfCrypt error code, callers throw the matching exception. */
+int wolfCryptJniHashArray(JNIEnv* env, enum wc_HashType type,
+    jbyteArray data, jint offset, jint len, jbyteArray hash, jint hashOffset);
+
+int wolfCryptJniHashBuffer(JNIEnv* env, enum wc_HashType type,
+    jobject data, jint offset, jint len, jobject hash, jint hashOffset);
+
+/* Batch variants, hash count independent messages in one JNI call and
+ * write the digests back to back starting at hash[hashOffset]. Message i
+ * is data[offsets[i]..offsets[i]+lengths[i]) for the array variant, and
+ * the same range of direct buffer data[i] for the buffer array variant. */
+int wolfCryptJniHashBatchArray(JNIEnv* env, enum wc_HashType type,
+    jbyteArray data, jintArray offsets, jintArray lengths, jint count,
+    jbyteArray hash, jint hashOffset);
+
+int wolfCryptJniHashBatchBuffers(JNIEnv* env, enum wc_HashType type,
+    jobjectArray data, jintArray offsets, jintArray lengths, jint count,
+    jobject hash, jint hashOffset);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,93 @@
+/* wolfcrypt_jni_log.h
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfCrypt.
+ *
+ * wolfCrypt is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfCrypt is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef _Included_wolfcrypt_jni_log
+#define _Included_wolfcrypt_jni_log
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Leveled native logging.
+ *
+ * Unlike LogStr(), which writes to stdout and only exists in
+ * WOLFCRYPT_JNI_DEBUG_ON builds, these macros record into an in-memory ring
+ * buffer that Java drains with Logging.getNativeLog(). A record is the
+ * format string pointer plus two integer arguments, formatting only happens
+ * when the ring is drained, so an enabled log point costs one atomic
+ * increment and a few stores. fmt must be a string literal and may use at
+ * most two %lld conversions.
+ *
+ * Levels above WOLFCRYPT_JNI_LOG_LEVEL are removed at compile time, the rest
+ * are checked against the runtime level set with Logging.setNativeLogLevel().
+ * Define WOLFCRYPT_JNI_LOG_LEVEL to WOLFCRYPT_JNI_LOG_OFF to build with no
+ * log points at all. */
+
+#define WOLFCRYPT_JNI_LOG_OFF   0
+#define WOLFCRYPT_JNI_LOG_ERROR 1
+#define WOLFCRYPT_JNI_LOG_INFO  2
+#define WOLFCRYPT_JNI_LOG_DEBUG 3
+
+#ifndef WOLFCRYPT_JNI_LOG_LEVEL
+    #define WOLFCRYPT_JNI_LOG_LEVEL WOLFCRYPT_JNI_LOG_INFO
+#endif
+
+/* ring size, must be a power of two */
+#ifndef WOLFCRYPT_JNI_LOG_ENTRIES
+    #define WOLFCRYPT_JNI_LOG_ENTRIES 1024
+#endif
+
+extern volatile int wolfCryptJniLogLevel;
+
+void wolfCryptJniLogWrite(int level, const char* fmt, long long a,
+                          long long b);
+
+#define WOLFCRYPT_JNI_LOG(level, fmt, a, b)                              \
+    do {                                                                 \
+        if (wolfCryptJniLogLevel >= (level))                             \
+            wolfCryptJniLogWrite((level), (fmt), (long long)(a),         \
+                                 (long long)(b));                        \
+    } while (0)
+
+#if WOLFCRYPT_JNI_LOG_LEVEL >= WOLFCRYPT_JNI_LOG_ERROR
+    #define LogError(fmt, a, b) \
+        WOLFCRYPT_JNI_LOG(WOLFCRYPT_JNI_LOG_ERROR, fmt, a, b)
+#else
+    #define LogError(fmt, a, b) do { } while (0)
+#endif
+
+#if WOLFCRYPT_JNI_LOG_LEVEL >= WOLFCRYPT_JNI_LOG_INFO
+    #define LogInfo(fmt, a, b) \
+        WOLFCRYPT_JNI_LOG(WOLFCRYPT_JNI_LOG_INFO, fmt, a, b)
+#else
+    #define LogInfo(fmt, a, b) do { } while (0)
+#endif
+
+#if WOLFCRYPT_JNI_LOG_LEVEL >= WOLFCRYPT_JNI_LOG_DEBUG
+    #define LogDebug(fmt, a, b) \
+        WOLFCRYPT_JNI_LOG(WOLFCRYPT_JNI_LOG_DEBUG, fmt, a, b)
+#else
+    #define LogDebug(fmt, a, b) do { } while (0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
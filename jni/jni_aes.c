@@ -27,6 +27,7 @@
     #include <wolfssl/options.h>
 #endif
 #include <wolfssl/wolfcrypt/aes.h>
+#include <wolfssl/wolfcrypt/misc.h>
 
 #include <com_wolfssl_wolfcrypt_Aes.h>
 #include <wolfcrypt_jni_NativeStruct.h>
@@ -34,6 +35,7 @@
 
 /* #define WOLFCRYPT_JNI_DEBUG_ON */
 #include <wolfcrypt_jni_debug.h>
+#include <wolfcrypt_jni_log.h>
 
 JNIEXPORT jlong JNICALL Java_com_wolfssl_wolfcrypt_Aes_mallocNativeStruct_1internal(
     JNIEnv* env, jobject this)
@@ -41,13 +43,10 @@ JNIEXPORT jlong JNICALL Java_com_wolfssl_wolfcrypt_Aes_mallocNativeStruct_1inter
 #ifndef NO_AES
     Aes* aes = NULL;
 
-    aes = (Aes*)XMALLOC(sizeof(Aes), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    aes = (Aes*)wolfCryptJniStructMalloc(sizeof(Aes));
     if (aes == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Aes object");
     }
-    else {
-        XMEMSET(aes, 0, sizeof(Aes));
-    }
 
     LogStr("new Aes() = %p\n", aes);
 
@@ -99,6 +98,99 @@ Java_com_wolfssl_wolfcrypt_Aes_native_1set_1key_1internal(
 #endif
 }
 
+#ifndef NO_AES
+static int aes_encrypt_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_AesCbcEncrypt((Aes*)ctx, chunk, chunk, chunkSz);
+}
+
+static int aes_decrypt_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_AesCbcDecrypt((Aes*)ctx, chunk, chunk, chunkSz);
+}
+
+static jint aes_update_array(JNIEnv* env, Aes* aes, jint opmode,
+    jbyteArray input_object, jint offset, jint length, jbyteArray output_object,
+    jint outputOffset)
+{
+    int ret = 0;
+    byte* input  = NULL;
+    byte* output = NULL;
+    word32 inputSz  = 0;
+    word32 outputSz = 0;
+
+    inputSz  = getByteArrayLength(env, input_object);
+    outputSz = getByteArrayLength(env, output_object);
+
+    if (!aes || !input_object || !output_object) {
+        ret = BAD_FUNC_ARG; /* NULL sanitizers */
+    }
+    else if (offset < 0 || length < 0 || outputOffset < 0) {
+        ret = BAD_FUNC_ARG; /* signed sanizizers */
+    }
+    else if (length == 0) {
+        ret = 0;
+    }
+    else if ((word32)(offset + length) > inputSz) {
+        ret = BUFFER_E; /* buffer overflow check */
+    }
+    else if ((word32)(outputOffset + length) > outputSz) {
+        ret = BUFFER_E; /* buffer overflow check */
+    }
+    else if (length > WOLFCRYPTJNI_CRITICAL_MAX_SZ ||
+             byteArrayRangesOverlap(env, input_object, offset, output_object,
+                 outputOffset, length)) {
+        /* stream large inputs instead of pinning the arrays, overlapping
+         * ranges of one array can not be processed in place either */
+        ret = processByteArrayChunked(env, input_object, offset,
+            output_object, outputOffset, length,
+            (opmode == AES_ENCRYPTION) ? aes_encrypt_chunk : aes_decrypt_chunk,
+            aes);
+        LogStr("aes chunked update(opmode=%d, inSz=%d) = %d\n", opmode,
+            length, ret);
+    }
+    else {
+        /* no other JNI calls until both arrays are released */
+        input  = getByteArrayCritical(env, input_object);
+        output = getByteArrayCritical(env, output_object);
+
+        if (!input || !output) {
+            ret = BAD_FUNC_ARG;
+        }
+        else if (opmode == AES_ENCRYPTION) {
+            ret = wc_AesCbcEncrypt(aes, output + outputOffset, input + offset,
+                length);
+            LogStr("wc_AesCbcEncrypt(aes=%p, out, in, inSz) = %d\n", aes, ret);
+            LogInfo("wc_AesCbcEncrypt(len %lld) = %lld", length, ret);
+        }
+        else {
+            ret = wc_AesCbcDecrypt(aes, output + outputOffset, input + offset,
+                length);
+            LogStr("wc_AesCbcDecrypt(aes=%p, out, in, inSz) = %d\n", aes, ret);
+            LogInfo("wc_AesCbcDecrypt(len %lld) = %lld", length, ret);
+        }
+
+        LogStr("input[%u]: [%p]\n", (word32)length, input + offset);
+        LogHex((byte*) input, offset, length);
+        LogStr("output[%u]: [%p]\n", (word32)length, output + outputOffset);
+        LogHex((byte*) output, outputOffset, length);
+
+        releaseByteArrayCritical(env, output_object, output, ret);
+        releaseByteArrayCritical(env, input_object, input, JNI_ABORT);
+    }
+
+    if (ret != 0) {
+        throwWolfCryptExceptionFromError(env, ret);
+        ret = 0; /* 0 bytes stored in output */
+    }
+    else {
+        ret = length;
+    }
+
+    return ret;
+}
+#endif
+
 JNIEXPORT jint JNICALL
 Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__I_3BII_3BI(
     JNIEnv* env, jobject this, jint opmode,
@@ -106,19 +198,47 @@ Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__I_3BII_3BI(
     jbyteArray output_object, jint outputOffset)
 {
 #ifndef NO_AES
-    int ret = 0;
-    Aes*  aes    = NULL;
-    byte* input  = NULL;
-    byte* output = NULL;
-
-    aes = (Aes*) getNativeStruct(env, this);
+    Aes* aes = (Aes*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return 0;
     }
 
-    input  = getByteArray(env, input_object);
-    output = getByteArray(env, output_object);
+    return aes_update_array(env, aes, opmode, input_object, offset, length,
+        output_object, outputOffset);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1update_1ptr__JI_3BII_3BI(
+    JNIEnv* env, jclass jcl, jlong ptr, jint opmode, jbyteArray input_object,
+    jint offset, jint length, jbyteArray output_object, jint outputOffset)
+{
+#ifndef NO_AES
+    return aes_update_array(env, (Aes*)(uintptr_t)ptr, opmode, input_object,
+        offset, length, output_object, outputOffset);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+#ifndef NO_AES
+static jint aes_update_buffer(JNIEnv* env, Aes* aes, jint opmode,
+    jobject input_object, jint offset, jint length, jobject output_object,
+    jint outputOffset)
+{
+    int ret = 0;
+    byte* input  = NULL;
+    byte* output = NULL;
+
+    input  = getDirectBufferAddress(env, input_object);
+    output = getDirectBufferAddress(env, output_object);
 
     if (!aes || !input || !output) {
         ret = BAD_FUNC_ARG; /* NULL sanitizers */
@@ -126,23 +246,33 @@ Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__I_3BII_3BI(
     else if (offset < 0 || length < 0 || outputOffset < 0) {
         ret = BAD_FUNC_ARG; /* signed sanizizers */
     }
-    else if (length == 0) {
-        ret = 0;
-    } else if ((word32)(offset + length) >
-             getByteArrayLength(env, input_object)) {
+    else if ((word32)(offset + length) >
+             getDirectBufferLimit(env, input_object)) {
         ret = BUFFER_E; /* buffer overflow check */
     }
     else if ((word32)(outputOffset + length) >
-             getByteArrayLength(env, output_object)) {
+             getDirectBufferLimit(env, output_object)) {
         ret = BUFFER_E; /* buffer overflow check */
     }
     else if (opmode == AES_ENCRYPTION) {
-        ret = wc_AesCbcEncrypt(aes, output+outputOffset, input+offset, length);
+        ret = wc_AesCbcEncrypt(aes, output + outputOffset,
+            input + offset, length);
         LogStr("wc_AesCbcEncrypt(aes=%p, out, in, inSz) = %d\n", aes, ret);
+        LogInfo("wc_AesCbcEncrypt(len %lld) = %lld", length, ret);
     }
     else {
-        ret = wc_AesCbcDecrypt(aes, output+outputOffset, input+offset, length);
+        ret = wc_AesCbcDecrypt(aes, output + outputOffset,
+            input + offset, length);
         LogStr("wc_AesCbcDecrypt(aes=%p, out, in, inSz) = %d\n", aes, ret);
+        LogInfo("wc_AesCbcDecrypt(len %lld) = %lld", length, ret);
+    }
+
+    if (ret != 0) {
+        throwWolfCryptExceptionFromError(env, ret);
+        ret = 0; /* 0 bytes stored in output */
+    }
+    else {
+        ret = length;
     }
 
     LogStr("input[%u]: [%p]\n", (word32)length, input + offset);
@@ -150,8 +280,165 @@ Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__I_3BII_3BI(
     LogStr("output[%u]: [%p]\n", (word32)length, output + outputOffset);
     LogHex((byte*) output, outputOffset, length);
 
-    releaseByteArray(env, input_object, input, JNI_ABORT);
-    releaseByteArray(env, output_object, output, ret);
+    return ret;
+}
+#endif
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__ILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jobject this, jint opmode,
+    jobject input_object, jint offset, jint length,
+    jobject output_object, jint outputOffset)
+{
+#ifndef NO_AES
+    Aes* aes = (Aes*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return 0;
+    }
+
+    return aes_update_buffer(env, aes, opmode, input_object, offset, length,
+        output_object, outputOffset);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1update_1ptr__JILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jlong ptr, jint opmode, jobject input_object,
+    jint offset, jint length, jobject output_object, jint outputOffset)
+{
+#ifndef NO_AES
+    return aes_update_buffer(env, (Aes*)(uintptr_t)ptr, opmode, input_object,
+        offset, length, output_object, outputOffset);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1set_1key_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray key_object)
+{
+#if !defined(NO_AES) && defined(HAVE_AESGCM)
+    int ret = 0;
+    Aes* aes  = (Aes*)(uintptr_t)ptr;
+    byte* key = NULL;
+    word32 keySz = 0;
+
+    key = getByteArray(env, key_object);
+    keySz = getByteArrayLength(env, key_object);
+
+    ret = (!aes || !key)
+        ? BAD_FUNC_ARG
+        : wc_AesGcmSetKey(aes, key, keySz);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+
+    LogStr("wc_AesGcmSetKey(aes=%p, key=%p, keySz=%u) = %d\n",
+        aes, key, keySz, ret);
+
+    releaseByteArray(env, key_object, key, JNI_ABORT);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+#if !defined(NO_AES) && defined(HAVE_AESGCM)
+static jint aes_gcm_crypt(JNIEnv* env, Aes* aes, int encrypt,
+    jbyteArray input_object, jint offset, jint length, jbyteArray output_object,
+    jint outputOffset, jbyteArray iv_object, jbyteArray authTag_object,
+    jbyteArray authIn_object)
+{
+    int ret = 0;
+    byte* input   = NULL;
+    byte* output  = NULL;
+    byte* in      = NULL;
+    byte* copy    = NULL;
+    byte* iv      = NULL;
+    byte* authTag = NULL;
+    byte* authIn  = NULL;
+    word32 inputSz   = 0;
+    word32 outputSz  = 0;
+    word32 ivSz      = 0;
+    word32 authTagSz = 0;
+    word32 authInSz  = 0;
+
+    inputSz   = getByteArrayLength(env, input_object);
+    outputSz  = getByteArrayLength(env, output_object);
+    ivSz      = getByteArrayLength(env, iv_object);
+    authTagSz = getByteArrayLength(env, authTag_object);
+    authInSz  = getByteArrayLength(env, authIn_object);
+
+    if (!aes || !input_object || !output_object || !iv_object ||
+        !authTag_object) {
+        ret = BAD_FUNC_ARG; /* NULL sanitizers, authIn is optional */
+    }
+    else if (offset < 0 || length < 0 || outputOffset < 0) {
+        ret = BAD_FUNC_ARG; /* signed sanizizers */
+    }
+    else if ((word32)(offset + length) > inputSz) {
+        ret = BUFFER_E; /* buffer overflow check */
+    }
+    else if ((word32)(outputOffset + length) > outputSz) {
+        ret = BUFFER_E; /* buffer overflow check */
+    }
+    else {
+        /* small parameter arrays are copied first, so that no other JNI
+         * calls are made while the data arrays are held critical */
+        iv      = getByteArray(env, iv_object);
+        authTag = getByteArray(env, authTag_object);
+        authIn  = getByteArray(env, authIn_object);
+
+        /* overlapping ranges of one array are read from a copy */
+        if (byteArrayRangesOverlap(env, input_object, offset, output_object,
+                outputOffset, length)) {
+            copy = getByteArrayRegionCopy(env, input_object, offset, length);
+        }
+        else {
+            input = getByteArrayCritical(env, input_object);
+        }
+        output = getByteArrayCritical(env, output_object);
+        in = (copy != NULL) ? copy : (input != NULL) ? input + offset : NULL;
+
+        if (!in || !output || !iv || !authTag) {
+            ret = BAD_FUNC_ARG;
+        }
+        else if (encrypt) {
+            ret = wc_AesGcmEncrypt(aes, output + outputOffset, in,
+                length, iv, ivSz, authTag, authTagSz, authIn, authInSz);
+            LogStr("wc_AesGcmEncrypt(aes=%p, out, in, inSz) = %d\n", aes, ret);
+            LogInfo("wc_AesGcmEncrypt(len %lld) = %lld", length, ret);
+        }
+        else {
+            ret = wc_AesGcmDecrypt(aes, output + outputOffset, in,
+                length, iv, ivSz, authTag, authTagSz, authIn, authInSz);
+            LogStr("wc_AesGcmDecrypt(aes=%p, out, in, inSz) = %d\n", aes, ret);
+            LogInfo("wc_AesGcmDecrypt(len %lld) = %lld", length, ret);
+
+            /* critical writes may land in the Java array directly and
+             * JNI_ABORT can't undo them, so wipe unverified plaintext */
+            if (ret != 0)
+                ForceZero(output + outputOffset, (word32)length);
+        }
+
+        releaseByteArrayCritical(env, output_object, output, ret);
+        releaseByteArrayCritical(env, input_object, input, JNI_ABORT);
+        freeByteArrayRegionCopy(copy, length);
+
+        /* tag is only written back when encrypting */
+        releaseByteArray(env, authTag_object, authTag,
+            (encrypt && ret == 0) ? 0 : JNI_ABORT);
+        releaseByteArray(env, authIn_object, authIn, JNI_ABORT);
+        releaseByteArray(env, iv_object, iv, JNI_ABORT);
+    }
 
     if (ret != 0) {
         throwWolfCryptExceptionFromError(env, ret);
@@ -160,39 +447,338 @@ Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__I_3BII_3BI(
     else {
         ret = length;
     }
+
+    return ret;
+}
+#endif
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1encrypt_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray input_object, jint offset,
+    jint length, jbyteArray output_object, jint outputOffset,
+    jbyteArray iv_object, jbyteArray authTag_object, jbyteArray authIn_object)
+{
+#if !defined(NO_AES) && defined(HAVE_AESGCM)
+    return aes_gcm_crypt(env, (Aes*)(uintptr_t)ptr, 1, input_object, offset,
+        length, output_object, outputOffset, iv_object, authTag_object,
+        authIn_object);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1decrypt_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray input_object, jint offset,
+    jint length, jbyteArray output_object, jint outputOffset,
+    jbyteArray iv_object, jbyteArray authTag_object, jbyteArray authIn_object)
+{
+#if !defined(NO_AES) && defined(HAVE_AESGCM)
+    return aes_gcm_crypt(env, (Aes*)(uintptr_t)ptr, 0, input_object, offset,
+        length, output_object, outputOffset, iv_object, authTag_object,
+        authIn_object);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1init_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray iv_object)
+{
+#if !defined(NO_AES) && defined(HAVE_AESGCM) && \
+    defined(WOLFSSL_AESGCM_STREAM)
+    int ret = 0;
+    Aes* aes = (Aes*)(uintptr_t)ptr;
+    byte* iv = NULL;
+    word32 ivSz = 0;
+
+    iv = getByteArray(env, iv_object);
+    ivSz = getByteArrayLength(env, iv_object);
+
+    /* key was already set with wc_AesGcmSetKey(), only reset the IV */
+    ret = (!aes || !iv)
+        ? BAD_FUNC_ARG
+        : wc_AesGcmInit(aes, NULL, 0, iv, ivSz);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+
+    LogStr("wc_AesGcmInit(aes=%p, iv=%p, ivSz=%u) = %d\n", aes, iv, ivSz, ret);
+
+    releaseByteArray(env, iv_object, iv, JNI_ABORT);
 #else
     throwNotCompiledInException(env);
 #endif
+}
+
+#if !defined(NO_AES) && defined(HAVE_AESGCM) && \
+    defined(WOLFSSL_AESGCM_STREAM)
+static int aes_gcm_encrypt_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_AesGcmEncryptUpdate((Aes*)ctx, chunk, chunk, chunkSz, NULL, 0);
+}
+
+static int aes_gcm_decrypt_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_AesGcmDecryptUpdate((Aes*)ctx, chunk, chunk, chunkSz, NULL, 0);
+}
+
+static jint aes_gcm_update(JNIEnv* env, Aes* aes, jint opmode,
+    jbyteArray input_object, jint offset, jint length, jbyteArray output_object,
+    jint outputOffset, jbyteArray authIn_object)
+{
+    int ret = 0;
+    byte* input  = NULL;
+    byte* output = NULL;
+    byte* authIn = NULL;
+    word32 inputSz  = 0;
+    word32 outputSz = 0;
+    word32 authInSz = 0;
+
+    inputSz  = getByteArrayLength(env, input_object);
+    outputSz = getByteArrayLength(env, output_object);
+    authInSz = getByteArrayLength(env, authIn_object);
+
+    if (!aes) {
+        ret = BAD_FUNC_ARG; /* NULL sanitizers, all arrays optional */
+    }
+    else if (offset < 0 || length < 0 || outputOffset < 0) {
+        ret = BAD_FUNC_ARG; /* signed sanizizers */
+    }
+    else if (length > 0 && (!input_object || !output_object)) {
+        ret = BAD_FUNC_ARG;
+    }
+    else if (length > 0 && (word32)(offset + length) > inputSz) {
+        ret = BUFFER_E; /* buffer overflow check */
+    }
+    else if (length > 0 && (word32)(outputOffset + length) > outputSz) {
+        ret = BUFFER_E; /* buffer overflow check */
+    }
+
+    /* AAD is passed on its own before any data */
+    if (ret == 0 && authInSz > 0) {
+        authIn = getByteArray(env, authIn_object);
+
+        if (!authIn) {
+            ret = BAD_FUNC_ARG;
+        }
+        else if (opmode == AES_ENCRYPTION) {
+            ret = wc_AesGcmEncryptUpdate(aes, NULL, NULL, 0, authIn, authInSz);
+        }
+        else {
+            ret = wc_AesGcmDecryptUpdate(aes, NULL, NULL, 0, authIn, authInSz);
+        }
+        LogStr("aes gcm AAD update(opmode=%d, aadSz=%u) = %d\n", opmode,
+            authInSz, ret);
+
+        releaseByteArray(env, authIn_object, authIn, JNI_ABORT);
+    }
+
+    if (ret != 0 || length == 0) {
+        /* error, or nothing more to process */
+    }
+    else if (length > WOLFCRYPTJNI_CRITICAL_MAX_SZ ||
+             byteArrayRangesOverlap(env, input_object, offset, output_object,
+                 outputOffset, length)) {
+        /* stream large inputs instead of pinning the arrays, overlapping
+         * ranges of one array can not be processed in place either */
+        ret = processByteArrayChunked(env, input_object, offset,
+            output_object, outputOffset, length,
+            (opmode == AES_ENCRYPTION) ?
+                aes_gcm_encrypt_chunk : aes_gcm_decrypt_chunk,
+            aes);
+        LogStr("aes gcm chunked update(opmode=%d, inSz=%d) = %d\n", opmode,
+            length, ret);
+    }
+    else {
+        /* no other JNI calls until both arrays are released */
+        input  = getByteArrayCritical(env, input_object);
+        output = getByteArrayCritical(env, output_object);
+
+        if (!input || !output) {
+            ret = BAD_FUNC_ARG;
+        }
+        else if (opmode == AES_ENCRYPTION) {
+            ret = wc_AesGcmEncryptUpdate(aes, output + outputOffset,
+                input + offset, length, NULL, 0);
+        }
+        else {
+            ret = wc_AesGcmDecryptUpdate(aes, output + outputOffset,
+                input + offset, length, NULL, 0);
+        }
+
+        releaseByteArrayCritical(env, output_object, output, ret);
+        releaseByteArrayCritical(env, input_object, input, JNI_ABORT);
+
+        LogStr("aes gcm update(opmode=%d, inSz=%d) = %d\n", opmode,
+            length, ret);
+    }
+
+    if (ret != 0) {
+        throwWolfCryptExceptionFromError(env, ret);
+        ret = 0; /* 0 bytes stored in output */
+    }
+    else {
+        ret = length;
+    }
 
     return ret;
 }
+#endif
 
 JNIEXPORT jint JNICALL
-Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__ILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I(
-    JNIEnv* env, jobject this, jint opmode,
-    jobject input_object, jint offset, jint length,
-    jobject output_object, jint outputOffset)
+Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1update_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jint opmode, jbyteArray input_object,
+    jint offset, jint length, jbyteArray output_object, jint outputOffset,
+    jbyteArray authIn_object)
 {
+#if !defined(NO_AES) && defined(HAVE_AESGCM) && \
+    defined(WOLFSSL_AESGCM_STREAM)
+    return aes_gcm_update(env, (Aes*)(uintptr_t)ptr, opmode, input_object,
+        offset, length, output_object, outputOffset, authIn_object);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1gcm_1final_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jint opmode, jbyteArray authTag_object)
+{
+#if !defined(NO_AES) && defined(HAVE_AESGCM) && \
+    defined(WOLFSSL_AESGCM_STREAM)
     int ret = 0;
+    Aes* aes = (Aes*)(uintptr_t)ptr;
+    byte* authTag = NULL;
+    word32 authTagSz = 0;
 
-#ifndef NO_AES
-    Aes*  aes    = NULL;
+    authTag = getByteArray(env, authTag_object);
+    authTagSz = getByteArrayLength(env, authTag_object);
+
+    if (!aes || !authTag) {
+        ret = BAD_FUNC_ARG;
+    }
+    else if (opmode == AES_ENCRYPTION) {
+        ret = wc_AesGcmEncryptFinal(aes, authTag, authTagSz);
+        LogStr("wc_AesGcmEncryptFinal(aes=%p, tagSz=%u) = %d\n", aes,
+            authTagSz, ret);
+    }
+    else {
+        /* returns AES_GCM_AUTH_E if tag does not match */
+        ret = wc_AesGcmDecryptFinal(aes, authTag, authTagSz);
+        LogStr("wc_AesGcmDecryptFinal(aes=%p, tagSz=%u) = %d\n", aes,
+            authTagSz, ret);
+    }
+
+    /* tag is only written back when encrypting */
+    releaseByteArray(env, authTag_object, authTag,
+        (opmode == AES_ENCRYPTION && ret == 0) ? 0 : JNI_ABORT);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+#if !defined(NO_AES) && defined(WOLFSSL_AES_COUNTER)
+static int aes_ctr_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_AesCtrEncrypt((Aes*)ctx, chunk, chunk, chunkSz);
+}
+
+static jint aes_ctr_update_array(JNIEnv* env, Aes* aes,
+    jbyteArray input_object, jint offset, jint length, jbyteArray output_object,
+    jint outputOffset)
+{
+    int ret = 0;
     byte* input  = NULL;
     byte* output = NULL;
+    word32 inputSz  = 0;
+    word32 outputSz = 0;
 
-    aes = (Aes*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return 0;
+    inputSz  = getByteArrayLength(env, input_object);
+    outputSz = getByteArrayLength(env, output_object);
+
+    if (!aes || !input_object || !output_object) {
+        ret = BAD_FUNC_ARG; /* NULL sanitizers */
+    }
+    else if (offset < 0 || length < 0 || outputOffset < 0) {
+        ret = BAD_FUNC_ARG; /* signed sanizizers */
+    }
+    else if (length == 0) {
+        ret = 0;
+    }
+    else if ((word32)(offset + length) > inputSz) {
+        ret = BUFFER_E; /* buffer overflow check */
+    }
+    else if ((word32)(outputOffset + length) > outputSz) {
+        ret = BUFFER_E; /* buffer overflow check */
+    }
+    else if (length > WOLFCRYPTJNI_CRITICAL_MAX_SZ ||
+             byteArrayRangesOverlap(env, input_object, offset, output_object,
+                 outputOffset, length)) {
+        /* stream large inputs instead of pinning the arrays, keystream
+         * position is kept in the Aes struct between chunks. Overlapping
+         * ranges of one array can not be processed in place either. */
+        ret = processByteArrayChunked(env, input_object, offset,
+            output_object, outputOffset, length, aes_ctr_chunk, aes);
+        LogStr("aes ctr chunked update(inSz=%d) = %d\n", length, ret);
+    }
+    else {
+        /* no other JNI calls until both arrays are released */
+        input  = getByteArrayCritical(env, input_object);
+        output = getByteArrayCritical(env, output_object);
+
+        if (!input || !output) {
+            ret = BAD_FUNC_ARG;
+        }
+        else {
+            ret = wc_AesCtrEncrypt(aes, output + outputOffset, input + offset,
+                length);
+        }
+
+        releaseByteArrayCritical(env, output_object, output, ret);
+        releaseByteArrayCritical(env, input_object, input, JNI_ABORT);
+
+        LogStr("wc_AesCtrEncrypt(aes=%p, out, in, inSz=%d) = %d\n", aes,
+            length, ret);
+        LogInfo("wc_AesCtrEncrypt(len %lld) = %lld", length, ret);
     }
 
+    if (ret != 0) {
+        throwWolfCryptExceptionFromError(env, ret);
+        ret = 0; /* 0 bytes stored in output */
+    }
+    else {
+        ret = length;
+    }
+
+    return ret;
+}
+
+static jint aes_ctr_update_buffer(JNIEnv* env, Aes* aes,
+    jobject input_object, jint offset, jint length, jobject output_object,
+    jint outputOffset)
+{
+    int ret = 0;
+    byte* input  = NULL;
+    byte* output = NULL;
+
     input  = getDirectBufferAddress(env, input_object);
     output = getDirectBufferAddress(env, output_object);
 
     if (!aes || !input || !output) {
         ret = BAD_FUNC_ARG; /* NULL sanitizers */
     }
-    else if (offset < 0 || length < 0) {
+    else if (offset < 0 || length < 0 || outputOffset < 0) {
         ret = BAD_FUNC_ARG; /* signed sanizizers */
     }
     else if ((word32)(offset + length) >
@@ -203,13 +789,13 @@ Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__ILjava_nio_ByteBuffer_2
              getDirectBufferLimit(env, output_object)) {
         ret = BUFFER_E; /* buffer overflow check */
     }
-    else if (opmode == AES_ENCRYPTION) {
-        ret = wc_AesCbcEncrypt(aes, output, input + offset, length);
-        LogStr("wc_AesCbcEncrypt(aes=%p, out, in, inSz) = %d\n", aes, ret);
-    }
-    else {
-        ret = wc_AesCbcDecrypt(aes, output, input + offset, length);
-        LogStr("wc_AesCbcDecrypt(aes=%p, out, in, inSz) = %d\n", aes, ret);
+    else if (length > 0) {
+        /* direct buffers are processed in place, no copies */
+        ret = wc_AesCtrEncrypt(aes, output + outputOffset, input + offset,
+            length);
+        LogStr("wc_AesCtrEncrypt(aes=%p, out, in, inSz=%d) = %d\n", aes,
+            length, ret);
+        LogInfo("wc_AesCtrEncrypt(len %lld) = %lld", length, ret);
     }
 
     if (ret != 0) {
@@ -220,14 +806,116 @@ Java_com_wolfssl_wolfcrypt_Aes_native_1update_1internal__ILjava_nio_ByteBuffer_2
         ret = length;
     }
 
-    LogStr("input[%u]: [%p]\n", (word32)length, input + offset);
-    LogHex((byte*) input, offset, length);
-    LogStr("output[%u]: [%p]\n", (word32)length, output);
-    LogHex((byte*) output, 0, length);
+    return ret;
+}
+#endif
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1ctr_1update_1ptr__J_3BII_3BI(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray input_object, jint offset,
+    jint length, jbyteArray output_object, jint outputOffset)
+{
+#if !defined(NO_AES) && defined(WOLFSSL_AES_COUNTER)
+    return aes_ctr_update_array(env, (Aes*)(uintptr_t)ptr, input_object,
+        offset, length, output_object, outputOffset);
 #else
     throwNotCompiledInException(env);
+
+    return 0;
 #endif
+}
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1ctr_1update_1ptr__JLjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject input_object, jint offset,
+    jint length, jobject output_object, jint outputOffset)
+{
+#if !defined(NO_AES) && defined(WOLFSSL_AES_COUNTER)
+    return aes_ctr_update_buffer(env, (Aes*)(uintptr_t)ptr, input_object,
+        offset, length, output_object, outputOffset);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+#if !defined(NO_AES) && defined(WOLFSSL_AES_COUNTER)
+/* Position AES-CTR keystream at byte offset 'position' from the start of
+ * the stream that begins with counter block 'iv'. */
+static int aes_ctr_seek(Aes* aes, const byte* iv, word64 position)
+{
+    int i;
+    int ret = 0;
+    word32 carry = 0;
+    word64 blocks = position / AES_BLOCK_SIZE;
+    word32 partial = (word32)(position % AES_BLOCK_SIZE);
+    byte counter[AES_BLOCK_SIZE];
+    byte skip[AES_BLOCK_SIZE];
+
+    /* add block index to big-endian 128-bit counter, same as wolfCrypt
+     * increments it internally */
+    XMEMCPY(counter, iv, AES_BLOCK_SIZE);
+    for (i = AES_BLOCK_SIZE - 1; i >= 0; i--) {
+        carry += (word32)counter[i] + (word32)(blocks & 0xff);
+        counter[i] = (byte)carry;
+        carry >>= 8;
+        blocks >>= 8;
+    }
+
+    ret = wc_AesSetIV(aes, counter);
+    if (ret == 0) {
+        /* drop any leftover keystream from the previous position */
+        aes->left = 0;
+
+        if (partial > 0) {
+            /* discard keystream bytes before position in this block */
+            XMEMSET(skip, 0, sizeof(skip));
+            ret = wc_AesCtrEncrypt(aes, skip, skip, partial);
+            XMEMSET(skip, 0, sizeof(skip));
+        }
+    }
+
+    XMEMSET(counter, 0, sizeof(counter));
 
     return ret;
 }
+#endif
 
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Aes_native_1ctr_1update_1at_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray iv_object, jlong position,
+    jbyteArray input_object, jint offset, jint length,
+    jbyteArray output_object, jint outputOffset)
+{
+#if !defined(NO_AES) && defined(WOLFSSL_AES_COUNTER)
+    int ret = 0;
+    Aes* aes = (Aes*)(uintptr_t)ptr;
+    byte* iv = NULL;
+
+    if (!aes || position < 0 ||
+        getByteArrayLength(env, iv_object) != AES_BLOCK_SIZE) {
+        ret = BAD_FUNC_ARG;
+    }
+    else {
+        iv = getByteArray(env, iv_object);
+        ret = (!iv) ? BAD_FUNC_ARG : aes_ctr_seek(aes, iv, (word64)position);
+        releaseByteArray(env, iv_object, iv, JNI_ABORT);
+
+        LogStr("aes_ctr_seek(aes=%p, position=%lld) = %d\n", aes,
+            (long long)position, ret);
+    }
+
+    if (ret != 0) {
+        throwWolfCryptExceptionFromError(env, ret);
+        return 0;
+    }
+
+    return aes_ctr_update_array(env, aes, input_object, offset, length,
+        output_object, outputOffset);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
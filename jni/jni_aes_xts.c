@@ -0,0 +1,194 @@
+/* jni_aes_xts.c
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <stdint.h>
+
+#ifdef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/wolfcrypt/settings.h>
+#elif !defined(__ANDROID__)
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/aes.h>
+
+#include <com_wolfssl_wolfcrypt_AesXts.h>
+#include <wolfcrypt_jni_NativeStruct.h>
+#include <wolfcrypt_jni_error.h>
+
+/* #define WOLFCRYPT_JNI_DEBUG_ON */
+#include <wolfcrypt_jni_debug.h>
+
+JNIEXPORT jlong JNICALL
+Java_com_wolfssl_wolfcrypt_AesXts_mallocNativeStruct_1internal(
+    JNIEnv* env, jobject this)
+{
+#if !defined(NO_AES) && defined(WOLFSSL_AES_XTS)
+    XtsAes* xaes = NULL;
+
+    xaes = (XtsAes*)wolfCryptJniStructMalloc(sizeof(XtsAes));
+    if (xaes == NULL) {
+        throwOutOfMemoryException(env, "Failed to allocate XtsAes object");
+    }
+
+    LogStr("new XtsAes() = %p\n", xaes);
+
+    return (jlong)(uintptr_t)xaes;
+
+#else
+    throwNotCompiledInException(env);
+
+    return (jlong)0;
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_AesXts_native_1set_1key_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray key_object, jint opmode)
+{
+#if !defined(NO_AES) && defined(WOLFSSL_AES_XTS)
+    int ret = 0;
+    XtsAes* xaes = (XtsAes*)(uintptr_t)ptr;
+    byte* key = NULL;
+    word32 keySz = 0;
+
+    key = getByteArray(env, key_object);
+    keySz = getByteArrayLength(env, key_object);
+
+    if (!xaes || !key) {
+        ret = BAD_FUNC_ARG;
+    }
+    else {
+        /* release any previous key before setting a new one */
+        wc_AesXtsFree(xaes);
+        ret = wc_AesXtsSetKey(xaes, key, keySz,
+            (opmode == AES_ENCRYPTION) ? AES_ENCRYPTION : AES_DECRYPTION,
+            NULL, INVALID_DEVID);
+    }
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+
+    LogStr("wc_AesXtsSetKey(xaes=%p, key=%p, keySz=%u, dir=%d) = %d\n",
+        xaes, key, keySz, opmode, ret);
+
+    releaseByteArray(env, key_object, key, JNI_ABORT);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_AesXts_native_1free_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#if !defined(NO_AES) && defined(WOLFSSL_AES_XTS)
+    XtsAes* xaes = (XtsAes*)(uintptr_t)ptr;
+
+    if (xaes != NULL) {
+        wc_AesXtsFree(xaes);
+    }
+
+    LogStr("wc_AesXtsFree(xaes=%p)\n", xaes);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_AesXts_native_1sector_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jint opmode, jlong sector,
+    jbyteArray input_object, jint offset, jint length,
+    jbyteArray output_object, jint outputOffset)
+{
+#if !defined(NO_AES) && defined(WOLFSSL_AES_XTS)
+    int ret = 0;
+    XtsAes* xaes = (XtsAes*)(uintptr_t)ptr;
+    byte* input  = NULL;
+    byte* output = NULL;
+    byte* in     = NULL;
+    byte* copy   = NULL;
+    word32 inputSz  = 0;
+    word32 outputSz = 0;
+
+    inputSz  = getByteArrayLength(env, input_object);
+    outputSz = getByteArrayLength(env, output_object);
+
+    if (!xaes || !input_object || !output_object) {
+        ret = BAD_FUNC_ARG; /* NULL sanitizers */
+    }
+    else if (offset < 0 || length < AES_BLOCK_SIZE || outputOffset < 0) {
+        ret = BAD_FUNC_ARG; /* XTS needs at least one block */
+    }
+    else if ((word32)(offset + length) > inputSz) {
+        ret = BUFFER_E; /* buffer overflow check */
+    }
+    else if ((word32)(outputOffset + length) > outputSz) {
+        ret = BUFFER_E; /* buffer overflow check */
+    }
+    else {
+        /* a sector can not be split, overlapping ranges of one array are
+         * read from a copy. No other JNI calls until both arrays are
+         * released. */
+        if (byteArrayRangesOverlap(env, input_object, offset, output_object,
+                outputOffset, length)) {
+            copy = getByteArrayRegionCopy(env, input_object, offset, length);
+        }
+        else {
+            input = getByteArrayCritical(env, input_object);
+        }
+        output = getByteArrayCritical(env, output_object);
+        in = (copy != NULL) ? copy : (input != NULL) ? input + offset : NULL;
+
+        if (!in || !output) {
+            ret = BAD_FUNC_ARG;
+        }
+        else if (opmode == AES_ENCRYPTION) {
+            ret = wc_AesXtsEncryptSector(xaes, output + outputOffset,
+                in, length, (word64)sector);
+        }
+        else {
+            ret = wc_AesXtsDecryptSector(xaes, output + outputOffset,
+                in, length, (word64)sector);
+        }
+
+        releaseByteArrayCritical(env, output_object, output, ret);
+        releaseByteArrayCritical(env, input_object, input, JNI_ABORT);
+        freeByteArrayRegionCopy(copy, length);
+
+        LogStr("wc_AesXts%sSector(xaes=%p, sz=%d, sector=%lld) = %d\n",
+            (opmode == AES_ENCRYPTION) ? "Encrypt" : "Decrypt", xaes,
+            length, (long long)sector, ret);
+    }
+
+    if (ret != 0) {
+        throwWolfCryptExceptionFromError(env, ret);
+        ret = 0; /* 0 bytes stored in output */
+    }
+    else {
+        ret = length;
+    }
+
+    return ret;
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
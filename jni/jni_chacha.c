@@ -44,13 +44,10 @@ Java_com_wolfssl_wolfcrypt_Chacha_mallocNativeStruct(
 #ifdef HAVE_CHACHA
     ChaCha* chacha = NULL;
 
-    chacha = (ChaCha*)XMALLOC(sizeof(ChaCha), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    chacha = (ChaCha*)wolfCryptJniStructMalloc(sizeof(ChaCha));
     if (chacha == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate ChaCha object");
     }
-    else {
-        XMEMSET(chacha, 0, sizeof(ChaCha));
-    }
 
     LogStr("new ChaCha object allocated = %p\n", chacha);
 
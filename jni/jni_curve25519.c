@@ -49,14 +49,10 @@ Java_com_wolfssl_wolfcrypt_Curve25519_mallocNativeStruct(
 #ifdef HAVE_CURVE25519
     curve25519_key* key = NULL;
 
-    key = (curve25519_key*)XMALLOC(sizeof(curve25519_key), NULL,
-                DYNAMIC_TYPE_TMP_BUFFER);
+    key = (curve25519_key*)wolfCryptJniStructMalloc(sizeof(curve25519_key));
     if (key == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Curve25519 object");
     }
-    else {
-        XMEMSET(key, 0, sizeof(curve25519_key));
-    }
 
     LogStr("new Curve25519() = %p\n", key);
 
@@ -113,6 +109,25 @@ Java_com_wolfssl_wolfcrypt_Curve25519_wc_1curve25519_1free(
 #endif
 }
 
+/* Free contents of native struct given only its pointer, used to clean up
+ * after a Curve25519 object that was not released explicitly. Does not throw,
+ * runs on the NativeStruct cleanup thread. */
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Curve25519_native_1free_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifdef HAVE_CURVE25519
+    curve25519_key* curve25519 = (curve25519_key*)(uintptr_t)ptr;
+
+    if (curve25519)
+        wc_curve25519_free(curve25519);
+
+    LogStr("curve25519_free(curve25519=%p), cleanup\n", curve25519);
+#else
+    (void)ptr;
+#endif
+}
+
 JNIEXPORT void JNICALL
 Java_com_wolfssl_wolfcrypt_Curve25519_wc_1curve25519_1make_1key(
     JNIEnv* env, jobject this, jobject rng_object, jint size)
@@ -34,6 +34,7 @@
 
 /* #define WOLFCRYPT_JNI_DEBUG_ON */
 #include <wolfcrypt_jni_debug.h>
+#include <wolfcrypt_jni_log.h>
 
 JNIEXPORT jlong JNICALL Java_com_wolfssl_wolfcrypt_Des3_mallocNativeStruct(
     JNIEnv* env, jobject this)
@@ -41,13 +42,10 @@ JNIEXPORT jlong JNICALL Java_com_wolfssl_wolfcrypt_Des3_mallocNativeStruct(
 #ifndef NO_DES3
     Des3* des = NULL;
 
-    des = (Des3*) XMALLOC(sizeof(Des3), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    des = (Des3*)wolfCryptJniStructMalloc(sizeof(Des3));
     if (des == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Des3 object");
     }
-    else {
-        XMEMSET(des, 0, sizeof(Des3));
-    }
 
     LogStr("new Des3() = %p\n", des);
 
@@ -95,59 +93,84 @@ Java_com_wolfssl_wolfcrypt_Des3_native_1set_1key_1internal(
 #endif
 }
 
-JNIEXPORT jint JNICALL
-Java_com_wolfssl_wolfcrypt_Des3_native_1update_1internal__I_3BII_3BI(
-    JNIEnv* env, jobject this, jint opmode,
-    jbyteArray input_object, jint offset, jint length,
-    jbyteArray output_object, jint outputOffset)
+#ifndef NO_DES3
+static int des3_encrypt_chunk(void* ctx, byte* chunk, word32 chunkSz)
 {
-    int ret = 0;
+    return wc_Des3_CbcEncrypt((Des3*)ctx, chunk, chunk, chunkSz);
+}
 
-#ifndef NO_DES3
-    Des3* des    = NULL;
+static int des3_decrypt_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_Des3_CbcDecrypt((Des3*)ctx, chunk, chunk, chunkSz);
+}
+
+static jint des3_update_array(JNIEnv* env, Des3* des, jint opmode,
+    jbyteArray input_object, jint offset, jint length, jbyteArray output_object,
+    jint outputOffset)
+{
+    int ret = 0;
     byte* input  = NULL;
     byte* output = NULL;
+    word32 inputSz  = 0;
+    word32 outputSz = 0;
 
-    des = (Des3*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return 0;
-    }
-
-    input  = getByteArray(env, input_object);
-    output = getByteArray(env, output_object);
+    inputSz  = getByteArrayLength(env, input_object);
+    outputSz = getByteArrayLength(env, output_object);
 
-    if (!des || !input || !output) {
+    if (!des || !input_object || !output_object) {
         ret = BAD_FUNC_ARG; /* NULL sanitizers */
     }
     else if (offset < 0 || length < 0 || outputOffset < 0) {
         ret = BAD_FUNC_ARG; /* signed sanizizers */
     }
-    else if ((word32)(offset + length) >
-             getByteArrayLength(env, input_object)) {
+    else if ((word32)(offset + length) > inputSz) {
         ret = BUFFER_E; /* buffer overflow check */
     }
-    else if ((word32)(outputOffset + length) >
-             getByteArrayLength(env, output_object)) {
+    else if ((word32)(outputOffset + length) > outputSz) {
         ret = BUFFER_E; /* buffer overflow check */
     }
-    else if (opmode == DES_ENCRYPTION) {
-        ret = wc_Des3_CbcEncrypt(des, output+outputOffset,input+offset, length);
-        LogStr("wc_Des3CbcEncrypt(des=%p, out, in, inSz) = %d\n", des, ret);
+    else if (length > WOLFCRYPTJNI_CRITICAL_MAX_SZ ||
+             byteArrayRangesOverlap(env, input_object, offset, output_object,
+                 outputOffset, length)) {
+        /* stream large inputs instead of pinning the arrays, overlapping
+         * ranges of one array can not be processed in place either */
+        ret = processByteArrayChunked(env, input_object, offset,
+            output_object, outputOffset, length,
+            (opmode == DES_ENCRYPTION) ?
+                des3_encrypt_chunk : des3_decrypt_chunk, des);
+        LogStr("des3 chunked update(opmode=%d, inSz=%d) = %d\n", opmode,
+            length, ret);
     }
     else {
-        ret = wc_Des3_CbcDecrypt(des, output+outputOffset,input+offset, length);
-        LogStr("wc_Des3CbcDecrypt(des=%p, out, in, inSz) = %d\n", des, ret);
+        /* no other JNI calls until both arrays are released */
+        input  = getByteArrayCritical(env, input_object);
+        output = getByteArrayCritical(env, output_object);
+
+        if (!input || !output) {
+            ret = BAD_FUNC_ARG;
+        }
+        else if (opmode == DES_ENCRYPTION) {
+            ret = wc_Des3_CbcEncrypt(des, output + outputOffset,
+                input + offset, length);
+            LogStr("wc_Des3CbcEncrypt(des=%p, out, in, inSz) = %d\n", des, ret);
+            LogInfo("wc_Des3CbcEncrypt(len %lld) = %lld", length, ret);
+        }
+        else {
+            ret = wc_Des3_CbcDecrypt(des, output + outputOffset,
+                input + offset, length);
+            LogStr("wc_Des3CbcDecrypt(des=%p, out, in, inSz) = %d\n", des, ret);
+            LogInfo("wc_Des3CbcDecrypt(len %lld) = %lld", length, ret);
+        }
+
+        LogStr("input[%u]: [%p]\n", (word32)length, input + offset);
+        LogHex((byte*) input, offset, length);
+        LogStr("output[%u]: [%p]\n", (word32)length, output + outputOffset);
+        LogHex((byte*) output, outputOffset, length);
+
+        releaseByteArrayCritical(env, output_object, output, ret);
+        releaseByteArrayCritical(env, input_object, input, JNI_ABORT);
     }
 
-    LogStr("input[%u]: [%p]\n", (word32)length, input + offset);
-    LogHex((byte*) input, offset, length);
-    LogStr("output[%u]: [%p]\n", (word32)length, output + outputOffset);
-    LogHex((byte*) output, outputOffset, length);
-
-    releaseByteArray(env, input_object, input, JNI_ABORT);
-    releaseByteArray(env, output_object, output, ret);
-
     if (ret != 0) {
         throwWolfCryptExceptionFromError(env, ret);
         ret = 0; /* 0 bytes stored in output */
@@ -155,39 +178,64 @@ Java_com_wolfssl_wolfcrypt_Des3_native_1update_1internal__I_3BII_3BI(
     else {
         ret = length;
     }
-#else
-    throwNotCompiledInException(env);
-#endif
 
     return ret;
 }
+#endif
 
 JNIEXPORT jint JNICALL
-Java_com_wolfssl_wolfcrypt_Des3_native_1update_1internal__ILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I(
+Java_com_wolfssl_wolfcrypt_Des3_native_1update_1internal__I_3BII_3BI(
     JNIEnv* env, jobject this, jint opmode,
-    jobject input_object, jint offset, jint length,
-    jobject output_object, jint outputOffset)
+    jbyteArray input_object, jint offset, jint length,
+    jbyteArray output_object, jint outputOffset)
 {
-    int ret = 0;
-
 #ifndef NO_DES3
-    Des3* des    = NULL;
-    byte* input  = NULL;
-    byte* output = NULL;
-
-    des = (Des3*) getNativeStruct(env, this);
+    Des3* des = (Des3*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return 0;
     }
 
+    return des3_update_array(env, des, opmode, input_object, offset, length,
+        output_object, outputOffset);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Des3_native_1update_1ptr__JI_3BII_3BI(
+    JNIEnv* env, jclass jcl, jlong ptr, jint opmode, jbyteArray input_object,
+    jint offset, jint length, jbyteArray output_object, jint outputOffset)
+{
+#ifndef NO_DES3
+    return des3_update_array(env, (Des3*)(uintptr_t)ptr, opmode, input_object,
+        offset, length, output_object, outputOffset);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+#ifndef NO_DES3
+static jint des3_update_buffer(JNIEnv* env, Des3* des, jint opmode,
+    jobject input_object, jint offset, jint length, jobject output_object,
+    jint outputOffset)
+{
+    int ret = 0;
+    byte* input  = NULL;
+    byte* output = NULL;
+
     input  = getDirectBufferAddress(env, input_object);
     output = getDirectBufferAddress(env, output_object);
 
     if (!des || !input || !output) {
         ret = BAD_FUNC_ARG; /* NULL sanitizers */
     }
-    else if (offset < 0 || length < 0) {
+    else if (offset < 0 || length < 0 || outputOffset < 0) {
         ret = BAD_FUNC_ARG; /* signed sanizizers */
     }
     else if ((word32)(offset + length) >
@@ -199,12 +247,16 @@ Java_com_wolfssl_wolfcrypt_Des3_native_1update_1internal__ILjava_nio_ByteBuffer_
         ret = BUFFER_E; /* buffer overflow check */
     }
     else if (opmode == DES_ENCRYPTION) {
-        ret = wc_Des3_CbcEncrypt(des, output, input + offset, length);
+        ret = wc_Des3_CbcEncrypt(des, output + outputOffset,
+            input + offset, length);
         LogStr("wc_Des3CbcEncrypt(des=%p, out, in, inSz) = %d\n", des, ret);
+        LogInfo("wc_Des3CbcEncrypt(len %lld) = %lld", length, ret);
     }
     else {
-        ret = wc_Des3_CbcDecrypt(des, output, input + offset, length);
+        ret = wc_Des3_CbcDecrypt(des, output + outputOffset,
+            input + offset, length);
         LogStr("wc_Des3CbcDecrypt(des=%p, out, in, inSz) = %d\n", des, ret);
+        LogInfo("wc_Des3CbcDecrypt(len %lld) = %lld", length, ret);
     }
 
     if (ret != 0) {
@@ -217,11 +269,46 @@ Java_com_wolfssl_wolfcrypt_Des3_native_1update_1internal__ILjava_nio_ByteBuffer_
 
     LogStr("input[%u]: [%p]\n", (word32)length, input + offset);
     LogHex((byte*) input, offset, length);
-    LogStr("output[%u]: [%p]\n", (word32)length, output);
-    LogHex((byte*) output, 0, length);
+    LogStr("output[%u]: [%p]\n", (word32)length, output + outputOffset);
+    LogHex((byte*) output, outputOffset, length);
+
+    return ret;
+}
+#endif
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Des3_native_1update_1internal__ILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jobject this, jint opmode,
+    jobject input_object, jint offset, jint length,
+    jobject output_object, jint outputOffset)
+{
+#ifndef NO_DES3
+    Des3* des = (Des3*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return 0;
+    }
+
+    return des3_update_buffer(env, des, opmode, input_object, offset, length,
+        output_object, outputOffset);
 #else
     throwNotCompiledInException(env);
+
+    return 0;
 #endif
+}
 
-    return ret;
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Des3_native_1update_1ptr__JILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jlong ptr, jint opmode, jobject input_object,
+    jint offset, jint length, jobject output_object, jint outputOffset)
+{
+#ifndef NO_DES3
+    return des3_update_buffer(env, (Des3*)(uintptr_t)ptr, opmode, input_object,
+        offset, length, output_object, outputOffset);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
 }
@@ -45,14 +45,11 @@ JNIEXPORT jlong JNICALL Java_com_wolfssl_wolfcrypt_Dh_mallocNativeStruct_1intern
 #ifndef NO_DH
     DhKey* dh = NULL;
 
-    dh = (DhKey*)XMALLOC(sizeof(DhKey), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    dh = (DhKey*)wolfCryptJniStructMalloc(sizeof(DhKey));
 
     if (dh == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Dh object");
     }
-    else {
-        XMEMSET(dh, 0, sizeof(DhKey));
-    }
 
     LogStr("new Dh() = %p\n", dh);
 
@@ -110,6 +107,26 @@ Java_com_wolfssl_wolfcrypt_Dh_wc_1FreeDhKey(
 #endif
 }
 
+/* Free contents of native struct given only its pointer, used to clean up
+ * after a Dh object that was not released explicitly. Does not throw,
+ * runs on the NativeStruct cleanup thread. */
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Dh_native_1free_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifndef NO_DH
+    DhKey* key = (DhKey*)(uintptr_t)ptr;
+
+    if (key != NULL) {
+        wc_FreeDhKey(key);
+    }
+
+    LogStr("wc_FreeDhKey(key=%p), cleanup\n", key);
+#else
+    (void)ptr;
+#endif
+}
+
 JNIEXPORT void JNICALL
 Java_com_wolfssl_wolfcrypt_Dh_wc_1DhSetKey(
     JNIEnv* env, jobject this, jbyteArray p_object, jbyteArray g_object)
@@ -35,6 +35,7 @@
 
 /* #define WOLFCRYPT_JNI_DEBUG_ON */
 #include <wolfcrypt_jni_debug.h>
+#include <wolfcrypt_jni_log.h>
 
 #define MAX_ECC_PRIVATE_DER_SZ 128
 
@@ -49,13 +50,10 @@ Java_com_wolfssl_wolfcrypt_Ecc_mallocNativeStruct(
 #ifdef HAVE_ECC
     ecc_key* ecc = NULL;
 
-    ecc = (ecc_key*)XMALLOC(sizeof(ecc_key), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    ecc = (ecc_key*)wolfCryptJniStructMalloc(sizeof(ecc_key));
     if (ecc == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Ecc object");
     }
-    else {
-        XMEMSET(ecc, 0, sizeof(ecc_key));
-    }
 
     LogStr("new Ecc() = %p\n", ecc);
 
@@ -111,6 +109,25 @@ Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1free(
 #endif
 }
 
+/* Free contents of native struct given only its pointer, used to clean up
+ * after a Ecc object that was not released explicitly. Does not throw,
+ * runs on the NativeStruct cleanup thread. */
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Ecc_native_1free_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifdef HAVE_ECC
+    ecc_key* ecc = (ecc_key*)(uintptr_t)ptr;
+
+    /* Checks ecc for NULL internally */
+    wc_ecc_free(ecc);
+
+    LogStr("ecc_free(ecc=%p), cleanup\n", ecc);
+#else
+    (void)ptr;
+#endif
+}
+
 JNIEXPORT void JNICALL
 Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1make_1key(
     JNIEnv* env, jobject this, jobject rng_object, jint size)
@@ -795,6 +812,7 @@ Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1shared_1secret(
 
     LogStr("wc_ecc_shared_secret(priv, pub, output=%p, outputSz) = %d\n",
         output, ret);
+    LogInfo("wc_ecc_shared_secret() = %lld", ret, 0);
     LogStr("output[%u]: [%p]\n", (word32)outputSz, output);
     LogHex((byte*) output, 0, outputSz);
 
@@ -809,33 +827,17 @@ Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1shared_1secret(
     return result;
 }
 
-JNIEXPORT jbyteArray JNICALL
-Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1sign_1hash(
-    JNIEnv* env, jobject this, jbyteArray hash_object, jobject rng_object)
+#ifdef HAVE_ECC_SIGN
+static jbyteArray ecc_key_sign_hash(JNIEnv* env, ecc_key* ecc, RNG* rng,
+    jbyteArray hash_object)
 {
     jbyteArray result = NULL;
-
-#ifdef HAVE_ECC_SIGN
     int ret = 0;
-    ecc_key* ecc = NULL;
-    RNG*  rng    = NULL;
     byte* hash   = NULL;
     byte* signature = NULL;
     word32 hashSz = 0, signatureSz = 0;
     word32 signatureBufSz = 0;
 
-    ecc = (ecc_key*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return NULL;
-    }
-
-    rng = (RNG*) getNativeStruct(env, rng_object);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return NULL;
-    }
-
     hash   = getByteArray(env, hash_object);
     hashSz = getByteArrayLength(env, hash_object);
 
@@ -875,6 +877,7 @@ Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1sign_1hash(
 
     LogStr("wc_ecc_sign_hash(input, inSz, output, &outSz, rng, ecc) = %d\n",
         ret);
+    LogInfo("wc_ecc_sign_hash() = %lld", ret, 0);
     LogStr("signature[%u]: [%p]\n", (word32)signatureSz, signature);
     LogHex((byte*) signature, 0, signatureSz);
 
@@ -884,32 +887,63 @@ Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1sign_1hash(
     }
 
     releaseByteArray(env, hash_object, hash, JNI_ABORT);
+
+    return result;
+}
+#endif
+
+JNIEXPORT jbyteArray JNICALL
+Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1sign_1hash(
+    JNIEnv* env, jobject this, jbyteArray hash_object, jobject rng_object)
+{
+#ifdef HAVE_ECC_SIGN
+    ecc_key* ecc = NULL;
+    RNG* rng = NULL;
+
+    ecc = (ecc_key*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return NULL;
+    }
+
+    rng = (RNG*) getNativeStruct(env, rng_object);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return NULL;
+    }
+
+    return ecc_key_sign_hash(env, ecc, rng, hash_object);
 #else
     throwNotCompiledInException(env);
+
+    return NULL;
 #endif
+}
 
-    return result;
+JNIEXPORT jbyteArray JNICALL
+Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1sign_1hash_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jlong rngPtr, jbyteArray hash_object)
+{
+#ifdef HAVE_ECC_SIGN
+    return ecc_key_sign_hash(env, (ecc_key*)(uintptr_t)ptr,
+        (RNG*)(uintptr_t)rngPtr, hash_object);
+#else
+    throwNotCompiledInException(env);
+
+    return NULL;
+#endif
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1verify_1hash(
-    JNIEnv* env, jobject this, jbyteArray hash_object,
-    jbyteArray signature_object)
+#ifdef HAVE_ECC_VERIFY
+static jboolean ecc_key_verify_hash(JNIEnv* env, ecc_key* ecc,
+    jbyteArray hash_object, jbyteArray signature_object)
 {
     int ret = 0;
-#ifdef HAVE_ECC_VERIFY
     int status = 0;
-    ecc_key* ecc    = NULL;
     byte* hash      = NULL;
     byte* signature = NULL;
     word32 hashSz = 0, signatureSz = 0;
 
-    ecc = (ecc_key*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return 0;
-    }
-
     hash   = getByteArray(env, hash_object);
     hashSz = getByteArrayLength(env, hash_object);
 
@@ -936,11 +970,44 @@ Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1verify_1hash(
 
     releaseByteArray(env, hash_object, hash, JNI_ABORT);
     releaseByteArray(env, signature_object, signature, JNI_ABORT);
+
+    return ret;
+}
+#endif
+
+JNIEXPORT jboolean JNICALL
+Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1verify_1hash(
+    JNIEnv* env, jobject this, jbyteArray hash_object,
+    jbyteArray signature_object)
+{
+#ifdef HAVE_ECC_VERIFY
+    ecc_key* ecc = (ecc_key*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return JNI_FALSE;
+    }
+
+    return ecc_key_verify_hash(env, ecc, hash_object, signature_object);
 #else
     throwNotCompiledInException(env);
+
+    return JNI_FALSE;
 #endif
+}
 
-    return ret;
+JNIEXPORT jboolean JNICALL
+Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1verify_1hash_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray hash_object,
+    jbyteArray signature_object)
+{
+#ifdef HAVE_ECC_VERIFY
+    return ecc_key_verify_hash(env, (ecc_key*)(uintptr_t)ptr, hash_object,
+        signature_object);
+#else
+    throwNotCompiledInException(env);
+
+    return JNI_FALSE;
+#endif
 }
 
 JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1get_1curve_1size_1from_1name
@@ -983,6 +1050,39 @@ JNIEXPORT jstring JNICALL Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1get_1curve_1na
     return name;
 }
 
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1size_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifdef HAVE_ECC
+    /* returns 0 if key has no curve set */
+    return wc_ecc_size((ecc_key*)(uintptr_t)ptr);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1get_1curve_1id_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifdef HAVE_ECC
+    ecc_key* ecc = (ecc_key*)(uintptr_t)ptr;
+
+    if (ecc == NULL) {
+        return ECC_CURVE_INVALID;
+    }
+
+    return wc_ecc_get_curve_id(ecc->idx);
+#else
+    throwNotCompiledInException(env);
+
+    return 0;
+#endif
+}
+
 JNIEXPORT jbyteArray JNICALL Java_com_wolfssl_wolfcrypt_Ecc_wc_1ecc_1private_1key_1to_1pkcs8
   (JNIEnv* env, jobject this)
 {
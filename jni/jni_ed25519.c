@@ -49,13 +49,10 @@ Java_com_wolfssl_wolfcrypt_Ed25519_mallocNativeStruct(
 #ifdef HAVE_ED25519
     ed25519_key* key = NULL;
 
-    key = (ed25519_key*)XMALLOC(sizeof(ed25519_key), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    key = (ed25519_key*)wolfCryptJniStructMalloc(sizeof(ed25519_key));
     if (key == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Ed25519 object");
     }
-    else {
-        XMEMSET(key, 0, sizeof(ed25519_key));
-    }
 
     LogStr("new Ed25519() = %p\n", key);
 
@@ -112,6 +109,25 @@ Java_com_wolfssl_wolfcrypt_Ed25519_wc_1ed25519_1free(
 #endif
 }
 
+/* Free contents of native struct given only its pointer, used to clean up
+ * after a Ed25519 object that was not released explicitly. Does not throw,
+ * runs on the NativeStruct cleanup thread. */
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Ed25519_native_1free_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifdef HAVE_ED25519
+    ed25519_key* ed25519 = (ed25519_key*)(uintptr_t)ptr;
+
+    if (ed25519)
+        wc_ed25519_free(ed25519);
+
+    LogStr("ed25519_free(ed25519=%p), cleanup\n", ed25519);
+#else
+    (void)ptr;
+#endif
+}
+
 JNIEXPORT void JNICALL
 Java_com_wolfssl_wolfcrypt_Ed25519_wc_1ed25519_1make_1key(
     JNIEnv* env, jobject this, jobject rng_object, jint size)
@@ -26,7 +26,9 @@
 #endif
 
 #include <com_wolfssl_wolfcrypt_WolfCryptError.h>
+#include <wolfcrypt_jni_NativeStruct.h>
 #include <wolfcrypt_jni_error.h>
+#include <wolfcrypt_jni_log.h>
 
 JNIEXPORT jstring JNICALL Java_com_wolfssl_wolfcrypt_WolfCryptError_wc_1GetErrorString
   (JNIEnv* env, jclass obj, jint error)
@@ -34,12 +36,32 @@ JNIEXPORT jstring JNICALL Java_com_wolfssl_wolfcrypt_WolfCryptError_wc_1GetError
     return (*env)->NewStringUTF(env, wc_GetErrorString(error));
 }
 
+jclass getWolfCryptExceptionClass(JNIEnv* env)
+{
+    if (g_cachedWolfCryptExceptionClass != NULL) {
+        return g_cachedWolfCryptExceptionClass;
+    }
+
+    return (*env)->FindClass(env, "com/wolfssl/wolfcrypt/WolfCryptException");
+}
+
+jclass getOutOfMemoryErrorClass(JNIEnv* env)
+{
+    if (g_cachedOutOfMemoryErrorClass != NULL) {
+        return g_cachedOutOfMemoryErrorClass;
+    }
+
+    return (*env)->FindClass(env, "java/lang/OutOfMemoryError");
+}
+
 void throwWolfCryptExceptionFromError(JNIEnv* env, int code)
 {
     jclass class = NULL;
     jobject exception = NULL;
     jmethodID constructor = NULL;
 
+    LogError("native error %lld: throwing WolfCryptException", code, 0);
+
     if (code == MEMORY_E) {
         throwOutOfMemoryException(
             env, "Failed to allocate memory in the native wolfcrypt library");
@@ -47,17 +69,20 @@ void throwWolfCryptExceptionFromError(JNIEnv* env, int code)
         return;
     }
 
-    class = (*env)->FindClass(env, "com/wolfssl/wolfcrypt/WolfCryptException");
+    class = getWolfCryptExceptionClass(env);
     /* FindClass may throw exception */
     if ((*env)->ExceptionOccurred(env)) {
         return;
     }
 
     if (class) {
-        constructor = (*env)->GetMethodID(env, class, "<init>", "(I)V");
-        /* GetMethodID may throw exception */
-        if ((*env)->ExceptionOccurred(env)) {
-            return;
+        constructor = g_cachedWolfCryptExceptionInit;
+        if (constructor == NULL) {
+            constructor = (*env)->GetMethodID(env, class, "<init>", "(I)V");
+            /* GetMethodID may throw exception */
+            if ((*env)->ExceptionOccurred(env)) {
+                return;
+            }
         }
 
         if (constructor) {
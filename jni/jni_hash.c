@@ -0,0 +1,476 @@
+/* jni_hash.c
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <stdint.h>
+
+#ifdef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/wolfcrypt/settings.h>
+#elif !defined(__ANDROID__)
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include <wolfssl/wolfcrypt/hash.h>
+
+#include <com_wolfssl_wolfcrypt_MessageDigest.h>
+#include <com_wolfssl_wolfcrypt_Md5.h>
+#include <com_wolfssl_wolfcrypt_Sha.h>
+#include <com_wolfssl_wolfcrypt_Sha256.h>
+#include <com_wolfssl_wolfcrypt_Sha384.h>
+#include <com_wolfssl_wolfcrypt_Sha512.h>
+#include <wolfcrypt_jni_hash.h>
+#include <wolfcrypt_jni_NativeStruct.h>
+#include <wolfcrypt_jni_error.h>
+
+/* #define WOLFCRYPT_JNI_DEBUG_ON */
+#include <wolfcrypt_jni_debug.h>
+#include <wolfcrypt_jni_log.h>
+
+typedef struct HashChunkCtx {
+    wc_HashAlg* alg;
+    enum wc_HashType type;
+} HashChunkCtx;
+
+static int hash_update_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    HashChunkCtx* c = (HashChunkCtx*)ctx;
+
+    return wc_HashUpdate(c->alg, c->type, chunk, chunkSz);
+}
+
+int wolfCryptJniHashArray(JNIEnv* env, enum wc_HashType type,
+    jbyteArray data, jint offset, jint len, jbyteArray hash, jint hashOffset)
+{
+    int ret = 0;
+    int digestSz = 0;
+    byte* in = NULL;
+    word32 dataSz = 0;
+    word32 hashSz = 0;
+    wc_HashAlg alg;
+    HashChunkCtx ctx;
+    byte digest[WC_MAX_DIGEST_SIZE];
+
+    digestSz = wc_HashGetDigestSize(type);
+    if (digestSz <= 0)
+        return (digestSz < 0) ? digestSz : BAD_FUNC_ARG;
+
+    if (data == NULL || hash == NULL || offset < 0 || len < 0 ||
+        hashOffset < 0)
+        return BAD_FUNC_ARG;
+
+    dataSz = getByteArrayLength(env, data);
+    hashSz = getByteArrayLength(env, hash);
+
+    if ((word32)offset + (word32)len > dataSz ||
+        (word32)hashOffset + (word32)digestSz > hashSz)
+        return BUFFER_E;
+
+    ret = wc_HashInit(&alg, type);
+    if (ret != 0)
+        return ret;
+
+    if (len > WOLFCRYPTJNI_CRITICAL_MAX_SZ) {
+        /* stream large inputs instead of pinning the array */
+        ctx.alg = &alg;
+        ctx.type = type;
+        ret = processByteArrayChunked(env, data, offset, NULL, 0, len,
+            hash_update_chunk, &ctx);
+    }
+    else if (len > 0) {
+        /* no other JNI calls until the array is released */
+        in = getByteArrayCritical(env, data);
+        ret = (!in)
+            ? BAD_FUNC_ARG
+            : wc_HashUpdate(&alg, type, in + offset, len);
+        releaseByteArrayCritical(env, data, in, JNI_ABORT);
+    }
+
+    if (ret == 0)
+        ret = wc_HashFinal(&alg, type, digest);
+
+    wc_HashFree(&alg, type);
+
+    if (ret == 0) {
+        (*env)->SetByteArrayRegion(env, hash, hashOffset, digestSz,
+            (const jbyte*)digest);
+        if ((*env)->ExceptionCheck(env)) {
+            (*env)->ExceptionClear(env);
+            ret = BUFFER_E;
+        }
+    }
+
+    LogStr("wc_Hash(type=%d, data, len=%d) = %d\n", type, len, ret);
+    LogInfo("wc_Hash(type %lld) one-shot = %lld", type, ret);
+
+    return ret;
+}
+
+int wolfCryptJniHashBuffer(JNIEnv* env, enum wc_HashType type,
+    jobject data, jint offset, jint len, jobject hash, jint hashOffset)
+{
+    int ret = 0;
+    int digestSz = 0;
+    byte* in = NULL;
+    byte* out = NULL;
+    wc_HashAlg alg;
+
+    digestSz = wc_HashGetDigestSize(type);
+    if (digestSz <= 0)
+        return (digestSz < 0) ? digestSz : BAD_FUNC_ARG;
+
+    if (data == NULL || hash == NULL || offset < 0 || len < 0 ||
+        hashOffset < 0)
+        return BAD_FUNC_ARG;
+
+    in = getDirectBufferAddress(env, data);
+    out = getDirectBufferAddress(env, hash);
+    if (in == NULL || out == NULL)
+        return BAD_FUNC_ARG;
+
+    if ((word32)offset + (word32)len > getDirectBufferLimit(env, data) ||
+        (word32)hashOffset + (word32)digestSz >
+            getDirectBufferLimit(env, hash))
+        return BUFFER_E;
+
+    /* direct buffers are read and written in place, no copies */
+    ret = wc_HashInit(&alg, type);
+    if (ret == 0) {
+        ret = wc_HashUpdate(&alg, type, in + offset, len);
+        if (ret == 0)
+            ret = wc_HashFinal(&alg, type, out + hashOffset);
+
+        wc_HashFree(&alg, type);
+    }
+
+    LogStr("wc_Hash(type=%d, data, len=%d) = %d\n", type, len, ret);
+    LogInfo("wc_Hash(type %lld) one-shot = %lld", type, ret);
+
+    return ret;
+}
+
+/* number of offset/length pairs copied from Java per iteration */
+#ifndef WOLFCRYPTJNI_HASH_BATCH_GROUP
+    #define WOLFCRYPTJNI_HASH_BATCH_GROUP 256
+#endif
+
+static int hash_batch_get_group(JNIEnv* env, jintArray offsets,
+    jintArray lengths, jint start, jint n, jint* offs, jint* lens)
+{
+    (*env)->GetIntArrayRegion(env, offsets, start, n, offs);
+    if (!(*env)->ExceptionCheck(env))
+        (*env)->GetIntArrayRegion(env, lengths, start, n, lens);
+
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionClear(env);
+        return BUFFER_E;
+    }
+
+    return 0;
+}
+
+static int hash_batch_check_args(JNIEnv* env, enum wc_HashType type,
+    jintArray offsets, jintArray lengths, jint count, jint hashOffset,
+    word32 hashSz, int* digestSz)
+{
+    *digestSz = wc_HashGetDigestSize(type);
+    if (*digestSz <= 0)
+        return (*digestSz < 0) ? *digestSz : BAD_FUNC_ARG;
+
+    if (offsets == NULL || lengths == NULL || count < 0 || hashOffset < 0)
+        return BAD_FUNC_ARG;
+
+    if ((word32)(*env)->GetArrayLength(env, offsets) < (word32)count ||
+        (word32)(*env)->GetArrayLength(env, lengths) < (word32)count)
+        return BAD_FUNC_ARG;
+
+    if ((word64)hashOffset + (word64)count * (word64)*digestSz >
+        (word64)hashSz)
+        return BUFFER_E;
+
+    return 0;
+}
+
+static int hash_one(wc_HashAlg* alg, enum wc_HashType type, const byte* in,
+    word32 inSz, byte* out)
+{
+    int ret = wc_HashInit(alg, type);
+
+    if (ret == 0) {
+        ret = wc_HashUpdate(alg, type, in, inSz);
+        if (ret == 0)
+            ret = wc_HashFinal(alg, type, out);
+
+        wc_HashFree(alg, type);
+    }
+
+    return ret;
+}
+
+int wolfCryptJniHashBatchArray(JNIEnv* env, enum wc_HashType type,
+    jbyteArray data, jintArray offsets, jintArray lengths, jint count,
+    jbyteArray hash, jint hashOffset)
+{
+    int ret = 0;
+    int digestSz = 0;
+    jint start, n, i, j;
+    word32 dataSz = 0;
+    word32 pinned = 0;
+    byte* in = NULL;
+    byte* out = NULL;
+    wc_HashAlg alg;
+    jint offs[WOLFCRYPTJNI_HASH_BATCH_GROUP];
+    jint lens[WOLFCRYPTJNI_HASH_BATCH_GROUP];
+
+    if (data == NULL || hash == NULL)
+        return BAD_FUNC_ARG;
+
+    ret = hash_batch_check_args(env, type, offsets, lengths, count,
+        hashOffset, getByteArrayLength(env, hash), &digestSz);
+    if (ret != 0)
+        return ret;
+
+    dataSz = getByteArrayLength(env, data);
+
+    for (start = 0; ret == 0 && start < count; start += n) {
+        n = count - start;
+        if (n > WOLFCRYPTJNI_HASH_BATCH_GROUP)
+            n = WOLFCRYPTJNI_HASH_BATCH_GROUP;
+
+        ret = hash_batch_get_group(env, offsets, lengths, start, n, offs,
+            lens);
+
+        for (i = 0; ret == 0 && i < n; i++) {
+            if (offs[i] < 0 || lens[i] < 0 ||
+                (word32)offs[i] + (word32)lens[i] > dataSz)
+                ret = BAD_FUNC_ARG;
+        }
+
+        for (i = 0; ret == 0 && i < n; i = j) {
+            if (lens[i] > WOLFCRYPTJNI_CRITICAL_MAX_SZ) {
+                /* large message, streamed without pinning the array */
+                ret = wolfCryptJniHashArray(env, type, data, offs[i],
+                    lens[i], hash, hashOffset + (start + i) * digestSz);
+                j = i + 1;
+                continue;
+            }
+
+            /* hash a run of small messages in one critical region, bounded
+             * by WOLFCRYPTJNI_CRITICAL_MAX_SZ bytes of input. The first
+             * message always fits, it was checked above */
+            in = getByteArrayCritical(env, data);
+            out = getByteArrayCritical(env, hash);
+            if (in == NULL || out == NULL)
+                ret = BAD_FUNC_ARG;
+
+            for (j = i, pinned = 0; ret == 0 && j < n &&
+                 (j == i || pinned + (word32)lens[j] <=
+                     WOLFCRYPTJNI_CRITICAL_MAX_SZ); j++) {
+                ret = hash_one(&alg, type, in + offs[j], lens[j],
+                    out + hashOffset + (start + j) * digestSz);
+                pinned += lens[j];
+            }
+
+            releaseByteArrayCritical(env, hash, out, 0);
+            releaseByteArrayCritical(env, data, in, JNI_ABORT);
+        }
+    }
+
+    LogStr("wc_Hash batch(type=%d, count=%d) = %d\n", type, count, ret);
+    LogInfo("wc_Hash(type %lld) batch of %lld", type, count);
+
+    return ret;
+}
+
+int wolfCryptJniHashBatchBuffers(JNIEnv* env, enum wc_HashType type,
+    jobjectArray data, jintArray offsets, jintArray lengths, jint count,
+    jobject hash, jint hashOffset)
+{
+    int ret = 0;
+    int digestSz = 0;
+    jint start, n, i;
+    jobject buf = NULL;
+    byte* in = NULL;
+    byte* out = NULL;
+    wc_HashAlg alg;
+    jint offs[WOLFCRYPTJNI_HASH_BATCH_GROUP];
+    jint lens[WOLFCRYPTJNI_HASH_BATCH_GROUP];
+
+    if (data == NULL || hash == NULL)
+        return BAD_FUNC_ARG;
+
+    out = getDirectBufferAddress(env, hash);
+    if (out == NULL)
+        return BAD_FUNC_ARG;
+
+    ret = hash_batch_check_args(env, type, offsets, lengths, count,
+        hashOffset, getDirectBufferLimit(env, hash), &digestSz);
+    if (ret != 0)
+        return ret;
+
+    if ((word32)(*env)->GetArrayLength(env, data) < (word32)count)
+        return BAD_FUNC_ARG;
+
+    for (start = 0; ret == 0 && start < count; start += n) {
+        n = count - start;
+        if (n > WOLFCRYPTJNI_HASH_BATCH_GROUP)
+            n = WOLFCRYPTJNI_HASH_BATCH_GROUP;
+
+        ret = hash_batch_get_group(env, offsets, lengths, start, n, offs,
+            lens);
+
+        for (i = 0; ret == 0 && i < n; i++) {
+            buf = (*env)->GetObjectArrayElement(env, data, start + i);
+            in = (buf == NULL) ? NULL : getDirectBufferAddress(env, buf);
+
+            if (in == NULL || offs[i] < 0 || lens[i] < 0) {
+                ret = BAD_FUNC_ARG;
+            }
+            else if ((word32)offs[i] + (word32)lens[i] >
+                     getDirectBufferLimit(env, buf)) {
+                ret = BUFFER_E;
+            }
+            else {
+                /* direct buffers are read in place, no copies */
+                ret = hash_one(&alg, type, in + offs[i], lens[i],
+                    out + hashOffset + (start + i) * digestSz);
+            }
+
+            if (buf != NULL)
+                (*env)->DeleteLocalRef(env, buf);
+        }
+    }
+
+    LogStr("wc_Hash batch(type=%d, count=%d) = %d\n", type, count, ret);
+    LogInfo("wc_Hash(type %lld) batch of %lld", type, count);
+
+    return ret;
+}
+
+/* map TYPE of a Java MessageDigest subclass to wc_HashType, returns
+ * WC_HASH_TYPE_NONE if the algorithm is not compiled in */
+static enum wc_HashType hashTypeFromJava(jint type)
+{
+    switch (type) {
+#ifndef NO_MD5
+        case com_wolfssl_wolfcrypt_Md5_TYPE:
+            return WC_HASH_TYPE_MD5;
+#endif
+#ifndef NO_SHA
+        case com_wolfssl_wolfcrypt_Sha_TYPE:
+            return WC_HASH_TYPE_SHA;
+#endif
+#ifndef NO_SHA256
+        case com_wolfssl_wolfcrypt_Sha256_TYPE:
+            return WC_HASH_TYPE_SHA256;
+#endif
+#ifdef WOLFSSL_SHA384
+        case com_wolfssl_wolfcrypt_Sha384_TYPE:
+            return WC_HASH_TYPE_SHA384;
+#endif
+#ifdef WOLFSSL_SHA512
+        case com_wolfssl_wolfcrypt_Sha512_TYPE:
+            return WC_HASH_TYPE_SHA512;
+#endif
+        default:
+            return WC_HASH_TYPE_NONE;
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_MessageDigest_native_1hash__ILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jint type, jobject data_buffer, jint position,
+    jint len, jobject hash_buffer, jint hashPosition)
+{
+    int ret = 0;
+    enum wc_HashType hashType = hashTypeFromJava(type);
+
+    if (hashType == WC_HASH_TYPE_NONE) {
+        throwNotCompiledInException(env);
+        return;
+    }
+
+    ret = wolfCryptJniHashBuffer(env, hashType, data_buffer, position, len,
+        hash_buffer, hashPosition);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_MessageDigest_native_1hash__I_3BII_3BI(
+    JNIEnv* env, jclass jcl, jint type, jbyteArray data_buffer, jint offset,
+    jint len, jbyteArray hash_buffer, jint hashOffset)
+{
+    int ret = 0;
+    enum wc_HashType hashType = hashTypeFromJava(type);
+
+    if (hashType == WC_HASH_TYPE_NONE) {
+        throwNotCompiledInException(env);
+        return;
+    }
+
+    ret = wolfCryptJniHashArray(env, hashType, data_buffer, offset, len,
+        hash_buffer, hashOffset);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_MessageDigest_native_1hash_1batch__I_3B_3I_3II_3BI(
+    JNIEnv* env, jclass jcl, jint type, jbyteArray data_buffer,
+    jintArray offsets, jintArray lengths, jint count, jbyteArray hash_buffer,
+    jint hashOffset)
+{
+    int ret = 0;
+    enum wc_HashType hashType = hashTypeFromJava(type);
+
+    if (hashType == WC_HASH_TYPE_NONE) {
+        throwNotCompiledInException(env);
+        return;
+    }
+
+    ret = wolfCryptJniHashBatchArray(env, hashType, data_buffer, offsets,
+        lengths, count, hash_buffer, hashOffset);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_MessageDigest_native_1hash_1batch__I_3Ljava_nio_ByteBuffer_2_3I_3IILjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jint type, jobjectArray data_buffers,
+    jintArray offsets, jintArray lengths, jint count, jobject hash_buffer,
+    jint hashOffset)
+{
+    int ret = 0;
+    enum wc_HashType hashType = hashTypeFromJava(type);
+
+    if (hashType == WC_HASH_TYPE_NONE) {
+        throwNotCompiledInException(env);
+        return;
+    }
+
+    ret = wolfCryptJniHashBatchBuffers(env, hashType, data_buffers, offsets,
+        lengths, count, hash_buffer, hashOffset);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
@@ -34,6 +34,7 @@
 
 /* #define WOLFCRYPT_JNI_DEBUG_ON */
 #include <wolfcrypt_jni_debug.h>
+#include <wolfcrypt_jni_log.h>
 
 #if (HAVE_FIPS_VERSION >= 2)
     #define MAX_DIGEST_SIZE WC_MAX_DIGEST_SIZE
@@ -109,13 +110,10 @@ Java_com_wolfssl_wolfcrypt_Hmac_mallocNativeStruct(
 #ifndef NO_HMAC
     Hmac* hmac = NULL;
 
-    hmac = (Hmac*) XMALLOC(sizeof(Hmac), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    hmac = (Hmac*)wolfCryptJniStructMalloc(sizeof(Hmac));
     if (hmac == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Hmac object");
     }
-    else {
-        XMEMSET(hmac, 0, sizeof(Hmac));
-    }
 
     LogStr("new Hmac() = %p\n", hmac);
 
@@ -162,17 +160,10 @@ Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacSetKey(
 #endif
 }
 
-JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate__B(
-    JNIEnv* env, jobject this, jbyte data)
-{
 #ifndef NO_HMAC
+static void hmac_update_byte(JNIEnv* env, Hmac* hmac, jbyte data)
+{
     int ret = 0;
-    Hmac* hmac = (Hmac*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
 
     ret = (!hmac)
         ? BAD_FUNC_ARG
@@ -182,61 +173,120 @@ Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate__B(
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_HmacUpdate(hmac=%p, data, 1) = %d\n", hmac, ret);
+    LogInfo("wc_HmacUpdate() = %lld", ret, 0);
     LogStr("data: %02x\n", data);
+}
+#endif
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate__B(
+    JNIEnv* env, jobject this, jbyte data)
+{
+#ifndef NO_HMAC
+    Hmac* hmac = (Hmac*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    hmac_update_byte(env, hmac, data);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
 JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate___3BII(
-    JNIEnv* env, jobject this, jbyteArray data_object, jint offset, jint length)
+Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate_1ptr__JB(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyte data)
 {
 #ifndef NO_HMAC
+    hmac_update_byte(env, (Hmac*)(uintptr_t)ptr, data);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+#ifndef NO_HMAC
+static int hmac_update_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_HmacUpdate((Hmac*)ctx, chunk, chunkSz);
+}
+
+static void hmac_update_array(JNIEnv* env, Hmac* hmac, jbyteArray data_object,
+    jint offset, jint length)
+{
     int ret = 0;
-    Hmac* hmac = NULL;
     byte* data = NULL;
+    word32 dataSz = 0;
 
-    hmac = (Hmac*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
+    dataSz = getByteArrayLength(env, data_object);
+
+    if (hmac == NULL || data_object == NULL || offset < 0 || length < 0 ||
+        (word32)(offset + length) > dataSz) {
+        ret = BAD_FUNC_ARG;
+    }
+    else if (length > WOLFCRYPTJNI_CRITICAL_MAX_SZ) {
+        /* stream large inputs instead of pinning the array */
+        ret = processByteArrayChunked(env, data_object, offset, NULL, 0,
+            length, hmac_update_chunk, hmac);
     }
+    else {
+        /* no other JNI calls until the array is released */
+        data = getByteArrayCritical(env, data_object);
+        ret = (!data)
+            ? BAD_FUNC_ARG
+            : wc_HmacUpdate(hmac, data + offset, length);
 
-    data = getByteArray(env, data_object);
+        LogStr("data[%u]: [%p]\n", (word32)length, data + offset);
+        LogHex((byte*) data, offset, length);
 
-    ret = (!hmac || !data)
-        ? BAD_FUNC_ARG
-        : wc_HmacUpdate(hmac, data + offset, length);
+        releaseByteArrayCritical(env, data_object, data, JNI_ABORT);
+    }
+
+    LogStr("wc_HmacUpdate(hmac=%p, data, length) = %d\n", hmac, ret);
+    LogInfo("wc_HmacUpdate(len %lld) = %lld", length, ret);
 
     if (ret != 0)
         throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
 
-    LogStr("wc_HmacUpdate(hmac=%p, data, length) = %d\n", hmac, ret);
-    LogStr("data[%u]: [%p]\n", (word32)length, data + offset);
-    LogHex((byte*) data, offset, length);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate___3BII(
+    JNIEnv* env, jobject this, jbyteArray data_object, jint offset, jint length)
+{
+#ifndef NO_HMAC
+    Hmac* hmac = (Hmac*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
 
-    releaseByteArray(env, data_object, data, JNI_ABORT);
+    hmac_update_array(env, hmac, data_object, offset, length);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
 JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate__Ljava_nio_ByteBuffer_2II(
-    JNIEnv* env, jobject this, jobject data_object, jint offset, jint length)
+Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate_1ptr__J_3BII(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray data_object, jint offset,
+    jint length)
 {
 #ifndef NO_HMAC
+    hmac_update_array(env, (Hmac*)(uintptr_t)ptr, data_object, offset, length);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+#ifndef NO_HMAC
+static void hmac_update_buffer(JNIEnv* env, Hmac* hmac, jobject data_object,
+    jint offset, jint length)
+{
     int ret = 0;
-    Hmac* hmac = NULL;
     byte* data = NULL;
 
-    hmac = (Hmac*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
-
     data = getDirectBufferAddress(env, data_object);
 
     ret = (!hmac || !data)
@@ -247,34 +297,58 @@ Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate__Ljava_nio_ByteBuffer_2II(
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_HmacUpdate(hmac=%p, data, length) = %d\n", hmac, ret);
+    LogInfo("wc_HmacUpdate(len %lld) = %lld", length, ret);
     LogStr("data[%u]: [%p]\n", (word32)length, data + offset);
     LogHex((byte*) data, offset, length);
+}
+#endif
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate__Ljava_nio_ByteBuffer_2II(
+    JNIEnv* env, jobject this, jobject data_object, jint offset, jint length)
+{
+#ifndef NO_HMAC
+    Hmac* hmac = (Hmac*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    hmac_update_buffer(env, hmac, data_object, offset, length);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
-JNIEXPORT jbyteArray JNICALL
-Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacFinal(
-    JNIEnv* env, jobject this)
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacUpdate_1ptr__JLjava_nio_ByteBuffer_2II(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject data_object, jint offset,
+    jint length)
 {
-    jbyteArray result = NULL;
+#ifndef NO_HMAC
+    hmac_update_buffer(env, (Hmac*)(uintptr_t)ptr, data_object, offset, length);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
 #ifndef NO_HMAC
+static jbyteArray hmac_final(JNIEnv* env, Hmac* hmac)
+{
+    jbyteArray result = NULL;
     int ret = 0;
-    Hmac* hmac = NULL;
     int   hmacSz = 0;
     byte tmp[MAX_DIGEST_SIZE];
 
-    hmac = (Hmac*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return NULL;
+    if (hmac == NULL) {
+        throwWolfCryptExceptionFromError(env, BAD_FUNC_ARG);
+        return result;
     }
+
     hmacSz = GetHashSizeByType(hmac->macType);
 
     if (hmacSz < 0) {
-        throwWolfCryptExceptionFromError(env, ret);
+        throwWolfCryptExceptionFromError(env, hmacSz);
         return result;
     }
 
@@ -296,13 +370,44 @@ Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacFinal(
     }
 
     LogStr("wc_HmacFinal(hmac=%p, result) = %d\n", hmac, ret);
+    LogInfo("wc_HmacFinal() = %lld", ret, 0);
     LogStr("result[%u]: [%p]\n", (word32)hmacSz, tmp);
     LogHex(tmp, 0, hmacSz);
+
+    return result;
+}
+#endif
+
+JNIEXPORT jbyteArray JNICALL
+Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacFinal(
+    JNIEnv* env, jobject this)
+{
+#ifndef NO_HMAC
+    Hmac* hmac = (Hmac*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return NULL;
+    }
+
+    return hmac_final(env, hmac);
 #else
     throwNotCompiledInException(env);
+
+    return NULL;
 #endif
+}
 
-    return result;
+JNIEXPORT jbyteArray JNICALL
+Java_com_wolfssl_wolfcrypt_Hmac_wc_1HmacFinal_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifndef NO_HMAC
+    return hmac_final(env, (Hmac*)(uintptr_t)ptr);
+#else
+    throwNotCompiledInException(env);
+
+    return NULL;
+#endif
 }
 
 JNIEXPORT jint JNICALL
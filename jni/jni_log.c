@@ -0,0 +1,182 @@
+/* jni_log.c
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/wolfcrypt/settings.h>
+#elif !defined(__ANDROID__)
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/types.h>
+
+#include <stdio.h>
+#ifdef _MSC_VER
+    #include <windows.h>
+#endif
+
+#include <com_wolfssl_wolfcrypt_Logging.h>
+#include <wolfcrypt_jni_log.h>
+
+#define LOG_MASK  (WOLFCRYPT_JNI_LOG_ENTRIES - 1)
+#define LOG_WIDTH 160
+
+typedef struct LogEntry {
+    volatile long long seq;  /* slot index + 1 once written, 0 while busy */
+    int level;
+    const char* fmt;
+    long long a;
+    long long b;
+} LogEntry;
+
+/* off until Java sets a level, so log points cost one load by default */
+volatile int wolfCryptJniLogLevel = WOLFCRYPT_JNI_LOG_OFF;
+
+static LogEntry logRing[WOLFCRYPT_JNI_LOG_ENTRIES];
+static volatile long long logHead = 0;
+/* next slot to drain, only touched by Logging.getNativeLog() which
+ * serializes callers */
+static long long logTail = 0;
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define LOG_CLAIM()         __atomic_fetch_add(&logHead, 1, \
+                                                   __ATOMIC_RELAXED)
+    #define LOG_LOAD(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define LOG_STORE(p, v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#elif defined(_MSC_VER)
+    #define LOG_CLAIM()         (InterlockedIncrement64(&logHead) - 1)
+    #define LOG_LOAD(p)         InterlockedCompareExchange64((p), 0, 0)
+    #define LOG_STORE(p, v)     InterlockedExchange64((p), (v))
+#else
+    /* no atomics available, concurrent writers may overwrite each other's
+     * records but the reader still skips torn entries */
+    #define LOG_CLAIM()         (logHead++)
+    #define LOG_LOAD(p)         (*(p))
+    #define LOG_STORE(p, v)     (*(p) = (v))
+#endif
+
+void wolfCryptJniLogWrite(int level, const char* fmt, long long a,
+                          long long b)
+{
+    long long idx = LOG_CLAIM();
+    LogEntry* e = &logRing[idx & LOG_MASK];
+
+    LOG_STORE(&e->seq, 0);
+    e->level = level;
+    e->fmt = fmt;
+    e->a = a;
+    e->b = b;
+    LOG_STORE(&e->seq, idx + 1);
+}
+
+static const char* logLevelName(int level)
+{
+    switch (level) {
+        case WOLFCRYPT_JNI_LOG_ERROR:
+            return "ERROR";
+        case WOLFCRYPT_JNI_LOG_INFO:
+            return "INFO";
+        default:
+            return "DEBUG";
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Logging_nativeSetLogLevel
+  (JNIEnv* env, jclass class, jint level)
+{
+    if (level < WOLFCRYPT_JNI_LOG_OFF)
+        level = WOLFCRYPT_JNI_LOG_OFF;
+    if (level > WOLFCRYPT_JNI_LOG_DEBUG)
+        level = WOLFCRYPT_JNI_LOG_DEBUG;
+
+    wolfCryptJniLogLevel = level;
+}
+
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Logging_nativeGetLogLevel
+  (JNIEnv* env, jclass class)
+{
+    return wolfCryptJniLogLevel;
+}
+
+JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Logging_nativeGetMaxLogLevel
+  (JNIEnv* env, jclass class)
+{
+    return WOLFCRYPT_JNI_LOG_LEVEL;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_wolfssl_wolfcrypt_Logging_nativeDrainLog
+  (JNIEnv* env, jclass class)
+{
+    jclass stringClass = NULL;
+    jobjectArray lines = NULL;
+    jstring line = NULL;
+    long long head = LOG_LOAD(&logHead);
+    long long start = logTail;
+    long long i;
+    jsize count = 0;
+    char buf[LOG_WIDTH];
+
+    /* anything older than one ring length has been overwritten */
+    if (head - start > WOLFCRYPT_JNI_LOG_ENTRIES)
+        start = head - WOLFCRYPT_JNI_LOG_ENTRIES;
+
+    stringClass = (*env)->FindClass(env, "java/lang/String");
+    if (stringClass == NULL)
+        return NULL;
+
+    lines = (*env)->NewObjectArray(env, (jsize)(head - start), stringClass,
+                                   NULL);
+    if (lines == NULL)
+        return NULL;
+
+    for (i = start; i < head; i++) {
+        LogEntry* e = &logRing[i & LOG_MASK];
+        int level;
+        const char* fmt;
+        long long a, b;
+        int n;
+
+        if (LOG_LOAD(&e->seq) != i + 1)
+            continue; /* still being written or already reused */
+
+        level = e->level;
+        fmt = e->fmt;
+        a = e->a;
+        b = e->b;
+
+        if (LOG_LOAD(&e->seq) != i + 1)
+            continue; /* reused while copying */
+
+        n = XSNPRINTF(buf, sizeof(buf), "[%s] ", logLevelName(level));
+        if (n < 0 || n >= (int)sizeof(buf))
+            continue;
+        XSNPRINTF(buf + n, sizeof(buf) - n, fmt, a, b);
+
+        line = (*env)->NewStringUTF(env, buf);
+        if (line == NULL)
+            return NULL;
+
+        (*env)->SetObjectArrayElement(env, lines, count++, line);
+        (*env)->DeleteLocalRef(env, line);
+    }
+
+    logTail = head;
+
+    return lines;
+}
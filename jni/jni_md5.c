@@ -36,6 +36,7 @@
 
 /* #define WOLFCRYPT_JNI_DEBUG_ON */
 #include <wolfcrypt_jni_debug.h>
+#include <wolfcrypt_jni_log.h>
 
 #ifndef NO_OLD_MD5_NAME
     #define MD5             WC_MD5
@@ -54,13 +55,10 @@ Java_com_wolfssl_wolfcrypt_Md5_mallocNativeStruct_1internal(
 #ifndef NO_MD5
     Md5* md5 = NULL;
 
-    md5 = (Md5*)XMALLOC(sizeof(Md5), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    md5 = (Md5*)wolfCryptJniStructMalloc(sizeof(Md5));
     if (md5 == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Md5 object");
     }
-    else {
-        XMEMSET(md5, 0, sizeof(Md5));
-    }
 
     LogStr("new Md5() = %p\n", md5);
 
@@ -72,26 +70,43 @@ Java_com_wolfssl_wolfcrypt_Md5_mallocNativeStruct_1internal(
 #endif
 }
 
+#ifndef NO_MD5
+static void md5_init(JNIEnv* env, Md5* md5)
+{
+    int ret = 0;
+
+    ret = (!md5)
+        ? BAD_FUNC_ARG
+        : wc_InitMd5(md5);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
 JNIEXPORT void JNICALL
 Java_com_wolfssl_wolfcrypt_Md5_native_1init_1internal(
     JNIEnv* env, jobject this)
 {
 #ifndef NO_MD5
-    int ret = 0;
     Md5* md5 = (Md5*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    if (!md5) {
-        throwWolfCryptExceptionFromError(env, BAD_FUNC_ARG);
-    } else {
-        ret = wc_InitMd5(md5);
-        if (ret != 0) {
-            throwWolfCryptExceptionFromError(env, ret);
-        }
-    }
+    md5_init(env, md5);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Md5_native_1init_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifndef NO_MD5
+    md5_init(env, (Md5*)(uintptr_t)ptr);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -130,35 +145,84 @@ JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Md5_native_1copy_1internal
 #endif
 }
 
+#ifndef NO_MD5
+static void md5_update_buffer(JNIEnv* env, Md5* md5,
+    jobject data_buffer, jint position, jint len)
+{
+    int ret = 0;
+    byte* data = NULL;
+
+    data = getDirectBufferAddress(env, data_buffer);
+
+    ret = (!md5 || !data)
+        ? BAD_FUNC_ARG
+        : wc_Md5Update(md5, data + position, len);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+
+    LogStr("wc_Md5Update(md5=%p, data, len) = %d\n", md5, ret);
+    LogInfo("wc_Md5Update(len %lld) = %lld", len, ret);
+    LogStr("data[%u]: [%p]\n", (word32)len, data);
+    LogHex(data, position, len);
+}
+
+static int md5_update_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_Md5Update((Md5*)ctx, chunk, chunkSz);
+}
+
+static void md5_update_array(JNIEnv* env, Md5* md5,
+    jbyteArray data_buffer, jint offset, jint len)
+{
+    int ret = 0;
+    byte* data = NULL;
+    word32 dataSz = 0;
+
+    dataSz = getByteArrayLength(env, data_buffer);
+
+    if (md5 == NULL || data_buffer == NULL || offset < 0 || len < 0 ||
+        (word32)(offset + len) > dataSz) {
+        ret = BAD_FUNC_ARG;
+    }
+    else if (len > WOLFCRYPTJNI_CRITICAL_MAX_SZ) {
+        /* stream large inputs instead of pinning the array */
+        ret = processByteArrayChunked(env, data_buffer, offset, NULL, 0, len,
+            md5_update_chunk, md5);
+    }
+    else {
+        /* no other JNI calls until the array is released */
+        data = getByteArrayCritical(env, data_buffer);
+        ret = (!data)
+            ? BAD_FUNC_ARG
+            : wc_Md5Update(md5, data + offset, len);
+
+        LogStr("data[%u]: [%p]\n", (word32)len, data);
+        LogHex(data, offset, len);
+
+        releaseByteArrayCritical(env, data_buffer, data, JNI_ABORT);
+    }
+
+    LogStr("wc_Md5Update(md5=%p, data, len) = %d\n", md5, ret);
+    LogInfo("wc_Md5Update(len %lld) = %lld", len, ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
 JNIEXPORT void JNICALL
 Java_com_wolfssl_wolfcrypt_Md5_native_1update_1internal__Ljava_nio_ByteBuffer_2II(
     JNIEnv* env, jobject this, jobject data_buffer, jint position, jint len)
 {
 #ifndef NO_MD5
-    int ret = 0;
-    Md5*  md5  = NULL;
-    byte* data = NULL;
-
-    md5 = (Md5*) getNativeStruct(env, this);
+    Md5* md5 = (Md5*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    data = getDirectBufferAddress(env, data_buffer);
-
-    if (!md5 || !data) {
-        throwWolfCryptExceptionFromError(env, BAD_FUNC_ARG);
-    } else {
-        ret = wc_Md5Update(md5, data + position, len);
-        if (ret != 0) {
-            throwWolfCryptExceptionFromError(env, ret);
-        }
-    }
-
-    LogStr("wc_Md5Update(md5=%p, data, len)\n", md5);
-    LogStr("data[%u]: [%p]\n", (word32)len, data);
-    LogHex(data, 0, len);
+    md5_update_buffer(env, md5, data_buffer, position, len);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -169,69 +233,106 @@ Java_com_wolfssl_wolfcrypt_Md5_native_1update_1internal___3BII(
     JNIEnv* env, jobject this, jbyteArray data_buffer, jint offset, jint len)
 {
 #ifndef NO_MD5
-    int ret = 0;
-    Md5*   md5   = NULL;
-    byte*  data  = NULL;
-    word32 dataSz = 0;
-
-    md5 = (Md5*) getNativeStruct(env, this);
+    Md5* md5 = (Md5*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    data   = getByteArray(env, data_buffer);
-    dataSz = getByteArrayLength(env, data_buffer);
-
-    if (md5 == NULL || data == NULL ||
-        ((word32)(offset + len) > dataSz)) {
-        throwWolfCryptExceptionFromError(env, BAD_FUNC_ARG);
-    } else {
-        ret = wc_Md5Update(md5, data + offset, len);
-        if (ret != 0) {
-            throwWolfCryptExceptionFromError(env, ret);
-        }
-    }
-
-    LogStr("wc_Md5Update(md5=%p, data, len)\n", md5);
-    LogStr("data[%u]: [%p]\n", (word32)len, data + offset);
-    LogHex(data, offset, len);
+    md5_update_array(env, md5, data_buffer, offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    releaseByteArray(env, data_buffer, data, JNI_ABORT);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Md5_native_1update_1ptr__JLjava_nio_ByteBuffer_2II(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject data_buffer, jint position,
+    jint len)
+{
+#ifndef NO_MD5
+    md5_update_buffer(env, (Md5*)(uintptr_t)ptr, data_buffer,
+        position, len);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
 JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Md5_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
-    JNIEnv* env, jobject this, jobject hash_buffer, jint position)
+Java_com_wolfssl_wolfcrypt_Md5_native_1update_1ptr__J_3BII(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray data_buffer, jint offset,
+    jint len)
 {
 #ifndef NO_MD5
+    md5_update_array(env, (Md5*)(uintptr_t)ptr, data_buffer,
+        offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+#ifndef NO_MD5
+static void md5_final_buffer(JNIEnv* env, Md5* md5,
+    jobject hash_buffer, jint position)
+{
     int ret = 0;
-    Md5*  md5  = NULL;
     byte* hash = NULL;
 
-    md5 = (Md5*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
-
     hash = getDirectBufferAddress(env, hash_buffer);
 
-    if (!md5 || !hash) {
-        throwWolfCryptExceptionFromError(env, BAD_FUNC_ARG);
-    } else {
-        ret = wc_Md5Final(md5, hash + position);
-        if (ret != 0) {
-            throwWolfCryptExceptionFromError(env, ret);
-        }
-    }
+    ret = (!md5 || !hash)
+        ? BAD_FUNC_ARG
+        : wc_Md5Final(md5, hash + position);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
 
-    LogStr("wc_Md5Final(md5=%p, hash)\n", md5);
+    LogStr("wc_Md5Final(md5=%p, hash) = %d\n", md5, ret);
+    LogInfo("wc_Md5Final() = %lld", ret, 0);
+    LogStr("hash[%u]: [%p]\n", (word32)MD5_DIGEST_SIZE, hash);
+    LogHex(hash, position, MD5_DIGEST_SIZE);
+}
+
+static void md5_final_array(JNIEnv* env, Md5* md5,
+    jbyteArray hash_buffer)
+{
+    int ret = 0;
+    byte* hash = NULL;
+    word32 hashSz = 0;
+
+    /* get length before entering critical region, no other JNI calls
+     * are allowed until the array is released */
+    hashSz = getByteArrayLength(env, hash_buffer);
+    hash   = getByteArrayCritical(env, hash_buffer);
+
+    ret = (!md5 || !hash || hashSz < MD5_DIGEST_SIZE)
+        ? BAD_FUNC_ARG
+        : wc_Md5Final(md5, hash);
+
+    LogStr("wc_Md5Final(md5=%p, hash) = %d\n", md5, ret);
+    LogInfo("wc_Md5Final() = %lld", ret, 0);
     LogStr("hash[%u]: [%p]\n", (word32)MD5_DIGEST_SIZE, hash);
     LogHex(hash, 0, MD5_DIGEST_SIZE);
+
+    releaseByteArrayCritical(env, hash_buffer, hash, ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Md5_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
+    JNIEnv* env, jobject this, jobject hash_buffer, jint position)
+{
+#ifndef NO_MD5
+    Md5* md5 = (Md5*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    md5_final_buffer(env, md5, hash_buffer, position);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -242,34 +343,36 @@ Java_com_wolfssl_wolfcrypt_Md5_native_1final_1internal___3B(
     JNIEnv* env, jobject this, jbyteArray hash_buffer)
 {
 #ifndef NO_MD5
-    int ret = 0;
-    Md5*  md5  = NULL;
-    byte* hash = NULL;
-
-    md5 = (Md5*) getNativeStruct(env, this);
+    Md5* md5 = (Md5*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    hash = getByteArray(env, hash_buffer);
-
-    if (!md5 || !hash) {
-        throwWolfCryptExceptionFromError(env, BAD_FUNC_ARG);
-    } else {
-        ret = wc_Md5Final(md5, hash);
-        if (ret != 0) {
-            throwWolfCryptExceptionFromError(env, ret);
-        }
-    }
-
-    LogStr("wc_Md5Final(md5=%p, hash)\n", md5);
-    LogStr("hash[%u]: [%p]\n", (word32)MD5_DIGEST_SIZE, hash);
-    LogHex(hash, 0, MD5_DIGEST_SIZE);
+    md5_final_array(env, md5, hash_buffer);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    releaseByteArray(env, hash_buffer, hash, 0);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Md5_native_1final_1ptr__JLjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject hash_buffer, jint position)
+{
+#ifndef NO_MD5
+    md5_final_buffer(env, (Md5*)(uintptr_t)ptr, hash_buffer, position);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Md5_native_1final_1ptr__J_3B(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray hash_buffer)
+{
+#ifndef NO_MD5
+    md5_final_array(env, (Md5*)(uintptr_t)ptr, hash_buffer);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
@@ -26,6 +26,7 @@
     #include <wolfssl/options.h>
 #endif
 #include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/misc.h>
 
 #include <com_wolfssl_wolfcrypt_NativeStruct.h>
 #include <wolfcrypt_jni_NativeStruct.h>
@@ -40,20 +41,209 @@
 
 JavaVM* g_vm = NULL;
 
+/* Class, field and method IDs cached once instead of being looked up on
+ * every native call. Class references are global refs, IDs remain valid
+ * as long as the class is not unloaded. A NULL entry means the lookup
+ * failed and callers fall back to resolving the ID at call time. */
+jclass    g_cachedWolfCryptExceptionClass = NULL;
+jmethodID g_cachedWolfCryptExceptionInit  = NULL;
+jclass    g_cachedOutOfMemoryErrorClass   = NULL;
+jclass    g_cachedNativeStructClass       = NULL;
+jfieldID  g_cachedNativeStructPointer     = NULL;
+jclass    g_cachedBufferClass             = NULL;
+jmethodID g_cachedBufferGetLimit          = NULL;
+jmethodID g_cachedBufferSetLimit          = NULL;
+
+/* Find class and store global reference, returns NULL on failure */
+static jclass cacheGlobalClass(JNIEnv* env, const char* name)
+{
+    jclass local = NULL;
+    jclass global = NULL;
+
+    local = (*env)->FindClass(env, name);
+    if ((*env)->ExceptionOccurred(env)) {
+        (*env)->ExceptionClear(env);
+        return NULL;
+    }
+
+    if (local != NULL) {
+        global = (jclass)(*env)->NewGlobalRef(env, local);
+        (*env)->DeleteLocalRef(env, local);
+    }
+
+    return global;
+}
+
+/* Look up method ID in cached class, returns NULL on failure */
+static jmethodID cacheMethodID(JNIEnv* env, jclass class, const char* name,
+    const char* sig)
+{
+    jmethodID method = NULL;
+
+    if (class != NULL) {
+        method = (*env)->GetMethodID(env, class, name, sig);
+        if ((*env)->ExceptionOccurred(env)) {
+            (*env)->ExceptionClear(env);
+            method = NULL;
+        }
+    }
+
+    return method;
+}
+
 /* called when native library is loaded */
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* reserved)
 {
+    JNIEnv* env = NULL;
+
     /* store JavaVM */
     g_vm = vm;
+
+    if ((*vm)->GetEnv(vm, (void**)&env, JNI_VERSION_1_6) != JNI_OK) {
+        return JNI_ERR;
+    }
+
+    /* NativeStruct is not cached here, FindClass() would run the
+     * WolfObject static initializer while this library is still loading.
+     * NativeStruct caches its own IDs from its static initializer. */
+    g_cachedWolfCryptExceptionClass =
+        cacheGlobalClass(env, "com/wolfssl/wolfcrypt/WolfCryptException");
+    g_cachedWolfCryptExceptionInit = cacheMethodID(env,
+        g_cachedWolfCryptExceptionClass, "<init>", "(I)V");
+
+    g_cachedOutOfMemoryErrorClass =
+        cacheGlobalClass(env, "java/lang/OutOfMemoryError");
+
+    g_cachedBufferClass = cacheGlobalClass(env, "java/nio/Buffer");
+    g_cachedBufferGetLimit = cacheMethodID(env, g_cachedBufferClass,
+        "limit", "()I");
+    g_cachedBufferSetLimit = cacheMethodID(env, g_cachedBufferClass,
+        "limit", "(I)Ljava/nio/Buffer;");
+
+    LogStr("JNI_OnLoad(), cached WolfCryptException (%p), Buffer (%p)\n",
+        g_cachedWolfCryptExceptionClass, g_cachedBufferClass);
+
     return JNI_VERSION_1_6;
 }
 
+/* called when native library is unloaded (class loader is collected) */
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM* vm, void* reserved)
+{
+    JNIEnv* env = NULL;
+
+    if ((*vm)->GetEnv(vm, (void**)&env, JNI_VERSION_1_6) != JNI_OK) {
+        return;
+    }
+
+    if (g_cachedWolfCryptExceptionClass != NULL) {
+        (*env)->DeleteGlobalRef(env, g_cachedWolfCryptExceptionClass);
+        g_cachedWolfCryptExceptionClass = NULL;
+    }
+    if (g_cachedOutOfMemoryErrorClass != NULL) {
+        (*env)->DeleteGlobalRef(env, g_cachedOutOfMemoryErrorClass);
+        g_cachedOutOfMemoryErrorClass = NULL;
+    }
+    if (g_cachedNativeStructClass != NULL) {
+        (*env)->DeleteGlobalRef(env, g_cachedNativeStructClass);
+        g_cachedNativeStructClass = NULL;
+    }
+    if (g_cachedBufferClass != NULL) {
+        (*env)->DeleteGlobalRef(env, g_cachedBufferClass);
+        g_cachedBufferClass = NULL;
+    }
+
+    g_cachedWolfCryptExceptionInit = NULL;
+    g_cachedNativeStructPointer = NULL;
+    g_cachedBufferGetLimit = NULL;
+    g_cachedBufferSetLimit = NULL;
+    g_vm = NULL;
+}
+
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_NativeStruct_initNativeStructCache(
+    JNIEnv* env, jclass class)
+{
+    jfieldID field = NULL;
+
+    field = (*env)->GetFieldID(env, class, "pointer", "J");
+
+    /* GetFieldID may throw exception, leave cache empty and let
+     * getNativeStruct() fall back to per-call lookup */
+    if ((*env)->ExceptionOccurred(env)) {
+        (*env)->ExceptionClear(env);
+        return;
+    }
+
+    if (g_cachedNativeStructClass == NULL) {
+        g_cachedNativeStructClass = (jclass)(*env)->NewGlobalRef(env, class);
+    }
+    g_cachedNativeStructPointer = field;
+
+    LogStr("NativeStruct.initNativeStructCache(), pointer field (%p)\n",
+        field);
+}
+
+/* Native structs are allocated with a header holding the struct size, so
+ * they can be zeroized knowing only the pointer. The header is
+ * WOLFCRYPTJNI_STRUCT_HDR_SZ bytes to keep the struct at the alignment
+ * returned by XMALLOC. */
+static byte* structHeader(void* ptr)
+{
+    return (byte*)ptr - WOLFCRYPTJNI_STRUCT_HDR_SZ;
+}
+
+static void structZero(void* ptr)
+{
+    word32 sz = 0;
+    volatile byte* z = (volatile byte*)ptr;
+
+    XMEMCPY(&sz, structHeader(ptr), sizeof(sz));
+
+    /* volatile so the compiler can not drop the writes */
+    while (sz--) {
+        *z++ = 0;
+    }
+}
+
+void* wolfCryptJniStructMalloc(word32 sz)
+{
+    byte* mem = NULL;
+
+    mem = (byte*)XMALLOC(WOLFCRYPTJNI_STRUCT_HDR_SZ + sz, NULL,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (mem == NULL) {
+        return NULL;
+    }
+
+    XMEMSET(mem, 0, WOLFCRYPTJNI_STRUCT_HDR_SZ + sz);
+    XMEMCPY(mem, &sz, sizeof(sz));
+
+    return mem + WOLFCRYPTJNI_STRUCT_HDR_SZ;
+}
+
+void wolfCryptJniStructFree(void* ptr)
+{
+    if (ptr != NULL) {
+        structZero(ptr);
+        XFREE(structHeader(ptr), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+}
+
 JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_NativeStruct_xfree(
-    JNIEnv* env, jobject this, jlong ptr)
+    JNIEnv* env, jclass jcl, jlong ptr)
 {
     LogStr("NativeStruct.xfree(), Freeing (%p)\n", (void*)ptr);
 
-    XFREE((void*)(uintptr_t)ptr, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    wolfCryptJniStructFree((void*)(uintptr_t)ptr);
+}
+
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_NativeStruct_xzero(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+    LogStr("NativeStruct.xzero(), Zeroizing (%p)\n", (void*)ptr);
+
+    if (ptr != 0) {
+        structZero((void*)(uintptr_t)ptr);
+    }
 }
 
 /*
@@ -66,8 +256,12 @@ void* getNativeStruct(JNIEnv* env, jobject this)
     jlong nativeStruct = 0;
 
     if (this) {
-        class = (*env)->GetObjectClass(env, this);
-        field = (*env)->GetFieldID(env, class, "pointer", "J");
+        field = g_cachedNativeStructPointer;
+
+        if (field == NULL) {
+            class = (*env)->GetObjectClass(env, this);
+            field = (*env)->GetFieldID(env, class, "pointer", "J");
+        }
 
         /* GetFieldID may throw exception */
         if ((*env)->ExceptionOccurred(env)) {
@@ -112,16 +306,18 @@ byte* getDirectBufferAddress(JNIEnv* env, jobject buffer)
 word32 getDirectBufferLimit(JNIEnv* env, jobject buffer)
 {
     jclass class;
-    jmethodID method;
+    jmethodID method = g_cachedBufferGetLimit;
 
-    class  = (*env)->GetObjectClass(env, buffer);
-    method = (*env)->GetMethodID(env, class, "limit", "()I");
+    if (method == NULL) {
+        class  = (*env)->GetObjectClass(env, buffer);
+        method = (*env)->GetMethodID(env, class, "limit", "()I");
 
-    /* GetMethodID may throw an exception */
-    if ((*env)->ExceptionOccurred(env)) {
-        (*env)->ExceptionDescribe(env);
-        (*env)->ExceptionClear(env);
-        return 0;
+        /* GetMethodID may throw an exception */
+        if ((*env)->ExceptionOccurred(env)) {
+            (*env)->ExceptionDescribe(env);
+            (*env)->ExceptionClear(env);
+            return 0;
+        }
     }
 
     return (word32) (*env)->CallIntMethod(env, buffer, method);
@@ -130,14 +326,17 @@ word32 getDirectBufferLimit(JNIEnv* env, jobject buffer)
 void setDirectBufferLimit(JNIEnv* env, jobject buffer, jint limit)
 {
     jclass class;
-    jmethodID method;
+    jmethodID method = g_cachedBufferSetLimit;
 
-    class = (*env)->GetObjectClass(env, buffer);
-    method = (*env)->GetMethodID(env, class, "limit", "(I)Ljava/nio/Buffer;");
+    if (method == NULL) {
+        class = (*env)->GetObjectClass(env, buffer);
+        method = (*env)->GetMethodID(env, class, "limit",
+            "(I)Ljava/nio/Buffer;");
 
-    /* GetMethodID may throw an exception */
-    if ((*env)->ExceptionOccurred(env)) {
-        return;
+        /* GetMethodID may throw an exception */
+        if ((*env)->ExceptionOccurred(env)) {
+            return;
+        }
     }
 
     /* may throw exception */
@@ -160,3 +359,170 @@ word32 getByteArrayLength(JNIEnv* env, jbyteArray array)
 {
     return array ? (*env)->GetArrayLength(env, array) : 0;
 }
+
+/* Get byte array elements inside a JNI critical region, avoiding the copy
+ * GetByteArrayElements() usually makes. No other JNI calls may be made,
+ * and nothing may block on another Java thread, until the array is released
+ * with releaseByteArrayCritical(). Array lengths should be read before this
+ * is called.
+ *
+ * FIPS builds can invoke the registered Java error callback from inside
+ * wolfCrypt, so those fall back to the copying getByteArray(). */
+byte* getByteArrayCritical(JNIEnv* env, jbyteArray array)
+{
+#ifndef HAVE_FIPS
+    return array ?
+        (byte*)(*env)->GetPrimitiveArrayCritical(env, array, NULL) : NULL;
+#else
+    return getByteArray(env, array);
+#endif
+}
+
+void releaseByteArrayCritical(JNIEnv* env, jbyteArray array, byte* elements,
+    jint abort)
+{
+#ifndef HAVE_FIPS
+    if (elements)
+        (*env)->ReleasePrimitiveArrayCritical(env, array, elements,
+            abort ? JNI_ABORT : 0);
+#else
+    releaseByteArray(env, array, elements, abort);
+#endif
+}
+
+/* Returns 1 if in and out are the same Java array and the len byte ranges
+ * at inOffset and outOffset partially overlap, otherwise 0. Identical
+ * ranges are in-place operation, which wolfCrypt supports. Must not be
+ * called while an array is held critical. */
+int byteArrayRangesOverlap(JNIEnv* env, jbyteArray in, jint inOffset,
+    jbyteArray out, jint outOffset, jint len)
+{
+    if (in == NULL || out == NULL || len <= 0 || inOffset == outOffset) {
+        return 0;
+    }
+
+    if (!(*env)->IsSameObject(env, in, out)) {
+        return 0;
+    }
+
+    if (inOffset < outOffset) {
+        return (outOffset - inOffset) < len;
+    }
+
+    return (inOffset - outOffset) < len;
+}
+
+/* Copy len bytes of array at offset into a new native buffer, NULL on
+ * allocation or array access failure. Free with freeByteArrayRegionCopy(). */
+byte* getByteArrayRegionCopy(JNIEnv* env, jbyteArray array, jint offset,
+    jint len)
+{
+    byte* copy = NULL;
+
+    if (array == NULL || offset < 0 || len < 0) {
+        return NULL;
+    }
+
+    /* XMALLOC(0) may return NULL, always allocate at least one byte */
+    copy = (byte*)XMALLOC(len > 0 ? len : 1, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    if (copy == NULL) {
+        return NULL;
+    }
+
+    (*env)->GetByteArrayRegion(env, array, offset, len, (jbyte*)copy);
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionClear(env);
+        XFREE(copy, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        return NULL;
+    }
+
+    return copy;
+}
+
+void freeByteArrayRegionCopy(byte* copy, jint len)
+{
+    if (copy != NULL) {
+        /* copy may hold plaintext */
+        ForceZero(copy, (word32)len);
+        XFREE(copy, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+}
+
+/* Process len bytes of a Java byte array starting at inOffset without
+ * pinning or copying the whole array. Data is copied in
+ * WOLFCRYPTJNI_CHUNK_SZ pieces into a native stack buffer with
+ * GetByteArrayRegion(), passed to cb, and if out is not NULL the (in-place
+ * transformed) chunk is written back to out at outOffset with
+ * SetByteArrayRegion().
+ *
+ * If out is the same array as in and outOffset is ahead of inOffset
+ * within len, writing a chunk would overwrite input not yet read. The
+ * whole input range is copied first in that case. Output that trails the
+ * input is safe, each chunk is read before it is written.
+ *
+ * Callers must have already validated offsets and lengths against the
+ * array sizes. Returns 0 on success, the first non-zero callback return
+ * value, MEMORY_E if the overlap copy could not be made, or BUFFER_E if a
+ * JNI array access failed. */
+int processByteArrayChunked(JNIEnv* env, jbyteArray in, jint inOffset,
+    jbyteArray out, jint outOffset, jint len, ByteArrayChunkCb cb, void* ctx)
+{
+    int ret = 0;
+    jint sz = 0;
+    jint copyLen = len;
+    byte* copy = NULL;
+    byte* copyPos = NULL;
+    byte chunk[WOLFCRYPTJNI_CHUNK_SZ];
+
+    if (in == NULL || cb == NULL || inOffset < 0 || outOffset < 0 ||
+        len < 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (out != NULL && outOffset > inOffset &&
+        byteArrayRangesOverlap(env, in, inOffset, out, outOffset, len)) {
+        copy = getByteArrayRegionCopy(env, in, inOffset, len);
+        if (copy == NULL) {
+            return MEMORY_E;
+        }
+        copyPos = copy;
+    }
+
+    while (ret == 0 && len > 0) {
+        sz = (len > WOLFCRYPTJNI_CHUNK_SZ) ? WOLFCRYPTJNI_CHUNK_SZ : len;
+
+        if (copyPos != NULL) {
+            XMEMCPY(chunk, copyPos, sz);
+            copyPos += sz;
+        }
+        else {
+            (*env)->GetByteArrayRegion(env, in, inOffset, sz, (jbyte*)chunk);
+            if ((*env)->ExceptionCheck(env)) {
+                (*env)->ExceptionClear(env);
+                ret = BUFFER_E;
+                break;
+            }
+        }
+
+        ret = cb(ctx, chunk, (word32)sz);
+
+        if (ret == 0 && out != NULL) {
+            (*env)->SetByteArrayRegion(env, out, outOffset, sz,
+                (const jbyte*)chunk);
+            if ((*env)->ExceptionCheck(env)) {
+                (*env)->ExceptionClear(env);
+                ret = BUFFER_E;
+            }
+            outOffset += sz;
+        }
+
+        inOffset += sz;
+        len -= sz;
+    }
+
+    /* chunk may hold key stream or plaintext */
+    ForceZero(chunk, sizeof(chunk));
+    freeByteArrayRegionCopy(copy, copyLen);
+
+    return ret;
+}
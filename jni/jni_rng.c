@@ -20,6 +20,10 @@
  */
 
 #include <stdint.h>
+#if !defined(_WIN32) && !defined(USE_WINDOWS_API)
+    #include <pthread.h>
+    #define WOLFCRYPTJNI_HAVE_ATFORK
+#endif
 
 #ifdef WOLFSSL_USER_SETTINGS
     #include <wolfssl/wolfcrypt/settings.h>
@@ -36,11 +40,43 @@
 
 /* #define WOLFCRYPT_JNI_DEBUG_ON */
 #include <wolfcrypt_jni_debug.h>
+#include <wolfcrypt_jni_log.h>
 
 #if !defined(WC_NO_RNG) && defined(NO_OLD_RNGNAME)
     #define RNG WC_RNG
 #endif
 
+/* Incremented in the child process after fork(). Shared with Java through
+ * a direct ByteBuffer so Rng objects can detect a fork, and drop state
+ * copied from the parent, without making a JNI call. */
+static volatile jint rngForkGeneration = 0;
+
+#ifdef WOLFCRYPTJNI_HAVE_ATFORK
+static void rngAtForkChild(void)
+{
+    rngForkGeneration++;
+}
+#endif
+
+JNIEXPORT jobject JNICALL
+Java_com_wolfssl_wolfcrypt_Rng_forkGenerationBuffer(
+    JNIEnv* env, jclass jcl)
+{
+#ifdef WOLFCRYPTJNI_HAVE_ATFORK
+    int ret = pthread_atfork(NULL, NULL, rngAtForkChild);
+
+    LogStr("pthread_atfork(rngAtForkChild) = %d\n", ret);
+
+    if (ret != 0) {
+        throwWolfCryptException(env, "Failed to register fork handler");
+        return NULL;
+    }
+#endif
+
+    return (*env)->NewDirectByteBuffer(env, (void*)&rngForkGeneration,
+        (jlong)sizeof(rngForkGeneration));
+}
+
 JNIEXPORT jlong JNICALL
 Java_com_wolfssl_wolfcrypt_Rng_mallocNativeStruct(
     JNIEnv* env, jobject this)
@@ -48,13 +84,10 @@ Java_com_wolfssl_wolfcrypt_Rng_mallocNativeStruct(
 #ifndef WC_NO_RNG
     RNG* rng = NULL;
 
-    rng = (RNG*)XMALLOC(sizeof(RNG), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    rng = (RNG*)wolfCryptJniStructMalloc(sizeof(RNG));
     if (rng == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Rng object");
     }
-    else {
-        XMEMSET(rng, 0, sizeof(RNG));
-    }
 
     LogStr("new Rng() = %p\n", rng);
 
@@ -116,20 +149,33 @@ Java_com_wolfssl_wolfcrypt_Rng_freeRng(
 #endif
 }
 
-JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock__Ljava_nio_ByteBuffer_2II(
-    JNIEnv* env, jobject this, jobject buffer_buffer, jint position, jint size)
+/* Free contents of native struct given only its pointer, used to clean up
+ * after a Rng object that was not released explicitly. Does not throw,
+ * runs on the NativeStruct cleanup thread. */
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Rng_native_1free_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
 {
 #ifndef WC_NO_RNG
-    int ret = 0;
-    RNG*  rng    = NULL;
-    byte* buffer = NULL;
+    RNG* rng = (RNG*)(uintptr_t)ptr;
 
-    rng = (RNG*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
+    if (rng != NULL) {
+        wc_FreeRng(rng);
     }
 
+    LogStr("wc_FreeRng(rng=%p), cleanup\n", rng);
+#else
+    (void)ptr;
+#endif
+}
+
+#ifndef WC_NO_RNG
+static void rng_generate_buffer(JNIEnv* env, RNG* rng, jobject buffer_buffer,
+    jint position, jint size)
+{
+    int ret = 0;
+    byte* buffer = NULL;
+
     buffer = getDirectBufferAddress(env, buffer_buffer);
 
     ret = (!rng || !buffer)
@@ -140,41 +186,99 @@ JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock__Ljava_ni
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_RNG_GenerateBlock(rng=%p, buffer, size) = %d\n", rng, ret);
+    LogInfo("wc_RNG_GenerateBlock(len %lld) = %lld", size, ret);
     LogStr("output[%u]: [%p]\n", (word32)size, buffer);
     LogHex(buffer, 0, size);
+}
+#endif
+
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock__Ljava_nio_ByteBuffer_2II(
+    JNIEnv* env, jobject this, jobject buffer_buffer, jint position, jint size)
+{
+#ifndef WC_NO_RNG
+    RNG* rng = (RNG*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    rng_generate_buffer(env, rng, buffer_buffer, position, size);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
-JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock___3BII(
-    JNIEnv* env, jobject this, jbyteArray buffer_buffer, jint offset,
-    jint length)
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock_1ptr__JLjava_nio_ByteBuffer_2II(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject buffer_buffer, jint position,
+    jint size)
 {
 #ifndef WC_NO_RNG
+    rng_generate_buffer(env, (RNG*)(uintptr_t)ptr, buffer_buffer, position,
+        size);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+#ifndef WC_NO_RNG
+static void rng_generate_array(JNIEnv* env, RNG* rng, jbyteArray buffer_buffer,
+    jint offset, jint length)
+{
     int ret = 0;
-    RNG*  rng    = NULL;
     byte* buffer = NULL;
+    word32 bufferSz = 0;
 
-    rng = (RNG*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
+    /* get length before entering critical region, no other JNI calls
+     * are allowed until the array is released */
+    bufferSz = getByteArrayLength(env, buffer_buffer);
+    buffer   = getByteArrayCritical(env, buffer_buffer);
+
+    if (rng == NULL || buffer == NULL || offset < 0 || length < 0 ||
+        (word32)(offset + length) > bufferSz) {
+        ret = BAD_FUNC_ARG;
+    }
+    else {
+        ret = wc_RNG_GenerateBlock(rng, buffer + offset, length);
     }
 
-    buffer = getByteArray(env, buffer_buffer);
+    LogStr("wc_RNG_GenerateBlock(rng=%p, buffer, length) = %d\n", rng, ret);
+    LogInfo("wc_RNG_GenerateBlock(len %lld) = %lld", length, ret);
+    LogStr("output[%u]: [%p]\n", (word32)length, buffer);
+    LogHex(buffer, offset, length);
+
+    releaseByteArrayCritical(env, buffer_buffer, buffer, ret);
 
-    ret = (!rng || !buffer)
-        ? BAD_FUNC_ARG
-        : wc_RNG_GenerateBlock(rng, buffer + offset, length);
     if (ret != 0)
         throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
 
-    LogStr("wc_RNG_GenerateBlock(rng=%p, buffer, length) = %d\n", rng, ret);
-    LogStr("output[%u]: [%p]\n", (word32)length, buffer);
-    LogHex(buffer, 0, length);
+JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock___3BII(
+    JNIEnv* env, jobject this, jbyteArray buffer_buffer, jint offset,
+    jint length)
+{
+#ifndef WC_NO_RNG
+    RNG* rng = (RNG*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
 
-    releaseByteArray(env, buffer_buffer, buffer, ret);
+    rng_generate_array(env, rng, buffer_buffer, offset, length);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Rng_rngGenerateBlock_1ptr__J_3BII(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray buffer_buffer, jint offset,
+    jint length)
+{
+#ifndef WC_NO_RNG
+    rng_generate_array(env, (RNG*)(uintptr_t)ptr, buffer_buffer, offset,
+        length);
 #else
     throwNotCompiledInException(env);
 #endif
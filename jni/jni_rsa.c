@@ -38,6 +38,7 @@
 
 /* #define WOLFCRYPT_JNI_DEBUG_ON */
 #include <wolfcrypt_jni_debug.h>
+#include <wolfcrypt_jni_log.h>
 
 #if !defined(WC_NO_RNG) && defined(NO_OLD_RNGNAME)
     #define RNG WC_RNG
@@ -50,13 +51,10 @@ Java_com_wolfssl_wolfcrypt_Rsa_mallocNativeStruct(
 #ifndef NO_RSA
     RsaKey* rsa = NULL;
 
-    rsa = (RsaKey*)XMALLOC(sizeof(RsaKey), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    rsa = (RsaKey*)wolfCryptJniStructMalloc(sizeof(RsaKey));
     if (rsa == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Rsa object");
     }
-    else {
-        XMEMSET(rsa, 0, sizeof(RsaKey));
-    }
 
     LogStr("new Rsa() = %p\n", rsa);
 
@@ -656,6 +654,26 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1FreeRsaKey(
 #endif
 }
 
+/* Free contents of native struct given only its pointer, used to clean up
+ * after a Rsa object that was not released explicitly. Does not throw,
+ * runs on the NativeStruct cleanup thread. */
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Rsa_native_1free_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifndef NO_RSA
+    RsaKey* key = (RsaKey*)(uintptr_t)ptr;
+
+    if (key != NULL) {
+        wc_FreeRsaKey(key);
+    }
+
+    LogStr("wc_FreeRsaKey(key=%p), cleanup\n", key);
+#else
+    (void)ptr;
+#endif
+}
+
 JNIEXPORT jboolean JNICALL
 Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSetRNG(
     JNIEnv* env, jobject this, jobject rng_object)
@@ -858,32 +876,16 @@ JNIEXPORT jint JNICALL Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaEncryptSize
     return ret;
 }
 
-JNIEXPORT jbyteArray JNICALL
-Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPublicEncrypt(
-    JNIEnv* env, jobject this, jbyteArray plaintext_object, jobject rng_object)
+#ifndef NO_RSA
+static jbyteArray rsa_public_encrypt(JNIEnv* env, RsaKey* key, RNG* rng,
+    jbyteArray plaintext_object)
 {
     jbyteArray result = NULL;
-
-#ifndef NO_RSA
     int ret = 0;
-    RsaKey* key = NULL;
-    RNG*    rng = NULL;
     byte* plaintext = NULL;
     byte* output = NULL;
     word32 size = 0, outputSz = 0;
 
-    key = (RsaKey*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return NULL;
-    }
-
-    rng = (RNG*) getNativeStruct(env, rng_object);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return NULL;
-    }
-
     plaintext = getByteArray(env, plaintext_object);
     size = getByteArrayLength(env, plaintext_object);
 
@@ -929,6 +931,7 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPublicEncrypt(
     }
 
     LogStr("wc_RsaPublicEncrypt(in, inSz, out, outSz, key=, rng) = %d\n", ret);
+    LogInfo("wc_RsaPublicEncrypt() = %lld", ret, 0);
     LogStr("output[%u]: [%p]\n", outputSz, output);
     LogHex((byte*) output, 0, outputSz);
 
@@ -936,25 +939,18 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPublicEncrypt(
         XFREE(output, NULL, DYNAMIC_TYPE_TMP_BUFFER);
     }
     releaseByteArray(env, plaintext_object, plaintext, JNI_ABORT);
-#else
-    throwNotCompiledInException(env);
-#endif
 
     return result;
 }
+#endif
 
 JNIEXPORT jbyteArray JNICALL
-Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPrivateDecrypt(
-    JNIEnv* env, jobject this, jbyteArray ciphertext_object)
+Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPublicEncrypt(
+    JNIEnv* env, jobject this, jbyteArray plaintext_object, jobject rng_object)
 {
-    jbyteArray result = NULL;
-
 #ifndef NO_RSA
-    int ret = 0;
     RsaKey* key = NULL;
-    byte* ciphertext = NULL;
-    byte* output = NULL;
-    word32 size = 0, outputSz = 0;
+    RNG* rng = NULL;
 
     key = (RsaKey*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
@@ -962,6 +958,45 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPrivateDecrypt(
         return NULL;
     }
 
+    rng = (RNG*) getNativeStruct(env, rng_object);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return NULL;
+    }
+
+    return rsa_public_encrypt(env, key, rng, plaintext_object);
+#else
+    throwNotCompiledInException(env);
+
+    return NULL;
+#endif
+}
+
+JNIEXPORT jbyteArray JNICALL
+Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPublicEncrypt_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jlong rngPtr,
+    jbyteArray plaintext_object)
+{
+#ifndef NO_RSA
+    return rsa_public_encrypt(env, (RsaKey*)(uintptr_t)ptr,
+        (RNG*)(uintptr_t)rngPtr, plaintext_object);
+#else
+    throwNotCompiledInException(env);
+
+    return NULL;
+#endif
+}
+
+#ifndef NO_RSA
+static jbyteArray rsa_private_decrypt(JNIEnv* env, RsaKey* key,
+    jbyteArray ciphertext_object)
+{
+    jbyteArray result = NULL;
+    int ret = 0;
+    byte* ciphertext = NULL;
+    byte* output = NULL;
+    word32 size = 0, outputSz = 0;
+
     ciphertext = getByteArray(env, ciphertext_object);
     size = getByteArrayLength(env, ciphertext_object);
 
@@ -1007,6 +1042,7 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPrivateDecrypt(
     }
 
     LogStr("wc_RsaPrivateDecrypt(in, inSz, out, outSz, key) = %d\n", ret);
+    LogInfo("wc_RsaPrivateDecrypt() = %lld", ret, 0);
     LogStr("output[%u]: [%p]\n", outputSz, output);
     LogHex((byte*) output, 0, outputSz);
 
@@ -1014,39 +1050,53 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPrivateDecrypt(
         XFREE(output, NULL, DYNAMIC_TYPE_TMP_BUFFER);
     }
     releaseByteArray(env, ciphertext_object, ciphertext, JNI_ABORT);
+
+    return result;
+}
+#endif
+
+JNIEXPORT jbyteArray JNICALL
+Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPrivateDecrypt(
+    JNIEnv* env, jobject this, jbyteArray ciphertext_object)
+{
+#ifndef NO_RSA
+    RsaKey* key = (RsaKey*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return NULL;
+    }
+
+    return rsa_private_decrypt(env, key, ciphertext_object);
 #else
     throwNotCompiledInException(env);
-#endif
 
-    return result;
+    return NULL;
+#endif
 }
 
 JNIEXPORT jbyteArray JNICALL
-Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Sign(
-    JNIEnv* env, jobject this, jbyteArray data_object, jobject rng_object)
+Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaPrivateDecrypt_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray ciphertext_object)
 {
-    jbyteArray result = NULL;
+#ifndef NO_RSA
+    return rsa_private_decrypt(env, (RsaKey*)(uintptr_t)ptr, ciphertext_object);
+#else
+    throwNotCompiledInException(env);
+
+    return NULL;
+#endif
+}
 
 #ifndef NO_RSA
+static jbyteArray rsa_ssl_sign(JNIEnv* env, RsaKey* key, RNG* rng,
+    jbyteArray data_object)
+{
+    jbyteArray result = NULL;
     int ret = 0;
-    RsaKey* key  = NULL;
-    RNG*  rng    = NULL;
     byte* data   = NULL;
     byte* output = NULL;
     word32 size = 0, outputSz = 0;
 
-    key = (RsaKey*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return NULL;
-    }
-
-    rng = (RNG*) getNativeStruct(env, rng_object);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return NULL;
-    }
-
     data = getByteArray(env, data_object);
     size = getByteArrayLength(env, data_object);
 
@@ -1093,6 +1143,7 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Sign(
     }
 
     LogStr("wc_RsaSSL_Sign(in, inSz, out, outSz, key, rng) = %d\n", ret);
+    LogInfo("wc_RsaSSL_Sign() = %lld", ret, 0);
     LogStr("output[%u]: [%p]\n", outputSz, output);
     LogHex((byte*) output, 0, outputSz);
 
@@ -1100,24 +1151,18 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Sign(
         XFREE(output, NULL, DYNAMIC_TYPE_TMP_BUFFER);
     }
     releaseByteArray(env, data_object, data, JNI_ABORT);
-#else
-    throwNotCompiledInException(env);
-#endif
 
     return result;
 }
+#endif
 
 JNIEXPORT jbyteArray JNICALL
-Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Verify(
-    JNIEnv* env, jobject this, jbyteArray signature_object)
+Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Sign(
+    JNIEnv* env, jobject this, jbyteArray data_object, jobject rng_object)
 {
-    jbyteArray result = NULL;
 #ifndef NO_RSA
-    int ret = 0;
-    RsaKey* key     = NULL;
-    byte* signature = NULL;
-    byte* output    = NULL;
-    word32 size = 0, outputSz = 0;
+    RsaKey* key = NULL;
+    RNG* rng = NULL;
 
     key = (RsaKey*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
@@ -1125,6 +1170,44 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Verify(
         return NULL;
     }
 
+    rng = (RNG*) getNativeStruct(env, rng_object);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return NULL;
+    }
+
+    return rsa_ssl_sign(env, key, rng, data_object);
+#else
+    throwNotCompiledInException(env);
+
+    return NULL;
+#endif
+}
+
+JNIEXPORT jbyteArray JNICALL
+Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Sign_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jlong rngPtr, jbyteArray data_object)
+{
+#ifndef NO_RSA
+    return rsa_ssl_sign(env, (RsaKey*)(uintptr_t)ptr, (RNG*)(uintptr_t)rngPtr,
+        data_object);
+#else
+    throwNotCompiledInException(env);
+
+    return NULL;
+#endif
+}
+
+#ifndef NO_RSA
+static jbyteArray rsa_ssl_verify(JNIEnv* env, RsaKey* key,
+    jbyteArray signature_object)
+{
+    jbyteArray result = NULL;
+    int ret = 0;
+    byte* signature = NULL;
+    byte* output    = NULL;
+    word32 size = 0, outputSz = 0;
+
     signature = getByteArray(env, signature_object);
     size = getByteArrayLength(env, signature_object);
 
@@ -1170,6 +1253,7 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Verify(
     }
 
     LogStr("wc_RsaSSL_Verify(in, inSz, out, outSz, key) = %d\n", ret);
+    LogInfo("wc_RsaSSL_Verify() = %lld", ret, 0);
     LogStr("output[%u]: [%p]\n", outputSz, output);
     LogHex((byte*) output, 0, outputSz);
 
@@ -1177,10 +1261,40 @@ Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Verify(
         XFREE(output, NULL, DYNAMIC_TYPE_TMP_BUFFER);
     }
     releaseByteArray(env, signature_object, signature, JNI_ABORT);
+
+    return result;
+}
+#endif
+
+JNIEXPORT jbyteArray JNICALL
+Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Verify(
+    JNIEnv* env, jobject this, jbyteArray signature_object)
+{
+#ifndef NO_RSA
+    RsaKey* key = (RsaKey*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return NULL;
+    }
+
+    return rsa_ssl_verify(env, key, signature_object);
 #else
     throwNotCompiledInException(env);
+
+    return NULL;
 #endif
+}
 
-    return result;
+JNIEXPORT jbyteArray JNICALL
+Java_com_wolfssl_wolfcrypt_Rsa_wc_1RsaSSL_1Verify_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray signature_object)
+{
+#ifndef NO_RSA
+    return rsa_ssl_verify(env, (RsaKey*)(uintptr_t)ptr, signature_object);
+#else
+    throwNotCompiledInException(env);
+
+    return NULL;
+#endif
 }
 
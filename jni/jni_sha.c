@@ -37,6 +37,7 @@
 
 /* #define WOLFCRYPT_JNI_DEBUG_ON */
 #include <wolfcrypt_jni_debug.h>
+#include <wolfcrypt_jni_log.h>
 
 #ifdef NO_OLD_WC_NAMES
     #ifndef NO_SHA
@@ -72,13 +73,10 @@ Java_com_wolfssl_wolfcrypt_Sha_mallocNativeStruct_1internal(
 #ifndef NO_SHA
     Sha* sha = NULL;
 
-    sha = (Sha*) XMALLOC(sizeof(Sha), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    sha = (Sha*)wolfCryptJniStructMalloc(sizeof(Sha));
     if (sha == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Sha object");
     }
-    else {
-        XMEMSET(sha, 0, sizeof(Sha));
-    }
 
     LogStr("new Sha() = %p\n", sha);
 
@@ -97,13 +95,10 @@ Java_com_wolfssl_wolfcrypt_Sha256_mallocNativeStruct_1internal(
 #ifndef NO_SHA256
     Sha256* sha = NULL;
 
-    sha = (Sha256*) XMALLOC(sizeof(Sha256), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    sha = (Sha256*)wolfCryptJniStructMalloc(sizeof(Sha256));
     if (sha == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Sha256 object");
     }
-    else {
-        XMEMSET(sha, 0, sizeof(Sha256));
-    }
 
     LogStr("new Sha256() = %p\n", sha);
 
@@ -122,13 +117,10 @@ Java_com_wolfssl_wolfcrypt_Sha384_mallocNativeStruct_1internal(
 #ifdef WOLFSSL_SHA384
     Sha384* sha = NULL;
 
-    sha = (Sha384*) XMALLOC(sizeof(Sha384), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    sha = (Sha384*)wolfCryptJniStructMalloc(sizeof(Sha384));
     if (sha == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Sha384 object");
     }
-    else {
-        XMEMSET(sha, 0, sizeof(Sha384));
-    }
 
     LogStr("new Sha384() = %p\n", sha);
 
@@ -147,13 +139,10 @@ Java_com_wolfssl_wolfcrypt_Sha512_mallocNativeStruct_1internal(
 #ifdef WOLFSSL_SHA512
     Sha512* sha = NULL;
 
-    sha = (Sha512*) XMALLOC(sizeof(Sha512), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    sha = (Sha512*)wolfCryptJniStructMalloc(sizeof(Sha512));
     if (sha == NULL) {
         throwOutOfMemoryException(env, "Failed to allocate Sha512 object");
     }
-    else {
-        XMEMSET(sha, 0, sizeof(Sha512));
-    }
 
     LogStr("new Sha512() = %p\n", sha);
 
@@ -165,24 +154,43 @@ Java_com_wolfssl_wolfcrypt_Sha512_mallocNativeStruct_1internal(
 #endif
 }
 
+#ifndef NO_SHA
+static void sha_init(JNIEnv* env, Sha* sha)
+{
+    int ret = 0;
+
+    ret = (!sha)
+        ? BAD_FUNC_ARG
+        : wc_InitSha(sha);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
 JNIEXPORT void JNICALL
 Java_com_wolfssl_wolfcrypt_Sha_native_1init_1internal(
     JNIEnv* env, jobject this)
 {
 #ifndef NO_SHA
-    int ret = 0;
     Sha* sha = (Sha*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    ret = (!sha)
-        ? BAD_FUNC_ARG
-        : wc_InitSha(sha);
+    sha_init(env, sha);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    if (ret != 0)
-        throwWolfCryptExceptionFromError(env, ret);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha_native_1init_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifndef NO_SHA
+    sha_init(env, (Sha*)(uintptr_t)ptr);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -221,21 +229,13 @@ JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha_native_1copy_1internal
 #endif
 }
 
-JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha_native_1update_1internal__Ljava_nio_ByteBuffer_2II(
-    JNIEnv* env, jobject this, jobject data_buffer, jint position, jint len)
-{
 #ifndef NO_SHA
+static void sha_update_buffer(JNIEnv* env, Sha* sha,
+    jobject data_buffer, jint position, jint len)
+{
     int ret = 0;
-    Sha*  sha  = NULL;
     byte* data = NULL;
 
-    sha = (Sha*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
-
     data = getDirectBufferAddress(env, data_buffer);
 
     ret = (!sha || !data)
@@ -246,68 +246,122 @@ Java_com_wolfssl_wolfcrypt_Sha_native_1update_1internal__Ljava_nio_ByteBuffer_2I
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_ShaUpdate(sha=%p, data, len) = %d\n", sha, ret);
+    LogInfo("wc_ShaUpdate(len %lld) = %lld", len, ret);
     LogStr("data[%u]: [%p]\n", (word32)len, data);
-    LogHex(data, 0, len);
-#else
-    throwNotCompiledInException(env);
-#endif
+    LogHex(data, position, len);
 }
 
-JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha_native_1update_1internal___3BII(
-    JNIEnv* env, jobject this, jbyteArray data_buffer, jint offset, jint len)
+static int sha_update_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_ShaUpdate((Sha*)ctx, chunk, chunkSz);
+}
+
+static void sha_update_array(JNIEnv* env, Sha* sha,
+    jbyteArray data_buffer, jint offset, jint len)
 {
-#ifndef NO_SHA
     int ret = 0;
-    Sha*  sha  = NULL;
     byte* data = NULL;
     word32 dataSz = 0;
 
-    sha = (Sha*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
-
-    data   = getByteArray(env, data_buffer);
     dataSz = getByteArrayLength(env, data_buffer);
 
-    if (sha == NULL || data == NULL ||
+    if (sha == NULL || data_buffer == NULL || offset < 0 || len < 0 ||
         (word32)(offset + len) > dataSz) {
         ret = BAD_FUNC_ARG;
     }
+    else if (len > WOLFCRYPTJNI_CRITICAL_MAX_SZ) {
+        /* stream large inputs instead of pinning the array */
+        ret = processByteArrayChunked(env, data_buffer, offset, NULL, 0, len,
+            sha_update_chunk, sha);
+    }
     else {
-        ret = wc_ShaUpdate(sha, data + offset, len);
+        /* no other JNI calls until the array is released */
+        data = getByteArrayCritical(env, data_buffer);
+        ret = (!data)
+            ? BAD_FUNC_ARG
+            : wc_ShaUpdate(sha, data + offset, len);
+
+        LogStr("data[%u]: [%p]\n", (word32)len, data);
+        LogHex(data, offset, len);
+
+        releaseByteArrayCritical(env, data_buffer, data, JNI_ABORT);
     }
 
+    LogStr("wc_ShaUpdate(sha=%p, data, len) = %d\n", sha, ret);
+    LogInfo("wc_ShaUpdate(len %lld) = %lld", len, ret);
+
     if (ret != 0)
         throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
 
-    LogStr("wc_ShaUpdate_fips(sha=%p, data, len) = %d\n", sha, ret);
-    LogStr("data[%u]: [%p]\n", (word32)len, data);
-    LogHex(data, offset, len);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha_native_1update_1internal__Ljava_nio_ByteBuffer_2II(
+    JNIEnv* env, jobject this, jobject data_buffer, jint position, jint len)
+{
+#ifndef NO_SHA
+    Sha* sha = (Sha*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
 
-    releaseByteArray(env, data_buffer, data, JNI_ABORT);
+    sha_update_buffer(env, sha, data_buffer, position, len);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
 JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
-    JNIEnv* env, jobject this, jobject hash_buffer, jint position)
+Java_com_wolfssl_wolfcrypt_Sha_native_1update_1internal___3BII(
+    JNIEnv* env, jobject this, jbyteArray data_buffer, jint offset, jint len)
 {
 #ifndef NO_SHA
-    int ret = 0;
-    Sha*  sha  = NULL;
-    byte* hash = NULL;
-
-    sha = (Sha*) getNativeStruct(env, this);
+    Sha* sha = (Sha*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
+    sha_update_array(env, sha, data_buffer, offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha_native_1update_1ptr__JLjava_nio_ByteBuffer_2II(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject data_buffer, jint position,
+    jint len)
+{
+#ifndef NO_SHA
+    sha_update_buffer(env, (Sha*)(uintptr_t)ptr, data_buffer,
+        position, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha_native_1update_1ptr__J_3BII(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray data_buffer, jint offset,
+    jint len)
+{
+#ifndef NO_SHA
+    sha_update_array(env, (Sha*)(uintptr_t)ptr, data_buffer,
+        offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+#ifndef NO_SHA
+static void sha_final_buffer(JNIEnv* env, Sha* sha,
+    jobject hash_buffer, jint position)
+{
+    int ret = 0;
+    byte* hash = NULL;
+
     hash = getDirectBufferAddress(env, hash_buffer);
 
     ret = (!sha || !hash)
@@ -318,8 +372,51 @@ Java_com_wolfssl_wolfcrypt_Sha_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_ShaFinal(sha=%p, hash) = %d\n", sha, ret);
+    LogInfo("wc_ShaFinal() = %lld", ret, 0);
+    LogStr("hash[%u]: [%p]\n", (word32)SHA_DIGEST_SIZE, hash);
+    LogHex(hash, position, SHA_DIGEST_SIZE);
+}
+
+static void sha_final_array(JNIEnv* env, Sha* sha,
+    jbyteArray hash_buffer)
+{
+    int ret = 0;
+    byte* hash = NULL;
+    word32 hashSz = 0;
+
+    /* get length before entering critical region, no other JNI calls
+     * are allowed until the array is released */
+    hashSz = getByteArrayLength(env, hash_buffer);
+    hash   = getByteArrayCritical(env, hash_buffer);
+
+    ret = (!sha || !hash || hashSz < SHA_DIGEST_SIZE)
+        ? BAD_FUNC_ARG
+        : wc_ShaFinal(sha, hash);
+
+    LogStr("wc_ShaFinal(sha=%p, hash) = %d\n", sha, ret);
+    LogInfo("wc_ShaFinal() = %lld", ret, 0);
     LogStr("hash[%u]: [%p]\n", (word32)SHA_DIGEST_SIZE, hash);
     LogHex(hash, 0, SHA_DIGEST_SIZE);
+
+    releaseByteArrayCritical(env, hash_buffer, hash, ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
+    JNIEnv* env, jobject this, jobject hash_buffer, jint position)
+{
+#ifndef NO_SHA
+    Sha* sha = (Sha*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    sha_final_buffer(env, sha, hash_buffer, position);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -330,53 +427,77 @@ Java_com_wolfssl_wolfcrypt_Sha_native_1final_1internal___3B(
     JNIEnv* env, jobject this, jbyteArray hash_buffer)
 {
 #ifndef NO_SHA
-    int ret = 0;
-    Sha*  sha  = NULL;
-    byte* hash = NULL;
-
-    sha = (Sha*) getNativeStruct(env, this);
+    Sha* sha = (Sha*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    hash = getByteArray(env, hash_buffer);
-
-    ret = (!sha || !hash)
-        ? BAD_FUNC_ARG
-        : wc_ShaFinal(sha, hash);
-
-    if (ret != 0)
-        throwWolfCryptExceptionFromError(env, ret);
+    sha_final_array(env, sha, hash_buffer);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    LogStr("wc_ShaFinal(sha=%p, hash) = %d\n", sha, ret);
-    LogStr("hash[%u]: [%p]\n", (word32)SHA_DIGEST_SIZE, hash);
-    LogHex(hash, 0, SHA_DIGEST_SIZE);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha_native_1final_1ptr__JLjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject hash_buffer, jint position)
+{
+#ifndef NO_SHA
+    sha_final_buffer(env, (Sha*)(uintptr_t)ptr, hash_buffer, position);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    releaseByteArray(env, hash_buffer, hash, ret);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha_native_1final_1ptr__J_3B(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray hash_buffer)
+{
+#ifndef NO_SHA
+    sha_final_array(env, (Sha*)(uintptr_t)ptr, hash_buffer);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
+#ifndef NO_SHA256
+static void sha256_init(JNIEnv* env, Sha256* sha)
+{
+    int ret = 0;
+
+    ret = (!sha)
+        ? BAD_FUNC_ARG
+        : wc_InitSha256(sha);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
 JNIEXPORT void JNICALL
 Java_com_wolfssl_wolfcrypt_Sha256_native_1init_1internal(
     JNIEnv* env, jobject this)
 {
 #ifndef NO_SHA256
-    int ret = 0;
     Sha256* sha = (Sha256*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    ret = (!sha)
-        ? BAD_FUNC_ARG
-        : wc_InitSha256(sha);
+    sha256_init(env, sha);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    if (ret != 0)
-        throwWolfCryptExceptionFromError(env, ret);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha256_native_1init_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifndef NO_SHA256
+    sha256_init(env, (Sha256*)(uintptr_t)ptr);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -415,20 +536,12 @@ JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha256_native_1copy_1internal
 #endif
 }
 
-JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha256_native_1update_1internal__Ljava_nio_ByteBuffer_2II(
-    JNIEnv* env, jobject this, jobject data_buffer, jint position, jint len)
-{
 #ifndef NO_SHA256
+static void sha256_update_buffer(JNIEnv* env, Sha256* sha,
+    jobject data_buffer, jint position, jint len)
+{
     int ret = 0;
-    Sha256* sha = NULL;
-    byte*  data = NULL;
-
-    sha = (Sha256*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
+    byte* data = NULL;
 
     data = getDirectBufferAddress(env, data_buffer);
 
@@ -440,73 +553,125 @@ Java_com_wolfssl_wolfcrypt_Sha256_native_1update_1internal__Ljava_nio_ByteBuffer
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_Sha256Update(sha=%p, data, len) = %d\n", sha, ret);
+    LogInfo("wc_Sha256Update(len %lld) = %lld", len, ret);
     LogStr("data[%u]: [%p]\n", (word32)len, data);
-    LogHex(data, 0, len);
-#else
-    throwNotCompiledInException(env);
-#endif
+    LogHex(data, position, len);
 }
 
-JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha256_native_1update_1internal___3BII(
-    JNIEnv* env, jobject this, jbyteArray data_buffer, jint offset,
-    jint len)
+static int sha256_update_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_Sha256Update((Sha256*)ctx, chunk, chunkSz);
+}
+
+static void sha256_update_array(JNIEnv* env, Sha256* sha,
+    jbyteArray data_buffer, jint offset, jint len)
 {
-#ifndef NO_SHA256
     int ret = 0;
-    Sha256* sha = NULL;
-    byte*  data = NULL;
+    byte* data = NULL;
     word32 dataSz = 0;
 
-    sha = (Sha256*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
-
-    data   = getByteArray(env, data_buffer);
     dataSz = getByteArrayLength(env, data_buffer);
 
-    if (sha == NULL || data == NULL ||
+    if (sha == NULL || data_buffer == NULL || offset < 0 || len < 0 ||
         (word32)(offset + len) > dataSz) {
         ret = BAD_FUNC_ARG;
     }
-    else {
-        ret = wc_Sha256Update(sha, data + offset, len);
+    else if (len > WOLFCRYPTJNI_CRITICAL_MAX_SZ) {
+        /* stream large inputs instead of pinning the array */
+        ret = processByteArrayChunked(env, data_buffer, offset, NULL, 0, len,
+            sha256_update_chunk, sha);
     }
+    else {
+        /* no other JNI calls until the array is released */
+        data = getByteArrayCritical(env, data_buffer);
+        ret = (!data)
+            ? BAD_FUNC_ARG
+            : wc_Sha256Update(sha, data + offset, len);
 
-    if (ret != 0) {
-        throwWolfCryptExceptionFromError(env, ret);
+        LogStr("data[%u]: [%p]\n", (word32)len, data);
+        LogHex(data, offset, len);
+
+        releaseByteArrayCritical(env, data_buffer, data, JNI_ABORT);
     }
 
     LogStr("wc_Sha256Update(sha=%p, data, len) = %d\n", sha, ret);
-    LogStr("data[%u]: [%p]\n", (word32)len, data);
-    LogHex(data, 0, len);
+    LogInfo("wc_Sha256Update(len %lld) = %lld", len, ret);
 
-    releaseByteArray(env, data_buffer, data, JNI_ABORT);
-#else
-    throwNotCompiledInException(env);
-#endif
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
 }
+#endif
 
 JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha256_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
-    JNIEnv* env, jobject this, jobject hash_buffer, jint position)
+Java_com_wolfssl_wolfcrypt_Sha256_native_1update_1internal__Ljava_nio_ByteBuffer_2II(
+    JNIEnv* env, jobject this, jobject data_buffer, jint position, jint len)
 {
 #ifndef NO_SHA256
-    int ret = 0;
-    Sha256* sha = NULL;
-    byte*  hash = NULL;
-
-    sha = (Sha256*) getNativeStruct(env, this);
+    Sha256* sha = (Sha256*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    hash = getDirectBufferAddress(env, hash_buffer);
-
-    ret = (!sha || !hash)
+    sha256_update_buffer(env, sha, data_buffer, position, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha256_native_1update_1internal___3BII(
+    JNIEnv* env, jobject this, jbyteArray data_buffer, jint offset, jint len)
+{
+#ifndef NO_SHA256
+    Sha256* sha = (Sha256*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    sha256_update_array(env, sha, data_buffer, offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha256_native_1update_1ptr__JLjava_nio_ByteBuffer_2II(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject data_buffer, jint position,
+    jint len)
+{
+#ifndef NO_SHA256
+    sha256_update_buffer(env, (Sha256*)(uintptr_t)ptr, data_buffer,
+        position, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha256_native_1update_1ptr__J_3BII(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray data_buffer, jint offset,
+    jint len)
+{
+#ifndef NO_SHA256
+    sha256_update_array(env, (Sha256*)(uintptr_t)ptr, data_buffer,
+        offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+#ifndef NO_SHA256
+static void sha256_final_buffer(JNIEnv* env, Sha256* sha,
+    jobject hash_buffer, jint position)
+{
+    int ret = 0;
+    byte* hash = NULL;
+
+    hash = getDirectBufferAddress(env, hash_buffer);
+
+    ret = (!sha || !hash)
         ? BAD_FUNC_ARG
         : wc_Sha256Final(sha, hash + position);
 
@@ -514,8 +679,51 @@ Java_com_wolfssl_wolfcrypt_Sha256_native_1final_1internal__Ljava_nio_ByteBuffer_
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_Sha256Final(sha=%p, hash) = %d\n", sha, ret);
+    LogInfo("wc_Sha256Final() = %lld", ret, 0);
+    LogStr("hash[%u]: [%p]\n", (word32)SHA256_DIGEST_SIZE, hash);
+    LogHex(hash, position, SHA256_DIGEST_SIZE);
+}
+
+static void sha256_final_array(JNIEnv* env, Sha256* sha,
+    jbyteArray hash_buffer)
+{
+    int ret = 0;
+    byte* hash = NULL;
+    word32 hashSz = 0;
+
+    /* get length before entering critical region, no other JNI calls
+     * are allowed until the array is released */
+    hashSz = getByteArrayLength(env, hash_buffer);
+    hash   = getByteArrayCritical(env, hash_buffer);
+
+    ret = (!sha || !hash || hashSz < SHA256_DIGEST_SIZE)
+        ? BAD_FUNC_ARG
+        : wc_Sha256Final(sha, hash);
+
+    LogStr("wc_Sha256Final(sha=%p, hash) = %d\n", sha, ret);
+    LogInfo("wc_Sha256Final() = %lld", ret, 0);
     LogStr("hash[%u]: [%p]\n", (word32)SHA256_DIGEST_SIZE, hash);
     LogHex(hash, 0, SHA256_DIGEST_SIZE);
+
+    releaseByteArrayCritical(env, hash_buffer, hash, ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha256_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
+    JNIEnv* env, jobject this, jobject hash_buffer, jint position)
+{
+#ifndef NO_SHA256
+    Sha256* sha = (Sha256*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    sha256_final_buffer(env, sha, hash_buffer, position);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -526,53 +734,77 @@ Java_com_wolfssl_wolfcrypt_Sha256_native_1final_1internal___3B(
     JNIEnv* env, jobject this, jbyteArray hash_buffer)
 {
 #ifndef NO_SHA256
-    int ret = 0;
-    Sha256* sha = NULL;
-    byte*  hash = NULL;
-
-    sha = (Sha256*) getNativeStruct(env, this);
+    Sha256* sha = (Sha256*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    hash = getByteArray(env, hash_buffer);
-
-    ret = (!sha || !hash)
-        ? BAD_FUNC_ARG
-        : wc_Sha256Final(sha, hash);
-
-    if (ret != 0)
-        throwWolfCryptExceptionFromError(env, ret);
+    sha256_final_array(env, sha, hash_buffer);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    LogStr("wc_Sha256Final(sha=%p, hash) = %d\n", sha, ret);
-    LogStr("hash[%u]: [%p]\n", (word32)SHA256_DIGEST_SIZE, hash);
-    LogHex(hash, 0, SHA256_DIGEST_SIZE);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha256_native_1final_1ptr__JLjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject hash_buffer, jint position)
+{
+#ifndef NO_SHA256
+    sha256_final_buffer(env, (Sha256*)(uintptr_t)ptr, hash_buffer, position);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    releaseByteArray(env, hash_buffer, hash, ret);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha256_native_1final_1ptr__J_3B(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray hash_buffer)
+{
+#ifndef NO_SHA256
+    sha256_final_array(env, (Sha256*)(uintptr_t)ptr, hash_buffer);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
+#ifdef WOLFSSL_SHA384
+static void sha384_init(JNIEnv* env, Sha384* sha)
+{
+    int ret = 0;
+
+    ret = (!sha)
+        ? BAD_FUNC_ARG
+        : wc_InitSha384(sha);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
 JNIEXPORT void JNICALL
 Java_com_wolfssl_wolfcrypt_Sha384_native_1init_1internal(
     JNIEnv* env, jobject this)
 {
 #ifdef WOLFSSL_SHA384
-    int ret = 0;
     Sha384* sha = (Sha384*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    ret = (!sha)
-        ? BAD_FUNC_ARG
-        : wc_InitSha384(sha);
+    sha384_init(env, sha);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    if (ret != 0)
-        throwWolfCryptExceptionFromError(env, ret);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha384_native_1init_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifdef WOLFSSL_SHA384
+    sha384_init(env, (Sha384*)(uintptr_t)ptr);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -611,20 +843,12 @@ JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha384_native_1copy_1internal
 #endif
 }
 
-JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha384_native_1update_1internal__Ljava_nio_ByteBuffer_2II(
-    JNIEnv* env, jobject this, jobject data_buffer, jint position, jint len)
-{
 #ifdef WOLFSSL_SHA384
+static void sha384_update_buffer(JNIEnv* env, Sha384* sha,
+    jobject data_buffer, jint position, jint len)
+{
     int ret = 0;
-    Sha384* sha = NULL;
-    byte*  data = NULL;
-
-    sha = (Sha384*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
+    byte* data = NULL;
 
     data = getDirectBufferAddress(env, data_buffer);
 
@@ -636,69 +860,122 @@ Java_com_wolfssl_wolfcrypt_Sha384_native_1update_1internal__Ljava_nio_ByteBuffer
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_Sha384Update(sha=%p, data, len) = %d\n", sha, ret);
+    LogInfo("wc_Sha384Update(len %lld) = %lld", len, ret);
     LogStr("data[%u]: [%p]\n", (word32)len, data);
-    LogHex(data, 0, len);
-#else
-    throwNotCompiledInException(env);
-#endif
+    LogHex(data, position, len);
 }
 
-JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha384_native_1update_1internal___3BII(
-    JNIEnv* env, jobject this, jbyteArray data_buffer, jint offset, jint len)
+static int sha384_update_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_Sha384Update((Sha384*)ctx, chunk, chunkSz);
+}
+
+static void sha384_update_array(JNIEnv* env, Sha384* sha,
+    jbyteArray data_buffer, jint offset, jint len)
 {
-#ifdef WOLFSSL_SHA384
     int ret = 0;
-    Sha384* sha = NULL;
-    byte*  data = NULL;
+    byte* data = NULL;
     word32 dataSz = 0;
 
-    sha = (Sha384*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
-
-    data   = getByteArray(env, data_buffer);
     dataSz = getByteArrayLength(env, data_buffer);
 
-    if (sha == NULL || data == NULL ||
+    if (sha == NULL || data_buffer == NULL || offset < 0 || len < 0 ||
         (word32)(offset + len) > dataSz) {
         ret = BAD_FUNC_ARG;
     }
-    else {
-        ret = wc_Sha384Update(sha, data + offset, len);
+    else if (len > WOLFCRYPTJNI_CRITICAL_MAX_SZ) {
+        /* stream large inputs instead of pinning the array */
+        ret = processByteArrayChunked(env, data_buffer, offset, NULL, 0, len,
+            sha384_update_chunk, sha);
     }
+    else {
+        /* no other JNI calls until the array is released */
+        data = getByteArrayCritical(env, data_buffer);
+        ret = (!data)
+            ? BAD_FUNC_ARG
+            : wc_Sha384Update(sha, data + offset, len);
 
-    if (ret != 0) {
-        throwWolfCryptExceptionFromError(env, ret);
+        LogStr("data[%u]: [%p]\n", (word32)len, data);
+        LogHex(data, offset, len);
+
+        releaseByteArrayCritical(env, data_buffer, data, JNI_ABORT);
     }
 
     LogStr("wc_Sha384Update(sha=%p, data, len) = %d\n", sha, ret);
-    LogStr("data[%u]: [%p]\n", (word32)len, data + offset);
-    LogHex(data, offset, len);
+    LogInfo("wc_Sha384Update(len %lld) = %lld", len, ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
 
-    releaseByteArray(env, data_buffer, data, JNI_ABORT);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha384_native_1update_1internal__Ljava_nio_ByteBuffer_2II(
+    JNIEnv* env, jobject this, jobject data_buffer, jint position, jint len)
+{
+#ifdef WOLFSSL_SHA384
+    Sha384* sha = (Sha384*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    sha384_update_buffer(env, sha, data_buffer, position, len);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
 JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha384_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
-    JNIEnv* env, jobject this, jobject hash_buffer, jint position)
+Java_com_wolfssl_wolfcrypt_Sha384_native_1update_1internal___3BII(
+    JNIEnv* env, jobject this, jbyteArray data_buffer, jint offset, jint len)
 {
 #ifdef WOLFSSL_SHA384
-    int ret = 0;
-    Sha384* sha = NULL;
-    byte*  hash = NULL;
-
-    sha = (Sha384*) getNativeStruct(env, this);
+    Sha384* sha = (Sha384*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
+    sha384_update_array(env, sha, data_buffer, offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha384_native_1update_1ptr__JLjava_nio_ByteBuffer_2II(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject data_buffer, jint position,
+    jint len)
+{
+#ifdef WOLFSSL_SHA384
+    sha384_update_buffer(env, (Sha384*)(uintptr_t)ptr, data_buffer,
+        position, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha384_native_1update_1ptr__J_3BII(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray data_buffer, jint offset,
+    jint len)
+{
+#ifdef WOLFSSL_SHA384
+    sha384_update_array(env, (Sha384*)(uintptr_t)ptr, data_buffer,
+        offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+#ifdef WOLFSSL_SHA384
+static void sha384_final_buffer(JNIEnv* env, Sha384* sha,
+    jobject hash_buffer, jint position)
+{
+    int ret = 0;
+    byte* hash = NULL;
+
     hash = getDirectBufferAddress(env, hash_buffer);
 
     ret = (!sha || !hash)
@@ -709,8 +986,51 @@ Java_com_wolfssl_wolfcrypt_Sha384_native_1final_1internal__Ljava_nio_ByteBuffer_
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_Sha384Final(sha=%p, hash) = %d\n", sha, ret);
+    LogInfo("wc_Sha384Final() = %lld", ret, 0);
+    LogStr("hash[%u]: [%p]\n", (word32)SHA384_DIGEST_SIZE, hash);
+    LogHex(hash, position, SHA384_DIGEST_SIZE);
+}
+
+static void sha384_final_array(JNIEnv* env, Sha384* sha,
+    jbyteArray hash_buffer)
+{
+    int ret = 0;
+    byte* hash = NULL;
+    word32 hashSz = 0;
+
+    /* get length before entering critical region, no other JNI calls
+     * are allowed until the array is released */
+    hashSz = getByteArrayLength(env, hash_buffer);
+    hash   = getByteArrayCritical(env, hash_buffer);
+
+    ret = (!sha || !hash || hashSz < SHA384_DIGEST_SIZE)
+        ? BAD_FUNC_ARG
+        : wc_Sha384Final(sha, hash);
+
+    LogStr("wc_Sha384Final(sha=%p, hash) = %d\n", sha, ret);
+    LogInfo("wc_Sha384Final() = %lld", ret, 0);
     LogStr("hash[%u]: [%p]\n", (word32)SHA384_DIGEST_SIZE, hash);
     LogHex(hash, 0, SHA384_DIGEST_SIZE);
+
+    releaseByteArrayCritical(env, hash_buffer, hash, ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha384_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
+    JNIEnv* env, jobject this, jobject hash_buffer, jint position)
+{
+#ifdef WOLFSSL_SHA384
+    Sha384* sha = (Sha384*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    sha384_final_buffer(env, sha, hash_buffer, position);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -721,53 +1041,77 @@ Java_com_wolfssl_wolfcrypt_Sha384_native_1final_1internal___3B(
     JNIEnv* env, jobject this, jbyteArray hash_buffer)
 {
 #ifdef WOLFSSL_SHA384
-    int ret = 0;
-    Sha384* sha = NULL;
-    byte*  hash = NULL;
-
-    sha = (Sha384*) getNativeStruct(env, this);
+    Sha384* sha = (Sha384*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    hash = getByteArray(env, hash_buffer);
-
-    ret = (!sha || !hash)
-        ? BAD_FUNC_ARG
-        : wc_Sha384Final(sha, hash);
-
-    if (ret != 0)
-        throwWolfCryptExceptionFromError(env, ret);
+    sha384_final_array(env, sha, hash_buffer);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    LogStr("wc_Sha384Final(sha=%p, hash) = %d\n", sha, ret);
-    LogStr("hash[%u]: [%p]\n", (word32)SHA384_DIGEST_SIZE, hash);
-    LogHex(hash, 0, SHA384_DIGEST_SIZE);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha384_native_1final_1ptr__JLjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject hash_buffer, jint position)
+{
+#ifdef WOLFSSL_SHA384
+    sha384_final_buffer(env, (Sha384*)(uintptr_t)ptr, hash_buffer, position);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    releaseByteArray(env, hash_buffer, hash, ret);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha384_native_1final_1ptr__J_3B(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray hash_buffer)
+{
+#ifdef WOLFSSL_SHA384
+    sha384_final_array(env, (Sha384*)(uintptr_t)ptr, hash_buffer);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
+#ifdef WOLFSSL_SHA512
+static void sha512_init(JNIEnv* env, Sha512* sha)
+{
+    int ret = 0;
+
+    ret = (!sha)
+        ? BAD_FUNC_ARG
+        : wc_InitSha512(sha);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
 JNIEXPORT void JNICALL
 Java_com_wolfssl_wolfcrypt_Sha512_native_1init_1internal(
     JNIEnv* env, jobject this)
 {
 #ifdef WOLFSSL_SHA512
-    int ret = 0;
     Sha512* sha = (Sha512*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    ret = (!sha)
-        ? BAD_FUNC_ARG
-        : wc_InitSha512(sha);
+    sha512_init(env, sha);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    if (ret != 0)
-        throwWolfCryptExceptionFromError(env, ret);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha512_native_1init_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr)
+{
+#ifdef WOLFSSL_SHA512
+    sha512_init(env, (Sha512*)(uintptr_t)ptr);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -806,20 +1150,12 @@ JNIEXPORT void JNICALL Java_com_wolfssl_wolfcrypt_Sha512_native_1copy_1internal
 #endif
 }
 
-JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha512_native_1update_1internal__Ljava_nio_ByteBuffer_2II(
-    JNIEnv* env, jobject this, jobject data_buffer, jint position, jint len)
-{
 #ifdef WOLFSSL_SHA512
+static void sha512_update_buffer(JNIEnv* env, Sha512* sha,
+    jobject data_buffer, jint position, jint len)
+{
     int ret = 0;
-    Sha512* sha = NULL;
-    byte*  data = NULL;
-
-    sha = (Sha512*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
+    byte* data = NULL;
 
     data = getDirectBufferAddress(env, data_buffer);
 
@@ -831,70 +1167,122 @@ Java_com_wolfssl_wolfcrypt_Sha512_native_1update_1internal__Ljava_nio_ByteBuffer
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_Sha512Update(sha=%p, data, len) = %d\n", sha, ret);
+    LogInfo("wc_Sha512Update(len %lld) = %lld", len, ret);
     LogStr("data[%u]: [%p]\n", (word32)len, data);
-    LogHex(data, 0, len);
-#else
-    throwNotCompiledInException(env);
-#endif
+    LogHex(data, position, len);
 }
 
-JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha512_native_1update_1internal___3BII(
-    JNIEnv* env, jobject this, jbyteArray data_buffer, jint offset,
-    jint len)
+static int sha512_update_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    return wc_Sha512Update((Sha512*)ctx, chunk, chunkSz);
+}
+
+static void sha512_update_array(JNIEnv* env, Sha512* sha,
+    jbyteArray data_buffer, jint offset, jint len)
 {
-#ifdef WOLFSSL_SHA512
     int ret = 0;
-    Sha512* sha = NULL;
-    byte*  data = NULL;
+    byte* data = NULL;
     word32 dataSz = 0;
 
-    sha = (Sha512*) getNativeStruct(env, this);
-    if ((*env)->ExceptionOccurred(env)) {
-        /* getNativeStruct may throw exception, prevent throwing another */
-        return;
-    }
-
-    data   = getByteArray(env, data_buffer);
     dataSz = getByteArrayLength(env, data_buffer);
 
-    if (sha == NULL || data == NULL ||
+    if (sha == NULL || data_buffer == NULL || offset < 0 || len < 0 ||
         (word32)(offset + len) > dataSz) {
         ret = BAD_FUNC_ARG;
     }
-    else {
-        ret = wc_Sha512Update(sha, data + offset, len);
+    else if (len > WOLFCRYPTJNI_CRITICAL_MAX_SZ) {
+        /* stream large inputs instead of pinning the array */
+        ret = processByteArrayChunked(env, data_buffer, offset, NULL, 0, len,
+            sha512_update_chunk, sha);
     }
+    else {
+        /* no other JNI calls until the array is released */
+        data = getByteArrayCritical(env, data_buffer);
+        ret = (!data)
+            ? BAD_FUNC_ARG
+            : wc_Sha512Update(sha, data + offset, len);
 
-    if (ret != 0) {
-        throwWolfCryptExceptionFromError(env, ret);
+        LogStr("data[%u]: [%p]\n", (word32)len, data);
+        LogHex(data, offset, len);
+
+        releaseByteArrayCritical(env, data_buffer, data, JNI_ABORT);
     }
 
     LogStr("wc_Sha512Update(sha=%p, data, len) = %d\n", sha, ret);
-    LogStr("data[%u]: [%p]\n", (word32)len, data + offset);
-    LogHex(data, offset, len);
+    LogInfo("wc_Sha512Update(len %lld) = %lld", len, ret);
 
-    releaseByteArray(env, data_buffer, data, JNI_ABORT);
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha512_native_1update_1internal__Ljava_nio_ByteBuffer_2II(
+    JNIEnv* env, jobject this, jobject data_buffer, jint position, jint len)
+{
+#ifdef WOLFSSL_SHA512
+    Sha512* sha = (Sha512*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    sha512_update_buffer(env, sha, data_buffer, position, len);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
 JNIEXPORT void JNICALL
-Java_com_wolfssl_wolfcrypt_Sha512_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
-    JNIEnv* env, jobject this, jobject hash_buffer, jint position)
+Java_com_wolfssl_wolfcrypt_Sha512_native_1update_1internal___3BII(
+    JNIEnv* env, jobject this, jbyteArray data_buffer, jint offset, jint len)
 {
 #ifdef WOLFSSL_SHA512
-    int ret = 0;
-    Sha512* sha = NULL;
-    byte*  hash = NULL;
-
-    sha = (Sha512*) getNativeStruct(env, this);
+    Sha512* sha = (Sha512*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
+    sha512_update_array(env, sha, data_buffer, offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha512_native_1update_1ptr__JLjava_nio_ByteBuffer_2II(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject data_buffer, jint position,
+    jint len)
+{
+#ifdef WOLFSSL_SHA512
+    sha512_update_buffer(env, (Sha512*)(uintptr_t)ptr, data_buffer,
+        position, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha512_native_1update_1ptr__J_3BII(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray data_buffer, jint offset,
+    jint len)
+{
+#ifdef WOLFSSL_SHA512
+    sha512_update_array(env, (Sha512*)(uintptr_t)ptr, data_buffer,
+        offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+#ifdef WOLFSSL_SHA512
+static void sha512_final_buffer(JNIEnv* env, Sha512* sha,
+    jobject hash_buffer, jint position)
+{
+    int ret = 0;
+    byte* hash = NULL;
+
     hash = getDirectBufferAddress(env, hash_buffer);
 
     ret = (!sha || !hash)
@@ -905,8 +1293,51 @@ Java_com_wolfssl_wolfcrypt_Sha512_native_1final_1internal__Ljava_nio_ByteBuffer_
         throwWolfCryptExceptionFromError(env, ret);
 
     LogStr("wc_Sha512Final(sha=%p, hash) = %d\n", sha, ret);
+    LogInfo("wc_Sha512Final() = %lld", ret, 0);
+    LogStr("hash[%u]: [%p]\n", (word32)SHA512_DIGEST_SIZE, hash);
+    LogHex(hash, position, SHA512_DIGEST_SIZE);
+}
+
+static void sha512_final_array(JNIEnv* env, Sha512* sha,
+    jbyteArray hash_buffer)
+{
+    int ret = 0;
+    byte* hash = NULL;
+    word32 hashSz = 0;
+
+    /* get length before entering critical region, no other JNI calls
+     * are allowed until the array is released */
+    hashSz = getByteArrayLength(env, hash_buffer);
+    hash   = getByteArrayCritical(env, hash_buffer);
+
+    ret = (!sha || !hash || hashSz < SHA512_DIGEST_SIZE)
+        ? BAD_FUNC_ARG
+        : wc_Sha512Final(sha, hash);
+
+    LogStr("wc_Sha512Final(sha=%p, hash) = %d\n", sha, ret);
+    LogInfo("wc_Sha512Final() = %lld", ret, 0);
     LogStr("hash[%u]: [%p]\n", (word32)SHA512_DIGEST_SIZE, hash);
     LogHex(hash, 0, SHA512_DIGEST_SIZE);
+
+    releaseByteArrayCritical(env, hash_buffer, hash, ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha512_native_1final_1internal__Ljava_nio_ByteBuffer_2I(
+    JNIEnv* env, jobject this, jobject hash_buffer, jint position)
+{
+#ifdef WOLFSSL_SHA512
+    Sha512* sha = (Sha512*) getNativeStruct(env, this);
+    if ((*env)->ExceptionOccurred(env)) {
+        /* getNativeStruct may throw exception, prevent throwing another */
+        return;
+    }
+
+    sha512_final_buffer(env, sha, hash_buffer, position);
 #else
     throwNotCompiledInException(env);
 #endif
@@ -917,32 +1348,36 @@ Java_com_wolfssl_wolfcrypt_Sha512_native_1final_1internal___3B(
     JNIEnv* env, jobject this, jbyteArray hash_buffer)
 {
 #ifdef WOLFSSL_SHA512
-    int ret = 0;
-    Sha512* sha = NULL;
-    byte*  hash = NULL;
-
-    sha = (Sha512*) getNativeStruct(env, this);
+    Sha512* sha = (Sha512*) getNativeStruct(env, this);
     if ((*env)->ExceptionOccurred(env)) {
         /* getNativeStruct may throw exception, prevent throwing another */
         return;
     }
 
-    hash = getByteArray(env, hash_buffer);
-
-    ret = (!sha || !hash)
-        ? BAD_FUNC_ARG
-        : wc_Sha512Final(sha, hash);
-
-    if (ret != 0)
-        throwWolfCryptExceptionFromError(env, ret);
-
-    LogStr("wc_Sha512Final(sha=%p, hash) = %d\n", sha, ret);
-    LogStr("hash[%u]: [%p]\n", (word32)SHA512_DIGEST_SIZE, hash);
-    LogHex(hash, 0, SHA512_DIGEST_SIZE);
+    sha512_final_array(env, sha, hash_buffer);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
 
-    releaseByteArray(env, hash_buffer, hash, ret);
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha512_native_1final_1ptr__JLjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jlong ptr, jobject hash_buffer, jint position)
+{
+#ifdef WOLFSSL_SHA512
+    sha512_final_buffer(env, (Sha512*)(uintptr_t)ptr, hash_buffer, position);
 #else
     throwNotCompiledInException(env);
 #endif
 }
 
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha512_native_1final_1ptr__J_3B(
+    JNIEnv* env, jclass jcl, jlong ptr, jbyteArray hash_buffer)
+{
+#ifdef WOLFSSL_SHA512
+    sha512_final_array(env, (Sha512*)(uintptr_t)ptr, hash_buffer);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
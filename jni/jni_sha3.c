@@ -0,0 +1,697 @@
+/* jni_sha3.c
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <stdint.h>
+
+#ifdef WOLFSSL_USER_SETTINGS
+    #include <wolfssl/wolfcrypt/settings.h>
+#elif !defined(__ANDROID__)
+    #include <wolfssl/options.h>
+#endif
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include <wolfssl/wolfcrypt/sha3.h>
+#include <wolfssl/wolfcrypt/misc.h>
+
+#include <com_wolfssl_wolfcrypt_Sha3.h>
+#include <com_wolfssl_wolfcrypt_Shake.h>
+#include <wolfcrypt_jni_NativeStruct.h>
+#include <wolfcrypt_jni_error.h>
+#include <wolfcrypt_jni_hash.h>
+
+/* #define WOLFCRYPT_JNI_DEBUG_ON */
+#include <wolfcrypt_jni_debug.h>
+#include <wolfcrypt_jni_log.h>
+
+/* Sha3 and Shake objects share one native struct type, the variant is
+ * passed down from Java on every call as its bit size: 224, 256, 384 or
+ * 512 for SHA-3, 128 or 256 for SHAKE. */
+
+#ifdef WOLFSSL_SHA3
+static int sha3_init(wc_Sha3* sha, int type)
+{
+    switch (type) {
+    #ifndef WOLFSSL_NOSHA3_224
+        case 224:
+            return wc_InitSha3_224(sha, NULL, INVALID_DEVID);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_256
+        case 256:
+            return wc_InitSha3_256(sha, NULL, INVALID_DEVID);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_384
+        case 384:
+            return wc_InitSha3_384(sha, NULL, INVALID_DEVID);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_512
+        case 512:
+            return wc_InitSha3_512(sha, NULL, INVALID_DEVID);
+    #endif
+        default:
+            return NOT_COMPILED_IN;
+    }
+}
+
+static int sha3_update(wc_Sha3* sha, int type, const byte* data, word32 len)
+{
+    switch (type) {
+    #ifndef WOLFSSL_NOSHA3_224
+        case 224:
+            return wc_Sha3_224_Update(sha, data, len);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_256
+        case 256:
+            return wc_Sha3_256_Update(sha, data, len);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_384
+        case 384:
+            return wc_Sha3_384_Update(sha, data, len);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_512
+        case 512:
+            return wc_Sha3_512_Update(sha, data, len);
+    #endif
+        default:
+            return NOT_COMPILED_IN;
+    }
+}
+
+static int sha3_final(wc_Sha3* sha, int type, byte* hash)
+{
+    switch (type) {
+    #ifndef WOLFSSL_NOSHA3_224
+        case 224:
+            return wc_Sha3_224_Final(sha, hash);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_256
+        case 256:
+            return wc_Sha3_256_Final(sha, hash);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_384
+        case 384:
+            return wc_Sha3_384_Final(sha, hash);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_512
+        case 512:
+            return wc_Sha3_512_Final(sha, hash);
+    #endif
+        default:
+            return NOT_COMPILED_IN;
+    }
+}
+
+static int sha3_copy(wc_Sha3* src, wc_Sha3* dst, int type)
+{
+    switch (type) {
+    #ifndef WOLFSSL_NOSHA3_224
+        case 224:
+            return wc_Sha3_224_Copy(src, dst);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_256
+        case 256:
+            return wc_Sha3_256_Copy(src, dst);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_384
+        case 384:
+            return wc_Sha3_384_Copy(src, dst);
+    #endif
+    #ifndef WOLFSSL_NOSHA3_512
+        case 512:
+            return wc_Sha3_512_Copy(src, dst);
+    #endif
+        default:
+            return NOT_COMPILED_IN;
+    }
+}
+
+static enum wc_HashType sha3_hash_type(int type)
+{
+    switch (type) {
+        case 224:
+            return WC_HASH_TYPE_SHA3_224;
+        case 256:
+            return WC_HASH_TYPE_SHA3_256;
+        case 384:
+            return WC_HASH_TYPE_SHA3_384;
+        case 512:
+            return WC_HASH_TYPE_SHA3_512;
+        default:
+            return WC_HASH_TYPE_NONE;
+    }
+}
+#endif /* WOLFSSL_SHA3 */
+
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+static int shake_init(wc_Shake* shake, int type)
+{
+    switch (type) {
+    #ifdef WOLFSSL_SHAKE128
+        case 128:
+            return wc_InitShake128(shake, NULL, INVALID_DEVID);
+    #endif
+    #ifdef WOLFSSL_SHAKE256
+        case 256:
+            return wc_InitShake256(shake, NULL, INVALID_DEVID);
+    #endif
+        default:
+            return NOT_COMPILED_IN;
+    }
+}
+
+static int shake_update(wc_Shake* shake, int type, const byte* data,
+    word32 len)
+{
+    switch (type) {
+    #ifdef WOLFSSL_SHAKE128
+        case 128:
+            return wc_Shake128_Update(shake, data, len);
+    #endif
+    #ifdef WOLFSSL_SHAKE256
+        case 256:
+            return wc_Shake256_Update(shake, data, len);
+    #endif
+        default:
+            return NOT_COMPILED_IN;
+    }
+}
+
+static int shake_final(wc_Shake* shake, int type, byte* out, word32 outSz)
+{
+    switch (type) {
+    #ifdef WOLFSSL_SHAKE128
+        case 128:
+            return wc_Shake128_Final(shake, out, outSz);
+    #endif
+    #ifdef WOLFSSL_SHAKE256
+        case 256:
+            return wc_Shake256_Final(shake, out, outSz);
+    #endif
+        default:
+            return NOT_COMPILED_IN;
+    }
+}
+
+static int shake_copy(wc_Shake* src, wc_Shake* dst, int type)
+{
+    switch (type) {
+    #ifdef WOLFSSL_SHAKE128
+        case 128:
+            return wc_Shake128_Copy(src, dst);
+    #endif
+    #ifdef WOLFSSL_SHAKE256
+        case 256:
+            return wc_Shake256_Copy(src, dst);
+    #endif
+        default:
+            return NOT_COMPILED_IN;
+    }
+}
+
+static void shake_free(wc_Shake* shake, int type)
+{
+    switch (type) {
+    #ifdef WOLFSSL_SHAKE128
+        case 128:
+            wc_Shake128_Free(shake);
+            break;
+    #endif
+    #ifdef WOLFSSL_SHAKE256
+        case 256:
+            wc_Shake256_Free(shake);
+            break;
+    #endif
+        default:
+            break;
+    }
+}
+#define HAVE_SHAKE_JNI
+#endif
+
+#if defined(WOLFSSL_SHA3) || defined(HAVE_SHAKE_JNI)
+/* Variant specific update function, SHA-3 and SHAKE share the Keccak
+ * struct so the generic helpers below serve both */
+typedef int (*Sha3UpdateFn)(wc_Sha3* sha, int type, const byte* data,
+    word32 len);
+
+typedef struct Sha3ChunkCtx {
+    wc_Sha3* sha;
+    int type;
+    Sha3UpdateFn update;
+} Sha3ChunkCtx;
+
+static int sha3_update_chunk(void* ctx, byte* chunk, word32 chunkSz)
+{
+    Sha3ChunkCtx* c = (Sha3ChunkCtx*)ctx;
+
+    return c->update(c->sha, c->type, chunk, chunkSz);
+}
+
+static void keccak_update_buffer(JNIEnv* env, wc_Sha3* sha, int type,
+    Sha3UpdateFn update, jobject data_buffer, jint position, jint len)
+{
+    int ret = 0;
+    byte* data = NULL;
+
+    data = getDirectBufferAddress(env, data_buffer);
+
+    if (sha == NULL || data == NULL || position < 0 || len < 0 ||
+        (word32)(position + len) > getDirectBufferLimit(env, data_buffer)) {
+        ret = BAD_FUNC_ARG;
+    }
+    else {
+        ret = update(sha, type, data + position, len);
+    }
+
+    LogStr("wc_Sha3/Shake Update(sha=%p, type=%d, len=%d) = %d\n", sha, type,
+        len, ret);
+    LogInfo("wc_Sha3_%lld_Update() len %lld", type, len);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+
+static void keccak_update_array(JNIEnv* env, wc_Sha3* sha, int type,
+    Sha3UpdateFn update, jbyteArray data_buffer, jint offset, jint len)
+{
+    int ret = 0;
+    byte* data = NULL;
+    word32 dataSz = 0;
+    Sha3ChunkCtx ctx;
+
+    dataSz = getByteArrayLength(env, data_buffer);
+
+    if (sha == NULL || data_buffer == NULL || offset < 0 || len < 0 ||
+        (word32)(offset + len) > dataSz) {
+        ret = BAD_FUNC_ARG;
+    }
+    else if (len > WOLFCRYPTJNI_CRITICAL_MAX_SZ) {
+        /* stream large inputs instead of pinning the array */
+        ctx.sha = sha;
+        ctx.type = type;
+        ctx.update = update;
+        ret = processByteArrayChunked(env, data_buffer, offset, NULL, 0, len,
+            sha3_update_chunk, &ctx);
+    }
+    else {
+        /* no other JNI calls until the array is released */
+        data = getByteArrayCritical(env, data_buffer);
+        ret = (!data)
+            ? BAD_FUNC_ARG
+            : update(sha, type, data + offset, len);
+
+        releaseByteArrayCritical(env, data_buffer, data, JNI_ABORT);
+    }
+
+    LogStr("wc_Sha3/Shake Update(sha=%p, type=%d, len=%d) = %d\n", sha, type,
+        len, ret);
+    LogInfo("wc_Sha3_%lld_Update() len %lld", type, len);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+}
+#endif
+
+JNIEXPORT jlong JNICALL
+Java_com_wolfssl_wolfcrypt_Sha3_mallocNativeStruct_1internal(
+    JNIEnv* env, jobject this)
+{
+#ifdef WOLFSSL_SHA3
+    wc_Sha3* sha = NULL;
+
+    sha = (wc_Sha3*)wolfCryptJniStructMalloc(sizeof(wc_Sha3));
+    if (sha == NULL) {
+        throwOutOfMemoryException(env, "Failed to allocate Sha3 object");
+    }
+
+    LogStr("new Sha3() = %p\n", sha);
+
+    return (jlong)(uintptr_t)sha;
+#else
+    throwNotCompiledInException(env);
+
+    return (jlong)0;
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha3_native_1init_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jint type)
+{
+#ifdef WOLFSSL_SHA3
+    wc_Sha3* sha = (wc_Sha3*)(uintptr_t)ptr;
+    int ret = (!sha) ? BAD_FUNC_ARG : sha3_init(sha, type);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha3_native_1copy_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jlong fromPtr, jint type)
+{
+#ifdef WOLFSSL_SHA3
+    wc_Sha3* sha = (wc_Sha3*)(uintptr_t)ptr;
+    wc_Sha3* tbc = (wc_Sha3*)(uintptr_t)fromPtr; /* tbc = to be copied */
+    int ret = (!sha || !tbc) ? BAD_FUNC_ARG : sha3_copy(tbc, sha, type);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha3_native_1update_1ptr__JILjava_nio_ByteBuffer_2II(
+    JNIEnv* env, jclass jcl, jlong ptr, jint type, jobject data_buffer,
+    jint position, jint len)
+{
+#ifdef WOLFSSL_SHA3
+    keccak_update_buffer(env, (wc_Sha3*)(uintptr_t)ptr, type, sha3_update,
+        data_buffer, position, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha3_native_1update_1ptr__JI_3BII(
+    JNIEnv* env, jclass jcl, jlong ptr, jint type, jbyteArray data_buffer,
+    jint offset, jint len)
+{
+#ifdef WOLFSSL_SHA3
+    keccak_update_array(env, (wc_Sha3*)(uintptr_t)ptr, type, sha3_update,
+        data_buffer, offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha3_native_1final_1ptr__JILjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jlong ptr, jint type, jobject hash_buffer,
+    jint position)
+{
+#ifdef WOLFSSL_SHA3
+    int ret = 0;
+    wc_Sha3* sha = (wc_Sha3*)(uintptr_t)ptr;
+    byte* hash = getDirectBufferAddress(env, hash_buffer);
+
+    if (sha == NULL || hash == NULL || position < 0 ||
+        (word32)position + (word32)(type / 8) >
+            getDirectBufferLimit(env, hash_buffer)) {
+        ret = BAD_FUNC_ARG;
+    }
+    else {
+        ret = sha3_final(sha, type, hash + position);
+    }
+
+    LogStr("wc_Sha3_%d_Final(sha=%p, hash) = %d\n", type, sha, ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha3_native_1final_1ptr__JI_3B(
+    JNIEnv* env, jclass jcl, jlong ptr, jint type, jbyteArray hash_buffer)
+{
+#ifdef WOLFSSL_SHA3
+    int ret = 0;
+    wc_Sha3* sha = (wc_Sha3*)(uintptr_t)ptr;
+    byte* hash = NULL;
+    word32 hashSz = 0;
+
+    /* get length before entering critical region, no other JNI calls
+     * are allowed until the array is released */
+    hashSz = getByteArrayLength(env, hash_buffer);
+    hash   = getByteArrayCritical(env, hash_buffer);
+
+    ret = (!sha || !hash || hashSz < (word32)(type / 8))
+        ? BAD_FUNC_ARG
+        : sha3_final(sha, type, hash);
+
+    LogStr("wc_Sha3_%d_Final(sha=%p, hash) = %d\n", type, sha, ret);
+
+    releaseByteArrayCritical(env, hash_buffer, hash, ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha3_native_1hash__ILjava_nio_ByteBuffer_2IILjava_nio_ByteBuffer_2I(
+    JNIEnv* env, jclass jcl, jint type, jobject data_buffer, jint position,
+    jint len, jobject hash_buffer, jint hashPosition)
+{
+#ifdef WOLFSSL_SHA3
+    int ret = wolfCryptJniHashBuffer(env, sha3_hash_type(type), data_buffer,
+        position, len, hash_buffer, hashPosition);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Sha3_native_1hash__I_3BII_3BI(
+    JNIEnv* env, jclass jcl, jint type, jbyteArray data_buffer, jint offset,
+    jint len, jbyteArray hash_buffer, jint hashOffset)
+{
+#ifdef WOLFSSL_SHA3
+    int ret = wolfCryptJniHashArray(env, sha3_hash_type(type), data_buffer,
+        offset, len, hash_buffer, hashOffset);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_wolfssl_wolfcrypt_Shake_mallocNativeStruct_1internal(
+    JNIEnv* env, jobject this)
+{
+#ifdef HAVE_SHAKE_JNI
+    wc_Shake* shake = NULL;
+
+    shake = (wc_Shake*)wolfCryptJniStructMalloc(sizeof(wc_Shake));
+    if (shake == NULL) {
+        throwOutOfMemoryException(env, "Failed to allocate Shake object");
+    }
+
+    LogStr("new Shake() = %p\n", shake);
+
+    return (jlong)(uintptr_t)shake;
+#else
+    throwNotCompiledInException(env);
+
+    return (jlong)0;
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Shake_native_1init_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jint type)
+{
+#ifdef HAVE_SHAKE_JNI
+    wc_Shake* shake = (wc_Shake*)(uintptr_t)ptr;
+    int ret = (!shake) ? BAD_FUNC_ARG : shake_init(shake, type);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Shake_native_1copy_1ptr(
+    JNIEnv* env, jclass jcl, jlong ptr, jlong fromPtr, jint type)
+{
+#ifdef HAVE_SHAKE_JNI
+    wc_Shake* shake = (wc_Shake*)(uintptr_t)ptr;
+    wc_Shake* tbc = (wc_Shake*)(uintptr_t)fromPtr; /* tbc = to be copied */
+    int ret = (!shake || !tbc) ? BAD_FUNC_ARG : shake_copy(tbc, shake, type);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Shake_native_1update_1ptr__JILjava_nio_ByteBuffer_2II(
+    JNIEnv* env, jclass jcl, jlong ptr, jint type, jobject data_buffer,
+    jint position, jint len)
+{
+#ifdef HAVE_SHAKE_JNI
+    keccak_update_buffer(env, (wc_Shake*)(uintptr_t)ptr, type, shake_update,
+        data_buffer, position, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Shake_native_1update_1ptr__JI_3BII(
+    JNIEnv* env, jclass jcl, jlong ptr, jint type, jbyteArray data_buffer,
+    jint offset, jint len)
+{
+#ifdef HAVE_SHAKE_JNI
+    keccak_update_array(env, (wc_Shake*)(uintptr_t)ptr, type, shake_update,
+        data_buffer, offset, len);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Shake_native_1final_1ptr__JILjava_nio_ByteBuffer_2II(
+    JNIEnv* env, jclass jcl, jlong ptr, jint type, jobject out_buffer,
+    jint position, jint outSz)
+{
+#ifdef HAVE_SHAKE_JNI
+    int ret = 0;
+    wc_Shake* shake = (wc_Shake*)(uintptr_t)ptr;
+    byte* out = getDirectBufferAddress(env, out_buffer);
+
+    if (shake == NULL || out == NULL || position < 0 || outSz < 0 ||
+        (word32)position + (word32)outSz >
+            getDirectBufferLimit(env, out_buffer)) {
+        ret = BAD_FUNC_ARG;
+    }
+    else {
+        ret = shake_final(shake, type, out + position, outSz);
+    }
+
+    LogStr("wc_Shake%d_Final(shake=%p, out, %d) = %d\n", type, shake, outSz,
+        ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Shake_native_1final_1ptr__JI_3BII(
+    JNIEnv* env, jclass jcl, jlong ptr, jint type, jbyteArray out_buffer,
+    jint offset, jint outSz)
+{
+#ifdef HAVE_SHAKE_JNI
+    int ret = 0;
+    wc_Shake* shake = (wc_Shake*)(uintptr_t)ptr;
+    byte* out = NULL;
+    word32 bufSz = 0;
+
+    /* get length before entering critical region, no other JNI calls
+     * are allowed until the array is released */
+    bufSz = getByteArrayLength(env, out_buffer);
+    out   = getByteArrayCritical(env, out_buffer);
+
+    ret = (!shake || !out || offset < 0 || outSz < 0 ||
+           (word32)offset + (word32)outSz > bufSz)
+        ? BAD_FUNC_ARG
+        : shake_final(shake, type, out + offset, outSz);
+
+    LogStr("wc_Shake%d_Final(shake=%p, out, %d) = %d\n", type, shake, outSz,
+        ret);
+
+    releaseByteArrayCritical(env, out_buffer, out, ret);
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
+
+JNIEXPORT void JNICALL
+Java_com_wolfssl_wolfcrypt_Shake_native_1hash(
+    JNIEnv* env, jclass jcl, jint type, jbyteArray data_buffer, jint offset,
+    jint len, jbyteArray out_buffer, jint outOffset, jint outSz)
+{
+#ifdef HAVE_SHAKE_JNI
+    int ret = 0;
+    wc_Shake shake;
+    byte* out = NULL;
+    word32 dataSz = 0;
+    word32 bufSz = 0;
+
+    /* one-shot over a stack struct, no native object allocation */
+    if (data_buffer == NULL || out_buffer == NULL || offset < 0 ||
+        len < 0 || outOffset < 0 || outSz < 0) {
+        ret = BAD_FUNC_ARG;
+    }
+    else {
+        dataSz = getByteArrayLength(env, data_buffer);
+        bufSz = getByteArrayLength(env, out_buffer);
+
+        if ((word32)offset + (word32)len > dataSz ||
+            (word32)outOffset + (word32)outSz > bufSz) {
+            ret = BUFFER_E;
+        }
+    }
+
+    if (ret == 0)
+        ret = shake_init(&shake, type);
+
+    if (ret == 0) {
+        keccak_update_array(env, &shake, type, shake_update, data_buffer,
+            offset, len);
+
+        if ((*env)->ExceptionCheck(env)) {
+            /* exception already thrown by update */
+            shake_free(&shake, type);
+            ForceZero(&shake, sizeof(shake));
+            return;
+        }
+
+        out = getByteArrayCritical(env, out_buffer);
+        ret = (!out)
+            ? BAD_FUNC_ARG
+            : shake_final(&shake, type, out + outOffset, outSz);
+        releaseByteArrayCritical(env, out_buffer, out, ret);
+
+        shake_free(&shake, type);
+        ForceZero(&shake, sizeof(shake));
+    }
+
+    if (ret != 0)
+        throwWolfCryptExceptionFromError(env, ret);
+#else
+    throwNotCompiledInException(env);
+#endif
+}
@@ -0,0 +1,105 @@
+/* BenchProviders.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.provider.jce.bench;
+
+import java.security.GeneralSecurityException;
+import java.security.MessageDigest;
+import java.security.SecureRandom;
+import java.security.Security;
+import java.security.Signature;
+import javax.crypto.Cipher;
+import javax.crypto.KeyAgreement;
+import javax.crypto.Mac;
+
+import com.wolfssl.provider.jce.WolfCryptProvider;
+
+/**
+ * Looks up JCA engines from either wolfJCE or the JDK default providers.
+ *
+ * wolfJCE is installed at the lowest priority, so a lookup without a
+ * provider name returns the implementation the JDK would normally use
+ * (SUN, SunJCE, SunRsaSign, SunEC).
+ */
+final class BenchProviders {
+
+    /** Use wolfJCE engine */
+    static final String WOLFJCE = "wolfJCE";
+
+    /** Use JDK default engine */
+    static final String JDK = "jdk";
+
+    private BenchProviders() { }
+
+    static synchronized void install() {
+        if (Security.getProvider(WOLFJCE) == null) {
+            Security.addProvider(new WolfCryptProvider());
+        }
+    }
+
+    static MessageDigest digest(String provider, String algorithm)
+        throws GeneralSecurityException {
+        install();
+        return WOLFJCE.equals(provider) ?
+            MessageDigest.getInstance(algorithm, WOLFJCE) :
+            MessageDigest.getInstance(algorithm);
+    }
+
+    static Mac mac(String provider, String algorithm)
+        throws GeneralSecurityException {
+        install();
+        return WOLFJCE.equals(provider) ?
+            Mac.getInstance(algorithm, WOLFJCE) :
+            Mac.getInstance(algorithm);
+    }
+
+    static Cipher cipher(String provider, String transformation)
+        throws GeneralSecurityException {
+        install();
+        return WOLFJCE.equals(provider) ?
+            Cipher.getInstance(transformation, WOLFJCE) :
+            Cipher.getInstance(transformation);
+    }
+
+    static Signature signature(String provider, String algorithm)
+        throws GeneralSecurityException {
+        install();
+        return WOLFJCE.equals(provider) ?
+            Signature.getInstance(algorithm, WOLFJCE) :
+            Signature.getInstance(algorithm);
+    }
+
+    static KeyAgreement keyAgreement(String provider, String algorithm)
+        throws GeneralSecurityException {
+        install();
+        return WOLFJCE.equals(provider) ?
+            KeyAgreement.getInstance(algorithm, WOLFJCE) :
+            KeyAgreement.getInstance(algorithm);
+    }
+
+    static SecureRandom random(String provider)
+        throws GeneralSecurityException {
+        install();
+        return WOLFJCE.equals(provider) ?
+            SecureRandom.getInstance("HashDRBG", WOLFJCE) :
+            new SecureRandom();
+    }
+}
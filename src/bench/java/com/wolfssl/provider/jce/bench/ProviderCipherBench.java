@@ -0,0 +1,121 @@
+/* ProviderCipherBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.provider.jce.bench;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.TimeUnit;
+import javax.crypto.Cipher;
+import javax.crypto.SecretKey;
+import javax.crypto.spec.GCMParameterSpec;
+import javax.crypto.spec.IvParameterSpec;
+import javax.crypto.spec.SecretKeySpec;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.bench.BenchUtil;
+
+/**
+ * Cipher encrypt throughput, wolfJCE compared to the JDK provider.
+ *
+ * GCM is re-initialized with a new IV for every operation, since IV reuse
+ * for encryption is rejected by the JDK provider.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class ProviderCipherBench {
+
+    @Param({ BenchProviders.WOLFJCE, BenchProviders.JDK })
+    public String provider;
+
+    @Param({ "AES/CBC/NoPadding", "AES/CTR/NoPadding", "AES/GCM/NoPadding",
+             "DESede/CBC/NoPadding" })
+    public String transformation;
+
+    @Param({ "16", "1024", "16384", "1048576" })
+    public int size;
+
+    @Param({ BenchUtil.ARRAY, BenchUtil.HEAP, BenchUtil.DIRECT })
+    public String input;
+
+    private Cipher cipher;
+    private SecretKey key;
+    private boolean gcm;
+    private byte[] gcmIv = new byte[12];
+    private byte[] inArray;
+    private byte[] outArray;
+    private ByteBuffer inBuffer;
+    private ByteBuffer outBuffer;
+
+    @Setup
+    public void setup() throws Exception {
+        cipher = BenchProviders.cipher(provider, transformation);
+        gcm = transformation.startsWith("AES/GCM");
+
+        if (transformation.startsWith("DESede")) {
+            key = new SecretKeySpec(BenchUtil.data(24), "DESede");
+            cipher.init(Cipher.ENCRYPT_MODE, key,
+                new IvParameterSpec(BenchUtil.data(8)));
+        } else {
+            key = new SecretKeySpec(BenchUtil.data(16), "AES");
+            if (gcm) {
+                cipher.init(Cipher.ENCRYPT_MODE, key,
+                    new GCMParameterSpec(128, gcmIv));
+            } else {
+                cipher.init(Cipher.ENCRYPT_MODE, key,
+                    new IvParameterSpec(BenchUtil.data(16)));
+            }
+        }
+
+        inArray = BenchUtil.data(size);
+        outArray = new byte[cipher.getOutputSize(size)];
+        inBuffer = BenchUtil.buffer(input, inArray);
+        outBuffer = BenchUtil.allocate(input, outArray.length);
+    }
+
+    @Benchmark
+    public Object encrypt() throws Exception {
+        if (gcm) {
+            /* unique IV per message */
+            for (int i = 0; i < gcmIv.length; i++) {
+                if (++gcmIv[i] != 0) {
+                    break;
+                }
+            }
+            cipher.init(Cipher.ENCRYPT_MODE, key,
+                new GCMParameterSpec(128, gcmIv));
+        }
+
+        if (input.equals(BenchUtil.ARRAY)) {
+            cipher.doFinal(inArray, 0, inArray.length, outArray, 0);
+            return outArray;
+        }
+
+        inBuffer.position(0);
+        outBuffer.clear();
+        cipher.doFinal(inBuffer, outBuffer);
+        return outBuffer;
+    }
+}
@@ -0,0 +1,77 @@
+/* ProviderKeyAgreementBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.provider.jce.bench;
+
+import java.security.KeyPair;
+import java.security.KeyPairGenerator;
+import java.util.concurrent.TimeUnit;
+import javax.crypto.KeyAgreement;
+
+import org.openjdk.jmh.annotations.*;
+
+/**
+ * KeyAgreement latency, wolfJCE compared to the JDK provider. Keys come
+ * from the JDK KeyPairGenerator so both providers use the same keys.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class ProviderKeyAgreementBench {
+
+    @Param({ BenchProviders.WOLFJCE, BenchProviders.JDK })
+    public String provider;
+
+    @Param({ "ECDH", "DH" })
+    public String algorithm;
+
+    private KeyAgreement ka;
+    private KeyPair local;
+    private KeyPair peer;
+
+    @Setup
+    public void setup() throws Exception {
+        KeyPairGenerator kpg;
+
+        if (algorithm.equals("ECDH")) {
+            kpg = KeyPairGenerator.getInstance("EC");
+            kpg.initialize(256);
+        } else {
+            kpg = KeyPairGenerator.getInstance("DH");
+            kpg.initialize(2048);
+        }
+
+        local = kpg.generateKeyPair();
+        peer = kpg.generateKeyPair();
+
+        ka = BenchProviders.keyAgreement(provider, algorithm);
+    }
+
+    @Benchmark
+    public byte[] agree() throws Exception {
+        ka.init(local.getPrivate());
+        ka.doPhase(peer.getPublic(), true);
+        return ka.generateSecret();
+    }
+}
@@ -0,0 +1,80 @@
+/* ProviderMacBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.provider.jce.bench;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.TimeUnit;
+import javax.crypto.Mac;
+import javax.crypto.spec.SecretKeySpec;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.bench.BenchUtil;
+
+/**
+ * Mac throughput, wolfJCE compared to the JDK provider.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class ProviderMacBench {
+
+    @Param({ BenchProviders.WOLFJCE, BenchProviders.JDK })
+    public String provider;
+
+    @Param({ "HmacMD5", "HmacSHA1", "HmacSHA256", "HmacSHA384",
+             "HmacSHA512" })
+    public String algorithm;
+
+    @Param({ "16", "1024", "16384", "1048576" })
+    public int size;
+
+    @Param({ BenchUtil.ARRAY, BenchUtil.HEAP, BenchUtil.DIRECT })
+    public String input;
+
+    private Mac mac;
+    private byte[] array;
+    private ByteBuffer buffer;
+
+    @Setup
+    public void setup() throws Exception {
+        mac = BenchProviders.mac(provider, algorithm);
+        mac.init(new SecretKeySpec(BenchUtil.data(32), algorithm));
+        array = BenchUtil.data(size);
+        buffer = BenchUtil.buffer(input, array);
+    }
+
+    @Benchmark
+    public byte[] mac() {
+        if (input.equals(BenchUtil.ARRAY)) {
+            mac.update(array, 0, array.length);
+        } else {
+            buffer.position(0);
+            mac.update(buffer);
+        }
+
+        return mac.doFinal();
+    }
+}
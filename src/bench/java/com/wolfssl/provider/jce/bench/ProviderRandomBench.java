@@ -0,0 +1,83 @@
+/* ProviderRandomBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.provider.jce.bench;
+
+import java.security.SecureRandom;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+/**
+ * SecureRandom throughput, wolfJCE compared to the JDK default.
+ *
+ * nextBytesShared uses one SecureRandom for all benchmark threads, run
+ * with -t to measure contention on it.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class ProviderRandomBench {
+
+    @State(Scope.Benchmark)
+    public static class SharedState {
+
+        @Param({ BenchProviders.WOLFJCE, BenchProviders.JDK })
+        public String provider;
+
+        SecureRandom random;
+
+        @Setup
+        public void setup() throws Exception {
+            random = BenchProviders.random(provider);
+        }
+    }
+
+    @State(Scope.Thread)
+    public static class ThreadState {
+
+        @Param({ "16", "32", "1024" })
+        public int size;
+
+        SecureRandom random;
+        byte[] out;
+
+        @Setup
+        public void setup(SharedState shared) throws Exception {
+            random = BenchProviders.random(shared.provider);
+            out = new byte[size];
+        }
+    }
+
+    @Benchmark
+    public byte[] nextBytes(ThreadState s) {
+        s.random.nextBytes(s.out);
+        return s.out;
+    }
+
+    @Benchmark
+    public byte[] nextBytesShared(SharedState shared, ThreadState s) {
+        shared.random.nextBytes(s.out);
+        return s.out;
+    }
+}
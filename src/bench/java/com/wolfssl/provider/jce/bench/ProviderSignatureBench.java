@@ -0,0 +1,95 @@
+/* ProviderSignatureBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.provider.jce.bench;
+
+import java.security.KeyPair;
+import java.security.KeyPairGenerator;
+import java.security.Signature;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.bench.BenchUtil;
+
+/**
+ * Signature sign and verify latency, wolfJCE compared to the JDK
+ * provider. Keys come from the JDK KeyPairGenerator so both providers
+ * use the same keys.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class ProviderSignatureBench {
+
+    @Param({ BenchProviders.WOLFJCE, BenchProviders.JDK })
+    public String provider;
+
+    @Param({ "SHA256withRSA", "SHA256withECDSA", "SHA384withECDSA" })
+    public String algorithm;
+
+    @Param({ "1024" })
+    public int size;
+
+    private Signature signer;
+    private Signature verifier;
+    private KeyPair pair;
+    private byte[] data;
+    private byte[] signature;
+
+    @Setup
+    public void setup() throws Exception {
+        KeyPairGenerator kpg;
+
+        if (algorithm.endsWith("RSA")) {
+            kpg = KeyPairGenerator.getInstance("RSA");
+            kpg.initialize(2048);
+        } else {
+            kpg = KeyPairGenerator.getInstance("EC");
+            kpg.initialize(algorithm.startsWith("SHA384") ? 384 : 256);
+        }
+        pair = kpg.generateKeyPair();
+
+        signer = BenchProviders.signature(provider, algorithm);
+        signer.initSign(pair.getPrivate());
+        verifier = BenchProviders.signature(provider, algorithm);
+        verifier.initVerify(pair.getPublic());
+
+        data = BenchUtil.data(size);
+        signer.update(data);
+        signature = signer.sign();
+    }
+
+    @Benchmark
+    public byte[] sign() throws Exception {
+        signer.update(data);
+        return signer.sign();
+    }
+
+    @Benchmark
+    public boolean verify() throws Exception {
+        verifier.update(data);
+        return verifier.verify(signature);
+    }
+}
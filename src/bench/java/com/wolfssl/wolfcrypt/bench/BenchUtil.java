@@ -0,0 +1,88 @@
+/* BenchUtil.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.bench;
+
+import java.nio.ByteBuffer;
+import java.util.Random;
+
+/**
+ * Helpers shared by the wolfCrypt JNI and wolfJCE JMH benchmarks.
+ *
+ * Input data is deterministic so results are comparable between runs,
+ * content does not matter to the primitives being measured.
+ */
+public final class BenchUtil {
+
+    /** Input held in a byte array */
+    public static final String ARRAY = "array";
+
+    /** Input held in a heap (non-direct) ByteBuffer */
+    public static final String HEAP = "heap";
+
+    /** Input held in a direct ByteBuffer */
+    public static final String DIRECT = "direct";
+
+    private BenchUtil() { }
+
+    /**
+     * Create array of pseudo random bytes
+     *
+     * @param size number of bytes
+     *
+     * @return new array filled with data
+     */
+    public static byte[] data(int size) {
+        byte[] out = new byte[size];
+        new Random(size).nextBytes(out);
+        return out;
+    }
+
+    /**
+     * Create ByteBuffer of requested kind holding a copy of data
+     *
+     * @param kind HEAP or DIRECT
+     * @param data content to place in buffer
+     *
+     * @return buffer with position 0 and limit data.length
+     */
+    public static ByteBuffer buffer(String kind, byte[] data) {
+        ByteBuffer buf = allocate(kind, data.length);
+        buf.put(data);
+        buf.flip();
+        return buf;
+    }
+
+    /**
+     * Allocate empty ByteBuffer of requested kind
+     *
+     * @param kind HEAP or DIRECT
+     * @param size capacity in bytes
+     *
+     * @return new buffer
+     */
+    public static ByteBuffer allocate(String kind, int size) {
+        if (DIRECT.equals(kind)) {
+            return ByteBuffer.allocateDirect(size);
+        }
+        return ByteBuffer.allocate(size);
+    }
+}
@@ -0,0 +1,180 @@
+/* CipherBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.bench;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.TimeUnit;
+import javax.crypto.ShortBufferException;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.Aes;
+import com.wolfssl.wolfcrypt.Des3;
+import com.wolfssl.wolfcrypt.Chacha;
+
+/**
+ * Encrypt throughput of the wolfCrypt JNI symmetric cipher wrappers.
+ *
+ * ArrayState covers every wrapped cipher using byte arrays. DirectState
+ * covers the modes that also take direct ByteBuffers.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class CipherBench {
+
+    @State(Scope.Thread)
+    public static class ArrayState {
+
+        @Param({ "AES-CBC", "AES-CTR", "AES-GCM", "DES3-CBC", "CHACHA" })
+        public String mode;
+
+        @Param({ "16", "1024", "16384", "1048576" })
+        public int size;
+
+        Aes aes;
+        Des3 des3;
+        Chacha chacha;
+        byte[] in;
+        byte[] out;
+        byte[] iv = new byte[Aes.GCM_NONCE_SIZE];
+        byte[] tag = new byte[Aes.GCM_TAG_SIZE];
+
+        @Setup
+        public void setup() {
+            /* multiple of every block size used */
+            in = BenchUtil.data(size);
+            out = new byte[size];
+
+            if (mode.equals("AES-CBC")) {
+                aes = new Aes(BenchUtil.data(Aes.KEY_SIZE_128),
+                    BenchUtil.data(Aes.BLOCK_SIZE), Aes.ENCRYPT_MODE);
+            } else if (mode.equals("AES-CTR")) {
+                aes = new Aes();
+                aes.ctrSetKey(BenchUtil.data(Aes.KEY_SIZE_128),
+                    BenchUtil.data(Aes.BLOCK_SIZE));
+            } else if (mode.equals("AES-GCM")) {
+                aes = new Aes();
+                aes.gcmSetKey(BenchUtil.data(Aes.KEY_SIZE_128));
+            } else if (mode.equals("DES3-CBC")) {
+                des3 = new Des3(BenchUtil.data(Des3.KEY_SIZE),
+                    BenchUtil.data(Des3.BLOCK_SIZE), Des3.ENCRYPT_MODE);
+            } else {
+                chacha = new Chacha();
+                chacha.setKey(BenchUtil.data(32));
+                chacha.setIV(BenchUtil.data(12));
+            }
+        }
+
+        @TearDown
+        public void tearDown() {
+            if (aes != null) {
+                aes.releaseNativeStruct();
+            }
+            if (des3 != null) {
+                des3.releaseNativeStruct();
+            }
+            if (chacha != null) {
+                chacha.releaseNativeStruct();
+            }
+        }
+    }
+
+    @State(Scope.Thread)
+    public static class DirectState {
+
+        @Param({ "AES-CBC", "AES-CTR", "DES3-CBC" })
+        public String mode;
+
+        @Param({ "16", "1024", "16384", "1048576" })
+        public int size;
+
+        Aes aes;
+        Des3 des3;
+        ByteBuffer in;
+        ByteBuffer out;
+
+        @Setup
+        public void setup() {
+            in = BenchUtil.buffer(BenchUtil.DIRECT, BenchUtil.data(size));
+            out = BenchUtil.allocate(BenchUtil.DIRECT, size);
+
+            if (mode.equals("AES-CBC")) {
+                aes = new Aes(BenchUtil.data(Aes.KEY_SIZE_128),
+                    BenchUtil.data(Aes.BLOCK_SIZE), Aes.ENCRYPT_MODE);
+            } else if (mode.equals("AES-CTR")) {
+                aes = new Aes();
+                aes.ctrSetKey(BenchUtil.data(Aes.KEY_SIZE_128),
+                    BenchUtil.data(Aes.BLOCK_SIZE));
+            } else {
+                des3 = new Des3(BenchUtil.data(Des3.KEY_SIZE),
+                    BenchUtil.data(Des3.BLOCK_SIZE), Des3.ENCRYPT_MODE);
+            }
+        }
+
+        @TearDown
+        public void tearDown() {
+            if (aes != null) {
+                aes.releaseNativeStruct();
+            }
+            if (des3 != null) {
+                des3.releaseNativeStruct();
+            }
+        }
+    }
+
+    @Benchmark
+    public Object encryptArray(ArrayState s) throws ShortBufferException {
+        if (s.mode.equals("AES-CBC")) {
+            s.aes.update(s.in, 0, s.in.length, s.out, 0);
+        } else if (s.mode.equals("AES-CTR")) {
+            s.aes.ctrUpdate(s.in, 0, s.in.length, s.out, 0);
+        } else if (s.mode.equals("AES-GCM")) {
+            s.aes.gcmEncrypt(s.in, 0, s.in.length, s.out, 0, s.iv, s.tag,
+                null);
+        } else if (s.mode.equals("DES3-CBC")) {
+            s.des3.update(s.in, 0, s.in.length, s.out, 0);
+        } else {
+            return s.chacha.process(s.in);
+        }
+
+        return s.out;
+    }
+
+    @Benchmark
+    public Object encryptDirect(DirectState s) throws ShortBufferException {
+        s.in.position(0);
+        s.out.clear();
+
+        if (s.mode.equals("AES-CBC")) {
+            s.aes.update(s.in, s.out);
+        } else if (s.mode.equals("AES-CTR")) {
+            s.aes.ctrUpdate(s.in, s.out);
+        } else {
+            s.des3.update(s.in, s.out);
+        }
+
+        return s.out;
+    }
+}
@@ -0,0 +1,77 @@
+/* Curve25519Bench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.bench;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.Curve25519;
+import com.wolfssl.wolfcrypt.Rng;
+
+/**
+ * Latency of the wolfCrypt JNI Curve25519 wrapper key generation and
+ * shared secret operations.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class Curve25519Bench {
+
+    private Rng rng;
+    private Curve25519 key;
+    private Curve25519 peer;
+
+    @Setup
+    public void setup() {
+        rng = new Rng();
+        rng.init();
+
+        key = new Curve25519();
+        key.makeKey(rng, 32);
+        peer = new Curve25519();
+        peer.makeKey(rng, 32);
+    }
+
+    @TearDown
+    public void tearDown() {
+        key.releaseNativeStruct();
+        peer.releaseNativeStruct();
+        rng.releaseNativeStruct();
+    }
+
+    @Benchmark
+    public Curve25519 keyGen() {
+        Curve25519 c = new Curve25519();
+        c.makeKey(rng, 32);
+        c.releaseNativeStruct();
+        return c;
+    }
+
+    @Benchmark
+    public byte[] sharedSecret() {
+        return key.makeSharedSecret(peer);
+    }
+}
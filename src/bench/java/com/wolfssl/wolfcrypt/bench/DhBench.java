@@ -0,0 +1,105 @@
+/* DhBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.bench;
+
+import java.math.BigInteger;
+import java.security.KeyPairGenerator;
+import java.util.Arrays;
+import java.util.concurrent.TimeUnit;
+import javax.crypto.interfaces.DHPublicKey;
+import javax.crypto.spec.DHParameterSpec;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.Dh;
+import com.wolfssl.wolfcrypt.Rng;
+
+/**
+ * Latency of the wolfCrypt JNI Dh wrapper key generation and shared
+ * secret operations.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class DhBench {
+
+    @Param({ "2048", "3072" })
+    public int keySize;
+
+    private Rng rng;
+    private Dh key;
+    private Dh peer;
+    private byte[] p;
+    private byte[] g;
+
+    @Setup
+    public void setup() throws Exception {
+        /* use the well known group the JDK ships for this size */
+        KeyPairGenerator kpg = KeyPairGenerator.getInstance("DH");
+        kpg.initialize(keySize);
+        DHParameterSpec spec =
+            ((DHPublicKey)kpg.generateKeyPair().getPublic()).getParams();
+
+        p = unsigned(spec.getP());
+        g = unsigned(spec.getG());
+
+        rng = new Rng();
+        rng.init();
+
+        key = new Dh(p, g);
+        key.makeKey(rng);
+        peer = new Dh(p, g);
+        peer.makeKey(rng);
+    }
+
+    @TearDown
+    public void tearDown() {
+        key.releaseNativeStruct();
+        peer.releaseNativeStruct();
+        rng.releaseNativeStruct();
+    }
+
+    @Benchmark
+    public Dh keyGen() {
+        Dh dh = new Dh(p, g);
+        dh.makeKey(rng);
+        dh.releaseNativeStruct();
+        return dh;
+    }
+
+    @Benchmark
+    public byte[] sharedSecret() {
+        return key.makeSharedSecret(peer);
+    }
+
+    /* BigInteger encoding without leading sign byte */
+    private static byte[] unsigned(BigInteger value) {
+        byte[] out = value.toByteArray();
+        if (out.length > 1 && out[0] == 0) {
+            out = Arrays.copyOfRange(out, 1, out.length);
+        }
+        return out;
+    }
+}
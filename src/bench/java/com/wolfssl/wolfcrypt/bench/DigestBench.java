@@ -0,0 +1,98 @@
+/* DigestBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.bench;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.Md5;
+import com.wolfssl.wolfcrypt.Sha;
+import com.wolfssl.wolfcrypt.Sha256;
+import com.wolfssl.wolfcrypt.Sha384;
+import com.wolfssl.wolfcrypt.Sha512;
+import com.wolfssl.wolfcrypt.MessageDigest;
+
+/**
+ * Throughput of the wolfCrypt JNI message digest wrappers, one update()
+ * plus digest() per operation.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class DigestBench {
+
+    @Param({ "MD5", "SHA", "SHA-256", "SHA-384", "SHA-512" })
+    public String algorithm;
+
+    @Param({ "16", "1024", "16384", "1048576" })
+    public int size;
+
+    @Param({ BenchUtil.ARRAY, BenchUtil.DIRECT })
+    public String input;
+
+    private MessageDigest md;
+    private byte[] array;
+    private ByteBuffer buffer;
+    private byte[] hash;
+
+    @Setup
+    public void setup() {
+        if (algorithm.equals("MD5")) {
+            md = new Md5();
+        } else if (algorithm.equals("SHA")) {
+            md = new Sha();
+        } else if (algorithm.equals("SHA-256")) {
+            md = new Sha256();
+        } else if (algorithm.equals("SHA-384")) {
+            md = new Sha384();
+        } else {
+            md = new Sha512();
+        }
+
+        array = BenchUtil.data(size);
+        buffer = BenchUtil.buffer(BenchUtil.DIRECT, array);
+        hash = new byte[md.digestSize()];
+    }
+
+    @TearDown
+    public void tearDown() {
+        md.releaseNativeStruct();
+    }
+
+    @Benchmark
+    public byte[] digest() {
+        if (input.equals(BenchUtil.DIRECT)) {
+            buffer.position(0);
+            md.update(buffer);
+        } else {
+            md.update(array, 0, array.length);
+        }
+
+        md.digest(hash);
+        return hash;
+    }
+}
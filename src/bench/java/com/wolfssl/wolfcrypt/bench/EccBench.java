@@ -0,0 +1,98 @@
+/* EccBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.bench;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.Ecc;
+import com.wolfssl.wolfcrypt.Rng;
+
+/**
+ * Latency of the wolfCrypt JNI Ecc wrapper key generation, ECDSA and
+ * ECDH operations.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class EccBench {
+
+    @Param({ "SECP256R1", "SECP384R1", "SECP521R1" })
+    public String curve;
+
+    private Rng rng;
+    private Ecc key;
+    private Ecc peer;
+    private int keySize;
+    private byte[] hash;
+    private byte[] signature;
+
+    @Setup
+    public void setup() {
+        rng = new Rng();
+        rng.init();
+
+        keySize = Ecc.getCurveSizeFromName(curve);
+
+        key = new Ecc();
+        key.makeKeyOnCurve(rng, keySize, curve);
+        peer = new Ecc();
+        peer.makeKeyOnCurve(rng, keySize, curve);
+
+        hash = BenchUtil.data(32);
+        signature = key.sign(hash, rng);
+    }
+
+    @TearDown
+    public void tearDown() {
+        key.releaseNativeStruct();
+        peer.releaseNativeStruct();
+        rng.releaseNativeStruct();
+    }
+
+    @Benchmark
+    public Ecc keyGen() {
+        Ecc ecc = new Ecc();
+        ecc.makeKeyOnCurve(rng, keySize, curve);
+        ecc.releaseNativeStruct();
+        return ecc;
+    }
+
+    @Benchmark
+    public byte[] sign() {
+        return key.sign(hash, rng);
+    }
+
+    @Benchmark
+    public boolean verify() {
+        return key.verify(hash, signature);
+    }
+
+    @Benchmark
+    public byte[] sharedSecret() {
+        return key.makeSharedSecret(peer);
+    }
+}
@@ -0,0 +1,86 @@
+/* Ed25519Bench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.bench;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.Ed25519;
+import com.wolfssl.wolfcrypt.Rng;
+
+/**
+ * Latency of the wolfCrypt JNI Ed25519 wrapper key generation, sign and
+ * verify operations.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class Ed25519Bench {
+
+    @Param({ "32", "1024" })
+    public int size;
+
+    private Rng rng;
+    private Ed25519 key;
+    private byte[] msg;
+    private byte[] signature;
+
+    @Setup
+    public void setup() {
+        rng = new Rng();
+        rng.init();
+
+        key = new Ed25519();
+        key.makeKey(rng, 32);
+
+        msg = BenchUtil.data(size);
+        signature = key.sign_msg(msg);
+    }
+
+    @TearDown
+    public void tearDown() {
+        key.releaseNativeStruct();
+        rng.releaseNativeStruct();
+    }
+
+    @Benchmark
+    public Ed25519 keyGen() {
+        Ed25519 ed = new Ed25519();
+        ed.makeKey(rng, 32);
+        ed.releaseNativeStruct();
+        return ed;
+    }
+
+    @Benchmark
+    public byte[] sign() {
+        return key.sign_msg(msg);
+    }
+
+    @Benchmark
+    public boolean verify() {
+        return key.verify_msg(msg, signature);
+    }
+}
@@ -0,0 +1,93 @@
+/* HmacBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.bench;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.Hmac;
+
+/**
+ * Throughput of the wolfCrypt JNI Hmac wrapper, one update() plus
+ * doFinal() per operation.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class HmacBench {
+
+    @Param({ "MD5", "SHA", "SHA256", "SHA384", "SHA512" })
+    public String algorithm;
+
+    @Param({ "16", "1024", "16384", "1048576" })
+    public int size;
+
+    @Param({ BenchUtil.ARRAY, BenchUtil.DIRECT })
+    public String input;
+
+    private Hmac hmac;
+    private byte[] array;
+    private ByteBuffer buffer;
+
+    @Setup
+    public void setup() {
+        int type;
+
+        if (algorithm.equals("MD5")) {
+            type = Hmac.MD5;
+        } else if (algorithm.equals("SHA")) {
+            type = Hmac.SHA;
+        } else if (algorithm.equals("SHA256")) {
+            type = Hmac.SHA256;
+        } else if (algorithm.equals("SHA384")) {
+            type = Hmac.SHA384;
+        } else {
+            type = Hmac.SHA512;
+        }
+
+        hmac = new Hmac(type, BenchUtil.data(32));
+        array = BenchUtil.data(size);
+        buffer = BenchUtil.buffer(BenchUtil.DIRECT, array);
+    }
+
+    @TearDown
+    public void tearDown() {
+        hmac.releaseNativeStruct();
+    }
+
+    @Benchmark
+    public byte[] mac() {
+        if (input.equals(BenchUtil.DIRECT)) {
+            buffer.position(0);
+            hmac.update(buffer);
+        } else {
+            hmac.update(array, 0, array.length);
+        }
+
+        return hmac.doFinal();
+    }
+}
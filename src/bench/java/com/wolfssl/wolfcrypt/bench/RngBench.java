@@ -0,0 +1,122 @@
+/* RngBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.bench;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.BufferedRng;
+import com.wolfssl.wolfcrypt.Rng;
+
+/**
+ * Throughput of the wolfCrypt JNI Rng wrapper.
+ *
+ * The shared benchmarks use one Rng for all benchmark threads, run with
+ * -t to measure contention on it.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class RngBench {
+
+    @State(Scope.Thread)
+    public static class ThreadState {
+
+        @Param({ "16", "32", "1024", "16384" })
+        public int size;
+
+        Rng rng;
+        BufferedRng buffered;
+        byte[] array;
+        ByteBuffer direct;
+
+        @Setup
+        public void setup() {
+            rng = new Rng();
+            rng.init();
+            buffered = new BufferedRng(rng);
+            array = new byte[size];
+            direct = BenchUtil.allocate(BenchUtil.DIRECT, size);
+        }
+
+        @TearDown
+        public void tearDown() {
+            buffered.clear();
+            rng.releaseNativeStruct();
+        }
+    }
+
+    @State(Scope.Benchmark)
+    public static class SharedState {
+
+        Rng rng;
+        BufferedRng buffered;
+
+        @Setup
+        public void setup() {
+            rng = new Rng();
+            rng.init();
+            buffered = new BufferedRng(BufferedRng.DEFAULT_BUFFER_SIZE);
+        }
+
+        @TearDown
+        public void tearDown() {
+            rng.releaseNativeStruct();
+        }
+    }
+
+    @Benchmark
+    public byte[] generateArray(ThreadState s) {
+        s.rng.generateBlock(s.array);
+        return s.array;
+    }
+
+    @Benchmark
+    public ByteBuffer generateDirect(ThreadState s) {
+        s.direct.clear();
+        s.rng.generateBlock(s.direct);
+        return s.direct;
+    }
+
+    @Benchmark
+    public byte[] generateBuffered(ThreadState s) {
+        s.buffered.nextBytes(s.array);
+        return s.array;
+    }
+
+    @Benchmark
+    public byte[] generateShared(SharedState shared, ThreadState s) {
+        shared.rng.generateBlock(s.array);
+        return s.array;
+    }
+
+    @Benchmark
+    public byte[] generateSharedBuffered(SharedState shared,
+        ThreadState s) {
+        shared.buffered.nextBytes(s.array);
+        return s.array;
+    }
+}
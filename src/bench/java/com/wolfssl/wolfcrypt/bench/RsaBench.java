@@ -0,0 +1,92 @@
+/* RsaBench.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.bench;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.*;
+
+import com.wolfssl.wolfcrypt.Rng;
+import com.wolfssl.wolfcrypt.Rsa;
+
+/**
+ * Latency of the wolfCrypt JNI Rsa wrapper private and public key
+ * operations, PKCS#1 v1.5 padding.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@State(Scope.Thread)
+public class RsaBench {
+
+    @Param({ "2048", "3072", "4096" })
+    public int keySize;
+
+    private Rng rng;
+    private Rsa rsa;
+    private byte[] data;
+    private byte[] signature;
+    private byte[] ciphertext;
+
+    @Setup
+    public void setup() {
+        rng = new Rng();
+        rng.init();
+
+        rsa = new Rsa();
+        rsa.makeKey(keySize, Rsa.getDefaultRsaExponent(), rng);
+        rsa.setRng(rng);
+
+        /* size of a DER encoded SHA-256 DigestInfo */
+        data = BenchUtil.data(51);
+        signature = rsa.sign(data, rng);
+        ciphertext = rsa.encrypt(data, rng);
+    }
+
+    @TearDown
+    public void tearDown() {
+        rsa.releaseNativeStruct();
+        rng.releaseNativeStruct();
+    }
+
+    @Benchmark
+    public byte[] sign() {
+        return rsa.sign(data, rng);
+    }
+
+    @Benchmark
+    public byte[] verify() {
+        return rsa.verify(signature);
+    }
+
+    @Benchmark
+    public byte[] encrypt() {
+        return rsa.encrypt(data, rng);
+    }
+
+    @Benchmark
+    public byte[] decrypt() {
+        return rsa.decrypt(ciphertext);
+    }
+}
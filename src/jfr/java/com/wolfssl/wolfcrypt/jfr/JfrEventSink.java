@@ -0,0 +1,226 @@
+/* JfrEventSink.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.jfr;
+
+import jdk.jfr.Category;
+import jdk.jfr.DataAmount;
+import jdk.jfr.Description;
+import jdk.jfr.Event;
+import jdk.jfr.EventType;
+import jdk.jfr.Label;
+import jdk.jfr.Name;
+import jdk.jfr.Threshold;
+
+import com.wolfssl.wolfcrypt.CryptoEvents;
+
+/**
+ * CryptoEvents.Sink committing Java Flight Recorder events.
+ *
+ * Loaded by CryptoEvents when present in the JAR. Each event type can be
+ * enabled and given a duration threshold separately in a JFR recording
+ * configuration, under the "com.wolfssl.wolfcrypt" event names. While an
+ * event type is not being recorded, begin() returns null without creating
+ * an event object.
+ */
+public final class JfrEventSink implements CryptoEvents.Sink {
+
+    /** Fields common to all wolfCrypt events, only operations taking
+     *  longer than 1 ms are recorded unless the threshold is changed */
+    @Category({ "wolfSSL", "wolfCrypt" })
+    @Threshold("1 ms")
+    public abstract static class CryptoEvent extends Event {
+
+        @Label("Algorithm")
+        String algorithm;
+
+        @Label("Key Size")
+        @DataAmount(DataAmount.BITS)
+        int keySize;
+
+        @Label("Curve")
+        String curve;
+    }
+
+    /** RSA signature generation */
+    @Name("com.wolfssl.wolfcrypt.RsaSign")
+    @Label("RSA Sign")
+    @Description("RSA signature generation")
+    public static final class RsaSign extends CryptoEvent { }
+
+    /** RSA private key decryption */
+    @Name("com.wolfssl.wolfcrypt.RsaDecrypt")
+    @Label("RSA Decrypt")
+    @Description("RSA private key decryption")
+    public static final class RsaDecrypt extends CryptoEvent { }
+
+    /** ECDSA signature generation */
+    @Name("com.wolfssl.wolfcrypt.EccSign")
+    @Label("ECDSA Sign")
+    @Description("ECDSA signature generation")
+    public static final class EccSign extends CryptoEvent { }
+
+    /** ECDSA signature verification */
+    @Name("com.wolfssl.wolfcrypt.EccVerify")
+    @Label("ECDSA Verify")
+    @Description("ECDSA signature verification")
+    public static final class EccVerify extends CryptoEvent { }
+
+    /** ECDH shared secret generation */
+    @Name("com.wolfssl.wolfcrypt.EccSharedSecret")
+    @Label("ECDH Shared Secret")
+    @Description("ECDH shared secret generation")
+    public static final class EccSharedSecret extends CryptoEvent { }
+
+    /** DH shared secret generation */
+    @Name("com.wolfssl.wolfcrypt.DhAgree")
+    @Label("DH Agree")
+    @Description("DH shared secret generation")
+    public static final class DhAgree extends CryptoEvent { }
+
+    /** RSA, ECC or DH key pair generation */
+    @Name("com.wolfssl.wolfcrypt.KeyGeneration")
+    @Label("Key Generation")
+    @Description("RSA, ECC or DH key pair generation")
+    public static final class KeyGeneration extends CryptoEvent { }
+
+    /** DRBG instantiation and seeding from the entropy source */
+    @Name("com.wolfssl.wolfcrypt.RngSeed")
+    @Label("DRBG Seed")
+    @Description("DRBG instantiation and seeding from the entropy source")
+    public static final class RngSeed extends CryptoEvent { }
+
+    /** wolfJCE Signature.sign() */
+    @Name("com.wolfssl.wolfcrypt.JceSign")
+    @Label("JCE Signature Sign")
+    @Description("wolfJCE Signature.sign()")
+    public static final class JceSign extends CryptoEvent { }
+
+    /** wolfJCE Signature.verify() */
+    @Name("com.wolfssl.wolfcrypt.JceVerify")
+    @Label("JCE Signature Verify")
+    @Description("wolfJCE Signature.verify()")
+    public static final class JceVerify extends CryptoEvent { }
+
+    /** wolfJCE KeyAgreement.generateSecret() */
+    @Name("com.wolfssl.wolfcrypt.JceKeyAgreement")
+    @Label("JCE Key Agreement")
+    @Description("wolfJCE KeyAgreement.generateSecret()")
+    public static final class JceKeyAgreement extends CryptoEvent { }
+
+    /** wolfJCE KeyPairGenerator.generateKeyPair() */
+    @Name("com.wolfssl.wolfcrypt.JceKeyGeneration")
+    @Label("JCE Key Generation")
+    @Description("wolfJCE KeyPairGenerator.generateKeyPair()")
+    public static final class JceKeyGeneration extends CryptoEvent { }
+
+    /* indexed by CryptoEvents type */
+    private final EventType[] types = new EventType[CryptoEvents.TYPES];
+
+    /** Create JfrEventSink, registering all event types with JFR */
+    public JfrEventSink() {
+        types[CryptoEvents.RSA_SIGN] =
+            EventType.getEventType(RsaSign.class);
+        types[CryptoEvents.RSA_DECRYPT] =
+            EventType.getEventType(RsaDecrypt.class);
+        types[CryptoEvents.ECC_SIGN] =
+            EventType.getEventType(EccSign.class);
+        types[CryptoEvents.ECC_VERIFY] =
+            EventType.getEventType(EccVerify.class);
+        types[CryptoEvents.ECC_SHARED_SECRET] =
+            EventType.getEventType(EccSharedSecret.class);
+        types[CryptoEvents.DH_AGREE] =
+            EventType.getEventType(DhAgree.class);
+        types[CryptoEvents.KEY_GENERATION] =
+            EventType.getEventType(KeyGeneration.class);
+        types[CryptoEvents.RNG_SEED] =
+            EventType.getEventType(RngSeed.class);
+        types[CryptoEvents.JCE_SIGN] =
+            EventType.getEventType(JceSign.class);
+        types[CryptoEvents.JCE_VERIFY] =
+            EventType.getEventType(JceVerify.class);
+        types[CryptoEvents.JCE_KEY_AGREEMENT] =
+            EventType.getEventType(JceKeyAgreement.class);
+        types[CryptoEvents.JCE_KEY_GENERATION] =
+            EventType.getEventType(JceKeyGeneration.class);
+    }
+
+    @Override
+    public Object begin(int type) {
+
+        if (type < 0 || type >= types.length || !types[type].isEnabled()) {
+            return null;
+        }
+
+        CryptoEvent event = create(type);
+        event.begin();
+
+        return event;
+    }
+
+    @Override
+    public void commit(Object event, String algorithm, int keySize,
+        String curve) {
+
+        CryptoEvent e = (CryptoEvent)event;
+
+        e.end();
+        if (e.shouldCommit()) {
+            e.algorithm = algorithm;
+            e.keySize = keySize;
+            e.curve = curve;
+            e.commit();
+        }
+    }
+
+    private static CryptoEvent create(int type) {
+
+        switch (type) {
+            case CryptoEvents.RSA_SIGN:
+                return new RsaSign();
+            case CryptoEvents.RSA_DECRYPT:
+                return new RsaDecrypt();
+            case CryptoEvents.ECC_SIGN:
+                return new EccSign();
+            case CryptoEvents.ECC_VERIFY:
+                return new EccVerify();
+            case CryptoEvents.ECC_SHARED_SECRET:
+                return new EccSharedSecret();
+            case CryptoEvents.DH_AGREE:
+                return new DhAgree();
+            case CryptoEvents.KEY_GENERATION:
+                return new KeyGeneration();
+            case CryptoEvents.RNG_SEED:
+                return new RngSeed();
+            case CryptoEvents.JCE_SIGN:
+                return new JceSign();
+            case CryptoEvents.JCE_VERIFY:
+                return new JceVerify();
+            case CryptoEvents.JCE_KEY_AGREEMENT:
+                return new JceKeyAgreement();
+            case CryptoEvents.JCE_KEY_GENERATION:
+                return new JceKeyGeneration();
+            default:
+                throw new IllegalArgumentException(
+                    "Unknown event type: " + type);
+        }
+    }
+}
@@ -22,15 +22,18 @@
 package com.wolfssl.provider.jce;
 
 import java.util.Arrays;
+import java.nio.ByteBuffer;
 
 import javax.crypto.Cipher;
 import javax.crypto.CipherSpi;
 import javax.crypto.SecretKey;
 import javax.crypto.BadPaddingException;
+import javax.crypto.AEADBadTagException;
 import javax.crypto.ShortBufferException;
 import javax.crypto.IllegalBlockSizeException;
 import javax.crypto.NoSuchPaddingException;
 import javax.crypto.spec.IvParameterSpec;
+import javax.crypto.spec.GCMParameterSpec;
 
 import java.security.SecureRandom;
 import java.security.AlgorithmParameters;
@@ -49,6 +52,11 @@ import com.wolfssl.wolfcrypt.Aes;
 import com.wolfssl.wolfcrypt.Des3;
 import com.wolfssl.wolfcrypt.Rsa;
 import com.wolfssl.wolfcrypt.Rng;
+import com.wolfssl.wolfcrypt.RngPool;
+import com.wolfssl.wolfcrypt.FeatureDetect;
+import com.wolfssl.wolfcrypt.Metrics;
+import com.wolfssl.wolfcrypt.WolfCryptError;
+import com.wolfssl.wolfcrypt.WolfCryptException;
 
 import com.wolfssl.provider.jce.WolfCryptDebug;
 
@@ -65,7 +73,9 @@ public class WolfCryptCipher extends CipherSpi {
 
     enum CipherMode {
         WC_ECB,
-        WC_CBC
+        WC_CBC,
+        WC_GCM,
+        WC_CTR
     }
 
     enum PaddingType {
@@ -95,7 +105,6 @@ public class WolfCryptCipher extends CipherSpi {
     private Aes  aes  = null;
     private Des3 des3 = null;
     private Rsa  rsa  = null;
-    private Rng  rng  = null;
 
     /* for debug logging */
     private WolfCryptDebug debug;
@@ -107,8 +116,29 @@ public class WolfCryptCipher extends CipherSpi {
     private AlgorithmParameterSpec storedSpec = null;
     private byte[] iv = null;
 
-    /* buffered data from update calls */
-    private byte[] buffered = new byte[0];
+    /* buffered data from update calls, first bufferedLen bytes are valid.
+     * Block modes only carry a partial block (or a held back last block
+     * and tag when decrypting) so the array is sized once and reused. RSA
+     * and non-streaming GCM grow it to hold the whole message. */
+    private byte[] buffered = null;
+    private int bufferedLen = 0;
+
+    /* AES-GCM tag length in bytes and additional authenticated data */
+    private int gcmTagLen = Aes.GCM_TAG_SIZE;
+    private byte[] aad = new byte[0];
+
+    /* set after a GCM encrypt with a caller-supplied IV, to prevent
+     * reusing the same key and IV for another encryption */
+    private boolean gcmNeedsNewIV = false;
+
+    /* use native AES-GCM streaming API to encrypt if available, otherwise
+     * all GCM data is buffered until final. See gcmStreaming(). */
+    private boolean gcmStream = false;
+
+    /* set once GCM data has been processed, AAD may no longer be added */
+    private boolean gcmDataStarted = false;
+
+    private Metrics.Operation finalMetrics;
 
     private WolfCryptCipher(CipherType type, CipherMode mode,
             PaddingType pad) {
@@ -117,13 +147,13 @@ public class WolfCryptCipher extends CipherSpi {
         this.cipherMode = mode;
         this.paddingType = pad;
 
-        this.rng = new Rng();
-        this.rng.init();
-
         switch (cipherType) {
             case WC_AES:
                 aes = new Aes();
                 blockSize = Aes.BLOCK_SIZE;
+                if (cipherMode == CipherMode.WC_GCM) {
+                    gcmStream = FeatureDetect.AesGcmStreamEnabled();
+                }
                 break;
 
             case WC_DES3:
@@ -133,11 +163,16 @@ public class WolfCryptCipher extends CipherSpi {
 
             case WC_RSA:
                 rsa = new Rsa();
-                rsa.setRng(this.rng);
                 break;
         }
 
-        if (debug.DEBUG) {
+        /* room for a partial block plus a held back block or GCM tag */
+        buffered = new byte[Math.max(2 * blockSize, Aes.GCM_TAG_SIZE)];
+
+        finalMetrics = Metrics.operation(typeToString(cipherType) + "/" +
+            modeToString(cipherMode), "engineDoFinal");
+
+        if (debug.enabled()) {
             algString = typeToString(cipherType);
             algMode = modeToString(cipherMode);
         }
@@ -156,10 +191,32 @@ public class WolfCryptCipher extends CipherSpi {
                 cipherMode = CipherMode.WC_ECB;
                 supported = 1;
 
-                if (debug.DEBUG)
+                if (debug.enabled())
                     log("set mode to ECB");
             }
 
+        } else if (mode.equals("GCM")) {
+
+            /* AES supports GCM */
+            if (cipherType == CipherType.WC_AES) {
+                cipherMode = CipherMode.WC_GCM;
+                supported = 1;
+
+                if (debug.enabled())
+                    log("set mode to GCM");
+            }
+
+        } else if (mode.equals("CTR")) {
+
+            /* AES supports CTR */
+            if (cipherType == CipherType.WC_AES) {
+                cipherMode = CipherMode.WC_CTR;
+                supported = 1;
+
+                if (debug.enabled())
+                    log("set mode to CTR");
+            }
+
         } else if (mode.equals("CBC")) {
 
             /* AES and 3DES support CBC */
@@ -168,7 +225,7 @@ public class WolfCryptCipher extends CipherSpi {
                 cipherMode = CipherMode.WC_CBC;
                 supported = 1;
 
-                if (debug.DEBUG)
+                if (debug.enabled())
                     log("set mode to CBC");
             }
         }
@@ -192,7 +249,7 @@ public class WolfCryptCipher extends CipherSpi {
                 paddingType = PaddingType.WC_NONE;
                 supported = 1;
 
-                if (debug.DEBUG)
+                if (debug.enabled())
                     log("set padding to NoPadding");
             }
 
@@ -202,17 +259,19 @@ public class WolfCryptCipher extends CipherSpi {
                 paddingType = PaddingType.WC_PKCS1;
                 supported = 1;
 
-                if (debug.DEBUG)
+                if (debug.enabled())
                     log("set padding to PKCS1Padding");
             }
 
         } else if (padding.equals("PKCS5Padding")) {
 
-            if (cipherType == CipherType.WC_AES) {
+            if (cipherType == CipherType.WC_AES &&
+                cipherMode != CipherMode.WC_GCM &&
+                cipherMode != CipherMode.WC_CTR) {
                 paddingType = PaddingType.WC_PKCS5;
                 supported = 1;
 
-                if (debug.DEBUG)
+                if (debug.enabled())
                     log("set padding to PKCS5Padding");
             }
         }
@@ -236,13 +295,26 @@ public class WolfCryptCipher extends CipherSpi {
 
         switch (this.cipherType) {
             case WC_AES:
-                if (paddingType == PaddingType.WC_NONE) {
+                if (cipherMode == CipherMode.WC_GCM) {
+                    /* ciphertext is followed by the auth tag */
+                    size = bufferedLen + inputLen;
+                    if (this.direction == OpMode.WC_DECRYPT) {
+                        size = Math.max(0, size - gcmTagLen);
+                    } else {
+                        size += gcmTagLen;
+                    }
+                }
+                else if (cipherMode == CipherMode.WC_CTR) {
+                    /* stream mode, output is same size as input */
+                    size = inputLen;
+                }
+                else if (paddingType == PaddingType.WC_NONE) {
                     /* wolfCrypt expects input to be padded by application to
                      * block size, thus output is same size as input */
                     size = inputLen;
                 }
                 else if (paddingType == PaddingType.WC_PKCS5) {
-                    size = buffered.length + inputLen;
+                    size = bufferedLen + inputLen;
                     size += Aes.getPKCS7PadSize(size, Aes.BLOCK_SIZE);
                 }
                 else {
@@ -259,7 +331,7 @@ public class WolfCryptCipher extends CipherSpi {
                     size = inputLen;
                 }
                 else if (paddingType == PaddingType.WC_PKCS5) {
-                    size = buffered.length + inputLen;
+                    size = bufferedLen + inputLen;
                     size += Des3.getPKCS7PadSize(size, Des3.BLOCK_SIZE);
                 }
                 else {
@@ -318,6 +390,11 @@ public class WolfCryptCipher extends CipherSpi {
         if (this.cipherType == CipherType.WC_RSA)
             return;
 
+        if (this.cipherMode == CipherMode.WC_GCM) {
+            wolfCryptSetGcmIV(spec, random);
+            return;
+        }
+
         /* store IV, or generate random IV if not available */
         if (spec == null) {
             this.iv = new byte[this.blockSize];
@@ -348,6 +425,55 @@ public class WolfCryptCipher extends CipherSpi {
         }
     }
 
+    private void wolfCryptSetGcmIV(AlgorithmParameterSpec spec,
+            SecureRandom random) throws InvalidAlgorithmParameterException {
+
+        this.gcmNeedsNewIV = false;
+
+        if (spec == null) {
+            /* decrypt needs the IV used during encryption */
+            if (this.direction == OpMode.WC_DECRYPT) {
+                throw new InvalidAlgorithmParameterException(
+                    "AES-GCM decryption requires a GCMParameterSpec");
+            }
+
+            this.gcmTagLen = Aes.GCM_TAG_SIZE;
+            this.iv = new byte[Aes.GCM_NONCE_SIZE];
+
+            if (random != null) {
+                random.nextBytes(this.iv);
+            } else {
+                SecureRandom rand = new SecureRandom();
+                rand.nextBytes(this.iv);
+            }
+
+        } else if (spec instanceof GCMParameterSpec) {
+
+            GCMParameterSpec gcmSpec = (GCMParameterSpec)spec;
+
+            /* tag length is given in bits, wolfCrypt supports 96-128 bit
+             * tags in 8 bit increments */
+            if (gcmSpec.getTLen() < 96 || gcmSpec.getTLen() > 128 ||
+                (gcmSpec.getTLen() % 8) != 0) {
+                throw new InvalidAlgorithmParameterException(
+                    "Unsupported GCM tag length (" + gcmSpec.getTLen() +
+                    " bits), must be 96, 104, 112, 120 or 128 bits");
+            }
+
+            if (gcmSpec.getIV() == null || gcmSpec.getIV().length == 0) {
+                throw new InvalidAlgorithmParameterException(
+                    "GCM IV must not be null or zero length");
+            }
+
+            this.gcmTagLen = gcmSpec.getTLen() / 8;
+            this.iv = gcmSpec.getIV();
+
+        } else {
+            throw new InvalidAlgorithmParameterException(
+                "AlgorithmParameterSpec must be of type GCMParameterSpec");
+        }
+    }
+
     private void wolfCryptSetKey(Key key)
         throws InvalidKeyException {
 
@@ -385,7 +511,13 @@ public class WolfCryptCipher extends CipherSpi {
 
         switch (cipherType) {
             case WC_AES:
-                if (this.direction == OpMode.WC_ENCRYPT) {
+                if (this.cipherMode == CipherMode.WC_GCM) {
+                    this.aes.gcmSetKey(encodedKey);
+                    wolfCryptGcmStart();
+                } else if (this.cipherMode == CipherMode.WC_CTR) {
+                    /* same keystream used for encrypt and decrypt */
+                    this.aes.ctrSetKey(encodedKey, iv);
+                } else if (this.direction == OpMode.WC_ENCRYPT) {
                     this.aes.setKey(encodedKey, iv, Aes.ENCRYPT_MODE);
                 } else {
                     this.aes.setKey(encodedKey, iv, Aes.DECRYPT_MODE);
@@ -407,7 +539,6 @@ public class WolfCryptCipher extends CipherSpi {
                     this.rsa.releaseNativeStruct();
 
                 this.rsa = new Rsa();
-                this.rsa.setRng(this.rng);
 
                 if (this.rsaKeyType == RsaKeyType.WC_RSA_PRIVATE) {
 
@@ -428,6 +559,29 @@ public class WolfCryptCipher extends CipherSpi {
         wolfCryptSetDirection(opmode);
         wolfCryptSetIV(spec, random);
         wolfCryptSetKey(key);
+
+        /* discard any state left over from a previous operation */
+        resetBuffered();
+        aad = new byte[0];
+        gcmDataStarted = false;
+    }
+
+    /* AES-GCM is streamed through the native incremental API only when
+     * encrypting. Decrypted data must not be returned before the tag has
+     * been verified (as in SunJCE), so decryption buffers all input and
+     * is done in one shot by wolfCryptFinalGcm(). */
+    private boolean gcmStreaming() {
+        return gcmStream && this.direction == OpMode.WC_ENCRYPT;
+    }
+
+    /* start a new streaming AES-GCM operation with the current IV, key
+     * must already be set */
+    private void wolfCryptGcmStart() {
+
+        if (!gcmStreaming())
+            return;
+
+        this.aes.gcmInit(this.iv, Aes.ENCRYPT_MODE);
     }
 
     @Override
@@ -438,7 +592,7 @@ public class WolfCryptCipher extends CipherSpi {
 
             wolfCryptCipherInit(opmode, key, null, random);
 
-            if (debug.DEBUG)
+            if (debug.enabled())
                 log("initialized with key");
 
         } catch (InvalidAlgorithmParameterException iape) {
@@ -453,7 +607,7 @@ public class WolfCryptCipher extends CipherSpi {
 
         wolfCryptCipherInit(opmode, key, params, random);
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("initialized with key and AlgorithmParameterSpec");
     }
 
@@ -466,9 +620,13 @@ public class WolfCryptCipher extends CipherSpi {
 
         try {
 
-            spec = params.getParameterSpec(IvParameterSpec.class);
+            if (this.cipherMode == CipherMode.WC_GCM) {
+                spec = params.getParameterSpec(GCMParameterSpec.class);
+            } else {
+                spec = params.getParameterSpec(IvParameterSpec.class);
+            }
 
-            if (debug.DEBUG)
+            if (debug.enabled())
                 log("initialized with key and AlgorithmParameters");
 
         } catch (InvalidParameterSpecException ipe) {
@@ -509,103 +667,239 @@ public class WolfCryptCipher extends CipherSpi {
         return 1;
     }
 
-    private byte[] wolfCryptUpdate(byte[] input, int inputOffset, int len) {
+    /* zero and discard buffered data, keeping the array for reuse */
+    private void resetBuffered() {
 
-        int  blocks    = 0;
-        int  remaining = 0;
-        int  bytesToProcess = 0;
-        byte[] output  = null;
-        byte[] tmpIn   = null;
-        byte[] tmpBuf  = null;
+        Arrays.fill(buffered, 0, bufferedLen, (byte)0);
+        bufferedLen = 0;
+    }
 
-        if (input == null || len < 0)
-            throw new IllegalArgumentException("Null input buffer or len < 0");
+    /* append len bytes of input to buffered, growing it only if needed */
+    private void appendBuffered(byte[] input, int inputOffset, int len) {
 
-        if ((buffered.length + len) == 0) {
-            /* no data to process */
-            return null;
+        byte[] tmp = null;
+
+        if (bufferedLen + len > buffered.length) {
+            tmp = new byte[Math.max(bufferedLen + len, 2 * buffered.length)];
+            System.arraycopy(buffered, 0, tmp, 0, bufferedLen);
+            Arrays.fill(buffered, 0, bufferedLen, (byte)0);
+            buffered = tmp;
         }
 
-        if (len > 0) {
-            /* add input bytes to buffered */
-            tmpIn = new byte[buffered.length + len];
-            System.arraycopy(buffered, 0, tmpIn, 0, buffered.length);
-            System.arraycopy(input, inputOffset, tmpIn, buffered.length, len);
-            buffered = tmpIn;
+        System.arraycopy(input, inputOffset, buffered, bufferedLen, len);
+        bufferedLen += len;
+    }
+
+    /* drop the first len bytes of buffered, moving the rest to the front */
+    private void consumeBuffered(int len) {
+
+        System.arraycopy(buffered, len, buffered, 0, bufferedLen - len);
+        Arrays.fill(buffered, bufferedLen - len, bufferedLen, (byte)0);
+        bufferedLen -= len;
+    }
+
+    /* number of bytes wolfCryptUpdate() will write for len more input
+     * bytes, given what is currently buffered */
+    private int wolfCryptUpdateSize(int len) {
+
+        int totalSz = bufferedLen + len;
+        int size = 0;
+
+        if (cipherType == CipherType.WC_RSA) {
+            /* processed in final */
+            size = 0;
+        }
+        else if (cipherMode == CipherMode.WC_CTR) {
+            size = len;
+        }
+        else if (cipherMode == CipherMode.WC_GCM) {
+            if (!gcmStreaming()) {
+                /* processed in final, decrypted data is only released
+                 * after the tag is verified */
+                size = 0;
+            } else {
+                size = totalSz;
+            }
+        }
+        else {
+            size = totalSz - (totalSz % blockSize);
+
+            /* if PKCS#5/7 padding, and decrypting, hold on to last block for
+             * padding check in wolfCryptFinal() */
+            if (paddingType == PaddingType.WC_PKCS5 &&
+                direction == OpMode.WC_DECRYPT && size > 0) {
+                size -= blockSize;
+            }
         }
 
-        /* keep buffered data if RSA or data is less than block size */
-        if (cipherType == CipherType.WC_RSA ||
-            buffered.length < blockSize) {
-            return new byte[0];
+        return size;
+    }
+
+    /* process one full block of input, or the front of buffered, into
+     * output */
+    private int wolfCryptUpdateBlock(byte[] input, int inputOffset,
+            int len, byte[] output, int outputOffset)
+        throws ShortBufferException {
+
+        if (cipherType == CipherType.WC_AES) {
+            return this.aes.update(input, inputOffset, len, output,
+                outputOffset);
         }
 
-        /* calculate blocks and partial non-block size remaining */
-        blocks    = buffered.length / blockSize;
-        remaining = buffered.length % blockSize;
-        bytesToProcess = blocks * blockSize;
+        return this.des3.update(input, inputOffset, len, output,
+            outputOffset);
+    }
+
+    /* true if writing outSz bytes to output at outputOffset can overlap
+     * input in the same array. Identical ranges with nothing carried are
+     * processed in place, output then never runs ahead of input. */
+    private boolean updateRangesOverlap(byte[] input, int inputOffset,
+            int len, byte[] output, int outputOffset, int outSz) {
 
-        /* if PKCS#5/7 padding, and decrypting, hold on to last block for
-         * padding check in wolfCryptFinal() */
-        if (paddingType == PaddingType.WC_PKCS5 &&
-            direction == OpMode.WC_DECRYPT) {
-            bytesToProcess -= blockSize;
+        if (input != output || len == 0 || outSz == 0) {
+            return false;
         }
 
-        /* not enough data to process yet return until more or final */
-        if (bytesToProcess == 0) {
-            return new byte[0];
+        if (inputOffset == outputOffset && bufferedLen == 0) {
+            return false;
         }
 
-        tmpIn = new byte[bytesToProcess];
-        System.arraycopy(buffered, 0, tmpIn, 0, bytesToProcess);
+        return (inputOffset < outputOffset + outSz) &&
+               (outputOffset < inputOffset + len);
+    }
 
-        /* buffer remaining non-block size input, or reset */
-        tmpBuf = new byte[buffered.length - bytesToProcess];
-        System.arraycopy(buffered, bytesToProcess, tmpBuf, 0, tmpBuf.length);
-        buffered = tmpBuf;
+    /* Process input, writing all available output directly to output at
+     * outputOffset. Only a partial block, a held back padding block, or a
+     * possible GCM tag are carried over in buffered between calls, so no
+     * heap allocation is done for block sized or larger updates.
+     * Returns number of bytes written to output. */
+    private int wolfCryptUpdate(byte[] input, int inputOffset, int len,
+            byte[] output, int outputOffset) throws ShortBufferException {
 
-        /* process tmpIn[] */
-        switch (this.cipherType) {
+        int outSz = 0;
+        int total = 0;
+        int chunk = 0;
 
-            case WC_AES:
-                output = this.aes.update(tmpIn, 0, tmpIn.length);
+        if (input == null || len < 0)
+            throw new IllegalArgumentException("Null input buffer or len < 0");
 
-                /* truncate */
-                output = Arrays.copyOfRange(output, 0, tmpIn.length);
+        if (cipherMode == CipherMode.WC_GCM && gcmNeedsNewIV) {
+            throw new IllegalStateException(
+                "Cipher must be re-initialized with a new IV before " +
+                "another AES-GCM encryption");
+        }
 
-                break;
+        outSz = wolfCryptUpdateSize(len);
+        if (outSz > 0 &&
+            (output == null || outputOffset < 0 ||
+             output.length - outputOffset < outSz)) {
+            throw new ShortBufferException(
+                "Output buffer too small, need " + outSz + " bytes");
+        }
 
-            case WC_DES3:
-                output = this.des3.update(tmpIn, 0, tmpIn.length);
+        if (cipherMode == CipherMode.WC_GCM && len > 0) {
+            gcmDataStarted = true;
+        }
 
-                /* truncate */
-                output = Arrays.copyOfRange(output, 0, tmpIn.length);
+        /* output could overwrite input not yet read if the ranges overlap
+         * in the same array, work from a copy in that case */
+        if (updateRangesOverlap(input, inputOffset, len, output,
+                outputOffset, outSz)) {
+            input = Arrays.copyOfRange(input, inputOffset, inputOffset + len);
+            inputOffset = 0;
+        }
 
-                break;
+        /* CTR keeps keystream position natively, nothing to buffer */
+        if (cipherMode == CipherMode.WC_CTR) {
+            return this.aes.ctrUpdate(input, inputOffset, len, output,
+                outputOffset);
+        }
 
-            default:
-                throw new RuntimeException("Unsupported algorithm type");
-        };
+        if (cipherMode == CipherMode.WC_GCM && gcmStreaming()) {
+            /* encrypting, everything is output and nothing is carried */
+            chunk = Math.min(bufferedLen, outSz);
+            if (chunk > 0) {
+                this.aes.gcmUpdate(buffered, 0, chunk, output, outputOffset);
+                consumeBuffered(chunk);
+            }
+            if (outSz - chunk > 0) {
+                this.aes.gcmUpdate(input, inputOffset, outSz - chunk, output,
+                    outputOffset + chunk);
+                inputOffset += outSz - chunk;
+                len -= outSz - chunk;
+            }
+            appendBuffered(input, inputOffset, len);
 
-        if (output == null) {
-            /* For interop compatibility, return empty byte array */
-            output = new byte[0];
+            return outSz;
         }
 
-        return output;
+        /* keep data buffered if RSA or GCM (processed in final), or not
+         * enough data for a block yet */
+        if (outSz == 0) {
+            appendBuffered(input, inputOffset, len);
+            return 0;
+        }
+
+        /* finish blocks started in buffered, at most two are carried */
+        while (bufferedLen > 0 && total < outSz) {
+            if (bufferedLen < blockSize) {
+                chunk = blockSize - bufferedLen;
+                appendBuffered(input, inputOffset, chunk);
+                inputOffset += chunk;
+                len -= chunk;
+            }
+            total += wolfCryptUpdateBlock(buffered, 0, blockSize, output,
+                outputOffset + total);
+            consumeBuffered(blockSize);
+        }
+
+        /* remaining whole blocks go straight from input to output */
+        if (outSz - total > 0) {
+            chunk = outSz - total;
+            total += wolfCryptUpdateBlock(input, inputOffset, chunk, output,
+                outputOffset + total);
+            inputOffset += chunk;
+            len -= chunk;
+        }
+
+        /* carry partial block, or block held back for padding check */
+        appendBuffered(input, inputOffset, len);
+
+        return total;
     }
 
     private byte[] wolfCryptFinal(byte[] input, int inputOffset, int len)
         throws IllegalBlockSizeException, BadPaddingException {
 
+        byte[] out;
+        long start = finalMetrics.start();
+
+        try {
+            out = wolfCryptFinalData(input, inputOffset, len);
+        } catch (IllegalBlockSizeException | BadPaddingException |
+                 RuntimeException e) {
+            finalMetrics.error(start);
+            throw e;
+        }
+        finalMetrics.end(start, len);
+
+        return out;
+    }
+
+    private byte[] wolfCryptFinalData(byte[] input, int inputOffset, int len)
+        throws IllegalBlockSizeException, BadPaddingException {
+
         int  totalSz  = 0;
         byte tmpIn[]  = null;
         byte tmpOut[] = null;
 
-        totalSz = buffered.length + len;
+        if (cipherMode == CipherMode.WC_GCM) {
+            return wolfCryptFinalGcm(input, inputOffset, len);
+        }
+
+        totalSz = bufferedLen + len;
 
-        if (isBlockCipher() &&
+        if (isBlockCipher() && cipherMode != CipherMode.WC_CTR &&
             (this.direction == OpMode.WC_DECRYPT ||
             (this.direction == OpMode.WC_ENCRYPT &&
              this.paddingType != PaddingType.WC_PKCS5)) &&
@@ -616,9 +910,9 @@ public class WolfCryptCipher extends CipherSpi {
 
         /* do final encrypt over totalSz */
         tmpIn = new byte[totalSz];
-        System.arraycopy(buffered, 0, tmpIn, 0, buffered.length);
+        System.arraycopy(buffered, 0, tmpIn, 0, bufferedLen);
         if (input != null && len > 0) {
-            System.arraycopy(input, inputOffset, tmpIn, buffered.length, len);
+            System.arraycopy(input, inputOffset, tmpIn, bufferedLen, len);
         }
 
         /* add padding if encrypting and PKCS5 padding is used. PKCS#5 padding
@@ -636,6 +930,11 @@ public class WolfCryptCipher extends CipherSpi {
         switch (this.cipherType) {
 
             case WC_AES:
+                if (this.cipherMode == CipherMode.WC_CTR) {
+                    tmpOut = this.aes.ctrUpdate(tmpIn, 0, tmpIn.length);
+                    break;
+                }
+
                 tmpOut = this.aes.update(tmpIn, 0, tmpIn.length);
 
                 /* truncate */
@@ -665,21 +964,31 @@ public class WolfCryptCipher extends CipherSpi {
 
             case WC_RSA:
 
-                if (this.direction == OpMode.WC_ENCRYPT) {
+                /* RNG from shared pool, set on key for blinding and
+                 * returned once operation completes */
+                Rng rng = RngPool.acquire();
 
-                    if (this.rsaKeyType == RsaKeyType.WC_RSA_PRIVATE) {
-                        tmpOut = this.rsa.sign(tmpIn, this.rng);
+                try {
+                    this.rsa.setRng(rng);
 
-                    } else {
-                        tmpOut = this.rsa.encrypt(tmpIn, this.rng);
-                    }
+                    if (this.direction == OpMode.WC_ENCRYPT) {
+
+                        if (this.rsaKeyType == RsaKeyType.WC_RSA_PRIVATE) {
+                            tmpOut = this.rsa.sign(tmpIn, rng);
+
+                        } else {
+                            tmpOut = this.rsa.encrypt(tmpIn, rng);
+                        }
 
-                } else {
-                    if (this.rsaKeyType == RsaKeyType.WC_RSA_PRIVATE) {
-                        tmpOut = this.rsa.decrypt(tmpIn);
                     } else {
-                        tmpOut = this.rsa.verify(tmpIn);
+                        if (this.rsaKeyType == RsaKeyType.WC_RSA_PRIVATE) {
+                            tmpOut = this.rsa.decrypt(tmpIn);
+                        } else {
+                            tmpOut = this.rsa.verify(tmpIn);
+                        }
                     }
+                } finally {
+                    RngPool.release(rng);
                 }
                 break;
 
@@ -687,9 +996,17 @@ public class WolfCryptCipher extends CipherSpi {
                 throw new RuntimeException("Unsupported algorithm type");
         };
 
-        /* reset state, user doesn't need to call init again before use */
+        wolfCryptFinalReset();
+
+        return tmpOut;
+    }
+
+    /* reset state after final, user doesn't need to call init again
+     * before use */
+    private void wolfCryptFinalReset() {
+
         try {
-            buffered = new byte[0];
+            resetBuffered();
             if (this.direction == OpMode.WC_ENCRYPT) {
                 wolfCryptSetDirection(Cipher.ENCRYPT_MODE);
             } else {
@@ -704,20 +1021,274 @@ public class WolfCryptCipher extends CipherSpi {
         } catch (InvalidAlgorithmParameterException e) {
             throw new RuntimeException(e.getMessage());
         }
+    }
+
+    /* return true if input and output can be passed straight to the native
+     * ByteBuffer API. Only CBC and CTR with no data buffered from a previous
+     * call qualify, everything else goes through the byte[] path. */
+    private boolean canUseDirectBuffers(ByteBuffer input, ByteBuffer output) {
+
+        if (input == null || output == null ||
+            !input.isDirect() || !output.isDirect() || output.isReadOnly()) {
+            return false;
+        }
+
+        if (this.direction == null || bufferedLen != 0) {
+            return false;
+        }
+
+        if (cipherType == CipherType.WC_AES) {
+            return (cipherMode == CipherMode.WC_CBC ||
+                    cipherMode == CipherMode.WC_CTR);
+        }
+
+        return (cipherType == CipherType.WC_DES3);
+    }
+
+    /* process len bytes from input position directly into output using the
+     * native ByteBuffer API, advancing both buffer positions */
+    private int wolfCryptProcessDirect(ByteBuffer input, int len,
+            ByteBuffer output) throws ShortBufferException {
+
+        int ret = 0;
+        int limit = input.limit();
+
+        if (len == 0) {
+            return 0;
+        }
+
+        try {
+            /* limit input to len bytes without creating a new view */
+            input.limit(input.position() + len);
+
+            if (cipherMode == CipherMode.WC_CTR) {
+                ret = this.aes.ctrUpdate(input, output);
+            } else if (cipherType == CipherType.WC_AES) {
+                ret = this.aes.update(input, output);
+            } else {
+                ret = this.des3.update(input, output);
+            }
+
+        } finally {
+            input.limit(limit);
+        }
+
+        return ret;
+    }
+
+    /* ByteBuffer version of wolfCryptUpdate(), whole blocks are processed in
+     * place and a trailing partial block is kept in buffered */
+    private int wolfCryptUpdateDirect(ByteBuffer input, ByteBuffer output)
+        throws ShortBufferException {
+
+        int len = input.remaining();
+        int bytesToProcess = len;
+        int ret = 0;
+
+        if (cipherMode != CipherMode.WC_CTR) {
+            bytesToProcess -= (len % blockSize);
+
+            /* if PKCS#5/7 padding, and decrypting, hold on to last block
+             * for padding check in wolfCryptFinal() */
+            if (paddingType == PaddingType.WC_PKCS5 &&
+                direction == OpMode.WC_DECRYPT && bytesToProcess > 0) {
+                bytesToProcess -= blockSize;
+            }
+        }
+
+        if (output.remaining() < bytesToProcess) {
+            throw new ShortBufferException(
+                "Output buffer too small, need " + bytesToProcess +
+                " bytes");
+        }
+
+        ret = wolfCryptProcessDirect(input, bytesToProcess, output);
+
+        if (input.hasRemaining()) {
+            bufferedLen = input.remaining();
+            input.get(buffered, 0, bufferedLen);
+        }
+
+        return ret;
+    }
+
+    private byte[] wolfCryptFinalGcm(byte[] input, int inputOffset, int len)
+        throws AEADBadTagException {
+
+        int totalSz = 0;
+        byte[] tmpIn  = null;
+        byte[] tmpOut = null;
+        byte[] tag    = null;
+
+        if (gcmNeedsNewIV) {
+            throw new IllegalStateException(
+                "Cipher must be re-initialized with a new IV before " +
+                "another AES-GCM encryption");
+        }
+
+        try {
+            if (gcmStreaming()) {
+                tmpOut = wolfCryptFinalGcmStream(input, inputOffset, len);
+
+            } else {
+                totalSz = bufferedLen + len;
+                tmpIn = new byte[totalSz];
+                System.arraycopy(buffered, 0, tmpIn, 0, bufferedLen);
+                if (input != null && len > 0) {
+                    System.arraycopy(input, inputOffset, tmpIn,
+                        bufferedLen, len);
+                }
+
+                if (this.direction == OpMode.WC_ENCRYPT) {
+                    tag = new byte[gcmTagLen];
+                    tmpOut = new byte[totalSz + gcmTagLen];
+
+                    this.aes.gcmEncrypt(tmpIn, 0, totalSz, tmpOut, 0, this.iv,
+                        tag, this.aad);
+
+                    /* append tag to ciphertext */
+                    System.arraycopy(tag, 0, tmpOut, totalSz, gcmTagLen);
+
+                } else {
+                    if (totalSz < gcmTagLen) {
+                        throw new AEADBadTagException(
+                            "Input too short to contain GCM tag");
+                    }
+
+                    tag = Arrays.copyOfRange(tmpIn, totalSz - gcmTagLen,
+                        totalSz);
+                    tmpOut = new byte[totalSz - gcmTagLen];
+
+                    this.aes.gcmDecrypt(tmpIn, 0, totalSz - gcmTagLen, tmpOut,
+                        0, this.iv, tag, this.aad);
+                }
+            }
+
+        } catch (ShortBufferException e) {
+            /* output sized above, should not happen */
+            throw new RuntimeException(e.getMessage());
+
+        } catch (WolfCryptException e) {
+            if (e.getError() == WolfCryptError.AES_GCM_AUTH_E) {
+                throw new AEADBadTagException("GCM tag mismatch");
+            }
+            throw e;
+
+        } finally {
+            /* reset state, same key and IV may be used again to decrypt,
+             * but a caller-supplied IV must not be reused to encrypt */
+            resetBuffered();
+            aad = new byte[0];
+            gcmDataStarted = false;
+
+            if (this.direction == OpMode.WC_ENCRYPT) {
+                if (storedSpec == null) {
+                    try {
+                        wolfCryptSetIV(null, null);
+                    } catch (InvalidAlgorithmParameterException e) {
+                        throw new RuntimeException(e.getMessage());
+                    }
+                } else {
+                    gcmNeedsNewIV = true;
+                }
+            }
+
+            if (!gcmNeedsNewIV) {
+                wolfCryptGcmStart();
+            }
+        }
 
         return tmpOut;
     }
 
+    /* finish a streaming AES-GCM encryption, see gcmStreaming() */
+    private byte[] wolfCryptFinalGcmStream(byte[] input, int inputOffset,
+            int len) throws ShortBufferException {
+
+        int outSz = 0;
+        byte[] tmpOut = null;
+        byte[] tag    = null;
+
+        if (input == null) {
+            input = new byte[0];
+            inputOffset = 0;
+            len = 0;
+        }
+
+        /* remaining data goes through the streaming update */
+        outSz = wolfCryptUpdateSize(len);
+
+        tmpOut = new byte[outSz + gcmTagLen];
+        wolfCryptUpdate(input, inputOffset, len, tmpOut, 0);
+
+        tag = new byte[gcmTagLen];
+        this.aes.gcmFinal(tag);
+
+        /* append tag to ciphertext */
+        System.arraycopy(tag, 0, tmpOut, outSz, gcmTagLen);
+
+        return tmpOut;
+    }
+
+    @Override
+    protected void engineUpdateAAD(byte[] src, int offset, int len) {
+
+        byte[] tmp = null;
+
+        if (debug.enabled())
+            log("updateAAD (offset: " + offset + ", len: " + len + ")");
+
+        if (cipherMode != CipherMode.WC_GCM) {
+            throw new IllegalStateException(
+                "AAD only supported in AES-GCM mode");
+        }
+
+        if (this.direction == null) {
+            throw new IllegalStateException("Cipher not initialized");
+        }
+
+        /* all AAD must be supplied before any data, as in SunJCE */
+        if (gcmDataStarted) {
+            throw new IllegalStateException(
+                "AAD must be supplied before encryption/decryption data");
+        }
+
+        if (src == null || offset < 0 || len < 0 ||
+            offset + len > src.length) {
+            throw new IllegalArgumentException("Invalid AAD buffer");
+        }
+
+        if (gcmStreaming()) {
+            this.aes.gcmUpdateAad(src, offset, len);
+            return;
+        }
+
+        tmp = new byte[aad.length + len];
+        System.arraycopy(aad, 0, tmp, 0, aad.length);
+        System.arraycopy(src, offset, tmp, aad.length, len);
+        aad = tmp;
+    }
+
     @Override
     protected byte[] engineUpdate(byte[] input, int inputOffset, int inputLen) {
 
         byte output[];
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("update (offset: " + inputOffset + ", len: " +
                 inputLen + ")");
 
-        output = wolfCryptUpdate(input, inputOffset, inputLen);
+        if (input == null || inputLen < 0)
+            throw new IllegalArgumentException("Null input buffer or len < 0");
+
+        output = new byte[wolfCryptUpdateSize(inputLen)];
+
+        try {
+            wolfCryptUpdate(input, inputOffset, inputLen, output, 0);
+        } catch (ShortBufferException e) {
+            /* output sized above, should not happen */
+            throw new RuntimeException(e.getMessage());
+        }
 
         return output;
     }
@@ -727,29 +1298,27 @@ public class WolfCryptCipher extends CipherSpi {
             byte[] output, int outputOffset)
         throws ShortBufferException {
 
-        byte tmpOut[];
-
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("update (in offset: " + inputOffset + ", len: " +
                 inputLen + ", out offset: " + outputOffset + ")");
 
-        tmpOut = wolfCryptUpdate(input, inputOffset, inputLen);
-        if (tmpOut == null) {
-            return 0;
-        }
-        System.arraycopy(tmpOut, 0, output, outputOffset, tmpOut.length);
-
-        return tmpOut.length;
+        return wolfCryptUpdate(input, inputOffset, inputLen, output,
+            outputOffset);
     }
 
-    private void zeroArray(byte[] in) {
+    @Override
+    protected int engineUpdate(ByteBuffer input, ByteBuffer output)
+        throws ShortBufferException {
 
-        if (in == null)
-            return;
+        if (debug.enabled())
+            log("update (ByteBuffer, direct: " + input.isDirect() +
+                ", len: " + input.remaining() + ")");
 
-        for (int i = 0; i < in.length; i++) {
-            in[i] = 0;
+        if (!canUseDirectBuffers(input, output)) {
+            return super.engineUpdate(input, output);
         }
+
+        return wolfCryptUpdateDirect(input, output);
     }
 
     @Override
@@ -757,7 +1326,7 @@ public class WolfCryptCipher extends CipherSpi {
             int inputLen)
         throws IllegalBlockSizeException, BadPaddingException {
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("final (offset: " + inputOffset + ", len: " +
                 inputLen + ")");
 
@@ -772,7 +1341,7 @@ public class WolfCryptCipher extends CipherSpi {
 
         byte tmpOut[];
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("final (in offset: " + inputOffset + ", len: " +
                 inputLen + ", out offset: " + outputOffset + ")");
 
@@ -783,6 +1352,51 @@ public class WolfCryptCipher extends CipherSpi {
         return tmpOut.length;
     }
 
+    @Override
+    protected int engineDoFinal(ByteBuffer input, ByteBuffer output)
+        throws ShortBufferException, IllegalBlockSizeException,
+               BadPaddingException {
+
+        int len = 0;
+        int ret = 0;
+
+        if (debug.enabled())
+            log("final (ByteBuffer, direct: " + input.isDirect() +
+                ", len: " + input.remaining() + ")");
+
+        /* padding needs the whole last block, leave to the byte[] path */
+        if (!canUseDirectBuffers(input, output) ||
+            (cipherMode != CipherMode.WC_CTR &&
+             paddingType != PaddingType.WC_NONE)) {
+            return super.engineDoFinal(input, output);
+        }
+
+        len = input.remaining();
+
+        if (cipherMode != CipherMode.WC_CTR && (len % blockSize) != 0) {
+            throw new IllegalBlockSizeException(
+                    "Input length not multiple of " + blockSize + " bytes");
+        }
+
+        if (output.remaining() < len) {
+            throw new ShortBufferException(
+                "Output buffer too small, need " + len + " bytes");
+        }
+
+        long start = finalMetrics.start();
+        try {
+            ret = wolfCryptProcessDirect(input, len, output);
+        } catch (RuntimeException e) {
+            finalMetrics.error(start);
+            throw e;
+        }
+        finalMetrics.end(start, len);
+
+        wolfCryptFinalReset();
+
+        return ret;
+    }
+
     @Override
     protected int engineGetKeySize(Key key)
         throws InvalidKeyException {
@@ -835,6 +1449,10 @@ public class WolfCryptCipher extends CipherSpi {
                 return "ECB";
             case WC_CBC:
                 return "CBC";
+            case WC_GCM:
+                return "GCM";
+            case WC_CTR:
+                return "CTR";
             default:
                 return "None";
         }
@@ -844,32 +1462,6 @@ public class WolfCryptCipher extends CipherSpi {
         debug.print("[Cipher, " + algString + "-" + algMode + "] " + msg);
     }
 
-    @SuppressWarnings("deprecation")
-    @Override
-    protected void finalize() throws Throwable {
-        try {
-            if (this.aes != null)
-                this.aes.releaseNativeStruct();
-
-            if (this.des3 != null)
-                this.des3.releaseNativeStruct();
-
-            if (this.rsa != null)
-                this.rsa.releaseNativeStruct();
-
-            if (this.rng != null)
-                this.rng.releaseNativeStruct();
-
-            zeroArray(this.iv);
-
-            this.storedKey = null;
-            this.storedSpec = null;
-
-        } finally {
-            super.finalize();
-        }
-    }
-
     /**
      * Class for AES-CBC with no padding
      */
@@ -894,6 +1486,30 @@ public class WolfCryptCipher extends CipherSpi {
         }
     }
 
+    /**
+     * Class for AES-GCM with no padding
+     */
+    public static final class wcAESGCMNoPadding extends WolfCryptCipher {
+        /**
+         * Create new wcAESGCMNoPadding object
+         */
+        public wcAESGCMNoPadding() {
+            super(CipherType.WC_AES, CipherMode.WC_GCM, PaddingType.WC_NONE);
+        }
+    }
+
+    /**
+     * Class for AES-CTR with no padding
+     */
+    public static final class wcAESCTRNoPadding extends WolfCryptCipher {
+        /**
+         * Create new wcAESCTRNoPadding object
+         */
+        public wcAESCTRNoPadding() {
+            super(CipherType.WC_AES, CipherMode.WC_CTR, PaddingType.WC_NONE);
+        }
+    }
+
     /**
      * Class for DES-EDE-CBC with no padding
      */
@@ -21,9 +21,12 @@
 
 package com.wolfssl.provider.jce;
 
+import com.wolfssl.wolfcrypt.Logging;
+
 class WolfCryptDebug {
 
-    public static boolean DEBUG = checkProperty();
+    /* "wolfjce.debug" System property, read once at startup */
+    private static final boolean DEBUG = checkProperty();
 
     private static boolean checkProperty() {
 
@@ -36,6 +39,18 @@ class WolfCryptDebug {
         return false;
     }
 
+    /**
+     * Check if debug output is enabled, by the "wolfjce.debug" System
+     * property or by a runtime JNI log level of JNI_LOG_DEBUG (see
+     * Logging.setNativeLogLevel()). Callers check this before building
+     * debug strings, so disabled debug output costs one volatile read.
+     *
+     * @return true if debug output is enabled, otherwise false
+     */
+    public static boolean enabled() {
+        return DEBUG || Logging.isLogLevelEnabled(Logging.JNI_LOG_DEBUG);
+    }
+
     public static void print(String string) {
         System.out.println("wolfJCE: " + string);
     }
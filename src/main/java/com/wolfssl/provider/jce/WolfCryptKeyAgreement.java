@@ -46,6 +46,8 @@ import java.security.interfaces.ECPrivateKey;
 
 import com.wolfssl.wolfcrypt.Dh;
 import com.wolfssl.wolfcrypt.Ecc;
+import com.wolfssl.wolfcrypt.CryptoEvents;
+import com.wolfssl.wolfcrypt.Metrics;
 
 import com.wolfssl.provider.jce.WolfCryptDebug;
 
@@ -77,6 +79,8 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
     private KeyAgreeType type;
     private EngineState state = EngineState.WC_UNINITIALIZED;
 
+    private Metrics.Operation secretMetrics;
+
     private WolfCryptDebug debug;
     private String algString;
 
@@ -96,7 +100,10 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
                 break;
         };
 
-        if (debug.DEBUG)
+        this.secretMetrics = Metrics.operation(typeToString(type),
+            "engineGenerateSecret");
+
+        if (debug.enabled())
             algString = typeToString(type);
 
         this.state = EngineState.WC_INIT_DONE;
@@ -108,7 +115,7 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
 
         byte[] pubKey = null;
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("engineDoPhase, lastPhase: " + lastPhase);
 
         if (this.state != EngineState.WC_PRIVKEY_DONE)
@@ -187,7 +194,7 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
 
             len = engineGenerateSecret(tmp, 0);
 
-            if (debug.DEBUG)
+            if (debug.enabled())
                 log("generated secret, len: " + len);
 
             /* may need to truncate */
@@ -211,6 +218,33 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
     protected int engineGenerateSecret(byte[] sharedSecret, int offset)
         throws IllegalStateException, ShortBufferException {
 
+        int len;
+        long start = secretMetrics.start();
+        Object event = CryptoEvents.begin(CryptoEvents.JCE_KEY_AGREEMENT);
+
+        try {
+            len = wolfCryptGenerateSecret(sharedSecret, offset);
+        } catch (ShortBufferException | RuntimeException e) {
+            secretMetrics.error(start);
+            throw e;
+        }
+        secretMetrics.end(start, 0);
+
+        if (event != null) {
+            if (this.type == KeyAgreeType.WC_DH) {
+                CryptoEvents.commit(event, "DH", this.primeLen * 8, null);
+            } else {
+                CryptoEvents.commit(event, "ECDH", this.curveSize * 8,
+                    this.curveName);
+            }
+        }
+
+        return len;
+    }
+
+    private int wolfCryptGenerateSecret(byte[] sharedSecret, int offset)
+        throws IllegalStateException, ShortBufferException {
+
         int  ret   = 0;
         byte tmp[] = null;
         long sz[]  = null;
@@ -293,7 +327,7 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
 
         if (tmp != null) {
 
-            if (debug.DEBUG)
+            if (debug.enabled())
                 log("generated secret, len: " + tmp.length);
 
             zeroArray(tmp);
@@ -310,7 +344,7 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
 
         byte secret[] = engineGenerateSecret();
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("generating SecretKey for " + algorithm);
 
         if (algorithm.equals("DES")) {
@@ -410,7 +444,7 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
             /* look up curve size */
             this.curveSize = this.ecPrivate.getCurveSizeFromName(
                                                 this.curveName);
-            if (debug.DEBUG)
+            if (debug.enabled())
                 log("curveName: " + curveName + ", curveSize: " + curveSize);
 
         } else if (spec instanceof ECParameterSpec) {
@@ -421,7 +455,7 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
 
             this.curveSize = this.ecPrivate.getCurveSizeFromName(
                                                 this.curveName);
-            if (debug.DEBUG)
+            if (debug.enabled())
                 log("curveName: " + curveName + ", curveSize: " + curveSize);
 
         } else {
@@ -487,7 +521,7 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
             SecureRandom random)
         throws InvalidKeyException, InvalidAlgorithmParameterException {
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("initialized with key and AlgorithmParameterSpec");
 
         wcKeyAgreementInit(key, params, random);
@@ -501,7 +535,7 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
 
         try {
 
-            if (debug.DEBUG)
+            if (debug.enabled())
                 log("initialized with key");
 
             wcKeyAgreementInit(key, null, random);
@@ -538,31 +572,6 @@ public class WolfCryptKeyAgreement extends KeyAgreementSpi {
         debug.print("[KeyAgreement, " + algString + "] " + msg);
     }
 
-    @SuppressWarnings("deprecation")
-    @Override
-    protected void finalize() throws Throwable {
-        try {
-
-            switch (this.type) {
-                case WC_DH:
-                    if (this.dh != null)
-                        this.dh.releaseNativeStruct();
-                    break;
-
-                case WC_ECDH:
-                    if (this.ecPublic != null)
-                        this.ecPublic.releaseNativeStruct();
-
-                    if (this.ecPrivate != null)
-                        this.ecPrivate.releaseNativeStruct();
-                    break;
-            }
-
-        } finally {
-            super.finalize();
-        }
-    }
-
     /**
      * wolfJCE DH class
      */
@@ -54,7 +54,10 @@ import javax.crypto.spec.DHPublicKeySpec;
 import com.wolfssl.wolfcrypt.Rsa;
 import com.wolfssl.wolfcrypt.Ecc;
 import com.wolfssl.wolfcrypt.Dh;
+import com.wolfssl.wolfcrypt.CryptoEvents;
+import com.wolfssl.wolfcrypt.Metrics;
 import com.wolfssl.wolfcrypt.Rng;
+import com.wolfssl.wolfcrypt.RngPool;
 
 import com.wolfssl.provider.jce.WolfCryptDebug;
 
@@ -78,7 +81,7 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
     private byte[] dhP = null;
     private byte[] dhG = null;
 
-    private Rng rng = null;
+    private Metrics.Operation generateMetrics;
 
     /* for debug logging */
     private WolfCryptDebug debug;
@@ -87,11 +90,10 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
     private WolfCryptKeyPairGenerator(KeyType type) {
 
         this.type = type;
+        this.generateMetrics = Metrics.operation(typeToString(type),
+            "generateKeyPair");
 
-        rng = new Rng();
-        rng.init();
-
-        if (debug.DEBUG)
+        if (debug.enabled())
             algString = typeToString(type);
     }
 
@@ -111,7 +113,7 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
             this.publicExponent = Rsa.getDefaultRsaExponent();
         }
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("init with keysize: " + keysize);
     }
 
@@ -144,7 +146,7 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
                         "RSA public exponent value larger than long");
                 }
 
-                if (debug.DEBUG) {
+                if (debug.enabled()) {
                     log("init with RSA spec, keysize = " + keysize +
                         ", public exponent = " + publicExponent);
                 }
@@ -172,7 +174,7 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
                 this.curve = curveName;
                 this.keysize = curvesize;
 
-                if (debug.DEBUG)
+                if (debug.enabled())
                     log("init with spec, curve: " + curveName +
                         ", keysize: " + curvesize);
 
@@ -194,7 +196,7 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
                         "Invalid parameters, either p or g is null");
                 }
 
-                if ((this.dhP != null) && debug.DEBUG)
+                if ((this.dhP != null) && debug.enabled())
                     log("init with spec, prime len: " + this.dhP.length);
 
                 break;
@@ -208,6 +210,29 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
     @Override
     public KeyPair generateKeyPair() {
 
+        /* get RNG from shared pool, returned once key is generated */
+        Rng rng = RngPool.acquire();
+        long start = generateMetrics.start();
+        Object event = CryptoEvents.begin(CryptoEvents.JCE_KEY_GENERATION);
+
+        try {
+            KeyPair pair = generateKeyPair(rng);
+            generateMetrics.end(start, 0);
+            commitEvent(event);
+
+            return pair;
+
+        } catch (RuntimeException e) {
+            generateMetrics.error(start);
+            throw e;
+
+        } finally {
+            RngPool.release(rng);
+        }
+    }
+
+    private KeyPair generateKeyPair(Rng rng) {
+
         KeyPair pair = null;
 
         byte[] privDer = null;
@@ -265,7 +290,7 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
                     throw new RuntimeException(e);
                 }
 
-                if (debug.DEBUG) {
+                if (debug.enabled()) {
                     log("generated RSA KeyPair");
                 }
 
@@ -321,7 +346,7 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
                     throw new RuntimeException(e);
                 }
 
-                if (debug.DEBUG)
+                if (debug.enabled())
                     log("generated ECC KeyPair");
 
                 break;
@@ -369,7 +394,7 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
                     throw new RuntimeException(e.getMessage());
                 }
 
-                if (debug.DEBUG)
+                if (debug.enabled())
                     log("generated DH KeyPair");
 
                 break;
@@ -382,6 +407,29 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
         return pair;
     }
 
+    /* record event returned by CryptoEvents.begin(), if any */
+    private void commitEvent(Object event) {
+
+        if (event == null) {
+            return;
+        }
+
+        switch (this.type) {
+            case WC_RSA:
+                CryptoEvents.commit(event, "RSA", this.keysize, null);
+                break;
+
+            case WC_ECC:
+                CryptoEvents.commit(event, "EC", 0, this.curve);
+                break;
+
+            case WC_DH:
+                CryptoEvents.commit(event, "DH",
+                    new BigInteger(1, this.dhP).bitLength(), null);
+                break;
+        }
+    }
+
     private String typeToString(KeyType type) {
         switch (type) {
             case WC_RSA:
@@ -399,19 +447,6 @@ public class WolfCryptKeyPairGenerator extends KeyPairGeneratorSpi {
         debug.print("[KeyPairGenerator, " + algString + "] " + msg);
     }
 
-    @SuppressWarnings("deprecation")
-    @Override
-    protected void finalize() throws Throwable {
-        try {
-            if (this.rng != null) {
-                rng.free();
-                rng.releaseNativeStruct();
-            }
-        } finally {
-            super.finalize();
-        }
-    }
-
     private void zeroArray(byte[] in) {
 
         if (in == null)
@@ -36,6 +36,7 @@ import com.wolfssl.wolfcrypt.Sha256;
 import com.wolfssl.wolfcrypt.Sha384;
 import com.wolfssl.wolfcrypt.Sha512;
 import com.wolfssl.wolfcrypt.Hmac;
+import com.wolfssl.wolfcrypt.Metrics;
 
 import com.wolfssl.provider.jce.WolfCryptDebug;
 
@@ -57,6 +58,8 @@ public class WolfCryptMac extends MacSpi {
     private int nativeHmacType = 0;
     private int digestSize = 0;
 
+    private Metrics.Operation finalMetrics;
+
     /* for debug logging */
     private WolfCryptDebug debug;
     private String algString;
@@ -98,16 +101,28 @@ public class WolfCryptMac extends MacSpi {
                     "Unsupported HMAC type");
         }
 
-        if (debug.DEBUG)
+        this.finalMetrics = Metrics.operation("Hmac" + typeToString(type),
+            "engineDoFinal");
+
+        if (debug.enabled())
             algString = typeToString(type);
     }
 
     @Override
     protected byte[] engineDoFinal() {
 
-        byte[] out = this.hmac.doFinal();
+        byte[] out;
+        long start = finalMetrics.start();
+
+        try {
+            out = this.hmac.doFinal();
+        } catch (RuntimeException e) {
+            finalMetrics.error(start);
+            throw e;
+        }
+        finalMetrics.end(start, 0);
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             if (out != null) {
                 log("final digest generated, len: " + out.length);
             } else {
@@ -140,7 +155,7 @@ public class WolfCryptMac extends MacSpi {
 
         this.hmac.setKey(nativeHmacType, encodedKey);
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("init with key and spec");
     }
 
@@ -148,7 +163,7 @@ public class WolfCryptMac extends MacSpi {
     protected void engineReset() {
         this.hmac.reset();
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("engine reset");
     }
 
@@ -156,7 +171,7 @@ public class WolfCryptMac extends MacSpi {
     protected void engineUpdate(byte input) {
         this.hmac.update(input);
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("update with single byte");
     }
 
@@ -164,7 +179,7 @@ public class WolfCryptMac extends MacSpi {
     protected void engineUpdate(byte[] input, int offset, int len) {
         this.hmac.update(input, offset, len);
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("update, offset: " + offset + ", len: " + len);
     }
 
@@ -189,17 +204,6 @@ public class WolfCryptMac extends MacSpi {
         debug.print("[Mac, " + algString + "] " + msg);
     }
 
-    @SuppressWarnings("deprecation")
-    @Override
-    protected void finalize() throws Throwable {
-        try {
-            if (this.hmac != null)
-                this.hmac.releaseNativeStruct();
-        } finally {
-            super.finalize();
-        }
-    }
-
     /**
      * wolfJCE HMAC-MD5 class
      */
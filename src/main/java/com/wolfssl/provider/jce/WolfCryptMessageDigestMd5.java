@@ -72,7 +72,7 @@ public final class WolfCryptMessageDigestMd5
             throw new RuntimeException(e.getMessage());
         }
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("generated final digest, len: " + digest.length);
 
         return digest;
@@ -83,7 +83,7 @@ public final class WolfCryptMessageDigestMd5
 
         this.md5.init();
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("engine reset");
     }
 
@@ -95,7 +95,7 @@ public final class WolfCryptMessageDigestMd5
 
         this.md5.update(tmp, 1);
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("update with single byte");
     }
 
@@ -104,7 +104,7 @@ public final class WolfCryptMessageDigestMd5
 
         this.md5.update(input, offset, len);
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("update, offset: " + offset + ", len: " + len);
     }
 
@@ -122,16 +122,5 @@ public final class WolfCryptMessageDigestMd5
         Md5 md5Copy = new Md5(this.md5);
         return new WolfCryptMessageDigestMd5(md5Copy);
     }
-
-    @SuppressWarnings("deprecation")
-    @Override
-    protected void finalize() throws Throwable {
-        try {
-            if (this.md5 != null)
-                this.md5.releaseNativeStruct();
-        } finally {
-            super.finalize();
-        }
-    }
 }
 
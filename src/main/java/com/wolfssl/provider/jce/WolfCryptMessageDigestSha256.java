@@ -72,7 +72,7 @@ public final class WolfCryptMessageDigestSha256
             throw new RuntimeException(e.getMessage());
         }
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("generated final digest, len: " + digest.length);
 
         return digest;
@@ -83,7 +83,7 @@ public final class WolfCryptMessageDigestSha256
 
         this.sha.init();
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("engine reset");
     }
 
@@ -95,7 +95,7 @@ public final class WolfCryptMessageDigestSha256
 
         this.sha.update(tmp, 1);
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("update with single byte");
     }
 
@@ -104,7 +104,7 @@ public final class WolfCryptMessageDigestSha256
 
         this.sha.update(input, offset, len);
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("update, offset: " + offset + ", len: " + len);
     }
 
@@ -122,16 +122,5 @@ public final class WolfCryptMessageDigestSha256
         Sha256 shaCopy = new Sha256(this.sha);
         return new WolfCryptMessageDigestSha256(shaCopy);
     }
-
-    @SuppressWarnings("deprecation")
-    @Override
-    protected void finalize() throws Throwable {
-        try {
-            if (this.sha != null)
-                this.sha.releaseNativeStruct();
-        } finally {
-            super.finalize();
-        }
-    }
 }
 
@@ -0,0 +1,170 @@
+/* WolfCryptMessageDigestSha3.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.provider.jce;
+
+import java.security.MessageDigestSpi;
+import javax.crypto.ShortBufferException;
+
+import com.wolfssl.wolfcrypt.Sha3;
+import com.wolfssl.provider.jce.WolfCryptDebug;
+
+/**
+ * wolfCrypt JCE SHA-3 MessageDigest wrapper, one nested class per
+ * SHA-3 variant
+ */
+public class WolfCryptMessageDigestSha3
+    extends MessageDigestSpi implements Cloneable {
+
+    /* internal reference to wolfCrypt JNI Sha3 object */
+    private Sha3 sha;
+
+    /* algorithm name for debug logging */
+    private final String name;
+
+    /* for debug logging */
+    private WolfCryptDebug debug;
+
+    /**
+     * Create new WolfCryptMessageDigestSha3 object
+     *
+     * @param type SHA-3 variant, one of Sha3.SHA3_224 to Sha3.SHA3_512
+     */
+    protected WolfCryptMessageDigestSha3(int type) {
+
+        sha = new Sha3(type);
+        name = "SHA3-" + type;
+    }
+
+    @Override
+    protected byte[] engineDigest() {
+
+        byte[] digest = new byte[this.sha.digestSize()];
+
+        try {
+
+            this.sha.digest(digest);
+
+        } catch (ShortBufferException e) {
+            throw new RuntimeException(e.getMessage());
+        }
+
+        if (debug.enabled())
+            log("generated final digest, len: " + digest.length);
+
+        return digest;
+    }
+
+    @Override
+    protected void engineReset() {
+
+        this.sha.init();
+
+        if (debug.enabled())
+            log("engine reset");
+    }
+
+    @Override
+    protected void engineUpdate(byte input) {
+
+        byte[] tmp = new byte[1];
+        tmp[0] = input;
+
+        this.sha.update(tmp, 1);
+
+        if (debug.enabled())
+            log("update with single byte");
+    }
+
+    @Override
+    protected void engineUpdate(byte[] input, int offset, int len) {
+
+        this.sha.update(input, offset, len);
+
+        if (debug.enabled())
+            log("update, offset: " + offset + ", len: " + len);
+    }
+
+    @Override
+    protected int engineGetDigestLength() {
+        return this.sha.digestSize();
+    }
+
+    private void log(String msg) {
+        debug.print("[MessageDigest, " + name + "] " + msg);
+    }
+
+    @Override
+    public Object clone() throws CloneNotSupportedException {
+        WolfCryptMessageDigestSha3 copy =
+            (WolfCryptMessageDigestSha3)super.clone();
+        copy.sha = new Sha3(this.sha);
+        return copy;
+    }
+
+    /**
+     * wolfJCE SHA3-224 message digest class
+     */
+    public static final class wcSha3_224 extends WolfCryptMessageDigestSha3 {
+        /**
+         * Create new wcSha3_224 object
+         */
+        public wcSha3_224() {
+            super(Sha3.SHA3_224);
+        }
+    }
+
+    /**
+     * wolfJCE SHA3-256 message digest class
+     */
+    public static final class wcSha3_256 extends WolfCryptMessageDigestSha3 {
+        /**
+         * Create new wcSha3_256 object
+         */
+        public wcSha3_256() {
+            super(Sha3.SHA3_256);
+        }
+    }
+
+    /**
+     * wolfJCE SHA3-384 message digest class
+     */
+    public static final class wcSha3_384 extends WolfCryptMessageDigestSha3 {
+        /**
+         * Create new wcSha3_384 object
+         */
+        public wcSha3_384() {
+            super(Sha3.SHA3_384);
+        }
+    }
+
+    /**
+     * wolfJCE SHA3-512 message digest class
+     */
+    public static final class wcSha3_512 extends WolfCryptMessageDigestSha3 {
+        /**
+         * Create new wcSha3_512 object
+         */
+        public wcSha3_512() {
+            super(Sha3.SHA3_512);
+        }
+    }
+}
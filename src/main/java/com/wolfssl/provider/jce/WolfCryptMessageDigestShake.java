@@ -0,0 +1,147 @@
+/* WolfCryptMessageDigestShake.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.provider.jce;
+
+import java.security.MessageDigestSpi;
+import javax.crypto.ShortBufferException;
+
+import com.wolfssl.wolfcrypt.Shake;
+import com.wolfssl.provider.jce.WolfCryptDebug;
+
+/**
+ * wolfCrypt JCE SHAKE MessageDigest wrapper, one nested class per SHAKE
+ * variant. Output length is fixed at twice the security strength of
+ * the variant: 32 bytes for SHAKE128 and 64 bytes for SHAKE256.
+ */
+public class WolfCryptMessageDigestShake
+    extends MessageDigestSpi implements Cloneable {
+
+    /* internal reference to wolfCrypt JNI Shake object */
+    private Shake shake;
+
+    /* algorithm name for debug logging */
+    private final String name;
+
+    /* for debug logging */
+    private WolfCryptDebug debug;
+
+    /**
+     * Create new WolfCryptMessageDigestShake object
+     *
+     * @param type SHAKE variant, Shake.SHAKE128 or Shake.SHAKE256
+     */
+    protected WolfCryptMessageDigestShake(int type) {
+
+        shake = new Shake(type);
+        name = "SHAKE" + type;
+    }
+
+    @Override
+    protected byte[] engineDigest() {
+
+        byte[] digest = new byte[this.shake.digestSize()];
+
+        try {
+
+            this.shake.digest(digest);
+
+        } catch (ShortBufferException e) {
+            throw new RuntimeException(e.getMessage());
+        }
+
+        if (debug.enabled())
+            log("generated final digest, len: " + digest.length);
+
+        return digest;
+    }
+
+    @Override
+    protected void engineReset() {
+
+        this.shake.init();
+
+        if (debug.enabled())
+            log("engine reset");
+    }
+
+    @Override
+    protected void engineUpdate(byte input) {
+
+        byte[] tmp = new byte[1];
+        tmp[0] = input;
+
+        this.shake.update(tmp, 1);
+
+        if (debug.enabled())
+            log("update with single byte");
+    }
+
+    @Override
+    protected void engineUpdate(byte[] input, int offset, int len) {
+
+        this.shake.update(input, offset, len);
+
+        if (debug.enabled())
+            log("update, offset: " + offset + ", len: " + len);
+    }
+
+    @Override
+    protected int engineGetDigestLength() {
+        return this.shake.digestSize();
+    }
+
+    private void log(String msg) {
+        debug.print("[MessageDigest, " + name + "] " + msg);
+    }
+
+    @Override
+    public Object clone() throws CloneNotSupportedException {
+        WolfCryptMessageDigestShake copy =
+            (WolfCryptMessageDigestShake)super.clone();
+        copy.shake = new Shake(this.shake);
+        return copy;
+    }
+
+    /**
+     * wolfJCE SHAKE128 message digest class
+     */
+    public static final class wcShake128 extends WolfCryptMessageDigestShake {
+        /**
+         * Create new wcShake128 object
+         */
+        public wcShake128() {
+            super(Shake.SHAKE128);
+        }
+    }
+
+    /**
+     * wolfJCE SHAKE256 message digest class
+     */
+    public static final class wcShake256 extends WolfCryptMessageDigestShake {
+        /**
+         * Create new wcShake256 object
+         */
+        public wcShake256() {
+            super(Shake.SHAKE256);
+        }
+    }
+}
@@ -59,12 +59,40 @@ public final class WolfCryptProvider extends Provider {
             put("MessageDigest.SHA-512",
                     "com.wolfssl.provider.jce.WolfCryptMessageDigestSha512");
         }
+        if (FeatureDetect.Sha3_224Enabled()) {
+            put("MessageDigest.SHA3-224",
+                    "com.wolfssl.provider.jce.WolfCryptMessageDigestSha3$wcSha3_224");
+        }
+        if (FeatureDetect.Sha3_256Enabled()) {
+            put("MessageDigest.SHA3-256",
+                    "com.wolfssl.provider.jce.WolfCryptMessageDigestSha3$wcSha3_256");
+        }
+        if (FeatureDetect.Sha3_384Enabled()) {
+            put("MessageDigest.SHA3-384",
+                    "com.wolfssl.provider.jce.WolfCryptMessageDigestSha3$wcSha3_384");
+        }
+        if (FeatureDetect.Sha3_512Enabled()) {
+            put("MessageDigest.SHA3-512",
+                    "com.wolfssl.provider.jce.WolfCryptMessageDigestSha3$wcSha3_512");
+        }
+        if (FeatureDetect.Shake128Enabled()) {
+            put("MessageDigest.SHAKE128",
+                    "com.wolfssl.provider.jce.WolfCryptMessageDigestShake$wcShake128");
+            put("Alg.Alias.MessageDigest.SHAKE128-256", "SHAKE128");
+        }
+        if (FeatureDetect.Shake256Enabled()) {
+            put("MessageDigest.SHAKE256",
+                    "com.wolfssl.provider.jce.WolfCryptMessageDigestShake$wcShake256");
+            put("Alg.Alias.MessageDigest.SHAKE256-512", "SHAKE256");
+        }
 
         /* SecureRandom */
         /* TODO: May need to add "SHA1PRNG" alias, other JCA consumemrs may
          * explicitly request it? Needs more testing. */
         put("SecureRandom.HashDRBG",
                 "com.wolfssl.provider.jce.WolfCryptRandom");
+        /* calls use a per-thread DRBG, SecureRandom need not lock */
+        put("SecureRandom.HashDRBG ThreadSafe", "true");
 
         /* Signature */
         if (FeatureDetect.Md5Enabled()) {
@@ -123,6 +151,14 @@ public final class WolfCryptProvider extends Provider {
                 "com.wolfssl.provider.jce.WolfCryptCipher$wcAESCBCNoPadding");
         put("Cipher.AES/CBC/PKCS5Padding",
                 "com.wolfssl.provider.jce.WolfCryptCipher$wcAESCBCPKCS5Padding");
+        if (FeatureDetect.AesGcmEnabled()) {
+            put("Cipher.AES/GCM/NoPadding",
+                "com.wolfssl.provider.jce.WolfCryptCipher$wcAESGCMNoPadding");
+        }
+        if (FeatureDetect.AesCtrEnabled()) {
+            put("Cipher.AES/CTR/NoPadding",
+                "com.wolfssl.provider.jce.WolfCryptCipher$wcAESCTRNoPadding");
+        }
 
         put("Cipher.DESede/CBC/NoPadding",
                 "com.wolfssl.provider.jce.WolfCryptCipher$wcDESedeCBCNoPadding");
@@ -24,15 +24,26 @@ package com.wolfssl.provider.jce;
 import java.security.SecureRandomSpi;
 
 import com.wolfssl.wolfcrypt.Rng;
+import com.wolfssl.wolfcrypt.RngPool;
+import com.wolfssl.wolfcrypt.BufferedRng;
 import com.wolfssl.provider.jce.WolfCryptDebug;
 
 /**
  * wolfCrypt JCE RNG/SecureRandom wrapper
+ *
+ * Setting the "wolfjce.rng.bufferSize" System property to a size in bytes
+ * enables buffered mode, where small nextBytes() requests are served from
+ * a per-thread block of RNG output instead of one native call each.
+ * Buffered mode is disabled by default.
+ *
+ * This class is registered as ThreadSafe. Each call is served by a DRBG
+ * owned by the calling thread (from RngPool), so threads sharing one
+ * SecureRandom object never contend on a single native WC_RNG.
  */
 public final class WolfCryptRandom extends SecureRandomSpi {
 
-    /** internal reference to wolfCrypt JNI RNG object */
-    private Rng rng;
+    /** serves small requests from buffered output, null if disabled */
+    private BufferedRng buffered = null;
 
     /** for debug logging */
     private WolfCryptDebug debug;
@@ -41,49 +52,78 @@ public final class WolfCryptRandom extends SecureRandomSpi {
      * Create new WolfCryptRandom object
      */
     public WolfCryptRandom() {
-        this.rng = new Rng();
-        this.rng.init();
 
-        if (debug.DEBUG)
-            log("initialized new object");
+        /* make sure native RNG is usable on this thread before returning,
+         * the Rng is kept in the pool for later calls */
+        RngPool.release(RngPool.acquire());
+
+        int bufferSize = getBufferSizeProperty();
+        if (bufferSize > 0) {
+            this.buffered = new BufferedRng(bufferSize);
+        }
+
+        if (debug.enabled())
+            log("initialized new object, buffer size: " + bufferSize);
+    }
+
+    /* Read buffer size from System property, 0 if not set or invalid */
+    private static int getBufferSizeProperty() {
+
+        String prop = System.getProperty("wolfjce.rng.bufferSize");
+        if (prop == null) {
+            return 0;
+        }
+
+        try {
+            int size = Integer.parseInt(prop.trim());
+            if (size > 0) {
+                return Math.min(size, BufferedRng.MAX_BUFFER_SIZE);
+            }
+        } catch (NumberFormatException e) {
+            /* treated as disabled */
+        }
+
+        return 0;
     }
 
     @Override
     protected byte[] engineGenerateSeed(int numBytes) {
 
-        return rng.generateBlock(numBytes);
+        Rng rng = RngPool.acquire();
+
+        try {
+            return rng.generateBlock(numBytes);
+        } finally {
+            RngPool.release(rng);
+        }
     }
 
     @Override
     protected void engineNextBytes(byte[] bytes) {
 
-        rng.generateBlock(bytes);
+        if (buffered != null) {
+            buffered.nextBytes(bytes);
+            return;
+        }
+
+        Rng rng = RngPool.acquire();
+
+        try {
+            rng.generateBlock(bytes);
+        } finally {
+            RngPool.release(rng);
+        }
     }
 
     @Override
     protected void engineSetSeed(byte[] seed) {
         /* wolfCrypt reseeds internally automatically */
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("setSeed() not supported by wolfJCE");
     }
 
     private void log(String msg) {
         debug.print("[Random] " + msg);
     }
-
-    @SuppressWarnings("deprecation")
-    @Override
-    protected void finalize() throws Throwable {
-        try {
-
-            if (this.rng != null) {
-                this.rng.free();
-                this.rng.releaseNativeStruct();
-            }
-
-        } finally {
-            super.finalize();
-        }
-    }
 }
 
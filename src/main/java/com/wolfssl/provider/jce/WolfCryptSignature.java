@@ -47,7 +47,10 @@ import com.wolfssl.wolfcrypt.Sha384;
 import com.wolfssl.wolfcrypt.Sha512;
 import com.wolfssl.wolfcrypt.Rsa;
 import com.wolfssl.wolfcrypt.Ecc;
+import com.wolfssl.wolfcrypt.CryptoEvents;
+import com.wolfssl.wolfcrypt.Metrics;
 import com.wolfssl.wolfcrypt.Rng;
+import com.wolfssl.wolfcrypt.RngPool;
 import com.wolfssl.wolfcrypt.WolfCryptException;
 
 import com.wolfssl.provider.jce.WolfCryptDebug;
@@ -96,6 +99,10 @@ public class WolfCryptSignature extends SignatureSpi {
     private int internalHashSum;    /* used for native EncodeSignature */
     private int digestSz;           /* digest size in bytes */
 
+    private String algorithm;       /* algorithm name, ex: SHA256withRSA */
+    private Metrics.Operation signMetrics;
+    private Metrics.Operation verifyMetrics;
+
     /* for debug logging */
     private WolfCryptDebug debug;
     private String keyString;
@@ -153,7 +160,11 @@ public class WolfCryptSignature extends SignatureSpi {
                     "Unsupported signature algorithm digest type");
         }
 
-        if (debug.DEBUG) {
+        this.algorithm = digestToString(dtype) + "with" + typeToString(ktype);
+        this.signMetrics = Metrics.operation(algorithm, "engineSign");
+        this.verifyMetrics = Metrics.operation(algorithm, "engineVerify");
+
+        if (debug.enabled()) {
             keyString = typeToString(ktype);
             digestString = digestToString(dtype);
         }
@@ -274,7 +285,7 @@ public class WolfCryptSignature extends SignatureSpi {
                 break;
         }
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("init sign with PrivateKey");
     }
 
@@ -339,7 +350,7 @@ public class WolfCryptSignature extends SignatureSpi {
                 break;
         }
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("init verify with PublicKey");
     }
 
@@ -355,6 +366,24 @@ public class WolfCryptSignature extends SignatureSpi {
     @Override
     protected byte[] engineSign() throws SignatureException {
 
+        byte[] signature;
+        long start = signMetrics.start();
+        Object event = CryptoEvents.begin(CryptoEvents.JCE_SIGN);
+
+        try {
+            signature = wolfCryptSign();
+        } catch (SignatureException | RuntimeException e) {
+            signMetrics.error(start);
+            throw e;
+        }
+        signMetrics.end(start, 0);
+        commitEvent(event);
+
+        return signature;
+    }
+
+    private byte[] wolfCryptSign() throws SignatureException {
+
         int ret = 0;
         int encodedSz = 0;
 
@@ -390,47 +419,48 @@ public class WolfCryptSignature extends SignatureSpi {
             throw new SignatureException(e.getMessage());
         }
 
-        /* init RNG for padding */
-        Rng rng = new Rng();
-        rng.init();
+        /* get RNG for padding from shared pool */
+        Rng rng = RngPool.acquire();
 
-        /* sign digest */
-        switch (this.keyType) {
-            case WC_RSA:
+        try {
+            /* sign digest */
+            switch (this.keyType) {
+                case WC_RSA:
 
-                /* DER encode digest */
-                encodedSz = (int)asn.encodeSignature(encDigest, digest,
-                                digest.length, this.internalHashSum);
+                    /* DER encode digest */
+                    encodedSz = (int)asn.encodeSignature(encDigest, digest,
+                                    digest.length, this.internalHashSum);
 
-                if (encodedSz < 0) {
-                    throw new SignatureException(
-                        "Failed to DER encode digest during sig gen");
-                }
+                    if (encodedSz < 0) {
+                        throw new SignatureException(
+                            "Failed to DER encode digest during sig gen");
+                    }
 
-                byte[] tmp = new byte[encodedSz];
-                System.arraycopy(encDigest, 0, tmp, 0, encodedSz);
-                signature = this.rsa.sign(tmp, rng);
-                zeroArray(tmp);
+                    byte[] tmp = new byte[encodedSz];
+                    System.arraycopy(encDigest, 0, tmp, 0, encodedSz);
+                    signature = this.rsa.sign(tmp, rng);
+                    zeroArray(tmp);
 
-                break;
+                    break;
 
-            case WC_ECDSA:
+                case WC_ECDSA:
 
-                /* ECC sign */
-                signature = this.ecc.sign(digest, rng);
+                    /* ECC sign */
+                    signature = this.ecc.sign(digest, rng);
 
-                break;
+                    break;
 
-            default:
-                throw new SignatureException(
-                    "Invalid signature algorithm type");
-        }
+                default:
+                    throw new SignatureException(
+                        "Invalid signature algorithm type");
+            }
 
-        /* release RNG */
-        rng.free();
-        rng.releaseNativeStruct();
+        } finally {
+            /* return RNG to pool */
+            RngPool.release(rng);
+        }
 
-        if (debug.DEBUG) {
+        if (debug.enabled()) {
             if (signature != null) {
                 log("generated signature, len: " + signature.length);
             } else {
@@ -449,7 +479,7 @@ public class WolfCryptSignature extends SignatureSpi {
 
         engineUpdate(tmp, 0, 1);
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("update with single byte");
     }
 
@@ -479,7 +509,7 @@ public class WolfCryptSignature extends SignatureSpi {
                 break;
         }
 
-        if (debug.DEBUG)
+        if (debug.enabled())
             log("update, offset: " + off + ", len: " + len);
     }
 
@@ -487,6 +517,25 @@ public class WolfCryptSignature extends SignatureSpi {
     protected boolean engineVerify(byte[] sigBytes)
         throws SignatureException {
 
+        boolean verified;
+        long start = verifyMetrics.start();
+        Object event = CryptoEvents.begin(CryptoEvents.JCE_VERIFY);
+
+        try {
+            verified = wolfCryptVerify(sigBytes);
+        } catch (SignatureException | RuntimeException e) {
+            verifyMetrics.error(start);
+            throw e;
+        }
+        verifyMetrics.end(start, 0);
+        commitEvent(event);
+
+        return verified;
+    }
+
+    private boolean wolfCryptVerify(byte[] sigBytes)
+        throws SignatureException {
+
         int    ret = 0;
         long   encodedSz = 0;
         boolean verified = true;
@@ -562,7 +611,7 @@ public class WolfCryptSignature extends SignatureSpi {
                 break;
         }
 
-        if (debug.DEBUG) {
+        if (debug.enabled()) {
             if (sigBytes != null) {
                 log("finished verify of sig len: " + sigBytes.length +
                     ", verified: " + verified);
@@ -572,6 +621,20 @@ public class WolfCryptSignature extends SignatureSpi {
         return verified;
     }
 
+    /* record event returned by CryptoEvents.begin(), if any */
+    private void commitEvent(Object event) {
+
+        if (event != null) {
+            int keySize = 0;
+
+            if (this.keyType == KeyType.WC_RSA) {
+                keySize = this.rsa.getEncryptSize() * 8;
+            }
+
+            CryptoEvents.commit(event, this.algorithm, keySize, null);
+        }
+    }
+
     private void zeroArray(byte[] in) {
 
         if (in == null)
@@ -615,38 +678,6 @@ public class WolfCryptSignature extends SignatureSpi {
                     digestString + "] " + msg);
     }
 
-    @SuppressWarnings("deprecation")
-    @Override
-    protected void finalize() throws Throwable {
-        try {
-            /* free native digest objects */
-            if (this.md5 != null)
-                this.md5.releaseNativeStruct();
-
-            if (this.sha != null)
-                this.sha.releaseNativeStruct();
-
-            if (this.sha256 != null)
-                this.sha256.releaseNativeStruct();
-
-            if (this.sha384 != null)
-                this.sha384.releaseNativeStruct();
-
-            if (this.sha512 != null)
-                this.sha512.releaseNativeStruct();
-
-            /* free native key objects */
-            if (this.rsa != null)
-                this.rsa.releaseNativeStruct();
-
-            if (this.ecc != null)
-                this.ecc.releaseNativeStruct();  /* frees internally */
-
-        } finally {
-            super.finalize();
-        }
-    }
-
     /**
      * wolfJCE MD5wRSA signature class
      */
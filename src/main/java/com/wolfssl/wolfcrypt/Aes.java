@@ -21,8 +21,11 @@
 
 package com.wolfssl.wolfcrypt;
 
+import java.util.Arrays;
 import java.nio.ByteBuffer;
 
+import javax.crypto.ShortBufferException;
+
 /**
  * Wrapper for the native WolfCrypt Aes implementation.
  *
@@ -42,11 +45,33 @@ public class Aes extends BlockCipher {
     public static final int ENCRYPT_MODE = 0;
     /** AES decrypt mode */
     public static final int DECRYPT_MODE = 1;
+    /** AES-GCM recommended nonce (IV) size */
+    public static final int GCM_NONCE_SIZE = 12;
+    /** AES-GCM maximum authentication tag size */
+    public static final int GCM_TAG_SIZE = 16;
 
     private WolfCryptState state = WolfCryptState.UNINITIALIZED;
 
     private int opmode;
 
+    /* AES-GCM key state, separate from the CBC key set via setKey() */
+    private WolfCryptState gcmState = WolfCryptState.UNINITIALIZED;
+
+    /* direction of the streaming AES-GCM operation started by gcmInit(),
+     * -1 when no streaming operation is in progress */
+    private int gcmStreamMode = -1;
+
+    /* AES-CTR key state, separate from the CBC key set via setKey() */
+    private WolfCryptState ctrState = WolfCryptState.UNINITIALIZED;
+
+    /* initial AES-CTR counter block, used to seek within the keystream */
+    private byte[] ctrIv = null;
+
+    private static final Metrics.Operation gcmEncryptMetrics =
+        Metrics.operation(Aes.class, "gcmEncrypt");
+    private static final Metrics.Operation gcmDecryptMetrics =
+        Metrics.operation(Aes.class, "gcmDecrypt");
+
     /* native JNI methods, internally reach back and grab/use pointer from
      * NativeStruct.java. We wrap calls to these below in order to
      * synchronize access to native pointer between threads */
@@ -58,6 +83,35 @@ public class Aes extends BlockCipher {
     private native int native_update_internal(int opmode, ByteBuffer input,
         int offset, int length, ByteBuffer output, int outputOffset);
 
+    /* static variants of the above, passed the native pointer directly
+     * instead of looking it up from this object on each call */
+    private static native int native_update_ptr(long ptr, int opmode,
+        byte[] input, int offset, int length, byte[] output, int outputOffset);
+    private static native int native_update_ptr(long ptr, int opmode,
+        ByteBuffer input, int offset, int length, ByteBuffer output,
+        int outputOffset);
+    private static native void native_gcm_set_key_ptr(long ptr, byte[] key);
+    private static native int native_gcm_encrypt_ptr(long ptr, byte[] input,
+        int offset, int length, byte[] output, int outputOffset, byte[] iv,
+        byte[] authTag, byte[] authIn);
+    private static native int native_gcm_decrypt_ptr(long ptr, byte[] input,
+        int offset, int length, byte[] output, int outputOffset, byte[] iv,
+        byte[] authTag, byte[] authIn);
+    private static native void native_gcm_init_ptr(long ptr, byte[] iv);
+    private static native int native_gcm_update_ptr(long ptr, int opmode,
+        byte[] input, int offset, int length, byte[] output, int outputOffset,
+        byte[] authIn);
+    private static native void native_gcm_final_ptr(long ptr, int opmode,
+        byte[] authTag);
+    private static native int native_ctr_update_ptr(long ptr, byte[] input,
+        int offset, int length, byte[] output, int outputOffset);
+    private static native int native_ctr_update_ptr(long ptr,
+        ByteBuffer input, int offset, int length, ByteBuffer output,
+        int outputOffset);
+    private static native int native_ctr_update_at_ptr(long ptr, byte[] iv,
+        long position, byte[] input, int offset, int length, byte[] output,
+        int outputOffset);
+
     /**
      * Malloc native JNI AES structure
      *
@@ -105,8 +159,8 @@ public class Aes extends BlockCipher {
             int length, byte[] output, int outputOffset) {
 
         synchronized (pointerLock) {
-            return native_update_internal(opmode, input, offset, length,
-                output, outputOffset);
+            return native_update_ptr(getNativeStruct(), opmode, input,
+                offset, length, output, outputOffset);
         }
     }
 
@@ -127,8 +181,8 @@ public class Aes extends BlockCipher {
             int offset, int length, ByteBuffer output, int outputOffset) {
 
         synchronized (pointerLock) {
-            return native_update_internal(opmode, input, offset, length,
-                output, outputOffset);
+            return native_update_ptr(getNativeStruct(), opmode, input,
+                offset, length, output, outputOffset);
         }
     }
 
@@ -148,5 +202,507 @@ public class Aes extends BlockCipher {
     public Aes(byte[] key, byte[] iv, int opmode) {
         setKey(key, iv, opmode);
     }
+
+    /**
+     * Set AES-GCM key
+     *
+     * The same key may be used for both GCM encryption and decryption,
+     * a new IV is passed to each gcmEncrypt() or gcmDecrypt() call.
+     *
+     * @param key AES key, 16, 24, or 32 bytes
+     *
+     * @throws WolfCryptException if AES-GCM is not compiled in or the
+     *         key is invalid
+     */
+    public synchronized void gcmSetKey(byte[] key) {
+
+        synchronized (pointerLock) {
+            native_gcm_set_key_ptr(getNativeStruct(), key);
+        }
+
+        gcmState = WolfCryptState.READY;
+    }
+
+    private void willUseGcmKey() {
+
+        if (gcmState != WolfCryptState.READY)
+            throw new IllegalStateException(
+                    "No available AES-GCM key to perform the operation.");
+    }
+
+    /**
+     * AES-GCM encrypt operation
+     *
+     * @param input plaintext to encrypt
+     * @param offset offset into input array to start encryption
+     * @param length length of plaintext to encrypt
+     * @param output output array to hold ciphertext
+     * @param outputOffset offset into output array to write ciphertext
+     * @param iv GCM nonce (IV), GCM_NONCE_SIZE bytes recommended
+     * @param authTag output array to hold the generated authentication tag,
+     *        array length is used as the tag size
+     * @param authIn additional authenticated data (AAD), may be null
+     *
+     * @return number of bytes stored in output
+     *
+     * @throws ShortBufferException if output array is too small
+     * @throws WolfCryptException if native encryption fails
+     */
+    public synchronized int gcmEncrypt(byte[] input, int offset, int length,
+        byte[] output, int outputOffset, byte[] iv, byte[] authTag,
+        byte[] authIn) throws ShortBufferException {
+
+        willUseGcmKey();
+
+        if (outputOffset + length > output.length)
+            throw new ShortBufferException(
+                    "output buffer is too small to hold the result.");
+
+        int result;
+        long start = gcmEncryptMetrics.start();
+
+        try {
+            synchronized (pointerLock) {
+                result = native_gcm_encrypt_ptr(getNativeStruct(), input,
+                    offset, length, output, outputOffset, iv, authTag, authIn);
+            }
+        } catch (WolfCryptException e) {
+            gcmEncryptMetrics.error(start);
+            throw e;
+        }
+        gcmEncryptMetrics.end(start, length);
+
+        return result;
+    }
+
+    /**
+     * AES-GCM encrypt operation
+     *
+     * @param input plaintext to encrypt
+     * @param iv GCM nonce (IV), GCM_NONCE_SIZE bytes recommended
+     * @param authTag output array to hold the generated authentication tag,
+     *        array length is used as the tag size
+     * @param authIn additional authenticated data (AAD), may be null
+     *
+     * @return ciphertext, same length as input
+     *
+     * @throws WolfCryptException if native encryption fails
+     */
+    public synchronized byte[] gcmEncrypt(byte[] input, byte[] iv,
+        byte[] authTag, byte[] authIn) {
+
+        byte[] output = new byte[input.length];
+
+        try {
+            gcmEncrypt(input, 0, input.length, output, 0, iv, authTag, authIn);
+        } catch (ShortBufferException e) {
+            /* output is sized to input, should not happen */
+            throw new WolfCryptException(e);
+        }
+
+        return output;
+    }
+
+    /**
+     * AES-GCM decrypt operation
+     *
+     * Authentication tag is verified before this method returns. If
+     * verification fails, the output range is zeroed before the exception
+     * is thrown so no unauthenticated plaintext is left in it.
+     *
+     * @param input ciphertext to decrypt
+     * @param offset offset into input array to start decryption
+     * @param length length of ciphertext to decrypt
+     * @param output output array to hold plaintext
+     * @param outputOffset offset into output array to write plaintext
+     * @param iv GCM nonce (IV) used during encryption
+     * @param authTag authentication tag to verify
+     * @param authIn additional authenticated data (AAD), may be null
+     *
+     * @return number of bytes stored in output
+     *
+     * @throws ShortBufferException if output array is too small
+     * @throws WolfCryptException if native decryption fails, or with
+     *         WolfCryptError.AES_GCM_AUTH_E if tag verification fails
+     */
+    public synchronized int gcmDecrypt(byte[] input, int offset, int length,
+        byte[] output, int outputOffset, byte[] iv, byte[] authTag,
+        byte[] authIn) throws ShortBufferException {
+
+        willUseGcmKey();
+
+        if (outputOffset + length > output.length)
+            throw new ShortBufferException(
+                    "output buffer is too small to hold the result.");
+
+        int result;
+        long start = gcmDecryptMetrics.start();
+
+        try {
+            synchronized (pointerLock) {
+                result = native_gcm_decrypt_ptr(getNativeStruct(), input,
+                    offset, length, output, outputOffset, iv, authTag, authIn);
+            }
+        } catch (WolfCryptException e) {
+            gcmDecryptMetrics.error(start);
+            throw e;
+        }
+        gcmDecryptMetrics.end(start, length);
+
+        return result;
+    }
+
+    /**
+     * AES-GCM decrypt operation
+     *
+     * Authentication tag is verified before this method returns.
+     *
+     * @param input ciphertext to decrypt
+     * @param iv GCM nonce (IV) used during encryption
+     * @param authTag authentication tag to verify
+     * @param authIn additional authenticated data (AAD), may be null
+     *
+     * @return plaintext, same length as input
+     *
+     * @throws WolfCryptException if native decryption fails, or with
+     *         WolfCryptError.AES_GCM_AUTH_E if tag verification fails
+     */
+    public synchronized byte[] gcmDecrypt(byte[] input, byte[] iv,
+        byte[] authTag, byte[] authIn) {
+
+        byte[] output = new byte[input.length];
+
+        try {
+            gcmDecrypt(input, 0, input.length, output, 0, iv, authTag, authIn);
+        } catch (ShortBufferException e) {
+            /* output is sized to input, should not happen */
+            throw new WolfCryptException(e);
+        }
+
+        return output;
+    }
+
+    /**
+     * Start a streaming AES-GCM operation
+     *
+     * Key must already be set with gcmSetKey(). Data is then passed to
+     * gcmUpdate() in any number of calls, and the operation is completed
+     * with gcmFinal(). Calling gcmInit() again starts a new operation.
+     *
+     * @param iv GCM nonce (IV), GCM_NONCE_SIZE bytes recommended
+     * @param opmode Aes.ENCRYPT_MODE or Aes.DECRYPT_MODE
+     *
+     * @throws WolfCryptException if AES-GCM streaming is not compiled in
+     *         or native initialization fails
+     */
+    public synchronized void gcmInit(byte[] iv, int opmode) {
+
+        willUseGcmKey();
+
+        if (opmode != ENCRYPT_MODE && opmode != DECRYPT_MODE)
+            throw new IllegalArgumentException(
+                    "opmode must be Aes.ENCRYPT_MODE or Aes.DECRYPT_MODE");
+
+        synchronized (pointerLock) {
+            native_gcm_init_ptr(getNativeStruct(), iv);
+        }
+
+        gcmStreamMode = opmode;
+    }
+
+    private void willUseGcmStream() {
+
+        willUseGcmKey();
+
+        if (gcmStreamMode == -1)
+            throw new IllegalStateException(
+                    "AES-GCM streaming operation not started with gcmInit().");
+    }
+
+    /**
+     * Add additional authenticated data (AAD) to a streaming AES-GCM
+     * operation. All AAD must be added before any data is passed to
+     * gcmUpdate().
+     *
+     * @param authIn additional authenticated data
+     * @param offset offset into authIn array
+     * @param length length of data in authIn to add
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public synchronized void gcmUpdateAad(byte[] authIn, int offset,
+        int length) {
+
+        byte[] aad = authIn;
+
+        willUseGcmStream();
+
+        if (authIn == null || offset < 0 || length < 0 ||
+            offset + length > authIn.length)
+            throw new IllegalArgumentException("Invalid AAD array or length");
+
+        if (offset != 0 || length != authIn.length)
+            aad = Arrays.copyOfRange(authIn, offset, offset + length);
+
+        synchronized (pointerLock) {
+            native_gcm_update_ptr(getNativeStruct(), gcmStreamMode, null, 0,
+                0, null, 0, aad);
+        }
+    }
+
+    /**
+     * Encrypt or decrypt data as part of a streaming AES-GCM operation.
+     *
+     * Output is the same length as input. When decrypting, plaintext
+     * returned here is not authenticated until gcmFinal() succeeds.
+     *
+     * @param input input data
+     * @param offset offset into input array
+     * @param length length of data in input to process
+     * @param output output array
+     * @param outputOffset offset into output array to write data
+     *
+     * @return number of bytes stored in output
+     *
+     * @throws ShortBufferException if output array is too small
+     * @throws WolfCryptException if native operation fails
+     */
+    public synchronized int gcmUpdate(byte[] input, int offset, int length,
+        byte[] output, int outputOffset) throws ShortBufferException {
+
+        willUseGcmStream();
+
+        if (outputOffset + length > output.length)
+            throw new ShortBufferException(
+                    "output buffer is too small to hold the result.");
+
+        synchronized (pointerLock) {
+            return native_gcm_update_ptr(getNativeStruct(), gcmStreamMode,
+                input, offset, length, output, outputOffset, null);
+        }
+    }
+
+    /**
+     * Complete a streaming AES-GCM operation.
+     *
+     * When encrypting, the authentication tag is written to authTag. When
+     * decrypting, authTag is verified against the data processed.
+     *
+     * @param authTag tag array, array length is used as the tag size
+     *
+     * @throws WolfCryptException if native operation fails, or with
+     *         WolfCryptError.AES_GCM_AUTH_E if tag verification fails
+     */
+    public synchronized void gcmFinal(byte[] authTag) {
+
+        int mode;
+
+        willUseGcmStream();
+
+        /* operation is over whether or not the tag verifies */
+        mode = gcmStreamMode;
+        gcmStreamMode = -1;
+
+        synchronized (pointerLock) {
+            native_gcm_final_ptr(getNativeStruct(), mode, authTag);
+        }
+    }
+
+    /**
+     * Set AES-CTR key and initial counter
+     *
+     * CTR mode encryption and decryption are the same operation, so no
+     * direction is given. Keystream position is kept across ctrUpdate()
+     * calls, inputs do not need to be a multiple of the block size.
+     *
+     * @param key AES key, 16, 24, or 32 bytes
+     * @param iv initial counter block, BLOCK_SIZE bytes
+     *
+     * @throws WolfCryptException if the key or IV is invalid
+     */
+    public synchronized void ctrSetKey(byte[] key, byte[] iv) {
+
+        if (iv == null || iv.length != BLOCK_SIZE)
+            throw new IllegalArgumentException(
+                    "AES-CTR IV must be " + BLOCK_SIZE + " bytes");
+
+        /* CTR only uses the AES encryption key schedule */
+        native_set_key(key, iv, ENCRYPT_MODE);
+
+        ctrIv = iv.clone();
+        ctrState = WolfCryptState.READY;
+    }
+
+    /**
+     * Move AES-CTR keystream to a byte position
+     *
+     * Position is relative to the start of the stream set up by
+     * ctrSetKey(). Following ctrUpdate() calls continue from here.
+     *
+     * @param position byte offset into the keystream, any value &gt;= 0
+     *
+     * @throws WolfCryptException if AES-CTR is not compiled in or native
+     *         operation fails
+     */
+    public synchronized void ctrSeek(long position) {
+
+        ctrUpdateAt(position, new byte[0], 0, 0, new byte[0], 0);
+    }
+
+    /**
+     * AES-CTR encrypt/decrypt starting at a byte position in the stream
+     *
+     * Seeks to position then processes input, as a single operation. This
+     * allows any slice of a CTR-encrypted object to be processed without
+     * running the cipher from the start. To process disjoint slices of the
+     * same object in parallel, give each thread its own Aes object set up
+     * with the same key and IV.
+     *
+     * @param position byte offset into the keystream of input[offset]
+     * @param input input data
+     * @param offset offset into input array
+     * @param length length of data in input to process, any length
+     * @param output output array
+     * @param outputOffset offset into output array to write data
+     *
+     * @return number of bytes stored in output
+     *
+     * @throws WolfCryptException if AES-CTR is not compiled in or native
+     *         operation fails
+     */
+    public synchronized int ctrUpdateAt(long position, byte[] input,
+        int offset, int length, byte[] output, int outputOffset) {
+
+        willUseCtrKey();
+
+        if (position < 0)
+            throw new IllegalArgumentException("position must be >= 0");
+
+        synchronized (pointerLock) {
+            return native_ctr_update_at_ptr(getNativeStruct(), ctrIv,
+                position, input, offset, length, output, outputOffset);
+        }
+    }
+
+    private void willUseCtrKey() {
+
+        if (ctrState != WolfCryptState.READY)
+            throw new IllegalStateException(
+                    "No available AES-CTR key to perform the operation.");
+    }
+
+    /**
+     * AES-CTR encrypt/decrypt operation
+     *
+     * @param input input data
+     * @param offset offset into input array
+     * @param length length of data in input to process, any length
+     * @param output output array
+     * @param outputOffset offset into output array to write data
+     *
+     * @return number of bytes stored in output
+     *
+     * @throws ShortBufferException if output array is too small
+     * @throws WolfCryptException if AES-CTR is not compiled in or native
+     *         operation fails
+     */
+    public synchronized int ctrUpdate(byte[] input, int offset, int length,
+        byte[] output, int outputOffset) throws ShortBufferException {
+
+        willUseCtrKey();
+
+        if (outputOffset + length > output.length)
+            throw new ShortBufferException(
+                    "output buffer is too small to hold the result.");
+
+        synchronized (pointerLock) {
+            return native_ctr_update_ptr(getNativeStruct(), input, offset,
+                length, output, outputOffset);
+        }
+    }
+
+    /**
+     * AES-CTR encrypt/decrypt operation
+     *
+     * @param input input data
+     * @param offset offset into input array
+     * @param length length of data in input to process, any length
+     *
+     * @return output array of length bytes
+     *
+     * @throws WolfCryptException if AES-CTR is not compiled in or native
+     *         operation fails
+     */
+    public synchronized byte[] ctrUpdate(byte[] input, int offset,
+        int length) {
+
+        byte[] output = new byte[length];
+
+        try {
+            ctrUpdate(input, offset, length, output, 0);
+        } catch (ShortBufferException e) {
+            /* output is sized to length, should not happen */
+            throw new WolfCryptException(e);
+        }
+
+        return output;
+    }
+
+    /**
+     * AES-CTR encrypt/decrypt operation
+     *
+     * All remaining bytes of input are processed into output, and both
+     * buffer positions are advanced. Direct buffers are processed by
+     * native code in place, without copying through Java arrays.
+     *
+     * @param input input data buffer
+     * @param output output buffer
+     *
+     * @return number of bytes written to output
+     *
+     * @throws ShortBufferException if output buffer is not large enough
+     * @throws WolfCryptException if AES-CTR is not compiled in or native
+     *         operation fails
+     */
+    public synchronized int ctrUpdate(ByteBuffer input, ByteBuffer output)
+        throws ShortBufferException {
+
+        int ret = 0;
+        int length = input.remaining();
+
+        willUseCtrKey();
+
+        if (output.remaining() < length)
+            throw new ShortBufferException(
+                    "output buffer is too small to hold the result.");
+
+        if (input.isDirect() && output.isDirect()) {
+            synchronized (pointerLock) {
+                ret = native_ctr_update_ptr(getNativeStruct(), input,
+                    input.position(), length, output, output.position());
+            }
+            input.position(input.position() + ret);
+            output.position(output.position() + ret);
+
+        } else {
+            byte[] in = new byte[length];
+            input.get(in);
+            byte[] out = ctrUpdate(in, 0, length);
+            output.put(out);
+            ret = length;
+        }
+
+        return ret;
+    }
+
+    @Override
+    public synchronized void releaseNativeStruct() {
+
+        gcmState = WolfCryptState.UNINITIALIZED;
+        gcmStreamMode = -1;
+        ctrState = WolfCryptState.UNINITIALIZED;
+        ctrIv = null;
+        super.releaseNativeStruct();
+    }
 }
 
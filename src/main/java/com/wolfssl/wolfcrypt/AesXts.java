@@ -0,0 +1,266 @@
+/* AesXts.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+import javax.crypto.ShortBufferException;
+
+/**
+ * Wrapper for the native WolfCrypt AES-XTS implementation.
+ *
+ * Each sector (data unit) is processed independently using its sector
+ * number as the tweak, so any range of sectors can be encrypted or
+ * decrypted without processing the sectors before it. Operations on one
+ * object are serialized, to process sectors in parallel give each thread
+ * its own AesXts object set up with the same key.
+ */
+public class AesXts extends NativeStruct {
+
+    /** AES-XTS key size using two AES-128 keys */
+    public static final int KEY_SIZE_256 = 32;
+    /** AES-XTS key size using two AES-256 keys */
+    public static final int KEY_SIZE_512 = 64;
+    /** Minimum AES-XTS sector size */
+    public static final int MIN_SECTOR_SIZE = Aes.BLOCK_SIZE;
+    /** AES-XTS encrypt mode */
+    public static final int ENCRYPT_MODE = 0;
+    /** AES-XTS decrypt mode */
+    public static final int DECRYPT_MODE = 1;
+
+    private WolfCryptState state = WolfCryptState.UNINITIALIZED;
+
+    private int opmode;
+
+    private native long mallocNativeStruct_internal() throws OutOfMemoryError;
+    private static native void native_set_key_ptr(long ptr, byte[] key,
+        int opmode);
+    private static native void native_free_ptr(long ptr);
+
+    /* frees native XtsAes key schedules if this object is collected
+     * without being released */
+    private static final NativeFree NATIVE_FREE = new NativeFree() {
+        public void free(long ptr) {
+            native_free_ptr(ptr);
+        }
+    };
+    private static native int native_sector_ptr(long ptr, int opmode,
+        long sector, byte[] input, int offset, int length, byte[] output,
+        int outputOffset);
+
+    /**
+     * Create new AesXts object
+     */
+    public AesXts() {
+    }
+
+    /**
+     * Create new AesXts object
+     *
+     * @param key AES-XTS key, two concatenated AES keys of KEY_SIZE_256 or
+     *        KEY_SIZE_512 bytes total
+     * @param opmode AesXts.ENCRYPT_MODE or AesXts.DECRYPT_MODE
+     */
+    public AesXts(byte[] key, int opmode) {
+        setKey(key, opmode);
+    }
+
+    /**
+     * Malloc native JNI XtsAes structure
+     *
+     * @return native allocated pointer
+     *
+     * @throws OutOfMemoryError when malloc fails with memory error
+     */
+    protected long mallocNativeStruct()
+        throws OutOfMemoryError {
+
+        synchronized (pointerLock) {
+            return mallocNativeStruct_internal();
+        }
+    }
+
+    /**
+     * Set AES-XTS key and direction
+     *
+     * @param key AES-XTS key, two concatenated AES keys of KEY_SIZE_256 or
+     *        KEY_SIZE_512 bytes total
+     * @param opmode AesXts.ENCRYPT_MODE or AesXts.DECRYPT_MODE
+     *
+     * @throws WolfCryptException if AES-XTS is not compiled in or the key
+     *         is invalid
+     */
+    public synchronized void setKey(byte[] key, int opmode) {
+
+        if (opmode != ENCRYPT_MODE && opmode != DECRYPT_MODE)
+            throw new IllegalArgumentException(
+                    "opmode must be AesXts.ENCRYPT_MODE or " +
+                    "AesXts.DECRYPT_MODE");
+
+        synchronized (pointerLock) {
+            native_set_key_ptr(getNativeStruct(), key, opmode);
+        }
+
+        setNativeFree(NATIVE_FREE);
+        this.opmode = opmode;
+        state = WolfCryptState.READY;
+    }
+
+    private void willUseKey(int mode) {
+
+        if (state != WolfCryptState.READY)
+            throw new IllegalStateException(
+                    "No available key to perform the operation.");
+
+        if (mode != this.opmode)
+            throw new IllegalStateException(
+                    "AesXts object was not set up for this direction.");
+    }
+
+    private int processSector(int mode, long sector, byte[] input,
+        int offset, int length, byte[] output, int outputOffset)
+        throws ShortBufferException {
+
+        willUseKey(mode);
+
+        if (length < MIN_SECTOR_SIZE)
+            throw new IllegalArgumentException(
+                    "AES-XTS sector must be at least " + MIN_SECTOR_SIZE +
+                    " bytes");
+
+        if (outputOffset + length > output.length)
+            throw new ShortBufferException(
+                    "output buffer is too small to hold the result.");
+
+        synchronized (pointerLock) {
+            return native_sector_ptr(getNativeStruct(), mode, sector, input,
+                offset, length, output, outputOffset);
+        }
+    }
+
+    /**
+     * Encrypt one sector
+     *
+     * @param sector sector number, used as the XTS tweak
+     * @param input plaintext sector data
+     * @param offset offset into input array
+     * @param length sector size, at least MIN_SECTOR_SIZE bytes
+     * @param output output array
+     * @param outputOffset offset into output array to write data
+     *
+     * @return number of bytes stored in output
+     *
+     * @throws ShortBufferException if output array is too small
+     * @throws WolfCryptException if native operation fails
+     */
+    public synchronized int encryptSector(long sector, byte[] input,
+        int offset, int length, byte[] output, int outputOffset)
+        throws ShortBufferException {
+
+        return processSector(ENCRYPT_MODE, sector, input, offset, length,
+            output, outputOffset);
+    }
+
+    /**
+     * Encrypt one sector
+     *
+     * @param sector sector number, used as the XTS tweak
+     * @param input plaintext sector data, at least MIN_SECTOR_SIZE bytes
+     *
+     * @return ciphertext, same length as input
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public synchronized byte[] encryptSector(long sector, byte[] input) {
+
+        byte[] output = new byte[input.length];
+
+        try {
+            encryptSector(sector, input, 0, input.length, output, 0);
+        } catch (ShortBufferException e) {
+            /* output is sized to input, should not happen */
+            throw new WolfCryptException(e);
+        }
+
+        return output;
+    }
+
+    /**
+     * Decrypt one sector
+     *
+     * @param sector sector number, used as the XTS tweak
+     * @param input ciphertext sector data
+     * @param offset offset into input array
+     * @param length sector size, at least MIN_SECTOR_SIZE bytes
+     * @param output output array
+     * @param outputOffset offset into output array to write data
+     *
+     * @return number of bytes stored in output
+     *
+     * @throws ShortBufferException if output array is too small
+     * @throws WolfCryptException if native operation fails
+     */
+    public synchronized int decryptSector(long sector, byte[] input,
+        int offset, int length, byte[] output, int outputOffset)
+        throws ShortBufferException {
+
+        return processSector(DECRYPT_MODE, sector, input, offset, length,
+            output, outputOffset);
+    }
+
+    /**
+     * Decrypt one sector
+     *
+     * @param sector sector number, used as the XTS tweak
+     * @param input ciphertext sector data, at least MIN_SECTOR_SIZE bytes
+     *
+     * @return plaintext, same length as input
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public synchronized byte[] decryptSector(long sector, byte[] input) {
+
+        byte[] output = new byte[input.length];
+
+        try {
+            decryptSector(sector, input, 0, input.length, output, 0);
+        } catch (ShortBufferException e) {
+            /* output is sized to input, should not happen */
+            throw new WolfCryptException(e);
+        }
+
+        return output;
+    }
+
+    @Override
+    public synchronized void releaseNativeStruct() {
+
+        /* free key schedules, then free native struct */
+        if (state != WolfCryptState.UNINITIALIZED) {
+            synchronized (pointerLock) {
+                native_free_ptr(getNativeStruct());
+            }
+            state = WolfCryptState.UNINITIALIZED;
+        }
+
+        super.releaseNativeStruct();
+    }
+}
+
@@ -23,6 +23,8 @@ package com.wolfssl.wolfcrypt;
 
 import java.util.Arrays;
 import java.nio.ByteBuffer;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
 
 import javax.crypto.ShortBufferException;
 
@@ -35,9 +37,28 @@ public abstract class BlockCipher extends NativeStruct {
 
     private int opmode;
 
+    /* update Operation of each class, resolved once per class rather
+     * than once per object */
+    private static final ConcurrentMap<Class<?>, Metrics.Operation>
+        classMetrics = new ConcurrentHashMap<Class<?>, Metrics.Operation>();
+
+    private final Metrics.Operation updateMetrics = metricsOf(getClass());
+
     /** Default BlockCipher constructor */
     public BlockCipher() { }
 
+    private static Metrics.Operation metricsOf(Class<?> cls) {
+
+        Metrics.Operation op = classMetrics.get(cls);
+
+        if (op == null) {
+            op = Metrics.operation(cls, "update");
+            classMetrics.putIfAbsent(cls, op);
+        }
+
+        return op;
+    }
+
     /**
      * Set block cipher key, IV, and mode
      *
@@ -131,7 +152,7 @@ public abstract class BlockCipher extends NativeStruct {
 
         byte[] output = new byte[input.length];
 
-        native_update(opmode, input, offset, length, output, 0);
+        updateMetered(input, offset, length, output, 0);
 
         return output;
     }
@@ -158,8 +179,7 @@ public abstract class BlockCipher extends NativeStruct {
             throw new ShortBufferException(
                     "output buffer is too small to hold the result.");
 
-        return native_update(opmode, input, offset, length, output,
-                outputOffset);
+        return updateMetered(input, offset, length, output, outputOffset);
     }
 
     /**
@@ -183,8 +203,15 @@ public abstract class BlockCipher extends NativeStruct {
             throw new ShortBufferException(
                     "output buffer is too small to hold the result.");
 
-        ret = native_update(opmode, input, input.position(), input.remaining(),
-                output, output.position());
+        long start = updateMetrics.start();
+        try {
+            ret = native_update(opmode, input, input.position(),
+                    input.remaining(), output, output.position());
+        } catch (WolfCryptException e) {
+            updateMetrics.error(start);
+            throw e;
+        }
+        updateMetrics.end(start, ret);
 
         input.position(input.position() + ret);
         output.position(output.position() + ret);
@@ -192,6 +219,24 @@ public abstract class BlockCipher extends NativeStruct {
         return ret;
     }
 
+    private int updateMetered(byte[] input, int offset, int length,
+        byte[] output, int outputOffset) throws WolfCryptException {
+
+        int ret;
+        long start = updateMetrics.start();
+
+        try {
+            ret = native_update(opmode, input, offset, length, output,
+                    outputOffset);
+        } catch (WolfCryptException e) {
+            updateMetrics.error(start);
+            throw e;
+        }
+        updateMetrics.end(start, length);
+
+        return ret;
+    }
+
     @Override
     public synchronized void releaseNativeStruct() {
 
@@ -0,0 +1,229 @@
+/* BufferedRng.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+import java.util.Arrays;
+
+/**
+ * Serves small random requests from a per-thread block of Rng output.
+ *
+ * Each refill pulls bufferSize bytes from the underlying Rng in one native
+ * call, and later small requests are copied out of that block without
+ * crossing into native code. Bytes are zeroized as soon as they have been
+ * handed out, and buffered output is discarded if the process forks.
+ * Requests larger than a quarter of the buffer go to the Rng directly.
+ *
+ * When created without an Rng, output is drawn from the calling thread's
+ * Rng in RngPool, so threads sharing one BufferedRng do not contend on a
+ * single native WC_RNG.
+ *
+ * Buffered bytes not yet handed out stay in memory until used, cleared
+ * with clear() or the owning thread exits.
+ */
+public final class BufferedRng {
+
+    /** Default per-thread buffer size in bytes */
+    public static final int DEFAULT_BUFFER_SIZE = 4096;
+
+    /** Maximum buffer size, largest block wolfCrypt generates per call */
+    public static final int MAX_BUFFER_SIZE = 65536;
+
+    /* Random bytes buffered for one thread */
+    private static final class Block {
+        final byte[] data;
+        int offset;
+        int forkGeneration;
+
+        Block(int size) {
+            data = new byte[size];
+            offset = size;
+        }
+    }
+
+    /* Rng to draw from, or null to use RngPool */
+    private final Rng rng;
+    private final int bufferSize;
+    private final int directThreshold;
+
+    private final ThreadLocal<Block> blocks = new ThreadLocal<Block>();
+
+    /**
+     * Create new BufferedRng drawing from RngPool
+     *
+     * @param bufferSize size of per-thread buffer in bytes
+     *
+     * @throws IllegalArgumentException if bufferSize is not between 1 and
+     *         MAX_BUFFER_SIZE
+     */
+    public BufferedRng(int bufferSize) {
+        this(null, bufferSize, true);
+    }
+
+    /**
+     * Create new BufferedRng using default buffer size
+     *
+     * @param rng initialized Rng to draw random data from
+     */
+    public BufferedRng(Rng rng) {
+        this(rng, DEFAULT_BUFFER_SIZE);
+    }
+
+    /**
+     * Create new BufferedRng
+     *
+     * @param rng initialized Rng to draw random data from
+     * @param bufferSize size of per-thread buffer in bytes
+     *
+     * @throws IllegalArgumentException if rng is null or bufferSize is
+     *         not between 1 and MAX_BUFFER_SIZE
+     */
+    public BufferedRng(Rng rng, int bufferSize) {
+        this(rng, bufferSize, false);
+    }
+
+    private BufferedRng(Rng rng, int bufferSize, boolean pooled) {
+
+        if (rng == null && !pooled) {
+            throw new IllegalArgumentException("Rng must not be null");
+        }
+
+        if (bufferSize <= 0 || bufferSize > MAX_BUFFER_SIZE) {
+            throw new IllegalArgumentException(
+                "Buffer size must be between 1 and " + MAX_BUFFER_SIZE);
+        }
+
+        this.rng = rng;
+        this.bufferSize = bufferSize;
+        this.directThreshold = Math.max(1, bufferSize / 4);
+    }
+
+    /**
+     * Get size of per-thread buffer
+     *
+     * @return buffer size in bytes
+     */
+    public int getBufferSize() {
+        return bufferSize;
+    }
+
+    /**
+     * Fill array with random data
+     *
+     * @param buffer output buffer to place random data
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public void nextBytes(byte[] buffer) {
+        nextBytes(buffer, 0, buffer.length);
+    }
+
+    /**
+     * Generate random block of data
+     *
+     * @param buffer output buffer to place random data
+     * @param offset input into buffer to start writing
+     * @param length length of random data to generate
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ArrayIndexOutOfBoundsException if offset and length do not
+     *         fit in buffer
+     */
+    public void nextBytes(byte[] buffer, int offset, int length) {
+
+        if (offset < 0 || length < 0 || offset > buffer.length - length) {
+            throw new ArrayIndexOutOfBoundsException(
+                "Invalid offset or length for output buffer");
+        }
+
+        if (length == 0) {
+            return;
+        }
+
+        if (length >= directThreshold) {
+            generate(buffer, offset, length);
+            return;
+        }
+
+        Block block = blocks.get();
+        if (block == null) {
+            block = new Block(bufferSize);
+            blocks.set(block);
+        }
+
+        /* discard anything generated before a fork */
+        int gen = Rng.getForkGeneration();
+        if (block.forkGeneration != gen) {
+            discard(block);
+            block.forkGeneration = gen;
+        }
+
+        while (length > 0) {
+            if (block.offset == block.data.length) {
+                generate(block.data, 0, block.data.length);
+                block.offset = 0;
+            }
+
+            int n = Math.min(length, block.data.length - block.offset);
+            System.arraycopy(block.data, block.offset, buffer, offset, n);
+
+            /* zeroize bytes once handed out */
+            Arrays.fill(block.data, block.offset, block.offset + n, (byte)0);
+
+            block.offset += n;
+            offset += n;
+            length -= n;
+        }
+    }
+
+    /**
+     * Zeroize and discard random data buffered for the current thread
+     */
+    public void clear() {
+        Block block = blocks.get();
+
+        if (block != null) {
+            discard(block);
+            blocks.remove();
+        }
+    }
+
+    private void generate(byte[] buffer, int offset, int length) {
+
+        if (rng != null) {
+            rng.generateBlock(buffer, offset, length);
+            return;
+        }
+
+        Rng pooled = RngPool.acquire();
+
+        try {
+            pooled.generateBlock(buffer, offset, length);
+        } finally {
+            RngPool.release(pooled);
+        }
+    }
+
+    private static void discard(Block block) {
+        Arrays.fill(block.data, (byte)0);
+        block.offset = block.data.length;
+    }
+}
@@ -0,0 +1,183 @@
+/* CryptoEvents.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+/**
+ * Timed events for expensive cryptographic operations.
+ *
+ * Events are delivered to a Sink. When the optional JFR support classes
+ * are included in the JAR (built on JDK 11 or later) and the running JVM
+ * has Java Flight Recorder, a Sink committing jdk.jfr events is installed
+ * at startup. It can be disabled by setting the "wolfcrypt.jni.jfr" System
+ * property to "false".
+ *
+ * Callers follow the pattern:
+ * <pre>
+ * Object event = CryptoEvents.begin(CryptoEvents.RSA_SIGN);
+ * ... run operation ...
+ * if (event != null) {
+ *     CryptoEvents.commit(event, "RSA", keySize, null);
+ * }
+ * </pre>
+ * begin() returns null unless a Sink is installed and has that event type
+ * enabled, so callers only compute event details (ex: key size) while
+ * recording.
+ */
+public final class CryptoEvents {
+
+    /** RSA signature generation, Rsa.sign() */
+    public static final int RSA_SIGN = 0;
+    /** RSA private key decryption, Rsa.decrypt() */
+    public static final int RSA_DECRYPT = 1;
+    /** ECDSA signature generation, Ecc.sign() */
+    public static final int ECC_SIGN = 2;
+    /** ECDSA signature verification, Ecc.verify() */
+    public static final int ECC_VERIFY = 3;
+    /** ECDH shared secret generation, Ecc.makeSharedSecret() */
+    public static final int ECC_SHARED_SECRET = 4;
+    /** DH shared secret generation, Dh.makeSharedSecret() */
+    public static final int DH_AGREE = 5;
+    /** RSA, ECC or DH key pair generation */
+    public static final int KEY_GENERATION = 6;
+    /** DRBG instantiation and seeding, Rng.init() */
+    public static final int RNG_SEED = 7;
+    /** JCE Signature sign, WolfCryptSignature */
+    public static final int JCE_SIGN = 8;
+    /** JCE Signature verify, WolfCryptSignature */
+    public static final int JCE_VERIFY = 9;
+    /** JCE KeyAgreement secret generation, WolfCryptKeyAgreement */
+    public static final int JCE_KEY_AGREEMENT = 10;
+    /** JCE KeyPairGenerator key generation, WolfCryptKeyPairGenerator */
+    public static final int JCE_KEY_GENERATION = 11;
+
+    /** Number of event types */
+    public static final int TYPES = 12;
+
+    /**
+     * Receives events, implemented by the JFR support classes.
+     */
+    public interface Sink {
+
+        /**
+         * Start an event of the given type.
+         *
+         * @param type event type, one of the CryptoEvents constants
+         *
+         * @return event object to pass to commit(), or null if this
+         *         event type is not being recorded
+         */
+        Object begin(int type);
+
+        /**
+         * Complete and record an event returned by begin()
+         *
+         * @param event event object returned by begin()
+         * @param algorithm algorithm name
+         * @param keySize key size in bits, 0 if unknown
+         * @param curve ECC curve name, null if not applicable
+         */
+        void commit(Object event, String algorithm, int keySize,
+            String curve);
+    }
+
+    private static final String JFR_SINK =
+        "com.wolfssl.wolfcrypt.jfr.JfrEventSink";
+
+    private static volatile Sink sink = loadJfrSink();
+
+    private CryptoEvents() { }
+
+    /**
+     * Start an event
+     *
+     * @param type event type
+     *
+     * @return event object to pass to commit(), or null if not recording
+     */
+    public static Object begin(int type) {
+
+        Sink s = sink;
+
+        if (s == null) {
+            return null;
+        }
+
+        return s.begin(type);
+    }
+
+    /**
+     * Complete and record an event
+     *
+     * @param event event object returned by begin(), ignored if null
+     * @param algorithm algorithm name
+     * @param keySize key size in bits, 0 if unknown
+     * @param curve ECC curve name, null if not applicable
+     */
+    public static void commit(Object event, String algorithm, int keySize,
+        String curve) {
+
+        Sink s = sink;
+
+        if (event != null && s != null) {
+            s.commit(event, algorithm, keySize, curve);
+        }
+    }
+
+    /**
+     * Get installed Sink
+     *
+     * @return current Sink, or null if events are disabled
+     */
+    public static Sink getSink() {
+        return sink;
+    }
+
+    /**
+     * Install Sink to receive events, replacing the JFR Sink
+     *
+     * @param newSink Sink to install, or null to disable events
+     */
+    public static void setSink(Sink newSink) {
+        sink = newSink;
+    }
+
+    private static Sink loadJfrSink() {
+
+        try {
+            String prop = System.getProperty("wolfcrypt.jni.jfr");
+            if (prop != null && prop.trim().equalsIgnoreCase("false")) {
+                return null;
+            }
+
+            return (Sink)Class.forName(JFR_SINK).newInstance();
+
+        } catch (ClassNotFoundException e) {
+            /* JFR support classes not built into this JAR */
+        } catch (LinkageError e) {
+            /* jdk.jfr not available in this JVM */
+        } catch (Exception e) {
+            /* events are best effort */
+        }
+
+        return null;
+    }
+}
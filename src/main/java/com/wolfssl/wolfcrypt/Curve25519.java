@@ -33,6 +33,9 @@ public class Curve25519 extends NativeStruct {
 
     private WolfCryptState state = WolfCryptState.UNINITIALIZED;
 
+    private static final Metrics.Operation sharedSecretMetrics =
+        Metrics.operation(Curve25519.class, "makeSharedSecret");
+
     /**
      * Create new Curve25519 object
      */
@@ -58,6 +61,15 @@ public class Curve25519 extends NativeStruct {
 
     private native void wc_curve25519_init();
     private native void wc_curve25519_free();
+    private static native void native_free_ptr(long ptr);
+
+    /* frees native curve25519_key contents if this object is collected without
+     * being released */
+    private static final NativeFree NATIVE_FREE = new NativeFree() {
+        public void free(long ptr) {
+            native_free_ptr(ptr);
+        }
+    };
     private native void wc_curve25519_make_key(Rng rng, int size);
     private native void wc_curve25519_make_key_ex(Rng rng, int size, int endian);
     private native void wc_curve25519_check_key();
@@ -74,6 +86,7 @@ public class Curve25519 extends NativeStruct {
     protected void init() {
         if (state == WolfCryptState.UNINITIALIZED) {
             wc_curve25519_init();
+            setNativeFree(NATIVE_FREE);
             state = WolfCryptState.INITIALIZED;
         } else {
             throw new IllegalStateException(
@@ -87,6 +100,7 @@ public class Curve25519 extends NativeStruct {
     protected void free() {
         if (state != WolfCryptState.UNINITIALIZED) {
             wc_curve25519_free();
+            setNativeFree(null);
             state = WolfCryptState.UNINITIALIZED;
         }
     }
@@ -235,7 +249,18 @@ public class Curve25519 extends NativeStruct {
      */
     public byte[] makeSharedSecret(Curve25519 pubKey) {
         if (state == WolfCryptState.READY) {
-            return wc_curve25519_make_shared_secret(pubKey);
+            byte[] secret;
+            long start = sharedSecretMetrics.start();
+
+            try {
+                secret = wc_curve25519_make_shared_secret(pubKey);
+            } catch (WolfCryptException e) {
+                sharedSecretMetrics.error(start);
+                throw e;
+            }
+            sharedSecretMetrics.end(start, 0);
+
+            return secret;
         } else {
             throw new IllegalStateException(
                     "No available key to perform the operation.");
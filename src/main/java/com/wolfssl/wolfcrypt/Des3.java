@@ -50,6 +50,14 @@ public class Des3 extends BlockCipher {
     private native int native_update_internal(int opmode, ByteBuffer input,
         int offset, int length, ByteBuffer output, int outputOffset);
 
+    /* static variants of the above, passed the native pointer directly
+     * instead of looking it up from this object on each call */
+    private static native int native_update_ptr(long ptr, int opmode,
+        byte[] input, int offset, int length, byte[] output, int outputOffset);
+    private static native int native_update_ptr(long ptr, int opmode,
+        ByteBuffer input, int offset, int length, ByteBuffer output,
+        int outputOffset);
+
     /**
      * Malloc native JNI Des3 structure
      *
@@ -91,8 +99,8 @@ public class Des3 extends BlockCipher {
         int length, byte[] output, int outputOffset) {
 
         synchronized (pointerLock) {
-            return native_update_internal(opmode, input, offset, length,
-                output, outputOffset);
+            return native_update_ptr(getNativeStruct(), opmode, input,
+                offset, length, output, outputOffset);
         }
     }
 
@@ -113,8 +121,8 @@ public class Des3 extends BlockCipher {
         int offset, int length, ByteBuffer output, int outputOffset) {
 
         synchronized (pointerLock) {
-            return native_update_internal(opmode, input, offset, length,
-                output, outputOffset);
+            return native_update_ptr(getNativeStruct(), opmode, input,
+                offset, length, output, outputOffset);
         }
     }
 
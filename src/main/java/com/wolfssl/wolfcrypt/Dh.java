@@ -34,6 +34,9 @@ public class Dh extends NativeStruct {
     /* Lock around object state */
     protected final Object stateLock = new Object();
 
+    private static final Metrics.Operation sharedSecretMetrics =
+        Metrics.operation(Dh.class, "makeSharedSecret");
+
     /**
      * Create new Dh object
      */
@@ -62,6 +65,15 @@ public class Dh extends NativeStruct {
     private native long mallocNativeStruct_internal() throws OutOfMemoryError;
     private native void wc_InitDhKey();
     private native void wc_FreeDhKey();
+    private static native void native_free_ptr(long ptr);
+
+    /* frees native DhKey contents if this object is collected without
+     * being released */
+    private static final NativeFree NATIVE_FREE = new NativeFree() {
+        public void free(long ptr) {
+            native_free_ptr(ptr);
+        }
+    };
     private native void wc_DhSetKey(byte[] p, byte[] g);
     private native void wc_DhGenerateKeyPair(Rng rng, int pSize);
     private native byte[] wc_DhAgree(byte[] priv, byte[] pub);
@@ -91,6 +103,7 @@ public class Dh extends NativeStruct {
                 synchronized (pointerLock) {
                     wc_InitDhKey();
                 }
+                setNativeFree(NATIVE_FREE);
                 state = WolfCryptState.INITIALIZED;
             } else {
                 throw new IllegalStateException(
@@ -108,6 +121,7 @@ public class Dh extends NativeStruct {
                 synchronized (pointerLock) {
                     wc_FreeDhKey();
                 }
+                setNativeFree(null);
                 setPrivateKey(new byte[0]);
                 setPublicKey(new byte[0]);
 
@@ -224,10 +238,13 @@ public class Dh extends NativeStruct {
         throws WolfCryptException, IllegalStateException {
 
         if (privateKey == null) {
+            Object event = CryptoEvents.begin(CryptoEvents.KEY_GENERATION);
+
             /* use size of P to allocate key buffer size */
             synchronized (pointerLock) {
                 wc_DhGenerateKeyPair(rng, this.pSize);
             }
+            CryptoEvents.commit(event, "DH", this.pSize * 8, null);
         } else {
             throw new IllegalStateException("Object already has a key");
         }
@@ -249,9 +266,22 @@ public class Dh extends NativeStruct {
         byte[] publicKey = pubKey.getPublicKey();
 
         if (privateKey != null || publicKey != null) {
-            synchronized (pointerLock) {
-                return wc_DhAgree(privateKey, publicKey);
+            byte[] result;
+            long start = sharedSecretMetrics.start();
+            Object event = CryptoEvents.begin(CryptoEvents.DH_AGREE);
+
+            try {
+                synchronized (pointerLock) {
+                    result = wc_DhAgree(privateKey, publicKey);
+                }
+            } catch (WolfCryptException e) {
+                sharedSecretMetrics.error(start);
+                throw e;
             }
+            sharedSecretMetrics.end(start, 0);
+            CryptoEvents.commit(event, "DH", this.pSize * 8, null);
+
+            return result;
         } else {
             throw new IllegalStateException(
                 "No available key to perform the operation");
@@ -35,12 +35,16 @@ public class Ecc extends NativeStruct {
 
     private WolfCryptState state = WolfCryptState.UNINITIALIZED;
 
-    /* used with native wc_ecc_set_rng() */
-    private Rng rng = null;
-
     /* Lock around object state */
     protected final Object stateLock = new Object();
 
+    private static final Metrics.Operation sharedSecretMetrics =
+        Metrics.operation(Ecc.class, "makeSharedSecret");
+    private static final Metrics.Operation signMetrics =
+        Metrics.operation(Ecc.class, "sign");
+    private static final Metrics.Operation verifyMetrics =
+        Metrics.operation(Ecc.class, "verify");
+
     /**
      * Create new Ecc object
      */
@@ -66,6 +70,15 @@ public class Ecc extends NativeStruct {
 
     private native void wc_ecc_init();
     private native void wc_ecc_free();
+    private static native void native_free_ptr(long ptr);
+
+    /* frees native ecc_key contents if this object is collected without
+     * being released */
+    private static final NativeFree NATIVE_FREE = new NativeFree() {
+        public void free(long ptr) {
+            native_free_ptr(ptr);
+        }
+    };
     private native void wc_ecc_make_key(Rng rng, int size);
     private native void wc_ecc_make_key_ex(Rng rng, int size, String curveName);
     private native void wc_ecc_check_key();
@@ -81,9 +94,15 @@ public class Ecc extends NativeStruct {
     private native byte[] wc_EccPublicKeyToDer();
     private native byte[] wc_ecc_sign_hash(byte[] hash, Rng rng);
     private native boolean wc_ecc_verify_hash(byte[] hash, byte[] signature);
+    private static native byte[] wc_ecc_sign_hash_ptr(long ptr, long rngPtr,
+        byte[] hash);
+    private static native boolean wc_ecc_verify_hash_ptr(long ptr, byte[] hash,
+        byte[] signature);
     private static native int wc_ecc_get_curve_size_from_name(String name);
     private native byte[] wc_ecc_private_key_to_pkcs8();
     private static native String wc_ecc_get_curve_name_from_id(int curve_id);
+    private static native int wc_ecc_size_ptr(long ptr);
+    private static native int wc_ecc_get_curve_id_ptr(long ptr);
     private static native int wc_ecc_get_curve_id_from_params(int fieldSize,
             byte[] prime, byte[] Af, byte[] Bf, byte[] order,
             byte[] Gx, byte[] Gy, int cofactor);
@@ -98,12 +117,7 @@ public class Ecc extends NativeStruct {
                 synchronized (pointerLock) {
                     wc_ecc_init();
                 }
-
-                /* used with native wc_ecc_set_rng() */
-                if (rng == null) {
-                    rng = new Rng();
-                    rng.init();
-                }
+                setNativeFree(NATIVE_FREE);
 
                 state = WolfCryptState.INITIALIZED;
             } else {
@@ -123,11 +137,7 @@ public class Ecc extends NativeStruct {
                 synchronized (pointerLock) {
                     wc_ecc_free();
                 }
-
-                if (this.rng != null) {
-                    rng.free();
-                    rng.releaseNativeStruct();
-                }
+                setNativeFree(null);
 
                 state = WolfCryptState.UNINITIALIZED;
             }
@@ -148,10 +158,13 @@ public class Ecc extends NativeStruct {
 
         synchronized (stateLock) {
             if (state == WolfCryptState.INITIALIZED) {
+                Object event =
+                    CryptoEvents.begin(CryptoEvents.KEY_GENERATION);
 
                 synchronized (pointerLock) {
                     wc_ecc_make_key(rng, size);
                 }
+                commitEvent(event, "ECC");
                 state = WolfCryptState.READY;
             } else {
                 throw new IllegalStateException("Object already has a key.");
@@ -174,10 +187,13 @@ public class Ecc extends NativeStruct {
 
         synchronized (stateLock) {
             if (state == WolfCryptState.INITIALIZED) {
+                Object event =
+                    CryptoEvents.begin(CryptoEvents.KEY_GENERATION);
 
                 synchronized (pointerLock) {
                     wc_ecc_make_key_ex(rng, size, curveName.toUpperCase());
                 }
+                commitEvent(event, "ECC");
                 state = WolfCryptState.READY;
             } else {
                 throw new IllegalStateException("Object already has a key.");
@@ -444,8 +460,30 @@ public class Ecc extends NativeStruct {
         synchronized (stateLock) {
             if (state == WolfCryptState.READY) {
 
-                synchronized (pointerLock) {
-                    return wc_ecc_shared_secret(pubKey, this.rng);
+                /* used with native wc_ecc_set_rng(), taken from shared
+                 * pool instead of initializing a new DRBG per key */
+                Rng rng = RngPool.acquire();
+
+                long start = sharedSecretMetrics.start();
+                Object event =
+                    CryptoEvents.begin(CryptoEvents.ECC_SHARED_SECRET);
+                try {
+                    byte[] secret;
+
+                    synchronized (pointerLock) {
+                        secret = wc_ecc_shared_secret(pubKey, rng);
+                    }
+                    sharedSecretMetrics.end(start, 0);
+                    commitEvent(event, "ECDH");
+
+                    return secret;
+
+                } catch (WolfCryptException e) {
+                    sharedSecretMetrics.error(start);
+                    throw e;
+
+                } finally {
+                    RngPool.release(rng);
                 }
             } else {
                 throw new IllegalStateException(
@@ -472,9 +510,23 @@ public class Ecc extends NativeStruct {
 
         synchronized (stateLock) {
             if (state == WolfCryptState.READY) {
-                synchronized (pointerLock) {
-                    signature = wc_ecc_sign_hash(hash, rng);
+                long start = signMetrics.start();
+                Object event = CryptoEvents.begin(CryptoEvents.ECC_SIGN);
+                try {
+                    synchronized (pointerLock) {
+                        /* also hold the Rng lock, keeps the cleaner from
+                         * freeing the Rng structure during the call */
+                        synchronized (pointerLockOf(rng)) {
+                            signature = wc_ecc_sign_hash_ptr(getNativeStruct(),
+                                getNativeStructOf(rng), hash);
+                        }
+                    }
+                } catch (WolfCryptException e) {
+                    signMetrics.error(start);
+                    throw e;
                 }
+                signMetrics.end(start, hash.length);
+                commitEvent(event, "ECDSA");
             } else {
                 throw new IllegalStateException(
                         "No available key to perform the operation.");
@@ -503,9 +555,19 @@ public class Ecc extends NativeStruct {
         synchronized (stateLock) {
             if (state == WolfCryptState.READY) {
 
-                synchronized (pointerLock) {
-                    result = wc_ecc_verify_hash(hash, signature);
+                long start = verifyMetrics.start();
+                Object event = CryptoEvents.begin(CryptoEvents.ECC_VERIFY);
+                try {
+                    synchronized (pointerLock) {
+                        result = wc_ecc_verify_hash_ptr(getNativeStruct(), hash,
+                            signature);
+                    }
+                } catch (WolfCryptException e) {
+                    verifyMetrics.error(start);
+                    throw e;
                 }
+                verifyMetrics.end(start, hash.length);
+                commitEvent(event, "ECDSA");
             } else {
                 throw new IllegalStateException(
                         "No available key to perform the operation.");
@@ -515,6 +577,24 @@ public class Ecc extends NativeStruct {
         return result;
     }
 
+    /* record event returned by CryptoEvents.begin(), if any, with key
+     * size and curve of this key */
+    private void commitEvent(Object event, String algorithm) {
+
+        if (event != null) {
+            int size;
+            String curve;
+
+            synchronized (pointerLock) {
+                size = wc_ecc_size_ptr(getNativeStruct());
+                curve = wc_ecc_get_curve_name_from_id(
+                    wc_ecc_get_curve_id_ptr(getNativeStruct()));
+            }
+
+            CryptoEvents.commit(event, algorithm, size * 8, curve);
+        }
+    }
+
     /**
      * Get ECC curve size from curve name.
      *
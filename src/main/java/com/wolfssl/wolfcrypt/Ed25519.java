@@ -30,6 +30,11 @@ public class Ed25519 extends NativeStruct {
 
     private WolfCryptState state = WolfCryptState.UNINITIALIZED;
 
+    private static final Metrics.Operation signMetrics =
+        Metrics.operation(Ed25519.class, "sign");
+    private static final Metrics.Operation verifyMetrics =
+        Metrics.operation(Ed25519.class, "verify");
+
     /**
      * Create new Ed25519 object
      */
@@ -55,6 +60,15 @@ public class Ed25519 extends NativeStruct {
 
     private native void wc_ed25519_init();
     private native void wc_ed25519_free();
+    private static native void native_free_ptr(long ptr);
+
+    /* frees native ed25519_key contents if this object is collected without
+     * being released */
+    private static final NativeFree NATIVE_FREE = new NativeFree() {
+        public void free(long ptr) {
+            native_free_ptr(ptr);
+        }
+    };
     private native void wc_ed25519_make_key(Rng rng, int size);
     private native void wc_ed25519_check_key();
     private native void wc_ed25519_import_private(byte[] privKey, byte[] key);
@@ -72,6 +86,7 @@ public class Ed25519 extends NativeStruct {
     protected void init() {
         if (state == WolfCryptState.UNINITIALIZED) {
             wc_ed25519_init();
+            setNativeFree(NATIVE_FREE);
             state = WolfCryptState.INITIALIZED;
         } else {
             throw new IllegalStateException(
@@ -85,6 +100,7 @@ public class Ed25519 extends NativeStruct {
     protected void free() {
         if (state != WolfCryptState.UNINITIALIZED) {
             wc_ed25519_free();
+            setNativeFree(null);
             state = WolfCryptState.UNINITIALIZED;
         }
     }
@@ -240,7 +256,14 @@ public class Ed25519 extends NativeStruct {
 
         byte[] msg_out = null;
         if (state == WolfCryptState.READY) {
-            msg_out = wc_ed25519_sign_msg(msg_in);
+            long start = signMetrics.start();
+            try {
+                msg_out = wc_ed25519_sign_msg(msg_in);
+            } catch (WolfCryptException e) {
+                signMetrics.error(start);
+                throw e;
+            }
+            signMetrics.end(start, msg_in.length);
         } else {
             throw new IllegalStateException(
                     "No available key to perform the operation.");
@@ -264,7 +287,14 @@ public class Ed25519 extends NativeStruct {
         boolean result = false;
 
         if (state == WolfCryptState.READY) {
-            result = wc_ed25519_verify_msg(signature, msg);
+            long start = verifyMetrics.start();
+            try {
+                result = wc_ed25519_verify_msg(signature, msg);
+            } catch (WolfCryptException e) {
+                verifyMetrics.error(start);
+                throw e;
+            }
+            verifyMetrics.end(start, msg.length);
         } else {
             throw new IllegalStateException(
                     "No available key to perform the operation.");
@@ -62,6 +62,48 @@ public class FeatureDetect {
      */
     public static native boolean Sha512Enabled();
 
+    /**
+     * Tests if SHA3-224 is compiled into the native wolfSSL library.
+     *
+     * @return true if enabled, otherwise false if not compiled in.
+     */
+    public static native boolean Sha3_224Enabled();
+
+    /**
+     * Tests if SHA3-256 is compiled into the native wolfSSL library.
+     *
+     * @return true if enabled, otherwise false if not compiled in.
+     */
+    public static native boolean Sha3_256Enabled();
+
+    /**
+     * Tests if SHA3-384 is compiled into the native wolfSSL library.
+     *
+     * @return true if enabled, otherwise false if not compiled in.
+     */
+    public static native boolean Sha3_384Enabled();
+
+    /**
+     * Tests if SHA3-512 is compiled into the native wolfSSL library.
+     *
+     * @return true if enabled, otherwise false if not compiled in.
+     */
+    public static native boolean Sha3_512Enabled();
+
+    /**
+     * Tests if SHAKE128 is compiled into the native wolfSSL library.
+     *
+     * @return true if enabled, otherwise false if not compiled in.
+     */
+    public static native boolean Shake128Enabled();
+
+    /**
+     * Tests if SHAKE256 is compiled into the native wolfSSL library.
+     *
+     * @return true if enabled, otherwise false if not compiled in.
+     */
+    public static native boolean Shake256Enabled();
+
     /**
      * Tests if HMAC-MD5 is compiled into the native wolfSSL library and
      * available for use.
@@ -102,6 +144,36 @@ public class FeatureDetect {
      */
     public static native boolean HmacSha512Enabled();
 
+    /**
+     * Tests if AES-GCM is compiled into the native wolfSSL library.
+     *
+     * @return true if enabled, otherwise false if not compiled in.
+     */
+    public static native boolean AesGcmEnabled();
+
+    /**
+     * Tests if AES-GCM streaming (incremental) API is compiled into the
+     * native wolfSSL library, ie wolfSSL compiled with
+     * WOLFSSL_AESGCM_STREAM.
+     *
+     * @return true if enabled, otherwise false if not compiled in.
+     */
+    public static native boolean AesGcmStreamEnabled();
+
+    /**
+     * Tests if AES-CTR is compiled into the native wolfSSL library.
+     *
+     * @return true if enabled, otherwise false if not compiled in.
+     */
+    public static native boolean AesCtrEnabled();
+
+    /**
+     * Tests if AES-XTS is compiled into the native wolfSSL library.
+     *
+     * @return true if enabled, otherwise false if not compiled in.
+     */
+    public static native boolean AesXtsEnabled();
+
     /**
      * Loads JNI library.
      *
@@ -23,7 +23,9 @@ package com.wolfssl.wolfcrypt;
 
 import com.wolfssl.wolfcrypt.WolfCrypt;
 import com.wolfssl.wolfcrypt.WolfCryptException;
+import java.io.IOException;
 import java.nio.ByteBuffer;
+import java.nio.file.Path;
 
 /**
  * Wrapper for the native WolfCrypt HMAC implementation.
@@ -53,6 +55,11 @@ public class Hmac extends NativeStruct {
     /* Lock around object state */
     protected final Object stateLock = new Object();
 
+    private static final Metrics.Operation updateMetrics =
+        Metrics.operation(Hmac.class, "update");
+    private static final Metrics.Operation finalMetrics =
+        Metrics.operation(Hmac.class, "doFinal");
+
     /**
      * Create new Hmac object
      */
@@ -74,6 +81,12 @@ public class Hmac extends NativeStruct {
     private native void wc_HmacUpdate(byte[] data, int offset, int length);
     private native void wc_HmacUpdate(ByteBuffer data, int offset, int length);
     private native byte[] wc_HmacFinal();
+    private static native void wc_HmacUpdate_ptr(long ptr, byte data);
+    private static native void wc_HmacUpdate_ptr(long ptr, byte[] data,
+        int offset, int length);
+    private static native void wc_HmacUpdate_ptr(long ptr, ByteBuffer data,
+        int offset, int length);
+    private static native byte[] wc_HmacFinal_ptr(long ptr);
     private native int wc_HmacSizeByType(int type);
     private native static int getCodeMd5();
     private native static int getCodeSha();
@@ -160,9 +173,16 @@ public class Hmac extends NativeStruct {
         synchronized (stateLock) {
             if (state == WolfCryptState.READY) {
 
-                synchronized (pointerLock) {
-                    wc_HmacUpdate(data);
+                long start = updateMetrics.start();
+                try {
+                    synchronized (pointerLock) {
+                        wc_HmacUpdate_ptr(getNativeStruct(), data);
+                    }
+                } catch (WolfCryptException e) {
+                    updateMetrics.error(start);
+                    throw e;
                 }
+                updateMetrics.end(start, 1);
             } else {
                 throw new IllegalStateException(
                     "No available key to perform the operation");
@@ -184,9 +204,17 @@ public class Hmac extends NativeStruct {
         synchronized (stateLock) {
             if (state == WolfCryptState.READY) {
 
-                synchronized (pointerLock) {
-                    wc_HmacUpdate(data, 0, data.length);
+                long start = updateMetrics.start();
+                try {
+                    synchronized (pointerLock) {
+                        wc_HmacUpdate_ptr(getNativeStruct(), data, 0,
+                            data.length);
+                    }
+                } catch (WolfCryptException e) {
+                    updateMetrics.error(start);
+                    throw e;
                 }
+                updateMetrics.end(start, data.length);
             } else {
                 throw new IllegalStateException(
                     "No available key to perform the operation");
@@ -210,9 +238,17 @@ public class Hmac extends NativeStruct {
         synchronized (stateLock) {
             if (state == WolfCryptState.READY) {
 
-                synchronized (pointerLock) {
-                    wc_HmacUpdate(data, offset, length);
+                long start = updateMetrics.start();
+                try {
+                    synchronized (pointerLock) {
+                        wc_HmacUpdate_ptr(getNativeStruct(), data, offset,
+                            length);
+                    }
+                } catch (WolfCryptException e) {
+                    updateMetrics.error(start);
+                    throw e;
                 }
+                updateMetrics.end(start, length);
             } else {
                 throw new IllegalStateException(
                     "No available key to perform the operation");
@@ -236,9 +272,17 @@ public class Hmac extends NativeStruct {
                 int offset = data.position();
                 int length = data.remaining();
 
-                synchronized (pointerLock) {
-                    wc_HmacUpdate(data, offset, length);
+                long start = updateMetrics.start();
+                try {
+                    synchronized (pointerLock) {
+                        wc_HmacUpdate_ptr(getNativeStruct(), data, offset,
+                            length);
+                    }
+                } catch (WolfCryptException e) {
+                    updateMetrics.error(start);
+                    throw e;
                 }
+                updateMetrics.end(start, length);
 
                 data.position(offset + length);
             } else {
@@ -248,6 +292,30 @@ public class Hmac extends NativeStruct {
         }
     }
 
+    /**
+     * Perform HMAC update operation with the contents of a file.
+     *
+     * The file is memory mapped read-only and passed to native code through
+     * the direct ByteBuffer path, no file data is copied through the Java
+     * heap.
+     *
+     * @param path file to authenticate
+     *
+     * @throws IOException if opening or mapping the file fails
+     * @throws WolfCryptException if native operation fails
+     * @throws IllegalStateException if object has no key
+     */
+    public synchronized void updateFile(Path path)
+        throws IOException, WolfCryptException, IllegalStateException {
+
+        MappedFile.read(path, new MappedFile.Sink() {
+            @Override
+            public void update(ByteBuffer window) {
+                Hmac.this.update(window);
+            }
+        });
+    }
+
     /**
      * Calculate final HMAC
      *
@@ -262,9 +330,7 @@ public class Hmac extends NativeStruct {
         synchronized (stateLock) {
             if (state == WolfCryptState.READY) {
 
-                synchronized (pointerLock) {
-                    return wc_HmacFinal();
-                }
+                return hmacFinal();
             } else {
                 throw new IllegalStateException(
                     "No available key to perform the operation");
@@ -289,9 +355,7 @@ public class Hmac extends NativeStruct {
             if (state == WolfCryptState.READY) {
                 update(data);
 
-                synchronized (pointerLock) {
-                    return wc_HmacFinal();
-                }
+                return hmacFinal();
             } else {
                 throw new IllegalStateException(
                     "No available key to perform the operation");
@@ -299,6 +363,54 @@ public class Hmac extends NativeStruct {
         }
     }
 
+    /* calculate final HMAC, caller holds stateLock */
+    private byte[] hmacFinal() throws WolfCryptException {
+
+        byte[] result;
+        long start = finalMetrics.start();
+
+        try {
+            synchronized (pointerLock) {
+                result = wc_HmacFinal_ptr(getNativeStruct());
+            }
+        } catch (WolfCryptException e) {
+            finalMetrics.error(start);
+            throw e;
+        }
+        finalMetrics.end(start, 0);
+
+        return result;
+    }
+
+    /**
+     * Compute HMAC of a file.
+     *
+     * The file is memory mapped read-only and authenticated in place by
+     * native wolfCrypt, no file data is copied through the Java heap.
+     *
+     * @param type HMAC type (Hmac.SHA, Hmac.SHA256, etc)
+     * @param key HMAC key
+     * @param path file to authenticate
+     *
+     * @return HMAC of file contents
+     *
+     * @throws IOException if opening or mapping the file fails
+     * @throws WolfCryptException if native operation fails
+     */
+    public static byte[] macFile(int type, byte[] key, Path path)
+        throws IOException, WolfCryptException {
+
+        Hmac hmac = new Hmac(type, key);
+
+        try {
+            hmac.updateFile(path);
+            return hmac.doFinal();
+
+        } finally {
+            hmac.releaseNativeStruct();
+        }
+    }
+
     /**
      * Get HMAC algorithm type
      *
@@ -21,11 +21,44 @@
 
 package com.wolfssl.wolfcrypt;
 
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Locale;
+
 /**
  * Wrapper for the native WolfCrypt Logging implementation
+ *
+ * Besides native wolfSSL debug output, the JNI layer keeps its own leveled
+ * log in a fixed size in-memory ring buffer. Records are stored unformatted
+ * and only turned into strings by {@link #getNativeLog()}, so enabled log
+ * points stay cheap on hot paths. The level can be set at runtime with
+ * {@link #setNativeLogLevel(int)} or at startup with the
+ * "wolfcrypt.jni.log.level" System property ("off", "error", "info",
+ * "debug"). Levels above {@link #getNativeMaxLogLevel()} were compiled out
+ * of the native library and never produce records. A runtime level of
+ * JNI_LOG_DEBUG also turns on the debug output of the wolfJCE provider.
  */
 public class Logging extends WolfObject {
 
+    /** Native JNI logging disabled (default) */
+    public static final int JNI_LOG_OFF = 0;
+    /** Log native errors thrown back to Java as exceptions */
+    public static final int JNI_LOG_ERROR = 1;
+    /** Also log individual cryptographic operations and their sizes */
+    public static final int JNI_LOG_INFO = 2;
+    /** Also log debug records */
+    public static final int JNI_LOG_DEBUG = 3;
+
+    private static final String LOG_LEVEL_PROPERTY = "wolfcrypt.jni.log.level";
+
+    /* Java side copy of the runtime level, checked without a JNI call */
+    private static volatile int logLevel = JNI_LOG_OFF;
+
+    private static native void nativeSetLogLevel(int level);
+    private static native int nativeGetLogLevel();
+    private static native int nativeGetMaxLogLevel();
+    private static native String[] nativeDrainLog();
+
     /**
      * Turn on native wolfSSL debug logging
      *
@@ -38,6 +71,115 @@ public class Logging extends WolfObject {
      */
     public static native void wolfSSL_Debugging_OFF();
 
+    /**
+     * Set the runtime level of the native JNI log.
+     *
+     * @param level one of JNI_LOG_OFF, JNI_LOG_ERROR, JNI_LOG_INFO or
+     *        JNI_LOG_DEBUG. Out of range values are clamped.
+     */
+    public static void setNativeLogLevel(int level) {
+        nativeSetLogLevel(level);
+        logLevel = Math.max(JNI_LOG_OFF, Math.min(level, JNI_LOG_DEBUG));
+    }
+
+    /**
+     * Check if records of a level are logged at the current runtime
+     * level. Reads a Java side copy of the level, so it is cheap enough
+     * to guard building of log messages on hot paths. wolfJCE uses it to
+     * gate its own debug output.
+     *
+     * @param level one of JNI_LOG_ERROR, JNI_LOG_INFO or JNI_LOG_DEBUG
+     *
+     * @return true if level is enabled, otherwise false
+     */
+    public static boolean isLogLevelEnabled(int level) {
+        return level > JNI_LOG_OFF && level <= logLevel;
+    }
+
+    /**
+     * Get the runtime level of the native JNI log.
+     *
+     * @return current native log level
+     */
+    public static int getNativeLogLevel() {
+        return nativeGetLogLevel();
+    }
+
+    /**
+     * Get the highest log level compiled into the native library,
+     * controlled by WOLFCRYPT_JNI_LOG_LEVEL at build time.
+     *
+     * @return maximum native log level
+     */
+    public static int getNativeMaxLogLevel() {
+        return nativeGetMaxLogLevel();
+    }
+
+    /**
+     * Remove and format all records currently held in the native log
+     * ring buffer, oldest first. Records overwritten before being drained
+     * are lost.
+     *
+     * @return formatted log lines, empty if nothing was logged
+     */
+    public static synchronized String[] getNativeLog() {
+        String[] raw = nativeDrainLog();
+        List<String> lines;
+
+        if (raw == null) {
+            return new String[0];
+        }
+
+        lines = new ArrayList<String>(raw.length);
+        for (String s : raw) {
+            /* slots being written during the drain are skipped */
+            if (s != null) {
+                lines.add(s);
+            }
+        }
+
+        return lines.toArray(new String[lines.size()]);
+    }
+
+    /**
+     * Apply the "wolfcrypt.jni.log.level" System property, called once
+     * after the native library has been loaded.
+     */
+    static void setNativeLogLevelFromProperty() {
+        String value;
+
+        try {
+            value = System.getProperty(LOG_LEVEL_PROPERTY);
+        } catch (SecurityException e) {
+            return;
+        }
+
+        if (value == null) {
+            return;
+        }
+
+        switch (value.trim().toLowerCase(Locale.ROOT)) {
+            case "off":
+                setNativeLogLevel(JNI_LOG_OFF);
+                break;
+            case "error":
+                setNativeLogLevel(JNI_LOG_ERROR);
+                break;
+            case "info":
+                setNativeLogLevel(JNI_LOG_INFO);
+                break;
+            case "debug":
+                setNativeLogLevel(JNI_LOG_DEBUG);
+                break;
+            default:
+                try {
+                    setNativeLogLevel(Integer.parseInt(value.trim()));
+                } catch (NumberFormatException e) {
+                    /* ignore unrecognized values, leave logging off */
+                }
+        }
+    }
+
     /** Default Logging constructor */
     public Logging() { }
 }
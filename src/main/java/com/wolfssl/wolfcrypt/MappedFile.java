@@ -0,0 +1,75 @@
+/* MappedFile.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+
+/**
+ * Feeds a file to a digest or MAC through read-only memory mapped windows.
+ *
+ * Mapped buffers are direct, so each window is passed to native wolfCrypt
+ * in place through the direct ByteBuffer JNI path, with no copy into a
+ * Java heap array.
+ */
+final class MappedFile {
+
+    /* size of each mapped window, bounds address space use on 32-bit JVMs
+     * and the time a single native update holds the object lock */
+    static final long WINDOW_SIZE = 64L * 1024 * 1024;
+
+    /** Receives each mapped window of the file in order */
+    interface Sink {
+        void update(ByteBuffer window);
+    }
+
+    private MappedFile() { }
+
+    /**
+     * Map path window by window and pass each window to sink.
+     *
+     * @param path file to read
+     * @param sink receiver of mapped windows
+     *
+     * @throws IOException if opening or mapping the file fails
+     */
+    static void read(Path path, Sink sink) throws IOException {
+
+        try (FileChannel channel =
+                 FileChannel.open(path, StandardOpenOption.READ)) {
+
+            long size = channel.size();
+
+            for (long pos = 0; pos < size; pos += WINDOW_SIZE) {
+                long len = Math.min(WINDOW_SIZE, size - pos);
+                MappedByteBuffer window =
+                    channel.map(FileChannel.MapMode.READ_ONLY, pos, len);
+
+                sink.update(window);
+            }
+        }
+    }
+}
@@ -21,7 +21,11 @@
 
 package com.wolfssl.wolfcrypt;
 
+import java.io.IOException;
 import java.nio.ByteBuffer;
+import java.nio.file.Path;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
 
 import javax.crypto.ShortBufferException;
 
@@ -32,9 +36,78 @@ public abstract class MessageDigest extends NativeStruct {
 
     private WolfCryptState state = WolfCryptState.UNINITIALIZED;
 
+    /* update and digest Operations, resolved once per metrics class
+     * rather than once per object */
+    private static final ConcurrentMap<Class<?>, Metrics.Operation[]>
+        classMetrics = new ConcurrentHashMap<Class<?>, Metrics.Operation[]>();
+
+    private static final int UPDATE_METRICS = 0;
+    private static final int DIGEST_METRICS = 1;
+
+    /* Operations of metricsClass(), looked up on first use */
+    private Metrics.Operation[] metrics = null;
+
+    /* one-shot hash, init/update/final over a native stack structure.
+     * type is the TYPE of the Md5, Sha, Sha256, Sha384 or Sha512 class */
+    private static native void native_hash(int type, ByteBuffer data,
+        int offset, int len, ByteBuffer hash, int hashOffset);
+    private static native void native_hash(int type, byte[] data,
+        int offset, int len, byte[] hash, int hashOffset);
+
+    /* batch hash, many independent messages in one native call */
+    private static native void native_hash_batch(int type, byte[] data,
+        int[] offsets, int[] lengths, int count, byte[] hash,
+        int hashOffset);
+    private static native void native_hash_batch(int type, ByteBuffer[] data,
+        int[] offsets, int[] lengths, int count, ByteBuffer hash,
+        int hashOffset);
+
+    /* TYPE of each subclass with static hash() methods */
+    private static final int[] hashTypes = new int[] {
+        Md5.TYPE, Sha.TYPE, Sha256.TYPE, Sha384.TYPE, Sha512.TYPE
+    };
+
+    /* one-shot hash Operations, indexed by hash type */
+    private static final Metrics.Operation[] hashMetrics =
+        hashTypeMetrics("hash");
+    private static final Metrics.Operation[] hashBatchMetrics =
+        hashTypeMetrics("hashBatch");
+
     /** Default MessageDigest constructor */
     public MessageDigest() { }
 
+    /**
+     * Get class that update and digest calls of this object are recorded
+     * under in Metrics. Defaults to the class of this object, classes
+     * serving several variants return the class of their variant.
+     *
+     * @return class to record metrics under
+     */
+    protected Class<?> metricsClass() {
+        return getClass();
+    }
+
+    private Metrics.Operation[] metrics() {
+
+        Metrics.Operation[] ops = metrics;
+
+        if (ops == null) {
+            Class<?> cls = metricsClass();
+
+            ops = classMetrics.get(cls);
+            if (ops == null) {
+                ops = new Metrics.Operation[] {
+                    Metrics.operation(cls, "update"),
+                    Metrics.operation(cls, "digest")
+                };
+                classMetrics.putIfAbsent(cls, ops);
+            }
+            metrics = ops;
+        }
+
+        return ops;
+    }
+
     /**
      * Initialize native structure
      */
@@ -112,7 +185,16 @@ public abstract class MessageDigest extends NativeStruct {
         if (state == WolfCryptState.READY) {
             length = Math.min(length, data.remaining());
 
-            native_update(data, data.position(), length);
+            Metrics.Operation updateMetrics = metrics()[UPDATE_METRICS];
+            long start = updateMetrics.start();
+            try {
+                native_update(data, data.position(), length);
+            } catch (WolfCryptException e) {
+                updateMetrics.error(start);
+                throw e;
+            }
+            updateMetrics.end(start, length);
+
             data.position(data.position() + length);
         } else {
             throw new IllegalStateException(
@@ -154,7 +236,15 @@ public abstract class MessageDigest extends NativeStruct {
             if (data.length - offset < len)
                 len = data.length - offset;
 
-            native_update(data, offset, len);
+            Metrics.Operation updateMetrics = metrics()[UPDATE_METRICS];
+            long start = updateMetrics.start();
+            try {
+                native_update(data, offset, len);
+            } catch (WolfCryptException e) {
+                updateMetrics.error(start);
+                throw e;
+            }
+            updateMetrics.end(start, len);
         } else {
             throw new IllegalStateException(
                     "Object must be initialized before use");
@@ -190,6 +280,30 @@ public abstract class MessageDigest extends NativeStruct {
         update(data, 0, data.length);
     }
 
+    /**
+     * Message digest update with the contents of a file.
+     *
+     * The file is memory mapped read-only and passed to native code through
+     * the direct ByteBuffer path, no file data is copied through the Java
+     * heap.
+     *
+     * @param path file to hash
+     *
+     * @throws IOException if opening or mapping the file fails
+     * @throws WolfCryptException if native operation fails
+     * @throws IllegalStateException object not initialized
+     */
+    public synchronized void updateFile(Path path)
+        throws IOException, WolfCryptException, IllegalStateException {
+
+        MappedFile.read(path, new MappedFile.Sink() {
+            @Override
+            public void update(ByteBuffer window) {
+                MessageDigest.this.update(window);
+            }
+        });
+    }
+
     /**
      * Calculate message digest
      *
@@ -207,7 +321,16 @@ public abstract class MessageDigest extends NativeStruct {
                 throw new ShortBufferException(
                         "Input buffer is too small for digest size");
 
-            native_final(hash, hash.position());
+            Metrics.Operation digestMetrics = metrics()[DIGEST_METRICS];
+            long start = digestMetrics.start();
+            try {
+                native_final(hash, hash.position());
+            } catch (WolfCryptException e) {
+                digestMetrics.error(start);
+                throw e;
+            }
+            digestMetrics.end(start, 0);
+
             hash.position(hash.position() + digestSize());
         } else {
             throw new IllegalStateException(
@@ -232,7 +355,7 @@ public abstract class MessageDigest extends NativeStruct {
                 throw new ShortBufferException(
                         "Input buffer is too small for digest size");
 
-            native_final(hash);
+            finalDigest(hash);
         } else {
             throw new IllegalStateException(
                     "Object must be initialized before use");
@@ -253,7 +376,7 @@ public abstract class MessageDigest extends NativeStruct {
         if (state == WolfCryptState.READY) {
             byte[] hash = new byte[digestSize()];
 
-            native_final(hash);
+            finalDigest(hash);
 
             return hash;
         } else {
@@ -262,6 +385,420 @@ public abstract class MessageDigest extends NativeStruct {
         }
     }
 
+    /**
+     * Check arguments passed to the static one-shot hash() methods of
+     * MessageDigest subclasses.
+     *
+     * @param dataLen length of input array
+     * @param offset offset into input array
+     * @param len length of input data
+     * @param hashLen length of output array
+     * @param hashOffset offset into output array
+     * @param digestSize digest size of the algorithm
+     *
+     * @throws ShortBufferException if output is too small for digest
+     * @throws IllegalArgumentException if offsets or length are invalid
+     */
+    protected static void checkHashArgs(int dataLen, int offset, int len,
+        int hashLen, int hashOffset, int digestSize)
+        throws ShortBufferException {
+
+        if (offset < 0 || len < 0 || offset > dataLen - len ||
+            hashOffset < 0) {
+            throw new IllegalArgumentException(
+                "Invalid offset or length for input or output buffer");
+        }
+
+        if (hashOffset > hashLen - digestSize) {
+            throw new ShortBufferException(
+                "Output buffer is too small for digest size");
+        }
+    }
+
+    /**
+     * Get class of a hash type, static hash() calls are recorded under it
+     * in Metrics.
+     *
+     * @param type hash type, TYPE of a MessageDigest subclass
+     *
+     * @return class of hash type
+     *
+     * @throws IllegalArgumentException if type is invalid
+     */
+    private static Class<?> hashClass(int type) {
+
+        switch (type) {
+            case Md5.TYPE:
+                return Md5.class;
+            case Sha.TYPE:
+                return Sha.class;
+            case Sha256.TYPE:
+                return Sha256.class;
+            case Sha384.TYPE:
+                return Sha384.class;
+            case Sha512.TYPE:
+                return Sha512.class;
+            default:
+                throw new IllegalArgumentException(
+                    "Invalid hash type: " + type);
+        }
+    }
+
+    /**
+     * Get digest size of a hash type.
+     *
+     * @param type hash type, TYPE of a MessageDigest subclass
+     *
+     * @return digest size in bytes
+     *
+     * @throws IllegalArgumentException if type is invalid
+     */
+    private static int hashDigestSize(int type) {
+
+        switch (type) {
+            case Md5.TYPE:
+                return Md5.DIGEST_SIZE;
+            case Sha.TYPE:
+                return Sha.DIGEST_SIZE;
+            case Sha256.TYPE:
+                return Sha256.DIGEST_SIZE;
+            case Sha384.TYPE:
+                return Sha384.DIGEST_SIZE;
+            case Sha512.TYPE:
+                return Sha512.DIGEST_SIZE;
+            default:
+                throw new IllegalArgumentException(
+                    "Invalid hash type: " + type);
+        }
+    }
+
+    private static Metrics.Operation[] hashTypeMetrics(String name) {
+
+        int max = 0;
+
+        for (int type : hashTypes) {
+            max = Math.max(max, type);
+        }
+
+        Metrics.Operation[] ops = new Metrics.Operation[max + 1];
+        for (int type : hashTypes) {
+            ops[type] = Metrics.operation(hashClass(type), name);
+        }
+
+        return ops;
+    }
+
+    /**
+     * Compute digest of data in a single native call, used by the static
+     * hash() methods of MessageDigest subclasses.
+     *
+     * No native structure is allocated, hash state is kept on the native
+     * stack for the duration of the call. Safe for concurrent use from
+     * multiple threads.
+     *
+     * @param type hash type, TYPE of a MessageDigest subclass
+     * @param data input data
+     * @param offset offset into input data
+     * @param len length of input data
+     * @param hash output buffer, digest size of type bytes are written
+     * @param hashOffset offset into output buffer
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     * @throws IllegalArgumentException if type, offsets or length are
+     *         invalid
+     */
+    protected static void hashByType(int type, byte[] data, int offset,
+        int len, byte[] hash, int hashOffset)
+        throws WolfCryptException, ShortBufferException {
+
+        checkHashArgs(data.length, offset, len, hash.length, hashOffset,
+            hashDigestSize(type));
+
+        Metrics.Operation metrics = hashMetrics[type];
+        long start = metrics.start();
+        try {
+            native_hash(type, data, offset, len, hash, hashOffset);
+        } catch (WolfCryptException e) {
+            metrics.error(start);
+            throw e;
+        }
+        metrics.end(start, len);
+    }
+
+    /**
+     * Compute digest of data in a single native call.
+     *
+     * @param type hash type, TYPE of a MessageDigest subclass
+     * @param data input data
+     *
+     * @return digest of data
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws IllegalArgumentException if type is invalid
+     */
+    protected static byte[] hashByType(int type, byte[] data)
+        throws WolfCryptException {
+
+        byte[] hash = new byte[hashDigestSize(type)];
+
+        try {
+            hashByType(type, data, 0, data.length, hash, 0);
+        } catch (ShortBufferException e) {
+            /* not reached, output is sized for the digest */
+            throw new WolfCryptException(e.getMessage(), e);
+        }
+
+        return hash;
+    }
+
+    /**
+     * Compute digest of all remaining bytes of data in a single native
+     * call. Positions of both buffers are advanced. Direct buffers are
+     * passed to native code in place.
+     *
+     * @param type hash type, TYPE of a MessageDigest subclass
+     * @param data input data, data.remaining() bytes are hashed
+     * @param hash output buffer
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     * @throws IllegalArgumentException if type is invalid
+     */
+    protected static void hashByType(int type, ByteBuffer data,
+        ByteBuffer hash) throws WolfCryptException, ShortBufferException {
+
+        int len = data.remaining();
+        int size = hashDigestSize(type);
+
+        if (hash.remaining() < size) {
+            throw new ShortBufferException(
+                "Output buffer is too small for digest size");
+        }
+
+        if (data.isDirect() && hash.isDirect()) {
+            Metrics.Operation metrics = hashMetrics[type];
+            long start = metrics.start();
+            try {
+                native_hash(type, data, data.position(), len, hash,
+                    hash.position());
+            } catch (WolfCryptException e) {
+                metrics.error(start);
+                throw e;
+            }
+            metrics.end(start, len);
+
+            hash.position(hash.position() + size);
+        }
+        else {
+            byte[] out = new byte[size];
+
+            if (data.hasArray()) {
+                hashByType(type, data.array(),
+                    data.arrayOffset() + data.position(), len, out, 0);
+            }
+            else {
+                byte[] in = new byte[len];
+                data.duplicate().get(in);
+                hashByType(type, in, 0, len, out, 0);
+            }
+
+            hash.put(out);
+        }
+
+        data.position(data.limit());
+    }
+
+    /**
+     * Check arguments passed to the static hashBatch() methods of
+     * MessageDigest subclasses.
+     *
+     * @param dataLen length of input array
+     * @param offsets offset of each message in the input array
+     * @param lengths length of each message
+     * @param hashLen length of output array
+     * @param hashOffset offset into output array of the first digest
+     * @param digestSize digest size of the algorithm
+     *
+     * @return total number of input bytes
+     *
+     * @throws ShortBufferException if output is too small for all digests
+     * @throws IllegalArgumentException if offsets or lengths are invalid
+     */
+    protected static long checkBatchArgs(int dataLen, int[] offsets,
+        int[] lengths, int hashLen, int hashOffset, int digestSize)
+        throws ShortBufferException {
+
+        long total = 0;
+
+        if (offsets.length != lengths.length || hashOffset < 0) {
+            throw new IllegalArgumentException(
+                "Invalid batch offsets, lengths or output offset");
+        }
+
+        for (int i = 0; i < offsets.length; i++) {
+            if (offsets[i] < 0 || lengths[i] < 0 ||
+                offsets[i] > dataLen - lengths[i]) {
+                throw new IllegalArgumentException(
+                    "Invalid offset or length for batch message " + i);
+            }
+            total += lengths[i];
+        }
+
+        if (hashOffset + ((long)offsets.length * digestSize) > hashLen) {
+            throw new ShortBufferException(
+                "Output buffer is too small for all digests");
+        }
+
+        return total;
+    }
+
+    /**
+     * Compute digests of many independent messages in a single native
+     * call, used by the static hashBatch() methods of MessageDigest
+     * subclasses.
+     *
+     * Message i is data[offsets[i]] to data[offsets[i] + lengths[i] - 1].
+     * Its digest is written to hash at hashOffset + (i * digest size).
+     *
+     * @param type hash type, TYPE of a MessageDigest subclass
+     * @param data input buffer holding all messages
+     * @param offsets offset of each message in data
+     * @param lengths length of each message
+     * @param hash output buffer, offsets.length digests are written
+     * @param hashOffset offset into output buffer of the first digest
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     * @throws IllegalArgumentException if type, offsets or lengths are
+     *         invalid
+     */
+    protected static void hashBatchByType(int type, byte[] data,
+        int[] offsets, int[] lengths, byte[] hash, int hashOffset)
+        throws WolfCryptException, ShortBufferException {
+
+        long total = checkBatchArgs(data.length, offsets, lengths,
+            hash.length, hashOffset, hashDigestSize(type));
+
+        Metrics.Operation metrics = hashBatchMetrics[type];
+        long start = metrics.start();
+        try {
+            native_hash_batch(type, data, offsets, lengths, offsets.length,
+                hash, hashOffset);
+        } catch (WolfCryptException e) {
+            metrics.error(start);
+            throw e;
+        }
+        metrics.end(start, total);
+    }
+
+    /**
+     * Compute digests of the remaining bytes of each buffer in data,
+     * writing them back to back into hash. Positions of all buffers are
+     * advanced.
+     *
+     * When data and hash are all direct buffers, the batch is processed
+     * in a single native call with no copies. Otherwise each buffer is
+     * hashed with hashByType(int, ByteBuffer, ByteBuffer).
+     *
+     * @param type hash type, TYPE of a MessageDigest subclass
+     * @param data input buffers, one message per buffer
+     * @param hash output buffer, data.length digests are written
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     * @throws IllegalArgumentException if type is invalid
+     */
+    protected static void hashBatchByType(int type, ByteBuffer[] data,
+        ByteBuffer hash) throws WolfCryptException, ShortBufferException {
+
+        int count = data.length;
+        int size = hashDigestSize(type);
+        boolean direct = hash.isDirect();
+        long total = 0;
+
+        if (hash.remaining() < (long)count * size) {
+            throw new ShortBufferException(
+                "Output buffer is too small for all digests");
+        }
+
+        for (ByteBuffer b : data) {
+            if (!b.isDirect()) {
+                direct = false;
+            }
+        }
+
+        if (!direct) {
+            for (ByteBuffer b : data) {
+                hashByType(type, b, hash);
+            }
+            return;
+        }
+
+        int[] offsets = new int[count];
+        int[] lengths = new int[count];
+        for (int i = 0; i < count; i++) {
+            offsets[i] = data[i].position();
+            lengths[i] = data[i].remaining();
+            total += lengths[i];
+        }
+
+        Metrics.Operation metrics = hashBatchMetrics[type];
+        long start = metrics.start();
+        try {
+            native_hash_batch(type, data, offsets, lengths, count, hash,
+                hash.position());
+        } catch (WolfCryptException e) {
+            metrics.error(start);
+            throw e;
+        }
+        metrics.end(start, total);
+
+        for (ByteBuffer b : data) {
+            b.position(b.limit());
+        }
+        hash.position(hash.position() + (count * size));
+    }
+
+    /**
+     * Compute digest of a file with a freshly constructed digest object,
+     * used by the static hashFile() methods of MessageDigest subclasses.
+     *
+     * The native structure of md is released before returning.
+     *
+     * @param md new MessageDigest object of the wanted hash type
+     * @param path file to hash
+     *
+     * @return digest of file contents
+     *
+     * @throws IOException if opening or mapping the file fails
+     * @throws WolfCryptException if native operation fails
+     */
+    protected static byte[] hashFileWith(MessageDigest md, Path path)
+        throws IOException, WolfCryptException {
+
+        try {
+            md.updateFile(path);
+            return md.digest();
+
+        } finally {
+            md.releaseNativeStruct();
+        }
+    }
+
+    private void finalDigest(byte[] hash) throws WolfCryptException {
+
+        Metrics.Operation digestMetrics = metrics()[DIGEST_METRICS];
+        long start = digestMetrics.start();
+        try {
+            native_final(hash);
+        } catch (WolfCryptException e) {
+            digestMetrics.error(start);
+            throw e;
+        }
+        digestMetrics.end(start, 0);
+    }
+
     @Override
     public synchronized void releaseNativeStruct() {
 
@@ -0,0 +1,446 @@
+/* Metrics.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.List;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
+import java.util.concurrent.atomic.AtomicLongArray;
+
+/**
+ * Per-operation counters and latency histograms.
+ *
+ * Each Operation, identified by algorithm and operation name (ex: "Sha256"
+ * and "update"), counts completed calls, bytes processed, errors and total
+ * time. Operations recorded by the com.wolfssl.wolfcrypt classes time the
+ * native call only. Operations recorded by the wolfJCE SPIs (ex:
+ * "SHA256withECDSA" and "engineSign") also include time spent in the
+ * provider itself.
+ *
+ * Recording is disabled by default. Enable it with the
+ * "wolfcrypt.jni.metrics" System property set to "true", or at runtime
+ * with setEnabled(). While disabled, recording costs one volatile read per
+ * operation. When enabled, counters are published through JMX as a
+ * MetricsMXBean named "com.wolfssl.wolfcrypt:type=Metrics" where the
+ * java.lang.management API is available.
+ *
+ * Counters are striped by thread so that concurrent operations do not
+ * contend on the same cache line.
+ */
+public final class Metrics {
+
+    /** Number of latency histogram buckets */
+    public static final int LATENCY_BUCKETS = 20;
+
+    /* bucket i counts latencies below 2^(i + LATENCY_SHIFT) nanoseconds,
+     * last bucket counts everything above */
+    private static final int LATENCY_SHIFT = 10;
+
+    /* cell layout of one stripe, padded to a multiple of 64 bytes */
+    private static final int COUNT = 0;
+    private static final int BYTES = 1;
+    private static final int ERRORS = 2;
+    private static final int NANOS = 3;
+    private static final int HISTOGRAM = 4;
+    private static final int STRIDE = 32;
+
+    private static final int STRIPES = stripes();
+
+    private static volatile boolean enabled = checkProperty();
+    private static volatile boolean registered = false;
+
+    private static final ConcurrentMap<String, Operation> operations =
+        new ConcurrentHashMap<String, Operation>();
+
+    static {
+        if (enabled) {
+            registerMBean();
+        }
+    }
+
+    private Metrics() { }
+
+    /**
+     * Get Operation used to record calls to an algorithm operation,
+     * creating it on first use.
+     *
+     * @param algorithm algorithm name
+     * @param name operation name
+     *
+     * @return Operation for algorithm and name
+     */
+    public static Operation operation(String algorithm, String name) {
+
+        String key = algorithm + "." + name;
+        Operation op = operations.get(key);
+
+        if (op == null) {
+            Operation created = new Operation(algorithm, name);
+            op = operations.putIfAbsent(key, created);
+            if (op == null) {
+                op = created;
+            }
+        }
+
+        return op;
+    }
+
+    /**
+     * Get Operation used to record calls to an operation of a class,
+     * named after the class simple name.
+     *
+     * @param cls class implementing the algorithm
+     * @param name operation name
+     *
+     * @return Operation for class and name
+     */
+    public static Operation operation(Class<?> cls, String name) {
+        return operation(cls.getSimpleName(), name);
+    }
+
+    /**
+     * Check if metrics recording is enabled
+     *
+     * @return true if enabled, otherwise false
+     */
+    public static boolean isEnabled() {
+        return enabled;
+    }
+
+    /**
+     * Enable or disable metrics recording. Enabling also registers the
+     * JMX MBean if not already registered.
+     *
+     * @param enable true to enable recording, false to disable
+     */
+    public static void setEnabled(boolean enable) {
+
+        enabled = enable;
+
+        if (enable) {
+            registerMBean();
+        }
+    }
+
+    /**
+     * Reset counters of all operations to zero
+     */
+    public static void reset() {
+        for (Operation op : operations.values()) {
+            op.reset();
+        }
+    }
+
+    /**
+     * Get all operations that have recorded at least one call or error,
+     * sorted by algorithm and operation name.
+     *
+     * @return list of operations
+     */
+    public static List<Operation> getOperations() {
+
+        List<Operation> list = new ArrayList<Operation>();
+
+        for (Operation op : operations.values()) {
+            if (op.getCount() != 0 || op.getErrors() != 0) {
+                list.add(op);
+            }
+        }
+
+        Collections.sort(list, new Comparator<Operation>() {
+            @Override
+            public int compare(Operation a, Operation b) {
+                int ret = a.getAlgorithm().compareTo(b.getAlgorithm());
+                if (ret == 0) {
+                    ret = a.getName().compareTo(b.getName());
+                }
+                return ret;
+            }
+        });
+
+        return list;
+    }
+
+    /**
+     * Get upper bound of each latency histogram bucket, in nanoseconds.
+     * The last bucket has no upper bound and is reported as Long.MAX_VALUE.
+     *
+     * @return array of LATENCY_BUCKETS upper bounds
+     */
+    public static long[] getLatencyBucketBounds() {
+
+        long[] bounds = new long[LATENCY_BUCKETS];
+
+        for (int i = 0; i < LATENCY_BUCKETS - 1; i++) {
+            bounds[i] = 1L << (i + LATENCY_SHIFT);
+        }
+        bounds[LATENCY_BUCKETS - 1] = Long.MAX_VALUE;
+
+        return bounds;
+    }
+
+    private static synchronized void registerMBean() {
+
+        if (registered) {
+            return;
+        }
+        registered = true;
+
+        try {
+            MetricsMBeanRegistration.register();
+        } catch (LinkageError e) {
+            /* java.lang.management not available (ex: Android) */
+        } catch (Exception e) {
+            /* JMX registration is best effort, recording still works */
+        }
+    }
+
+    private static boolean checkProperty() {
+
+        try {
+            String prop = System.getProperty("wolfcrypt.jni.metrics");
+            if (prop != null && prop.trim().equalsIgnoreCase("true")) {
+                return true;
+            }
+        } catch (SecurityException e) {
+            /* fall through to default */
+        }
+
+        return false;
+    }
+
+    private static int stripes() {
+
+        int cpus = Runtime.getRuntime().availableProcessors();
+        int n = 1;
+
+        while (n < cpus && n < 16) {
+            n <<= 1;
+        }
+
+        return n;
+    }
+
+    private static int bucket(long nanos) {
+
+        int bits = 64 - Long.numberOfLeadingZeros(nanos >>> LATENCY_SHIFT);
+
+        return Math.min(bits, LATENCY_BUCKETS - 1);
+    }
+
+    /**
+     * Counters and latency histogram of one algorithm operation.
+     *
+     * Recording follows the pattern:
+     * <pre>
+     * long start = op.start();
+     * ... run operation, on failure call op.error(start) ...
+     * op.end(start, bytes);
+     * </pre>
+     */
+    public static final class Operation {
+
+        private final String algorithm;
+        private final String name;
+
+        /* allocated on first recorded call */
+        private volatile AtomicLongArray cells = null;
+
+        Operation(String algorithm, String name) {
+            this.algorithm = algorithm;
+            this.name = name;
+        }
+
+        /**
+         * Get algorithm name
+         *
+         * @return algorithm name
+         */
+        public String getAlgorithm() {
+            return algorithm;
+        }
+
+        /**
+         * Get operation name
+         *
+         * @return operation name
+         */
+        public String getName() {
+            return name;
+        }
+
+        /**
+         * Get number of completed calls
+         *
+         * @return completed call count
+         */
+        public long getCount() {
+            return sum(COUNT);
+        }
+
+        /**
+         * Get number of bytes processed by completed calls
+         *
+         * @return byte count
+         */
+        public long getBytes() {
+            return sum(BYTES);
+        }
+
+        /**
+         * Get number of calls that failed
+         *
+         * @return error count
+         */
+        public long getErrors() {
+            return sum(ERRORS);
+        }
+
+        /**
+         * Get total time spent in completed calls, in nanoseconds
+         *
+         * @return total time in nanoseconds
+         */
+        public long getTimeNanos() {
+            return sum(NANOS);
+        }
+
+        /**
+         * Get latency histogram of completed calls, bucket bounds are
+         * given by Metrics.getLatencyBucketBounds().
+         *
+         * @return array of LATENCY_BUCKETS call counts
+         */
+        public long[] getLatencyHistogram() {
+
+            long[] histogram = new long[LATENCY_BUCKETS];
+
+            for (int i = 0; i < LATENCY_BUCKETS; i++) {
+                histogram[i] = sum(HISTOGRAM + i);
+            }
+
+            return histogram;
+        }
+
+        /**
+         * Mark start of a call.
+         *
+         * @return start time to pass to end() or error(), or 0 if
+         *         recording is disabled
+         */
+        public long start() {
+            if (!enabled) {
+                return 0;
+            }
+            return System.nanoTime();
+        }
+
+        /**
+         * Record a completed call.
+         *
+         * @param start value returned by start()
+         * @param bytes number of bytes processed by the call
+         */
+        public void end(long start, long bytes) {
+
+            if (start == 0) {
+                return;
+            }
+
+            long nanos = System.nanoTime() - start;
+            AtomicLongArray c = cells();
+            int base = stripe();
+
+            c.getAndIncrement(base + COUNT);
+            c.getAndAdd(base + BYTES, bytes);
+            c.getAndAdd(base + NANOS, nanos);
+            c.getAndIncrement(base + HISTOGRAM + bucket(nanos));
+        }
+
+        /**
+         * Record a failed call.
+         *
+         * @param start value returned by start()
+         */
+        public void error(long start) {
+
+            if (start == 0) {
+                return;
+            }
+
+            cells().getAndIncrement(stripe() + ERRORS);
+        }
+
+        /**
+         * Reset counters of this operation to zero
+         */
+        public void reset() {
+
+            AtomicLongArray c = cells;
+
+            if (c != null) {
+                for (int i = 0; i < c.length(); i++) {
+                    c.set(i, 0);
+                }
+            }
+        }
+
+        private AtomicLongArray cells() {
+
+            AtomicLongArray c = cells;
+
+            if (c == null) {
+                synchronized (this) {
+                    c = cells;
+                    if (c == null) {
+                        c = new AtomicLongArray(STRIPES * STRIDE);
+                        cells = c;
+                    }
+                }
+            }
+
+            return c;
+        }
+
+        private long sum(int index) {
+
+            AtomicLongArray c = cells;
+            long total = 0;
+
+            if (c != null) {
+                for (int i = 0; i < STRIPES; i++) {
+                    total += c.get(i * STRIDE + index);
+                }
+            }
+
+            return total;
+        }
+
+        private static int stripe() {
+            return ((int)Thread.currentThread().getId() & (STRIPES - 1))
+                * STRIDE;
+        }
+    }
+}
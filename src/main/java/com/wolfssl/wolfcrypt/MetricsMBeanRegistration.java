@@ -0,0 +1,74 @@
+/* MetricsMBeanRegistration.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+import java.lang.management.ManagementFactory;
+import java.util.List;
+import javax.management.MBeanServer;
+import javax.management.ObjectName;
+
+/**
+ * Registers Metrics with the platform MBeanServer. Kept separate from
+ * Metrics so that java.lang.management is only loaded when registering.
+ */
+final class MetricsMBeanRegistration implements MetricsMXBean {
+
+    /** ObjectName of the registered MBean */
+    static final String OBJECT_NAME = "com.wolfssl.wolfcrypt:type=Metrics";
+
+    private MetricsMBeanRegistration() { }
+
+    static void register() throws Exception {
+
+        MBeanServer server = ManagementFactory.getPlatformMBeanServer();
+        ObjectName name = new ObjectName(OBJECT_NAME);
+
+        if (!server.isRegistered(name)) {
+            server.registerMBean(new MetricsMBeanRegistration(), name);
+        }
+    }
+
+    @Override
+    public boolean isEnabled() {
+        return Metrics.isEnabled();
+    }
+
+    @Override
+    public void setEnabled(boolean enabled) {
+        Metrics.setEnabled(enabled);
+    }
+
+    @Override
+    public List<Metrics.Operation> getOperations() {
+        return Metrics.getOperations();
+    }
+
+    @Override
+    public long[] getLatencyBucketBounds() {
+        return Metrics.getLatencyBucketBounds();
+    }
+
+    @Override
+    public void reset() {
+        Metrics.reset();
+    }
+}
@@ -0,0 +1,64 @@
+/* MetricsMXBean.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+import java.util.List;
+
+/**
+ * JMX management interface for wolfCrypt JNI operation metrics, registered
+ * as "com.wolfssl.wolfcrypt:type=Metrics". See Metrics.
+ */
+public interface MetricsMXBean {
+
+    /**
+     * Check if metrics recording is enabled
+     *
+     * @return true if enabled, otherwise false
+     */
+    boolean isEnabled();
+
+    /**
+     * Enable or disable metrics recording
+     *
+     * @param enabled true to enable recording, false to disable
+     */
+    void setEnabled(boolean enabled);
+
+    /**
+     * Get counters of all operations that have been recorded
+     *
+     * @return list of operations
+     */
+    List<Metrics.Operation> getOperations();
+
+    /**
+     * Get upper bound of each latency histogram bucket, in nanoseconds
+     *
+     * @return array of bucket upper bounds
+     */
+    long[] getLatencyBucketBounds();
+
+    /**
+     * Reset counters of all operations to zero
+     */
+    void reset();
+}
@@ -21,19 +21,274 @@
 
 package com.wolfssl.wolfcrypt;
 
+import java.lang.ref.PhantomReference;
+import java.lang.ref.ReferenceQueue;
+import java.util.Collections;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentMap;
+
 /**
  * Wrapper for the native WolfCrypt structs.
+ *
+ * Native memory is released when releaseNativeStruct() or close() is
+ * called. Objects that are not released explicitly are tracked with a
+ * PhantomReference and their native memory is freed by a background
+ * cleanup thread once the object has been garbage collected.
+ *
+ * The cleanup thread, a daemon named "wolfCrypt NativeStruct cleaner",
+ * is started when the first object that owns native memory is created.
+ * It exits on its own once no tracked objects remain and it has been idle
+ * for a few seconds, so it does not keep the defining class loader alive
+ * after all NativeStruct objects are gone. A later object starts it again.
+ *
+ * Released native structures are zeroized and kept in a small per-class
+ * pool so that short lived objects (ex: one Sha256 per message) can reuse
+ * them instead of calling malloc/free each time. The pool size per class
+ * defaults to 16 and can be set with the "wolfcrypt.jni.pool.size" System
+ * property or setPoolSize(). A size of 0 disables pooling.
  */
-public abstract class NativeStruct extends WolfObject {
+public abstract class NativeStruct extends WolfObject
+    implements AutoCloseable {
 
     /** Logical mapping of NULL to 0 */
     public static final long NULL = 0;
 
+    /* Cache native JNI class and field IDs used to access the native
+     * pointer. Called once here since WolfObject has loaded the native
+     * library by the time NativeStruct is initialized. */
+    private static native void initNativeStructCache();
+
+    /* References to live objects, keeps each Cleanup reachable until its
+     * object has been collected and the native memory freed */
+    private static final Set<Cleanup> cleanups =
+        Collections.newSetFromMap(new ConcurrentHashMap<Cleanup, Boolean>());
+
+    private static final ReferenceQueue<NativeStruct> cleanupQueue =
+        new ReferenceQueue<NativeStruct>();
+
+    /* Idle time after which the cleaner exits if nothing is tracked */
+    private static final long CLEANER_IDLE_MS = 5000;
+
+    /* Guards starting and stopping the cleaner thread */
+    private static final Object cleanerLock = new Object();
+
+    /* Running cleaner thread, or null if none */
+    private static volatile Thread cleaner = null;
+
+    /** Default number of released structures kept per class */
+    public static final int DEFAULT_POOL_SIZE = 16;
+
+    /* Maximum number of pooled structures per class */
+    private static volatile int poolSize = readPoolSize();
+
+    /* Released native structures, by NativeStruct class */
+    private static final ConcurrentMap<Class<?>, Pool> pools =
+        new ConcurrentHashMap<Class<?>, Pool>();
+
+    static {
+        initNativeStructCache();
+    }
+
+    /* Frees native memory of collected objects until none are tracked */
+    private static final class Cleaner implements Runnable {
+        public void run() {
+            while (true) {
+                try {
+                    Cleanup c = (Cleanup)cleanupQueue.remove(
+                        CLEANER_IDLE_MS);
+                    if (c != null) {
+                        c.clean();
+                        cleanups.remove(c);
+                        continue;
+                    }
+                } catch (InterruptedException e) {
+                    /* check below whether there is work left */
+                } catch (Throwable t) {
+                    /* never let one failure stop later cleanups */
+                    continue;
+                }
+
+                synchronized (cleanerLock) {
+                    if (!cleanups.isEmpty()) {
+                        continue;
+                    }
+                    cleaner = null;
+                }
+
+                /* an object registered while exiting either saw
+                 * cleaner == null and started a new thread, or is seen
+                 * here */
+                if (!cleanups.isEmpty()) {
+                    startCleaner();
+                }
+                return;
+            }
+        }
+    }
+
+    /* Start cleaner thread if it is not running */
+    private static void startCleaner() {
+        if (cleaner != null) {
+            return;
+        }
+
+        synchronized (cleanerLock) {
+            if (cleaner == null) {
+                Thread t = new Thread(new Cleaner(),
+                    "wolfCrypt NativeStruct cleaner");
+                t.setDaemon(true);
+                /* don't pin the class loader of the creating thread */
+                t.setContextClassLoader(null);
+                t.start();
+                cleaner = t;
+            }
+        }
+    }
+
+    /**
+     * Frees resources held inside a native structure, without freeing the
+     * structure memory itself.
+     *
+     * Used to clean up objects that were not released explicitly. It runs
+     * after the owning object has been collected, so implementations may
+     * only use the pointer passed in.
+     */
+    protected interface NativeFree {
+        /**
+         * Free resources held by native structure
+         *
+         * @param pointer pointer to native structure
+         */
+        void free(long pointer);
+    }
+
+    /* Bounded stack of zeroized native structures of one class */
+    private static final class Pool {
+
+        private long[] pointers = new long[0];
+        private int count = 0;
+        private long hits = 0;
+        private long misses = 0;
+
+        synchronized long take() {
+            if (count == 0) {
+                misses++;
+                return NULL;
+            }
+
+            hits++;
+            long ptr = pointers[--count];
+            pointers[count] = NULL;
+
+            return ptr;
+        }
+
+        /* returns false if pool is full and pointer was not kept */
+        synchronized boolean put(long ptr) {
+            int max = poolSize;
+
+            if (count >= max) {
+                return false;
+            }
+
+            if (pointers.length < max) {
+                long[] tmp = new long[max];
+                System.arraycopy(pointers, 0, tmp, 0, count);
+                pointers = tmp;
+            }
+
+            xzero(ptr);
+            pointers[count++] = ptr;
+
+            return true;
+        }
+
+        synchronized void trim(int max) {
+            while (count > max) {
+                xfree(pointers[--count]);
+                pointers[count] = NULL;
+            }
+        }
+
+        synchronized int count() {
+            return count;
+        }
+
+        synchronized long hits() {
+            return hits;
+        }
+
+        synchronized long misses() {
+            return misses;
+        }
+    }
+
+    /* Tracks the native pointer of one NativeStruct without keeping the
+     * object itself reachable.
+     *
+     * Static natives are passed the raw pointer, so the owning object may
+     * become phantom reachable while a native call made under its
+     * pointerLock is still running. clean() takes the same pointerLock,
+     * which makes the cleaner wait for that call to return before freeing
+     * or recycling the structure. */
+    private static final class Cleanup
+        extends PhantomReference<NativeStruct> {
+
+        private final Pool pool;
+        private final Object lock;
+        private long pointer = NULL;
+        private NativeFree nativeFree = null;
+
+        Cleanup(NativeStruct referent, Pool pool) {
+            super(referent, cleanupQueue);
+            this.pool = pool;
+            this.lock = referent.pointerLock;
+        }
+
+        synchronized void setPointer(long pointer) {
+            this.pointer = pointer;
+            this.nativeFree = null;
+        }
+
+        synchronized void setNativeFree(NativeFree nativeFree) {
+            this.nativeFree = nativeFree;
+        }
+
+        void clean() {
+            synchronized (lock) {
+                synchronized (this) {
+                    if (pointer != NULL) {
+                        if (nativeFree != null) {
+                            nativeFree.free(pointer);
+                        }
+                        recycle(pool, pointer);
+                    }
+                    pointer = NULL;
+                    nativeFree = null;
+                }
+            }
+        }
+    }
+
+    private final Cleanup cleanup;
+
+    /* pool of released structures of this object's class */
+    private final Pool pool;
+
     /**
      * Create new NativeStruct object
      */
     protected NativeStruct() {
-        setNativeStruct(mallocNativeStruct());
+        pool = getPool(getClass());
+        cleanup = new Cleanup(this, pool);
+
+        long ptr = pool.take();
+        if (ptr == NULL) {
+            ptr = mallocNativeStruct();
+        }
+
+        setNativeStruct(ptr);
     }
 
     /* points to the internal native structure */
@@ -55,11 +310,48 @@ public abstract class NativeStruct extends WolfObject {
         return this.pointer;
     }
 
+    /**
+     * Get pointer to the native structure wrapped by another object, for
+     * passing to static native methods that take the pointer directly.
+     *
+     * @param struct NativeStruct object, may be null
+     *
+     * @return pointer to native structure, or NULL if struct is null
+     */
+    protected static long getNativeStructOf(NativeStruct struct) {
+        if (struct == null) {
+            return NULL;
+        }
+
+        return struct.getNativeStruct();
+    }
+
+    /**
+     * Get lock guarding the native structure of another object passed to
+     * a native method of this one.
+     *
+     * Holding it for the length of the native call keeps the NativeStruct
+     * cleaner from freeing that structure while native code is still
+     * using it, even if the other object is otherwise unreachable.
+     *
+     * @param struct NativeStruct object, may be null
+     *
+     * @return pointerLock of struct, or of this object if struct is null
+     */
+    protected Object pointerLockOf(NativeStruct struct) {
+        if (struct == null) {
+            return pointerLock;
+        }
+
+        return struct.pointerLock;
+    }
+
     /**
      * Set pointer to native structure
      *
-     * If NativeStruct already holds pointer, old pointer will be free()'d
-     * before resetting to new pointer.
+     * If NativeStruct already holds pointer, old pointer will be zeroized
+     * and returned to the pool for this class, or free()'d if the pool is
+     * full, before resetting to new pointer.
      *
      * @param nativeStruct pointer to initialized native structure
      */
@@ -67,13 +359,37 @@ public abstract class NativeStruct extends WolfObject {
 
         synchronized (pointerLock) {
             if (this.pointer != NULL) {
-                xfree(this.pointer);
+                recycle(pool, this.pointer);
             }
 
             this.pointer = nativeStruct;
+
+            /* only track objects that own native memory */
+            cleanup.setPointer(nativeStruct);
+            if (nativeStruct != NULL) {
+                cleanups.add(cleanup);
+                startCleaner();
+            } else {
+                cleanups.remove(cleanup);
+            }
         }
     }
 
+    /**
+     * Set function used to free resources inside the native structure if
+     * this object is garbage collected without being released.
+     *
+     * Subclasses whose native structure needs its own free function call
+     * this once the structure has been initialized, and again with null
+     * after freeing it explicitly. Reset to null whenever the native
+     * pointer changes.
+     *
+     * @param nativeFree free function, or null if none is needed
+     */
+    protected void setNativeFree(NativeFree nativeFree) {
+        cleanup.setNativeFree(nativeFree);
+    }
+
     /**
      * Releases the host data stored in a NativeStruct.
      *
@@ -86,6 +402,16 @@ public abstract class NativeStruct extends WolfObject {
         setNativeStruct(NULL);
     }
 
+    /**
+     * Releases native resources, same as releaseNativeStruct().
+     *
+     * Allows NativeStruct objects to be used in try-with-resources.
+     */
+    @Override
+    public void close() {
+        releaseNativeStruct();
+    }
+
     /**
      * Malloc native structure pointer
      *
@@ -95,14 +421,116 @@ public abstract class NativeStruct extends WolfObject {
      */
     protected abstract long mallocNativeStruct() throws OutOfMemoryError;
 
-    private native void xfree(long pointer);
+    /**
+     * Set the maximum number of released native structures kept per
+     * NativeStruct class. Pools larger than the new size are trimmed.
+     *
+     * @param size maximum pooled structures per class, 0 disables pooling
+     *
+     * @throws IllegalArgumentException if size is negative
+     */
+    public static void setPoolSize(int size) {
+        if (size < 0) {
+            throw new IllegalArgumentException(
+                "Pool size must not be negative");
+        }
 
-    @SuppressWarnings("deprecation")
-    @Override
-    protected void finalize() throws Throwable {
-        releaseNativeStruct();
+        poolSize = size;
 
-        super.finalize();
+        for (Pool p : pools.values()) {
+            p.trim(size);
+        }
     }
+
+    /**
+     * Get the maximum number of released native structures kept per
+     * NativeStruct class.
+     *
+     * @return maximum pooled structures per class
+     */
+    public static int getPoolSize() {
+        return poolSize;
+    }
+
+    /**
+     * Get number of objects of the given class created with a pooled
+     * native structure.
+     *
+     * @param type NativeStruct class
+     *
+     * @return number of pool hits
+     */
+    public static long getPoolHits(Class<? extends NativeStruct> type) {
+        Pool p = pools.get(type);
+        return (p == null) ? 0 : p.hits();
+    }
+
+    /**
+     * Get number of objects of the given class that had to malloc a new
+     * native structure.
+     *
+     * @param type NativeStruct class
+     *
+     * @return number of pool misses
+     */
+    public static long getPoolMisses(Class<? extends NativeStruct> type) {
+        Pool p = pools.get(type);
+        return (p == null) ? 0 : p.misses();
+    }
+
+    /**
+     * Get number of native structures currently pooled for the given class.
+     *
+     * @param type NativeStruct class
+     *
+     * @return number of pooled native structures
+     */
+    public static int getPoolCount(Class<? extends NativeStruct> type) {
+        Pool p = pools.get(type);
+        return (p == null) ? 0 : p.count();
+    }
+
+    private static Pool getPool(Class<?> type) {
+        Pool p = pools.get(type);
+
+        if (p == null) {
+            Pool created = new Pool();
+            p = pools.putIfAbsent(type, created);
+            if (p == null) {
+                p = created;
+            }
+        }
+
+        return p;
+    }
+
+    /* Return released structure to pool, or free it if pool is full */
+    private static void recycle(Pool p, long ptr) {
+        if (!p.put(ptr)) {
+            xfree(ptr);
+        }
+    }
+
+    private static int readPoolSize() {
+        try {
+            String prop = System.getProperty("wolfcrypt.jni.pool.size");
+            if (prop != null) {
+                int size = Integer.parseInt(prop.trim());
+                if (size >= 0) {
+                    return size;
+                }
+            }
+        } catch (NumberFormatException e) {
+            /* fall through to default */
+        } catch (SecurityException e) {
+            /* fall through to default */
+        }
+
+        return DEFAULT_POOL_SIZE;
+    }
+
+    private static native void xfree(long pointer);
+
+    private static native void xzero(long pointer);
 }
 
@@ -22,6 +22,7 @@
 package com.wolfssl.wolfcrypt;
 
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 
 /**
  * Wrapper for the native WolfCrypt RNG implementation
@@ -39,15 +40,42 @@ public class Rng extends NativeStruct {
 
     private WolfCryptState state = WolfCryptState.UNINITIALIZED;
 
+    private static final Metrics.Operation generateMetrics =
+        Metrics.operation(Rng.class, "generateBlock");
+
     /* native wrappers called by public functions below */
     private native void initRng();
     private native void freeRng();
+    private static native void native_free_ptr(long ptr);
+
+    /* frees native WC_RNG contents if this object is collected without
+     * being released */
+    private static final NativeFree NATIVE_FREE = new NativeFree() {
+        public void free(long ptr) {
+            native_free_ptr(ptr);
+        }
+    };
     private native void rngGenerateBlock(ByteBuffer buffer, int offset,
             int length);
     private native void rngGenerateBlock(byte[] buffer, int offset, int length);
+    private static native void rngGenerateBlock_ptr(long ptr,
+            ByteBuffer buffer, int offset, int length);
+    private static native void rngGenerateBlock_ptr(long ptr, byte[] buffer,
+            int offset, int length);
+    private static native ByteBuffer forkGenerationBuffer();
 
-    /* Lock to prevent concurrent access to native WC_RNG */
-    private final Object rngLock = new Object();
+    /* Native counter incremented in the child process after fork(), read
+     * directly so checking it does not need a JNI call */
+    private static final ByteBuffer forkGeneration =
+        forkGenerationBuffer().order(ByteOrder.nativeOrder());
+
+    /* fork generation at the time native WC_RNG was initialized */
+    private int initForkGeneration = 0;
+
+    /* Lock to prevent concurrent access to native WC_RNG. Same object as
+     * pointerLock, which the NativeStruct cleaner also takes before freeing
+     * the structure of an unreachable Rng. */
+    private final Object rngLock = pointerLock;
 
     /** Default Rng constructor */
     public Rng() { }
@@ -64,12 +92,43 @@ public class Rng extends NativeStruct {
     public synchronized void init() {
         synchronized (rngLock) {
             if (state == WolfCryptState.UNINITIALIZED) {
+                Object event = CryptoEvents.begin(CryptoEvents.RNG_SEED);
                 initRng();
+                CryptoEvents.commit(event, "HashDRBG", 0, null);
+                setNativeFree(NATIVE_FREE);
+                initForkGeneration = getForkGeneration();
                 state = WolfCryptState.INITIALIZED;
             }
         }
     }
 
+    /**
+     * Get current process fork generation.
+     *
+     * Starts at 0 and is incremented in the child process each time the
+     * process forks. Callers holding random data or DRBG state should
+     * discard it when this value changes.
+     *
+     * @return current fork generation
+     */
+    public static int getForkGeneration() {
+        return forkGeneration.getInt(0);
+    }
+
+    /**
+     * Re-initialize the native DRBG if the process has forked since it
+     * was initialized, so parent and child never share DRBG state.
+     */
+    synchronized void checkFork() {
+        synchronized (rngLock) {
+            if (state == WolfCryptState.INITIALIZED &&
+                initForkGeneration != getForkGeneration()) {
+                free();
+                init();
+            }
+        }
+    }
+
     /**
      * Free Rng object
      */
@@ -77,6 +136,7 @@ public class Rng extends NativeStruct {
         synchronized (rngLock) {
             if (state == WolfCryptState.INITIALIZED) {
                 freeRng();
+                setNativeFree(null);
                 state = WolfCryptState.UNINITIALIZED;
             }
         }
@@ -95,16 +155,27 @@ public class Rng extends NativeStruct {
      */
     public synchronized void generateBlock(ByteBuffer buffer) {
         init();
+        checkFork();
 
         if (buffer.isDirect() == false) {
             throw new WolfCryptException("Input ByteBuffer is not direct");
         }
 
-        synchronized (rngLock) {
-            rngGenerateBlock(buffer, buffer.position(), buffer.remaining());
+        int length = buffer.remaining();
+        long start = generateMetrics.start();
+
+        try {
+            synchronized (rngLock) {
+                rngGenerateBlock_ptr(getNativeStruct(), buffer,
+                    buffer.position(), length);
+            }
+        } catch (WolfCryptException e) {
+            generateMetrics.error(start);
+            throw e;
         }
+        generateMetrics.end(start, length);
 
-        buffer.position(buffer.position() + buffer.remaining());
+        buffer.position(buffer.position() + length);
     }
 
     /**
@@ -118,10 +189,19 @@ public class Rng extends NativeStruct {
      */
     public synchronized void generateBlock(byte[] buffer, int offset, int length) {
         init();
+        checkFork();
 
-        synchronized (rngLock) {
-            rngGenerateBlock(buffer, offset, length);
+        long start = generateMetrics.start();
+
+        try {
+            synchronized (rngLock) {
+                rngGenerateBlock_ptr(getNativeStruct(), buffer, offset, length);
+            }
+        } catch (WolfCryptException e) {
+            generateMetrics.error(start);
+            throw e;
         }
+        generateMetrics.end(start, length);
     }
 
     /**
@@ -0,0 +1,95 @@
+/* RngPool.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+/**
+ * Shared pool of initialized Rng objects.
+ *
+ * Instantiating a native DRBG seeds it from the OS entropy source, which is
+ * expensive compared to the sign, encrypt or key agreement operation it is
+ * usually needed for. RngPool keeps one initialized Rng per thread and
+ * lends it out with acquire() and release().
+ *
+ * An acquired Rng is owned exclusively by the caller until it is released,
+ * so it may be passed to native operations (ex: Rsa.setRng()) that use the
+ * WC_RNG without taking the Rng lock. Nested acquire() calls on the same
+ * thread get a new Rng. Rng objects cached by a thread that exits are freed
+ * when that thread is garbage collected.
+ */
+public final class RngPool {
+
+    /* Rng available to the current thread, null while lent out */
+    private static final ThreadLocal<Rng> local = new ThreadLocal<Rng>();
+
+    private RngPool() { }
+
+    /**
+     * Get an initialized Rng for exclusive use by the caller.
+     *
+     * Callers should return the Rng with release() once done, typically
+     * from a finally block.
+     *
+     * @return initialized Rng object
+     *
+     * @throws WolfCryptException if native Rng initialization fails
+     */
+    public static Rng acquire() throws WolfCryptException {
+
+        Rng rng = local.get();
+
+        if (rng != null) {
+            local.set(null);
+
+            /* drop DRBG state copied from parent process */
+            rng.checkFork();
+
+            return rng;
+        }
+
+        rng = new Rng();
+        rng.init();
+
+        return rng;
+    }
+
+    /**
+     * Return Rng obtained from acquire() to the pool.
+     *
+     * The Rng is kept for reuse by the current thread, or released if this
+     * thread already has one cached. The caller must not use the Rng after
+     * calling this method.
+     *
+     * @param rng Rng object to return, ignored if null
+     */
+    public static void release(Rng rng) {
+
+        if (rng == null) {
+            return;
+        }
+
+        if (local.get() == null) {
+            local.set(rng);
+        } else {
+            rng.releaseNativeStruct();
+        }
+    }
+}
@@ -35,6 +35,15 @@ public class Rsa extends NativeStruct {
     /* Lock around object state */
     protected final Object stateLock = new Object();
 
+    private static final Metrics.Operation encryptMetrics =
+        Metrics.operation(Rsa.class, "encrypt");
+    private static final Metrics.Operation decryptMetrics =
+        Metrics.operation(Rsa.class, "decrypt");
+    private static final Metrics.Operation signMetrics =
+        Metrics.operation(Rsa.class, "sign");
+    private static final Metrics.Operation verifyMetrics =
+        Metrics.operation(Rsa.class, "verify");
+
     /**
      * Malloc native JNI Rsa structure
      *
@@ -74,6 +83,15 @@ public class Rsa extends NativeStruct {
             throws WolfCryptException;
     private native void wc_FreeRsaKey()
             throws WolfCryptException;
+    private static native void native_free_ptr(long ptr);
+
+    /* frees native RsaKey contents if this object is collected without
+     * being released */
+    private static final NativeFree NATIVE_FREE = new NativeFree() {
+        public void free(long ptr) {
+            native_free_ptr(ptr);
+        }
+    };
     private native boolean wc_RsaSetRNG(Rng rng)
             throws WolfCryptException;
     private native void wc_RsaPrivateKeyDecode(byte[] key)
@@ -92,6 +110,14 @@ public class Rsa extends NativeStruct {
             throws WolfCryptException;
     private native byte[] wc_RsaSSL_Verify(byte[] data)
             throws WolfCryptException;
+    private static native byte[] wc_RsaPublicEncrypt_ptr(long ptr, long rngPtr,
+            byte[] data) throws WolfCryptException;
+    private static native byte[] wc_RsaPrivateDecrypt_ptr(long ptr, byte[] data)
+            throws WolfCryptException;
+    private static native byte[] wc_RsaSSL_Sign_ptr(long ptr, long rngPtr,
+            byte[] data) throws WolfCryptException;
+    private static native byte[] wc_RsaSSL_Verify_ptr(long ptr, byte[] data)
+            throws WolfCryptException;
 
     /**
      * Create new Rsa object
@@ -168,6 +194,7 @@ public class Rsa extends NativeStruct {
                 synchronized (pointerLock) {
                     wc_InitRsaKey();
                 }
+                setNativeFree(NATIVE_FREE);
                 state = WolfCryptState.INITIALIZED;
             }
         }
@@ -227,6 +254,7 @@ public class Rsa extends NativeStruct {
                 synchronized (pointerLock) {
                     wc_FreeRsaKey();
                 }
+                setNativeFree(null);
                 state = WolfCryptState.UNINITIALIZED;
             }
         }
@@ -248,9 +276,12 @@ public class Rsa extends NativeStruct {
         willSetKey();
 
         synchronized (stateLock) {
+            Object event = CryptoEvents.begin(CryptoEvents.KEY_GENERATION);
+
             synchronized (pointerLock) {
                 MakeRsaKey(size, e, rng);
             }
+            CryptoEvents.commit(event, "RSA", size, null);
 
             state = WolfCryptState.READY;
             hasPrivateKey = true;
@@ -526,9 +557,25 @@ public class Rsa extends NativeStruct {
 
         willUseKey(false);
 
-        synchronized (pointerLock) {
-            return wc_RsaPublicEncrypt(plain, rng);
+        byte[] result;
+        long start = encryptMetrics.start();
+
+        try {
+            synchronized (pointerLock) {
+                /* also hold the Rng lock, keeps the cleaner from freeing
+                 * the Rng structure during the native call */
+                synchronized (pointerLockOf(rng)) {
+                    result = wc_RsaPublicEncrypt_ptr(getNativeStruct(),
+                        getNativeStructOf(rng), plain);
+                }
+            }
+        } catch (WolfCryptException e) {
+            encryptMetrics.error(start);
+            throw e;
         }
+        encryptMetrics.end(start, plain.length);
+
+        return result;
     }
 
     /**
@@ -545,9 +592,23 @@ public class Rsa extends NativeStruct {
 
         willUseKey(true);
 
-        synchronized (pointerLock) {
-            return wc_RsaPrivateDecrypt(ciphertext);
+        byte[] result;
+        long start = decryptMetrics.start();
+        Object event = CryptoEvents.begin(CryptoEvents.RSA_DECRYPT);
+
+        try {
+            synchronized (pointerLock) {
+                result = wc_RsaPrivateDecrypt_ptr(getNativeStruct(),
+                    ciphertext);
+            }
+        } catch (WolfCryptException e) {
+            decryptMetrics.error(start);
+            throw e;
         }
+        decryptMetrics.end(start, ciphertext.length);
+        commitEvent(event);
+
+        return result;
     }
 
     /**
@@ -566,9 +627,27 @@ public class Rsa extends NativeStruct {
 
         willUseKey(true);
 
-        synchronized (pointerLock) {
-            return wc_RsaSSL_Sign(data, rng);
+        byte[] result;
+        long start = signMetrics.start();
+        Object event = CryptoEvents.begin(CryptoEvents.RSA_SIGN);
+
+        try {
+            synchronized (pointerLock) {
+                /* also hold the Rng lock, keeps the cleaner from freeing
+                 * the Rng structure during the native call */
+                synchronized (pointerLockOf(rng)) {
+                    result = wc_RsaSSL_Sign_ptr(getNativeStruct(),
+                        getNativeStructOf(rng), data);
+                }
+            }
+        } catch (WolfCryptException e) {
+            signMetrics.error(start);
+            throw e;
         }
+        signMetrics.end(start, data.length);
+        commitEvent(event);
+
+        return result;
     }
 
     /**
@@ -585,9 +664,27 @@ public class Rsa extends NativeStruct {
 
         willUseKey(false);
 
-        synchronized (pointerLock) {
-            return wc_RsaSSL_Verify(signature);
+        byte[] result;
+        long start = verifyMetrics.start();
+
+        try {
+            synchronized (pointerLock) {
+                result = wc_RsaSSL_Verify_ptr(getNativeStruct(), signature);
+            }
+        } catch (WolfCryptException e) {
+            verifyMetrics.error(start);
+            throw e;
         }
+        verifyMetrics.end(start, signature.length);
+
+        return result;
     }
-}
 
+    /* record event returned by CryptoEvents.begin(), if any */
+    private void commitEvent(Object event) {
+
+        if (event != null) {
+            CryptoEvents.commit(event, "RSA", getEncryptSize() * 8, null);
+        }
+    }
+}
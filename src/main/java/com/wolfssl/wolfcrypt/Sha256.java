@@ -21,7 +21,11 @@
 
 package com.wolfssl.wolfcrypt;
 
+import java.io.IOException;
 import java.nio.ByteBuffer;
+import java.nio.file.Path;
+
+import javax.crypto.ShortBufferException;
 
 /**
  * Wrapper for the native WolfCrypt SHA2-256 implementation
@@ -46,6 +50,17 @@ public class Sha256 extends MessageDigest {
     private native void native_final_internal(ByteBuffer hash, int offset);
     private native void native_final_internal(byte[] hash);
 
+    /* static variants of the above, passed the native pointer directly
+     * instead of looking it up from this object on each call */
+    private static native void native_init_ptr(long ptr);
+    private static native void native_update_ptr(long ptr, ByteBuffer data,
+        int offset, int len);
+    private static native void native_update_ptr(long ptr, byte[] data,
+        int offset, int len);
+    private static native void native_final_ptr(long ptr, ByteBuffer hash,
+        int offset);
+    private static native void native_final_ptr(long ptr, byte[] hash);
+
     /**
      * Malloc native JNI Sha256 structure
      *
@@ -70,7 +85,7 @@ public class Sha256 extends MessageDigest {
         throws WolfCryptException {
 
         synchronized (pointerLock) {
-            native_init_internal();
+            native_init_ptr(getNativeStruct());
         }
     }
 
@@ -103,7 +118,7 @@ public class Sha256 extends MessageDigest {
         throws WolfCryptException {
 
         synchronized (pointerLock) {
-            native_update_internal(data, offset, len);
+            native_update_ptr(getNativeStruct(), data, offset, len);
         }
     }
 
@@ -120,7 +135,7 @@ public class Sha256 extends MessageDigest {
         throws WolfCryptException {
 
         synchronized (pointerLock) {
-            native_update_internal(data, offset, len);
+            native_update_ptr(getNativeStruct(), data, offset, len);
         }
     }
 
@@ -136,7 +151,7 @@ public class Sha256 extends MessageDigest {
         throws WolfCryptException {
 
         synchronized (pointerLock) {
-            native_final_internal(hash, offset);
+            native_final_ptr(getNativeStruct(), hash, offset);
         }
     }
 
@@ -151,10 +166,131 @@ public class Sha256 extends MessageDigest {
         throws WolfCryptException {
 
         synchronized (pointerLock) {
-            native_final_internal(hash);
+            native_final_ptr(getNativeStruct(), hash);
         }
     }
 
+    /**
+     * Compute SHA2-256 digest of data in a single native call.
+     *
+     * No native Sha256 structure is allocated, hash state is kept on the
+     * native stack for the duration of the call. Safe for concurrent use
+     * from multiple threads.
+     *
+     * @param data input data
+     * @param offset offset into input data
+     * @param len length of input data
+     * @param hash output buffer, DIGEST_SIZE bytes are written
+     * @param hashOffset offset into output buffer
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     * @throws IllegalArgumentException if offsets or length are invalid
+     */
+    public static void hash(byte[] data, int offset, int len, byte[] hash,
+        int hashOffset) throws WolfCryptException, ShortBufferException {
+
+        hashByType(TYPE, data, offset, len, hash, hashOffset);
+    }
+
+    /**
+     * Compute SHA2-256 digest of data in a single native call.
+     *
+     * @param data input data
+     *
+     * @return SHA2-256 digest of data
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public static byte[] hash(byte[] data) throws WolfCryptException {
+        return hashByType(TYPE, data);
+    }
+
+    /**
+     * Compute SHA2-256 digest of all remaining bytes of data in a single native
+     * call, writing DIGEST_SIZE bytes to hash. Positions of both buffers
+     * are advanced. Direct buffers are passed to native code in place.
+     *
+     * @param data input data, data.remaining() bytes are hashed
+     * @param hash output buffer
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     */
+    public static void hash(ByteBuffer data, ByteBuffer hash)
+        throws WolfCryptException, ShortBufferException {
+
+        hashByType(TYPE, data, hash);
+    }
+
+    /**
+     * Compute SHA2-256 digests of many independent messages in a single
+     * native call.
+     *
+     * Message i is data[offsets[i]] to data[offsets[i] + lengths[i] - 1].
+     * Its digest is written to hash at hashOffset + (i * DIGEST_SIZE).
+     * Intended for large numbers of small inputs, where per-call JNI
+     * overhead would otherwise dominate.
+     *
+     * @param data input buffer holding all messages
+     * @param offsets offset of each message in data
+     * @param lengths length of each message
+     * @param hash output buffer, offsets.length * DIGEST_SIZE bytes are
+     *        written
+     * @param hashOffset offset into output buffer of the first digest
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     * @throws IllegalArgumentException if offsets or lengths are invalid
+     */
+    public static void hashBatch(byte[] data, int[] offsets, int[] lengths,
+        byte[] hash, int hashOffset)
+        throws WolfCryptException, ShortBufferException {
+
+        hashBatchByType(TYPE, data, offsets, lengths, hash, hashOffset);
+    }
+
+    /**
+     * Compute SHA2-256 digests of the remaining bytes of each buffer in data,
+     * writing them back to back into hash. Positions of all buffers are
+     * advanced.
+     *
+     * When data and hash are all direct buffers, the batch is processed
+     * in a single native call with no copies. Otherwise each buffer is
+     * hashed with {@link #hash(ByteBuffer, ByteBuffer)}.
+     *
+     * @param data input buffers, one message per buffer
+     * @param hash output buffer, data.length * DIGEST_SIZE bytes are
+     *        written
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     */
+    public static void hashBatch(ByteBuffer[] data, ByteBuffer hash)
+        throws WolfCryptException, ShortBufferException {
+
+        hashBatchByType(TYPE, data, hash);
+    }
+
+    /**
+     * Compute SHA2-256 digest of a file.
+     *
+     * The file is memory mapped read-only and hashed in place by native
+     * wolfCrypt, no file data is copied through the Java heap.
+     *
+     * @param path file to hash
+     *
+     * @return SHA2-256 digest of file contents
+     *
+     * @throws IOException if opening or mapping the file fails
+     * @throws WolfCryptException if native operation fails
+     */
+    public static byte[] hashFile(Path path)
+        throws IOException, WolfCryptException {
+
+        return hashFileWith(new Sha256(), path);
+    }
+
     /**
      * Create new SHA2-256 object
      */
@@ -0,0 +1,453 @@
+/* Sha3.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.file.Path;
+
+import javax.crypto.ShortBufferException;
+
+/**
+ * Wrapper for the native WolfCrypt SHA-3 implementation.
+ *
+ * One class serves all four SHA-3 variants, selected by digest size in
+ * bits at construction. {@link Sha3_224}, {@link Sha3_256},
+ * {@link Sha3_384} and {@link Sha3_512} fix the variant for callers that
+ * prefer a class per algorithm, matching the SHA-2 wrappers.
+ */
+public class Sha3 extends MessageDigest {
+
+    /** SHA3-224 variant */
+    public static final int SHA3_224 = 224;
+    /** SHA3-256 variant */
+    public static final int SHA3_256 = 256;
+    /** SHA3-384 variant */
+    public static final int SHA3_384 = 384;
+    /** SHA3-512 variant */
+    public static final int SHA3_512 = 512;
+
+    /* SHA-3 variant of this object, one of SHA3_224 to SHA3_512 */
+    private final int type;
+
+    /* native JNI methods, passed the native pointer and variant directly.
+     * We wrap calls to these below in order to synchronize access to
+     * native pointer between threads */
+    private native long mallocNativeStruct_internal() throws OutOfMemoryError;
+    private static native void native_init_ptr(long ptr, int type);
+    private static native void native_copy_ptr(long ptr, long fromPtr,
+        int type);
+    private static native void native_update_ptr(long ptr, int type,
+        ByteBuffer data, int offset, int len);
+    private static native void native_update_ptr(long ptr, int type,
+        byte[] data, int offset, int len);
+    private static native void native_final_ptr(long ptr, int type,
+        ByteBuffer hash, int offset);
+    private static native void native_final_ptr(long ptr, int type,
+        byte[] hash);
+
+    /* one-shot hash, init/update/final over a native stack structure */
+    private static native void native_hash(int type, ByteBuffer data,
+        int offset, int len, ByteBuffer hash, int hashOffset);
+    private static native void native_hash(int type, byte[] data, int offset,
+        int len, byte[] hash, int hashOffset);
+
+    /* one-shot hash Operations, recorded under the class of each variant
+     * so that variants are counted separately */
+    private static final Metrics.Operation hash224Metrics =
+        Metrics.operation(Sha3_224.class, "hash");
+    private static final Metrics.Operation hash256Metrics =
+        Metrics.operation(Sha3_256.class, "hash");
+    private static final Metrics.Operation hash384Metrics =
+        Metrics.operation(Sha3_384.class, "hash");
+    private static final Metrics.Operation hash512Metrics =
+        Metrics.operation(Sha3_512.class, "hash");
+
+    /* class of a SHA-3 variant, or Sha3 if type is not a variant */
+    private static Class<?> variantClass(int type) {
+
+        switch (type) {
+            case SHA3_224:
+                return Sha3_224.class;
+            case SHA3_256:
+                return Sha3_256.class;
+            case SHA3_384:
+                return Sha3_384.class;
+            case SHA3_512:
+                return Sha3_512.class;
+            default:
+                return Sha3.class;
+        }
+    }
+
+    private static Metrics.Operation hashMetricsOf(int type) {
+
+        switch (type) {
+            case SHA3_224:
+                return hash224Metrics;
+            case SHA3_256:
+                return hash256Metrics;
+            case SHA3_384:
+                return hash384Metrics;
+            default:
+                return hash512Metrics;
+        }
+    }
+
+    /**
+     * Check that type is a valid SHA-3 variant.
+     *
+     * @param type SHA-3 variant
+     *
+     * @return digest size of variant in bytes
+     *
+     * @throws IllegalArgumentException if type is not a SHA-3 variant
+     */
+    private static int checkType(int type) {
+
+        switch (type) {
+            case SHA3_224:
+            case SHA3_256:
+            case SHA3_384:
+            case SHA3_512:
+                return type / 8;
+            default:
+                throw new IllegalArgumentException(
+                    "Invalid SHA-3 type: " + type);
+        }
+    }
+
+    /**
+     * Get class of the SHA-3 variant of this object, metrics of all Sha3
+     * objects are recorded under the class of their variant.
+     *
+     * @return variant class
+     */
+    @Override
+    protected Class<?> metricsClass() {
+        return variantClass(type);
+    }
+
+    /**
+     * Malloc native JNI Sha3 structure
+     *
+     * @return native allocated pointer
+     *
+     * @throws OutOfMemoryError when malloc fails with memory error
+     */
+    protected long mallocNativeStruct()
+        throws OutOfMemoryError {
+
+        synchronized (pointerLock) {
+            return mallocNativeStruct_internal();
+        }
+    }
+
+    /**
+     * Initialize Sha3 object
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    protected void native_init()
+        throws WolfCryptException {
+
+        synchronized (pointerLock) {
+            native_init_ptr(getNativeStruct(), type);
+        }
+    }
+
+    /**
+     * Copy existing native wc_Sha3 struct (Sha3 object) into this one.
+     * Copies structure state using wc_Sha3_*_Copy().
+     *
+     * @param toBeCopied initialized Sha3 object of the same variant
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws IllegalArgumentException if variants differ
+     */
+    protected void native_copy(Sha3 toBeCopied)
+        throws WolfCryptException {
+
+        if (toBeCopied.type != type) {
+            throw new IllegalArgumentException(
+                "Cannot copy SHA-3 state between different variants");
+        }
+
+        synchronized (pointerLock) {
+            synchronized (toBeCopied.pointerLock) {
+                native_copy_ptr(getNativeStruct(),
+                    toBeCopied.getNativeStruct(), type);
+            }
+        }
+    }
+
+    /**
+     * Native SHA-3 update
+     *
+     * @param data input data
+     * @param offset offset into input data
+     * @param len length of input data
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    protected void native_update(ByteBuffer data, int offset, int len)
+        throws WolfCryptException {
+
+        synchronized (pointerLock) {
+            native_update_ptr(getNativeStruct(), type, data, offset, len);
+        }
+    }
+
+    /**
+     * Native SHA-3 update
+     *
+     * @param data input data
+     * @param offset offset into input data
+     * @param len length of input data
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    protected void native_update(byte[] data, int offset, int len)
+        throws WolfCryptException {
+
+        synchronized (pointerLock) {
+            native_update_ptr(getNativeStruct(), type, data, offset, len);
+        }
+    }
+
+    /**
+     * Native SHA-3 final, calculate final digest
+     *
+     * @param hash output buffer to place digest
+     * @param offset offset into output buffer to write digest
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    protected void native_final(ByteBuffer hash, int offset)
+        throws WolfCryptException {
+
+        synchronized (pointerLock) {
+            native_final_ptr(getNativeStruct(), type, hash, offset);
+        }
+    }
+
+    /**
+     * Native SHA-3 final, calculate final digest
+     *
+     * @param hash output buffer to place digest
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    protected void native_final(byte[] hash)
+        throws WolfCryptException {
+
+        synchronized (pointerLock) {
+            native_final_ptr(getNativeStruct(), type, hash);
+        }
+    }
+
+    /**
+     * Compute SHA-3 digest of data in a single native call.
+     *
+     * No native Sha3 structure is allocated, hash state is kept on the
+     * native stack for the duration of the call. Safe for concurrent use
+     * from multiple threads.
+     *
+     * @param type SHA-3 variant, one of SHA3_224 to SHA3_512
+     * @param data input data
+     * @param offset offset into input data
+     * @param len length of input data
+     * @param hash output buffer, type / 8 bytes are written
+     * @param hashOffset offset into output buffer
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     * @throws IllegalArgumentException if type, offsets or length are
+     *         invalid
+     */
+    public static void hash(int type, byte[] data, int offset, int len,
+        byte[] hash, int hashOffset)
+        throws WolfCryptException, ShortBufferException {
+
+        checkHashArgs(data.length, offset, len, hash.length, hashOffset,
+            checkType(type));
+
+        Metrics.Operation hashMetrics = hashMetricsOf(type);
+        long start = hashMetrics.start();
+        try {
+            native_hash(type, data, offset, len, hash, hashOffset);
+        } catch (WolfCryptException e) {
+            hashMetrics.error(start);
+            throw e;
+        }
+        hashMetrics.end(start, len);
+    }
+
+    /**
+     * Compute SHA-3 digest of data in a single native call.
+     *
+     * @param type SHA-3 variant, one of SHA3_224 to SHA3_512
+     * @param data input data
+     *
+     * @return SHA-3 digest of data
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws IllegalArgumentException if type is invalid
+     */
+    public static byte[] hash(int type, byte[] data)
+        throws WolfCryptException {
+
+        byte[] hash = new byte[checkType(type)];
+
+        try {
+            hash(type, data, 0, data.length, hash, 0);
+        } catch (ShortBufferException e) {
+            /* not reached, output is sized for the digest */
+            throw new WolfCryptException(e.getMessage(), e);
+        }
+
+        return hash;
+    }
+
+    /**
+     * Compute SHA-3 digest of all remaining bytes of data in a single
+     * native call, writing type / 8 bytes to hash. Positions of both
+     * buffers are advanced. Direct buffers are passed to native code in
+     * place.
+     *
+     * @param type SHA-3 variant, one of SHA3_224 to SHA3_512
+     * @param data input data, data.remaining() bytes are hashed
+     * @param hash output buffer
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     * @throws IllegalArgumentException if type is invalid
+     */
+    public static void hash(int type, ByteBuffer data, ByteBuffer hash)
+        throws WolfCryptException, ShortBufferException {
+
+        int len = data.remaining();
+        int size = checkType(type);
+
+        if (hash.remaining() < size) {
+            throw new ShortBufferException(
+                "Output buffer is too small for digest size");
+        }
+
+        if (data.isDirect() && hash.isDirect()) {
+            Metrics.Operation hashMetrics = hashMetricsOf(type);
+            long start = hashMetrics.start();
+            try {
+                native_hash(type, data, data.position(), len, hash,
+                    hash.position());
+            } catch (WolfCryptException e) {
+                hashMetrics.error(start);
+                throw e;
+            }
+            hashMetrics.end(start, len);
+
+            hash.position(hash.position() + size);
+        }
+        else {
+            byte[] out = new byte[size];
+
+            if (data.hasArray()) {
+                hash(type, data.array(), data.arrayOffset() + data.position(),
+                    len, out, 0);
+            }
+            else {
+                byte[] in = new byte[len];
+                data.duplicate().get(in);
+                hash(type, in, 0, len, out, 0);
+            }
+
+            hash.put(out);
+        }
+
+        data.position(data.limit());
+    }
+
+    /**
+     * Compute SHA-3 digest of a file.
+     *
+     * The file is memory mapped read-only and hashed in place by native
+     * wolfCrypt, no file data is copied through the Java heap.
+     *
+     * @param type SHA-3 variant, one of SHA3_224 to SHA3_512
+     * @param path file to hash
+     *
+     * @return SHA-3 digest of file contents
+     *
+     * @throws IOException if opening or mapping the file fails
+     * @throws WolfCryptException if native operation fails
+     * @throws IllegalArgumentException if type is invalid
+     */
+    public static byte[] hashFile(int type, Path path)
+        throws IOException, WolfCryptException {
+
+        return hashFileWith(new Sha3(type), path);
+    }
+
+    /**
+     * Create new SHA-3 object
+     *
+     * @param type SHA-3 variant, one of SHA3_224 to SHA3_512
+     *
+     * @throws IllegalArgumentException if type is invalid
+     */
+    public Sha3(int type) {
+        checkType(type);
+        this.type = type;
+        init();
+    }
+
+    /**
+     * Create new SHA-3 object by making a copy of the one given.
+     *
+     * @param sha3 Initialized/created Sha3 object to be copied
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public Sha3(Sha3 sha3) {
+        this.type = sha3.type;
+        init();
+        native_copy(sha3);
+    }
+
+    /**
+     * Get SHA-3 variant of this object
+     *
+     * @return one of SHA3_224, SHA3_256, SHA3_384 or SHA3_512
+     */
+    public int getType() {
+        return type;
+    }
+
+    /**
+     * Get SHA-3 digest size
+     *
+     * @return SHA-3 digest size in bytes
+     */
+    public int digestSize() {
+        return type / 8;
+    }
+}
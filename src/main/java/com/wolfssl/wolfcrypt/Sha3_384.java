@@ -0,0 +1,132 @@
+/* Sha3_384.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.file.Path;
+
+import javax.crypto.ShortBufferException;
+
+/**
+ * Wrapper for the native WolfCrypt SHA3-384 implementation
+ */
+public class Sha3_384 extends Sha3 {
+
+    /** SHA3-384 hash type */
+    public static final int TYPE = SHA3_384;
+    /** SHA3-384 digest size */
+    public static final int DIGEST_SIZE = 48;
+
+    /**
+     * Compute SHA3-384 digest of data in a single native call.
+     *
+     * @param data input data
+     * @param offset offset into input data
+     * @param len length of input data
+     * @param hash output buffer, DIGEST_SIZE bytes are written
+     * @param hashOffset offset into output buffer
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     * @throws IllegalArgumentException if offsets or length are invalid
+     */
+    public static void hash(byte[] data, int offset, int len, byte[] hash,
+        int hashOffset) throws WolfCryptException, ShortBufferException {
+
+        hash(TYPE, data, offset, len, hash, hashOffset);
+    }
+
+    /**
+     * Compute SHA3-384 digest of data in a single native call.
+     *
+     * @param data input data
+     *
+     * @return SHA3-384 digest of data
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public static byte[] hash(byte[] data) throws WolfCryptException {
+        return hash(TYPE, data);
+    }
+
+    /**
+     * Compute SHA3-384 digest of all remaining bytes of data in a single
+     * native call, writing DIGEST_SIZE bytes to hash. Positions of both
+     * buffers are advanced.
+     *
+     * @param data input data, data.remaining() bytes are hashed
+     * @param hash output buffer
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     */
+    public static void hash(ByteBuffer data, ByteBuffer hash)
+        throws WolfCryptException, ShortBufferException {
+
+        hash(TYPE, data, hash);
+    }
+
+    /**
+     * Compute SHA3-384 digest of a file.
+     *
+     * @param path file to hash
+     *
+     * @return SHA3-384 digest of file contents
+     *
+     * @throws IOException if opening or mapping the file fails
+     * @throws WolfCryptException if native operation fails
+     */
+    public static byte[] hashFile(Path path)
+        throws IOException, WolfCryptException {
+
+        return hashFile(TYPE, path);
+    }
+
+    /**
+     * Create new SHA3-384 object
+     */
+    public Sha3_384() {
+        super(TYPE);
+    }
+
+    /**
+     * Create new SHA3-384 object by making a copy of the one given.
+     *
+     * @param sha3 Initialized/created Sha3_384 object to be copied
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public Sha3_384(Sha3_384 sha3) {
+        super(sha3);
+    }
+
+    /**
+     * Create new SHA3-384 object
+     *
+     * @param data input data to hash
+     */
+    public Sha3_384(byte[] data) {
+        super(TYPE);
+        update(data);
+    }
+}
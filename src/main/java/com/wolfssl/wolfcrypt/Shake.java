@@ -0,0 +1,402 @@
+/* Shake.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+import java.nio.ByteBuffer;
+
+import javax.crypto.ShortBufferException;
+
+/**
+ * Wrapper for the native WolfCrypt SHAKE128 and SHAKE256 extendable
+ * output functions.
+ *
+ * The output length is chosen at construction and returned by
+ * digestSize(), so the inherited update()/digest() methods behave like
+ * any other MessageDigest. {@link #digest(int)} produces output of any
+ * other length from the same state.
+ */
+public class Shake extends MessageDigest {
+
+    /** SHAKE128 variant */
+    public static final int SHAKE128 = 128;
+    /** SHAKE256 variant */
+    public static final int SHAKE256 = 256;
+
+    /* SHAKE variant of this object, SHAKE128 or SHAKE256 */
+    private final int type;
+
+    /* output length in bytes returned by digest() */
+    private final int outLen;
+
+    /* native JNI methods, passed the native pointer and variant directly.
+     * We wrap calls to these below in order to synchronize access to
+     * native pointer between threads */
+    private native long mallocNativeStruct_internal() throws OutOfMemoryError;
+    private static native void native_init_ptr(long ptr, int type);
+    private static native void native_copy_ptr(long ptr, long fromPtr,
+        int type);
+    private static native void native_update_ptr(long ptr, int type,
+        ByteBuffer data, int offset, int len);
+    private static native void native_update_ptr(long ptr, int type,
+        byte[] data, int offset, int len);
+    private static native void native_final_ptr(long ptr, int type,
+        ByteBuffer out, int offset, int outLen);
+    private static native void native_final_ptr(long ptr, int type,
+        byte[] out, int offset, int outLen);
+
+    /* one-shot hash, init/update/final over a native stack structure */
+    private static native void native_hash(int type, byte[] data, int offset,
+        int len, byte[] out, int outOffset, int outLen);
+
+    /* one-shot hash Operations, recorded under the class of each variant
+     * so that variants are counted separately */
+    private static final Metrics.Operation hash128Metrics =
+        Metrics.operation(Shake128.class, "hash");
+    private static final Metrics.Operation hash256Metrics =
+        Metrics.operation(Shake256.class, "hash");
+
+    /**
+     * Get default output length of a SHAKE variant, twice its security
+     * strength: 32 bytes for SHAKE128 and 64 bytes for SHAKE256.
+     *
+     * @param type SHAKE variant
+     *
+     * @return default output length in bytes
+     *
+     * @throws IllegalArgumentException if type is not a SHAKE variant
+     */
+    public static int defaultOutputLength(int type) {
+
+        switch (type) {
+            case SHAKE128:
+            case SHAKE256:
+                return type / 4;
+            default:
+                throw new IllegalArgumentException(
+                    "Invalid SHAKE type: " + type);
+        }
+    }
+
+    /**
+     * Get class of a SHAKE variant, metrics of all Shake objects are
+     * recorded under the class of their variant.
+     *
+     * @return variant class
+     */
+    @Override
+    protected Class<?> metricsClass() {
+        return (type == SHAKE128) ? Shake128.class : Shake256.class;
+    }
+
+    /**
+     * Malloc native JNI Shake structure
+     *
+     * @return native allocated pointer
+     *
+     * @throws OutOfMemoryError when malloc fails with memory error
+     */
+    protected long mallocNativeStruct()
+        throws OutOfMemoryError {
+
+        synchronized (pointerLock) {
+            return mallocNativeStruct_internal();
+        }
+    }
+
+    /**
+     * Initialize Shake object
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    protected void native_init()
+        throws WolfCryptException {
+
+        synchronized (pointerLock) {
+            native_init_ptr(getNativeStruct(), type);
+        }
+    }
+
+    /**
+     * Copy existing native wc_Shake struct (Shake object) into this one.
+     * Copies structure state using wc_Shake*_Copy().
+     *
+     * @param toBeCopied initialized Shake object of the same variant
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws IllegalArgumentException if variants differ
+     */
+    protected void native_copy(Shake toBeCopied)
+        throws WolfCryptException {
+
+        if (toBeCopied.type != type) {
+            throw new IllegalArgumentException(
+                "Cannot copy SHAKE state between different variants");
+        }
+
+        synchronized (pointerLock) {
+            synchronized (toBeCopied.pointerLock) {
+                native_copy_ptr(getNativeStruct(),
+                    toBeCopied.getNativeStruct(), type);
+            }
+        }
+    }
+
+    /**
+     * Native SHAKE update
+     *
+     * @param data input data
+     * @param offset offset into input data
+     * @param len length of input data
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    protected void native_update(ByteBuffer data, int offset, int len)
+        throws WolfCryptException {
+
+        synchronized (pointerLock) {
+            native_update_ptr(getNativeStruct(), type, data, offset, len);
+        }
+    }
+
+    /**
+     * Native SHAKE update
+     *
+     * @param data input data
+     * @param offset offset into input data
+     * @param len length of input data
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    protected void native_update(byte[] data, int offset, int len)
+        throws WolfCryptException {
+
+        synchronized (pointerLock) {
+            native_update_ptr(getNativeStruct(), type, data, offset, len);
+        }
+    }
+
+    /**
+     * Native SHAKE final, write digestSize() bytes of output
+     *
+     * @param hash output buffer
+     * @param offset offset into output buffer
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    protected void native_final(ByteBuffer hash, int offset)
+        throws WolfCryptException {
+
+        synchronized (pointerLock) {
+            native_final_ptr(getNativeStruct(), type, hash, offset, outLen);
+        }
+    }
+
+    /**
+     * Native SHAKE final, write digestSize() bytes of output
+     *
+     * @param hash output buffer
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    protected void native_final(byte[] hash)
+        throws WolfCryptException {
+
+        synchronized (pointerLock) {
+            native_final_ptr(getNativeStruct(), type, hash, 0, outLen);
+        }
+    }
+
+    /**
+     * Finish the SHAKE computation with an output length other than the
+     * one this object was created with. The object is reset for reuse,
+     * as with digest().
+     *
+     * @param len number of output bytes
+     *
+     * @return len bytes of SHAKE output
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws IllegalArgumentException if len is negative
+     * @throws IllegalStateException object not initialized
+     */
+    public synchronized byte[] digest(int len)
+        throws WolfCryptException, IllegalStateException {
+
+        if (len < 0) {
+            throw new IllegalArgumentException(
+                "SHAKE output length must not be negative");
+        }
+
+        byte[] out = new byte[len];
+
+        synchronized (pointerLock) {
+            if (getNativeStruct() == NULL) {
+                throw new IllegalStateException(
+                    "Object must be initialized before use");
+            }
+            native_final_ptr(getNativeStruct(), type, out, 0, len);
+        }
+
+        return out;
+    }
+
+    /**
+     * Compute SHAKE output of data in a single native call.
+     *
+     * No native Shake structure is allocated, state is kept on the native
+     * stack for the duration of the call. Safe for concurrent use from
+     * multiple threads.
+     *
+     * @param type SHAKE variant, SHAKE128 or SHAKE256
+     * @param data input data
+     * @param offset offset into input data
+     * @param len length of input data
+     * @param out output buffer
+     * @param outOffset offset into output buffer
+     * @param outLen number of output bytes to write
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws ShortBufferException if output buffer is too small
+     * @throws IllegalArgumentException if type, offsets or lengths are
+     *         invalid
+     */
+    public static void hash(int type, byte[] data, int offset, int len,
+        byte[] out, int outOffset, int outLen)
+        throws WolfCryptException, ShortBufferException {
+
+        defaultOutputLength(type);
+
+        if (outLen < 0) {
+            throw new IllegalArgumentException(
+                "SHAKE output length must not be negative");
+        }
+        checkHashArgs(data.length, offset, len, out.length, outOffset,
+            outLen);
+
+        Metrics.Operation hashMetrics =
+            (type == SHAKE128) ? hash128Metrics : hash256Metrics;
+        long start = hashMetrics.start();
+        try {
+            native_hash(type, data, offset, len, out, outOffset, outLen);
+        } catch (WolfCryptException e) {
+            hashMetrics.error(start);
+            throw e;
+        }
+        hashMetrics.end(start, len);
+    }
+
+    /**
+     * Compute SHAKE output of data in a single native call.
+     *
+     * @param type SHAKE variant, SHAKE128 or SHAKE256
+     * @param data input data
+     * @param outLen number of output bytes
+     *
+     * @return outLen bytes of SHAKE output
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws IllegalArgumentException if type or outLen is invalid
+     */
+    public static byte[] hash(int type, byte[] data, int outLen)
+        throws WolfCryptException {
+
+        if (outLen < 0) {
+            throw new IllegalArgumentException(
+                "SHAKE output length must not be negative");
+        }
+
+        byte[] out = new byte[outLen];
+
+        try {
+            hash(type, data, 0, data.length, out, 0, outLen);
+        } catch (ShortBufferException e) {
+            /* not reached, output is sized for outLen */
+            throw new WolfCryptException(e.getMessage(), e);
+        }
+
+        return out;
+    }
+
+    /**
+     * Create new SHAKE object producing the default output length for
+     * the variant.
+     *
+     * @param type SHAKE variant, SHAKE128 or SHAKE256
+     *
+     * @throws IllegalArgumentException if type is invalid
+     */
+    public Shake(int type) {
+        this(type, defaultOutputLength(type));
+    }
+
+    /**
+     * Create new SHAKE object
+     *
+     * @param type SHAKE variant, SHAKE128 or SHAKE256
+     * @param outLen output length in bytes returned by digest()
+     *
+     * @throws IllegalArgumentException if type or outLen is invalid
+     */
+    public Shake(int type, int outLen) {
+        defaultOutputLength(type);
+        if (outLen < 0) {
+            throw new IllegalArgumentException(
+                "SHAKE output length must not be negative");
+        }
+        this.type = type;
+        this.outLen = outLen;
+        init();
+    }
+
+    /**
+     * Create new SHAKE object by making a copy of the one given,
+     * including its output length.
+     *
+     * @param shake Initialized/created Shake object to be copied
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public Shake(Shake shake) {
+        this.type = shake.type;
+        this.outLen = shake.outLen;
+        init();
+        native_copy(shake);
+    }
+
+    /**
+     * Get SHAKE variant of this object
+     *
+     * @return SHAKE128 or SHAKE256
+     */
+    public int getType() {
+        return type;
+    }
+
+    /**
+     * Get SHAKE output length of digest()
+     *
+     * @return output length in bytes
+     */
+    public int digestSize() {
+        return outLen;
+    }
+}
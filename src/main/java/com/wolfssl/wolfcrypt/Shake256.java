@@ -0,0 +1,91 @@
+/* Shake256.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+/**
+ * Wrapper for the native WolfCrypt SHAKE256 implementation, producing
+ * DIGEST_SIZE bytes of output by default
+ */
+public class Shake256 extends Shake {
+
+    /** SHAKE256 hash type */
+    public static final int TYPE = SHAKE256;
+    /** SHAKE256 default output size */
+    public static final int DIGEST_SIZE = 64;
+
+    /**
+     * Compute SHAKE256 output of data in a single native call.
+     *
+     * @param data input data
+     * @param outLen number of output bytes
+     *
+     * @return outLen bytes of SHAKE256 output
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public static byte[] hash(byte[] data, int outLen)
+        throws WolfCryptException {
+
+        return hash(TYPE, data, outLen);
+    }
+
+    /**
+     * Compute DIGEST_SIZE bytes of SHAKE256 output of data in a single
+     * native call.
+     *
+     * @param data input data
+     *
+     * @return SHAKE256 output of data
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public static byte[] hash(byte[] data) throws WolfCryptException {
+        return hash(TYPE, data, DIGEST_SIZE);
+    }
+
+    /**
+     * Create new SHAKE256 object with DIGEST_SIZE bytes of output
+     */
+    public Shake256() {
+        super(TYPE, DIGEST_SIZE);
+    }
+
+    /**
+     * Create new SHAKE256 object
+     *
+     * @param outLen output length in bytes returned by digest()
+     */
+    public Shake256(int outLen) {
+        super(TYPE, outLen);
+    }
+
+    /**
+     * Create new SHAKE256 object by making a copy of the one given.
+     *
+     * @param shake Initialized/created Shake256 object to be copied
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public Shake256(Shake256 shake) {
+        super(shake);
+    }
+}
@@ -0,0 +1,497 @@
+/* TreeHash.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.RecursiveAction;
+
+/**
+ * Parallel Merkle tree hash over Sha256, Sha384 or Sha512.
+ *
+ * Input is split into fixed size leaves which are hashed concurrently on a
+ * work-stealing ForkJoinPool, then combined pairwise into a single root
+ * digest. Leaf and interior node hashes are domain separated as in
+ * RFC 6962: leaf = H(0x00 || leaf data), node = H(0x01 || left || right).
+ * A node without a sibling is promoted to the next level unchanged. Empty
+ * input is a single empty leaf.
+ *
+ * The root depends on the digest algorithm and leaf size, both must match
+ * between the producer and verifier of a tree hash. It is not equal to a
+ * plain digest of the same input.
+ *
+ * Leaf digests are kept in the returned {@link Result}, so a changed
+ * region can be re-verified by rehashing only the leaves that cover it
+ * and recomputing the root with {@link #combine(int, byte[][])}.
+ *
+ * TreeHash objects are immutable and may be shared between threads.
+ */
+public class TreeHash {
+
+    /** Default leaf size, 1 MiB */
+    public static final int DEFAULT_LEAF_SIZE = 1024 * 1024;
+
+    private static final byte[] LEAF_PREFIX = new byte[] { 0x00 };
+    private static final byte[] NODE_PREFIX = new byte[] { 0x01 };
+
+    /* files are mapped in windows of about this many bytes */
+    private static final long MAP_WINDOW = 1L << 30;
+
+    private static volatile ForkJoinPool defaultPool;
+
+    private final int type;
+    private final int leafSize;
+    private final ForkJoinPool pool;
+
+    /**
+     * Create new TreeHash using the default leaf size and a shared pool
+     * sized to the number of available processors.
+     *
+     * @param type digest type, Sha256.TYPE, Sha384.TYPE or Sha512.TYPE
+     *
+     * @throws IllegalArgumentException if type is not supported
+     */
+    public TreeHash(int type) {
+        this(type, DEFAULT_LEAF_SIZE, null);
+    }
+
+    /**
+     * Create new TreeHash.
+     *
+     * @param type digest type, Sha256.TYPE, Sha384.TYPE or Sha512.TYPE
+     * @param leafSize size of each leaf in bytes
+     * @param pool pool used to hash leaves, or null for a shared pool sized
+     *        to the number of available processors
+     *
+     * @throws IllegalArgumentException if type is not supported or
+     *         leafSize is not positive
+     */
+    public TreeHash(int type, int leafSize, ForkJoinPool pool) {
+
+        checkType(type);
+
+        if (leafSize <= 0) {
+            throw new IllegalArgumentException(
+                "Leaf size must be greater than zero");
+        }
+
+        this.type = type;
+        this.leafSize = leafSize;
+        this.pool = pool;
+    }
+
+    /**
+     * Get digest type used by this TreeHash
+     *
+     * @return digest type, ex: Sha256.TYPE
+     */
+    public int getType() {
+        return this.type;
+    }
+
+    /**
+     * Get leaf size used by this TreeHash
+     *
+     * @return leaf size in bytes
+     */
+    public int getLeafSize() {
+        return this.leafSize;
+    }
+
+    /**
+     * Tree hash a byte array region.
+     *
+     * @param data input data
+     * @param offset offset into input data
+     * @param len length of input data
+     *
+     * @return tree hash result
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public Result hash(byte[] data, int offset, int len)
+        throws WolfCryptException {
+
+        if (offset < 0 || len < 0 || offset > data.length - len) {
+            throw new IllegalArgumentException(
+                "Invalid offset or length for input buffer");
+        }
+
+        return hash(ByteBuffer.wrap(data, offset, len));
+    }
+
+    /**
+     * Tree hash all remaining bytes of a ByteBuffer. The buffer position is
+     * not changed. Direct and mapped buffers are hashed in place.
+     *
+     * @param data input data
+     *
+     * @return tree hash result
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public Result hash(ByteBuffer data) throws WolfCryptException {
+
+        long len = data.remaining();
+        byte[][] leaves = new byte[leafCount(len)][];
+
+        run(new LeafTask(data, data.position(), len, 0, 0, leaves.length,
+            leaves));
+
+        return new Result(this.type, this.leafSize, len, leaves);
+    }
+
+    /**
+     * Tree hash the contents of a file channel from position 0 to its
+     * current size. The file is memory mapped read-only window by window,
+     * so inputs larger than 2 GB are supported and no file data is copied
+     * through the Java heap.
+     *
+     * @param channel open channel to read, its position is not changed
+     *
+     * @return tree hash result
+     *
+     * @throws IOException if mapping the file fails
+     * @throws WolfCryptException if native operation fails
+     */
+    public Result hash(FileChannel channel)
+        throws IOException, WolfCryptException {
+
+        long size = channel.size();
+        byte[][] leaves = new byte[leafCount(size)][];
+        long window = Math.max(1, MAP_WINDOW / leafSize) * leafSize;
+
+        if (size == 0) {
+            leaves[0] = hashLeaf(ByteBuffer.allocate(0));
+        }
+
+        for (long pos = 0; pos < size; pos += window) {
+            long len = Math.min(window, size - pos);
+            MappedByteBuffer map =
+                channel.map(FileChannel.MapMode.READ_ONLY, pos, len);
+            int first = (int)(pos / leafSize);
+
+            run(new LeafTask(map, 0, len, first, first,
+                first + leafCount(len), leaves));
+        }
+
+        return new Result(this.type, this.leafSize, size, leaves);
+    }
+
+    /**
+     * Hash a single leaf, for re-verifying part of a previously hashed
+     * input against {@link Result#getLeafDigest(int)}.
+     *
+     * @param leaf leaf data, all remaining bytes are used. Should be
+     *        getLeafSize() bytes long, except for the last leaf.
+     *
+     * @return leaf digest
+     *
+     * @throws WolfCryptException if native operation fails
+     */
+    public byte[] hashLeaf(ByteBuffer leaf) throws WolfCryptException {
+        return hashLeaf(this.type, leaf.duplicate());
+    }
+
+    /**
+     * Combine leaf digests into a root digest.
+     *
+     * @param type digest type the leaf digests were computed with
+     * @param leaves leaf digests in order, at least one
+     *
+     * @return root digest
+     *
+     * @throws WolfCryptException if native operation fails
+     * @throws IllegalArgumentException if leaves is empty or type is not
+     *         supported
+     */
+    public static byte[] combine(int type, byte[][] leaves)
+        throws WolfCryptException {
+
+        byte[][] level = leaves.clone();
+        int n = level.length;
+
+        if (n == 0) {
+            throw new IllegalArgumentException("At least one leaf required");
+        }
+
+        MessageDigest md = newDigest(type);
+
+        try {
+            while (n > 1) {
+                int next = 0;
+
+                for (int i = 0; i < n; i += 2) {
+                    if (i + 1 == n) {
+                        /* odd node out, promoted unchanged */
+                        level[next++] = level[i];
+                        continue;
+                    }
+
+                    md.update(NODE_PREFIX);
+                    md.update(level[i]);
+                    md.update(level[i + 1]);
+                    level[next++] = md.digest();
+                }
+                n = next;
+            }
+        } finally {
+            md.releaseNativeStruct();
+        }
+
+        return level[0].clone();
+    }
+
+    private int leafCount(long len) {
+        long count = (len + leafSize - 1) / leafSize;
+
+        if (count > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException(
+                "Input too large for leaf size " + leafSize);
+        }
+
+        return (count == 0) ? 1 : (int)count;
+    }
+
+    private void run(LeafTask task) {
+        ForkJoinPool p = this.pool;
+
+        if (p == null) {
+            p = getDefaultPool();
+        }
+
+        p.invoke(task);
+    }
+
+    private static ForkJoinPool getDefaultPool() {
+        if (defaultPool == null) {
+            synchronized (TreeHash.class) {
+                if (defaultPool == null) {
+                    defaultPool = new ForkJoinPool();
+                }
+            }
+        }
+
+        return defaultPool;
+    }
+
+    private static void checkType(int type) {
+        if (type != Sha256.TYPE && type != Sha384.TYPE &&
+            type != Sha512.TYPE) {
+            throw new IllegalArgumentException(
+                "Unsupported tree hash digest type: " + type);
+        }
+    }
+
+    private static MessageDigest newDigest(int type) {
+        switch (type) {
+            case Sha256.TYPE:
+                return new Sha256();
+            case Sha384.TYPE:
+                return new Sha384();
+            case Sha512.TYPE:
+                return new Sha512();
+            default:
+                throw new IllegalArgumentException(
+                    "Unsupported tree hash digest type: " + type);
+        }
+    }
+
+    private static byte[] hashLeaf(int type, ByteBuffer leaf) {
+        MessageDigest md = newDigest(type);
+
+        try {
+            md.update(LEAF_PREFIX);
+
+            if (!leaf.hasRemaining()) {
+                /* empty input, leaf is H(0x00) */
+            }
+            else if (leaf.isDirect()) {
+                md.update(leaf);
+            }
+            else if (leaf.hasArray()) {
+                md.update(leaf.array(), leaf.arrayOffset() + leaf.position(),
+                    leaf.remaining());
+            }
+            else {
+                byte[] tmp = new byte[leaf.remaining()];
+                leaf.get(tmp);
+                md.update(tmp);
+            }
+
+            return md.digest();
+
+        } finally {
+            md.releaseNativeStruct();
+        }
+    }
+
+    /* hashes leaves [from, to) of the tree, leaf base of this input region
+     * starts at offset start of data */
+    private class LeafTask extends RecursiveAction {
+
+        private static final long serialVersionUID = 1L;
+
+        private final ByteBuffer data;
+        private final long start;
+        private final long len;
+        private final int base;
+        private final int from;
+        private final int to;
+        private final byte[][] leaves;
+
+        LeafTask(ByteBuffer data, long start, long len, int base, int from,
+            int to, byte[][] leaves) {
+            this.data = data;
+            this.start = start;
+            this.len = len;
+            this.base = base;
+            this.from = from;
+            this.to = to;
+            this.leaves = leaves;
+        }
+
+        @Override
+        protected void compute() {
+            if (to - from > 1) {
+                int mid = (from + to) >>> 1;
+                invokeAll(
+                    new LeafTask(data, start, len, base, from, mid, leaves),
+                    new LeafTask(data, start, len, base, mid, to, leaves));
+                return;
+            }
+
+            long off = (long)(from - base) * leafSize;
+            ByteBuffer leaf = data.duplicate();
+            leaf.position((int)(start + off));
+            leaf.limit((int)(start + Math.min(off + leafSize, len)));
+
+            leaves[from] = hashLeaf(type, leaf);
+        }
+    }
+
+    /**
+     * Result of a tree hash: root digest and leaf digests.
+     */
+    public static class Result {
+
+        private final int type;
+        private final int leafSize;
+        private final long length;
+        private final byte[][] leaves;
+        private final byte[] root;
+
+        Result(int type, int leafSize, long length, byte[][] leaves) {
+            this.type = type;
+            this.leafSize = leafSize;
+            this.length = length;
+            this.leaves = leaves;
+            this.root = combine(type, leaves);
+        }
+
+        /**
+         * Get root digest
+         *
+         * @return copy of root digest
+         */
+        public byte[] getRoot() {
+            return root.clone();
+        }
+
+        /**
+         * Get number of leaves
+         *
+         * @return leaf count, at least one
+         */
+        public int getLeafCount() {
+            return leaves.length;
+        }
+
+        /**
+         * Get digest of one leaf
+         *
+         * @param index leaf index, leaf i covers input bytes
+         *        [i * leafSize, (i + 1) * leafSize)
+         *
+         * @return copy of leaf digest
+         */
+        public byte[] getLeafDigest(int index) {
+            return leaves[index].clone();
+        }
+
+        /**
+         * Get all leaf digests
+         *
+         * @return copy of leaf digests, in input order
+         */
+        public byte[][] getLeafDigests() {
+            byte[][] copy = new byte[leaves.length][];
+
+            for (int i = 0; i < leaves.length; i++) {
+                copy[i] = leaves[i].clone();
+            }
+
+            return copy;
+        }
+
+        /**
+         * Get digest type of this result
+         *
+         * @return digest type, ex: Sha256.TYPE
+         */
+        public int getType() {
+            return type;
+        }
+
+        /**
+         * Get leaf size of this result
+         *
+         * @return leaf size in bytes
+         */
+        public int getLeafSize() {
+            return leafSize;
+        }
+
+        /**
+         * Get number of input bytes hashed
+         *
+         * @return input length
+         */
+        public long getLength() {
+            return length;
+        }
+
+        /**
+         * Check if root digest matches expected value, in constant time.
+         *
+         * @param expected expected root digest
+         *
+         * @return true if equal
+         */
+        public boolean matches(byte[] expected) {
+            return java.security.MessageDigest.isEqual(root, expected);
+        }
+    }
+}
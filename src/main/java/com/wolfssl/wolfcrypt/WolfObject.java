@@ -64,6 +64,8 @@ public class WolfObject {
 
         /* initialize native wolfCrypt library */
         init();
+
+        Logging.setNativeLogLevelFromProperty();
     }
 
     /**
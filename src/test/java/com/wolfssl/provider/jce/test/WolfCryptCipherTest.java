@@ -25,6 +25,8 @@ import static org.junit.Assert.*;
 import org.junit.Test;
 import org.junit.BeforeClass;
 
+import java.io.ByteArrayOutputStream;
+import java.nio.ByteBuffer;
 import java.util.ArrayList;
 import java.util.HashMap;
 import java.util.Random;
@@ -38,9 +40,12 @@ import java.util.concurrent.LinkedBlockingQueue;
 import javax.crypto.Cipher;
 import javax.crypto.spec.SecretKeySpec;
 import javax.crypto.spec.IvParameterSpec;
+import javax.crypto.spec.GCMParameterSpec;
+import javax.crypto.AEADBadTagException;
 import javax.crypto.NoSuchPaddingException;
 import javax.crypto.IllegalBlockSizeException;
 import javax.crypto.BadPaddingException;
+import javax.crypto.ShortBufferException;
 
 import java.security.Security;
 import java.security.Provider;
@@ -53,11 +58,13 @@ import java.security.NoSuchProviderException;
 import java.security.NoSuchAlgorithmException;
 import java.security.InvalidKeyException;
 import java.security.InvalidAlgorithmParameterException;
+import java.security.spec.AlgorithmParameterSpec;
 
 import com.wolfssl.wolfcrypt.WolfCrypt;
 import com.wolfssl.wolfcrypt.Fips;
 import com.wolfssl.provider.jce.WolfCryptProvider;
 import com.wolfssl.wolfcrypt.WolfCryptException;
+import com.wolfssl.wolfcrypt.test.Util;
 
 public class WolfCryptCipherTest {
 
@@ -65,6 +72,8 @@ public class WolfCryptCipherTest {
     private static String supportedJCEAlgos[] = {
         "AES/CBC/NoPadding",
         "AES/CBC/PKCS5Padding",
+        "AES/GCM/NoPadding",
+        "AES/CTR/NoPadding",
         "DESede/CBC/NoPadding",
         "RSA",
         "RSA/ECB/PKCS1Padding"
@@ -111,6 +120,8 @@ public class WolfCryptCipherTest {
         /* fill expected block size HashMap */
         expectedBlockSizes.put("AES/CBC/NoPadding", 16);
         expectedBlockSizes.put("AES/CBC/PKCS5Padding", 16);
+        expectedBlockSizes.put("AES/GCM/NoPadding", 16);
+        expectedBlockSizes.put("AES/CTR/NoPadding", 16);
         expectedBlockSizes.put("DESede/CBC/NoPadding", 8);
         expectedBlockSizes.put("RSA", 0);
         expectedBlockSizes.put("RSA/ECB/PKCS1Padding", 0);
@@ -1474,6 +1485,465 @@ public class WolfCryptCipherTest {
         }
     }
 
+    @Test
+    public void testAesGcmNoPadding()
+        throws NoSuchProviderException, NoSuchAlgorithmException,
+               NoSuchPaddingException, InvalidKeyException,
+               IllegalBlockSizeException, InvalidAlgorithmParameterException,
+               BadPaddingException {
+
+        /* NIST GCM test case 4 */
+        byte[] key = Util.h2b("feffe9928665731c6d6a8f9467308308");
+        byte[] iv  = Util.h2b("cafebabefacedbaddecaf888");
+        byte[] aad = Util.h2b("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+        byte[] input = Util.h2b(
+            "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72" +
+            "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39");
+        byte[] expected = Util.h2b(
+            "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e" +
+            "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091" +
+            "5bc94fbc3221a5db94fae95ae7121a47");
+
+        byte output[];
+        byte plain[];
+
+        if (!enabledJCEAlgos.contains("AES/GCM/NoPadding")) {
+            /* bail out if AES-GCM is not enabled */
+            return;
+        }
+
+        Cipher cipher = Cipher.getInstance("AES/GCM/NoPadding", jceProvider);
+        SecretKeySpec keySpec = new SecretKeySpec(key, "AES");
+        GCMParameterSpec spec = new GCMParameterSpec(128, iv);
+
+        /* one-shot encrypt, output is ciphertext followed by tag */
+        cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+        cipher.updateAAD(aad);
+        assertEquals(expected.length, cipher.getOutputSize(input.length));
+        output = cipher.doFinal(input);
+        assertArrayEquals(expected, output);
+
+        /* reusing same key and IV to encrypt again is not allowed */
+        try {
+            cipher.doFinal(input);
+            fail("AES-GCM encrypt should fail when reusing key and IV");
+        } catch (IllegalStateException e) { }
+
+        /* decrypt in pieces */
+        cipher.init(Cipher.DECRYPT_MODE, keySpec, spec);
+        cipher.updateAAD(aad, 0, 10);
+        cipher.updateAAD(aad, 10, aad.length - 10);
+        cipher.update(expected, 0, 17);
+        plain = cipher.doFinal(expected, 17, expected.length - 17);
+        assertArrayEquals(input, plain);
+
+        /* modified tag should throw AEADBadTagException */
+        byte[] bad = expected.clone();
+        bad[bad.length - 1] ^= 0x01;
+        cipher.init(Cipher.DECRYPT_MODE, keySpec, spec);
+        cipher.updateAAD(aad);
+        try {
+            cipher.doFinal(bad);
+            fail("AES-GCM decrypt should fail with bad tag");
+        } catch (AEADBadTagException e) { }
+
+        /* shorter 96-bit tag */
+        cipher.init(Cipher.ENCRYPT_MODE, keySpec,
+            new GCMParameterSpec(96, iv));
+        cipher.updateAAD(aad);
+        output = cipher.doFinal(input);
+        assertArrayEquals(Arrays.copyOfRange(expected, 0, expected.length - 4),
+            output);
+
+        /* interop with another provider, if available */
+        if (interopProvider != null) {
+            Cipher interop = Cipher.getInstance("AES/GCM/NoPadding",
+                interopProvider);
+            spec = new GCMParameterSpec(128, iv);
+
+            interop.init(Cipher.DECRYPT_MODE, keySpec, spec);
+            interop.updateAAD(aad);
+            plain = interop.doFinal(expected);
+            assertArrayEquals(input, plain);
+        }
+    }
+
+    @Test
+    public void testAesGcmNoPaddingBigMessageWithUpdate()
+        throws NoSuchProviderException, NoSuchAlgorithmException,
+               NoSuchPaddingException, InvalidKeyException,
+               IllegalBlockSizeException, InvalidAlgorithmParameterException,
+               BadPaddingException {
+
+        byte[] key = new byte[16];
+        byte[] iv = new byte[12];
+        byte[] input = new byte[(256 * 1024) + 5];
+        byte[] aad = new byte[] { 0x01, 0x02, 0x03 };
+        byte[] oneShot = null;
+        byte[] tmp = null;
+        byte[] plain = null;
+        ByteArrayOutputStream out = null;
+
+        if (!enabledJCEAlgos.contains("AES/GCM/NoPadding")) {
+            /* bail out if AES-GCM is not enabled */
+            return;
+        }
+
+        secureRandom.nextBytes(key);
+        secureRandom.nextBytes(iv);
+        secureRandom.nextBytes(input);
+
+        Cipher cipher = Cipher.getInstance("AES/GCM/NoPadding", jceProvider);
+        SecretKeySpec keySpec = new SecretKeySpec(key, "AES");
+        GCMParameterSpec spec = new GCMParameterSpec(128, iv);
+
+        cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+        cipher.updateAAD(aad);
+        oneShot = cipher.doFinal(input);
+        assertEquals(input.length + 16, oneShot.length);
+
+        /* encrypt through many updates, output must match one-shot */
+        cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+        cipher.updateAAD(aad);
+        out = new ByteArrayOutputStream();
+        for (int i = 0; i < input.length; i += 4099) {
+            tmp = cipher.update(input, i, Math.min(4099, input.length - i));
+            if (tmp != null) {
+                out.write(tmp, 0, tmp.length);
+            }
+        }
+        tmp = cipher.doFinal();
+        out.write(tmp, 0, tmp.length);
+        assertArrayEquals(oneShot, out.toByteArray());
+
+        /* decrypt through many updates, including splitting the tag */
+        cipher.init(Cipher.DECRYPT_MODE, keySpec, spec);
+        cipher.updateAAD(aad);
+        out = new ByteArrayOutputStream();
+        for (int i = 0; i < oneShot.length - 8; i += 4099) {
+            tmp = cipher.update(oneShot, i,
+                Math.min(4099, oneShot.length - 8 - i));
+            if (tmp != null) {
+                out.write(tmp, 0, tmp.length);
+            }
+        }
+        tmp = cipher.doFinal(oneShot, oneShot.length - 8, 8);
+        out.write(tmp, 0, tmp.length);
+        plain = out.toByteArray();
+        assertArrayEquals(input, plain);
+    }
+
+    @Test
+    public void testAesGcmDecryptReleasesNoUnverifiedPlaintext()
+        throws NoSuchProviderException, NoSuchAlgorithmException,
+               NoSuchPaddingException, InvalidKeyException,
+               IllegalBlockSizeException, InvalidAlgorithmParameterException,
+               BadPaddingException {
+
+        byte[] key = new byte[16];
+        byte[] iv = new byte[12];
+        byte[] input = new byte[(64 * 1024) + 5];
+        byte[] cipherText = null;
+        byte[] tmp = null;
+
+        if (!enabledJCEAlgos.contains("AES/GCM/NoPadding")) {
+            /* bail out if AES-GCM is not enabled */
+            return;
+        }
+
+        secureRandom.nextBytes(key);
+        secureRandom.nextBytes(iv);
+        secureRandom.nextBytes(input);
+
+        Cipher cipher = Cipher.getInstance("AES/GCM/NoPadding", jceProvider);
+        SecretKeySpec keySpec = new SecretKeySpec(key, "AES");
+        GCMParameterSpec spec = new GCMParameterSpec(128, iv);
+
+        cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+        cipherText = cipher.doFinal(input);
+
+        /* no plaintext may be returned before the tag is verified */
+        cipher.init(Cipher.DECRYPT_MODE, keySpec, spec);
+        for (int i = 0; i < cipherText.length; i += 4099) {
+            tmp = cipher.update(cipherText, i,
+                Math.min(4099, cipherText.length - i));
+            assertTrue(tmp == null || tmp.length == 0);
+        }
+        assertArrayEquals(input, cipher.doFinal());
+
+        /* tampered ciphertext releases nothing and fails in final */
+        cipherText[100] ^= 0x01;
+        cipher.init(Cipher.DECRYPT_MODE, keySpec, spec);
+        for (int i = 0; i < cipherText.length; i += 4099) {
+            tmp = cipher.update(cipherText, i,
+                Math.min(4099, cipherText.length - i));
+            assertTrue(tmp == null || tmp.length == 0);
+        }
+        try {
+            cipher.doFinal();
+            fail("AES-GCM decrypt should fail with tampered ciphertext");
+        } catch (AEADBadTagException e) { }
+    }
+
+    @Test
+    public void testAesCtrNoPadding()
+        throws NoSuchProviderException, NoSuchAlgorithmException,
+               NoSuchPaddingException, InvalidKeyException,
+               IllegalBlockSizeException, InvalidAlgorithmParameterException,
+               BadPaddingException {
+
+        /* NIST SP 800-38A F.5.1, CTR-AES128.Encrypt */
+        byte[] key = Util.h2b("2b7e151628aed2a6abf7158809cf4f3c");
+        byte[] iv  = Util.h2b("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+        byte[] input = Util.h2b(
+            "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51" +
+            "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+        byte[] expected = Util.h2b(
+            "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff" +
+            "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+        byte[] output = null;
+        byte[] tmp = null;
+        ByteArrayOutputStream out = null;
+
+        if (!enabledJCEAlgos.contains("AES/CTR/NoPadding")) {
+            /* bail out if AES-CTR is not enabled */
+            return;
+        }
+
+        Cipher cipher = Cipher.getInstance("AES/CTR/NoPadding", jceProvider);
+        SecretKeySpec keySpec = new SecretKeySpec(key, "AES");
+        IvParameterSpec spec = new IvParameterSpec(iv);
+
+        cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+        output = cipher.doFinal(input);
+        assertArrayEquals(expected, output);
+
+        /* odd sized updates, output produced immediately for each */
+        cipher.init(Cipher.DECRYPT_MODE, keySpec, spec);
+        out = new ByteArrayOutputStream();
+        tmp = cipher.update(expected, 0, 3);
+        assertEquals(3, tmp.length);
+        out.write(tmp, 0, tmp.length);
+        tmp = cipher.update(expected, 3, 30);
+        assertEquals(30, tmp.length);
+        out.write(tmp, 0, tmp.length);
+        tmp = cipher.doFinal(expected, 33, expected.length - 33);
+        out.write(tmp, 0, tmp.length);
+        assertArrayEquals(input, out.toByteArray());
+
+        /* non-block-multiple input in doFinal is allowed */
+        cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+        output = cipher.doFinal(input, 0, 17);
+        assertArrayEquals(Arrays.copyOfRange(expected, 0, 17), output);
+
+        /* interop with another provider, if available */
+        if (interopProvider != null) {
+            Cipher interop = Cipher.getInstance("AES/CTR/NoPadding",
+                interopProvider);
+            interop.init(Cipher.DECRYPT_MODE, keySpec, spec);
+            assertArrayEquals(input, interop.doFinal(expected));
+        }
+    }
+
+    @Test
+    public void testUpdateIntoOutputArrayWithOddChunks()
+        throws NoSuchProviderException, NoSuchAlgorithmException,
+               NoSuchPaddingException, InvalidKeyException,
+               IllegalBlockSizeException, InvalidAlgorithmParameterException,
+               BadPaddingException, ShortBufferException {
+
+        String[] algos = new String[] {
+            "AES/CBC/NoPadding",
+            "AES/CBC/PKCS5Padding",
+            "AES/CTR/NoPadding",
+            "AES/GCM/NoPadding",
+            "DESede/CBC/NoPadding"
+        };
+        int[] chunks = new int[] { 1, 7, 16, 3, 25, 13, 31 };
+        byte[] input = new byte[96];
+        SecureRandom rand = new SecureRandom();
+        rand.nextBytes(input);
+
+        for (String algo : algos) {
+
+            if (!enabledJCEAlgos.contains(algo)) {
+                continue;
+            }
+
+            Cipher cipher = Cipher.getInstance(algo, jceProvider);
+            boolean isAes = algo.startsWith("AES");
+            boolean isGcm = algo.contains("GCM");
+            byte[] key = new byte[isAes ? 16 : 24];
+            byte[] iv = new byte[isGcm ? 12 : cipher.getBlockSize()];
+            rand.nextBytes(key);
+            rand.nextBytes(iv);
+
+            SecretKeySpec keySpec =
+                new SecretKeySpec(key, isAes ? "AES" : "DESede");
+            AlgorithmParameterSpec spec = isGcm ?
+                new GCMParameterSpec(128, iv) : new IvParameterSpec(iv);
+
+            cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+            byte[] expected = cipher.doFinal(input);
+
+            /* decrypt in place, carried bytes must not be overwritten
+             * before they are read */
+            byte[] buf = expected.clone();
+            int inPos = 0;
+            int outPos = 0;
+            int i = 0;
+
+            cipher.init(Cipher.DECRYPT_MODE, keySpec, spec);
+            while (inPos < buf.length) {
+                int len = Math.min(chunks[i++ % chunks.length],
+                    buf.length - inPos);
+                outPos += cipher.update(buf, inPos, len, buf, outPos);
+                inPos += len;
+            }
+            outPos += cipher.doFinal(buf, outPos);
+
+            assertEquals(algo, input.length, outPos);
+            assertArrayEquals(algo, input,
+                Arrays.copyOfRange(buf, 0, outPos));
+
+            /* encrypt in odd chunks into a separate array at an offset */
+            byte[] out = new byte[expected.length + 3];
+            inPos = 0;
+            outPos = 3;
+            i = 0;
+
+            if (isGcm) {
+                /* GCM encrypt needs a fresh IV for each operation */
+                rand.nextBytes(iv);
+                spec = new GCMParameterSpec(128, iv);
+            }
+
+            cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+            while (inPos < input.length) {
+                int len = Math.min(chunks[i++ % chunks.length],
+                    input.length - inPos);
+                outPos += cipher.update(input, inPos, len, out, outPos);
+                inPos += len;
+            }
+            outPos += cipher.doFinal(out, outPos);
+
+            if (isGcm) {
+                cipher.init(Cipher.DECRYPT_MODE, keySpec, spec);
+                expected = cipher.doFinal(out, 3, outPos - 3);
+                assertArrayEquals(algo, input, expected);
+                continue;
+            }
+
+            assertEquals(algo, expected.length + 3, outPos);
+            assertArrayEquals(algo, expected,
+                Arrays.copyOfRange(out, 3, outPos));
+
+            /* encrypt with output ahead of input in the same array, after
+             * an odd first chunk so block modes carry data into it */
+            buf = new byte[expected.length + 12];
+            System.arraycopy(input, 0, buf, 0, input.length);
+
+            cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+            byte[] head = cipher.update(input, 0, 7);
+            if (head == null) {
+                head = new byte[0];
+            }
+            outPos = 12;
+            outPos += cipher.update(buf, 7, input.length - 7, buf, outPos);
+            outPos += cipher.doFinal(buf, outPos);
+
+            assertEquals(algo, expected.length, head.length + outPos - 12);
+            assertArrayEquals(algo, Arrays.copyOfRange(expected, 0,
+                head.length), head);
+            assertArrayEquals(algo, Arrays.copyOfRange(expected,
+                head.length, expected.length),
+                Arrays.copyOfRange(buf, 12, outPos));
+        }
+    }
+
+    @Test
+    public void testDirectByteBufferMatchesByteArray()
+        throws NoSuchProviderException, NoSuchAlgorithmException,
+               NoSuchPaddingException, InvalidKeyException,
+               IllegalBlockSizeException, InvalidAlgorithmParameterException,
+               BadPaddingException, ShortBufferException {
+
+        String[] algos = new String[] {
+            "AES/CBC/NoPadding",
+            "AES/CBC/PKCS5Padding",
+            "AES/CTR/NoPadding",
+            "DESede/CBC/NoPadding"
+        };
+        /* first update ends on and off a block boundary */
+        int[] splits = new int[] { 32, 37 };
+        byte[] input = new byte[96];
+        SecureRandom rand = new SecureRandom();
+        rand.nextBytes(input);
+
+        for (String algo : algos) {
+
+            if (!enabledJCEAlgos.contains(algo)) {
+                continue;
+            }
+
+            Cipher cipher = Cipher.getInstance(algo, jceProvider);
+            boolean isAes = algo.startsWith("AES");
+            byte[] key = new byte[isAes ? 16 : 24];
+            byte[] iv = new byte[cipher.getBlockSize()];
+            rand.nextBytes(key);
+            rand.nextBytes(iv);
+
+            SecretKeySpec keySpec =
+                new SecretKeySpec(key, isAes ? "AES" : "DESede");
+            IvParameterSpec spec = new IvParameterSpec(iv);
+
+            cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+            byte[] expected = cipher.doFinal(input);
+
+            for (int split : splits) {
+                ByteBuffer in = ByteBuffer.allocateDirect(input.length);
+                ByteBuffer out = ByteBuffer.allocateDirect(
+                    expected.length + 5);
+                in.put(input).flip();
+
+                /* start output at a non-zero position */
+                out.position(5);
+
+                cipher.init(Cipher.ENCRYPT_MODE, keySpec, spec);
+                in.limit(split);
+                cipher.update(in, out);
+                assertEquals(split, in.position());
+                in.limit(input.length);
+                cipher.doFinal(in, out);
+                assertFalse(in.hasRemaining());
+                assertEquals(expected.length + 5, out.position());
+
+                byte[] result = new byte[expected.length];
+                out.position(5);
+                out.get(result);
+                assertArrayEquals(algo, expected, result);
+
+                /* decrypt ciphertext back through direct buffers */
+                ByteBuffer enc = ByteBuffer.allocateDirect(expected.length);
+                /* getOutputSize() reserves room for padding */
+                ByteBuffer dec = ByteBuffer.allocateDirect(
+                    expected.length + 32);
+                enc.put(expected).flip();
+
+                cipher.init(Cipher.DECRYPT_MODE, keySpec, spec);
+                enc.limit(split);
+                cipher.update(enc, dec);
+                enc.limit(expected.length);
+                cipher.doFinal(enc, dec);
+
+                result = new byte[dec.position()];
+                dec.flip();
+                dec.get(result);
+                assertArrayEquals(algo, input, result);
+            }
+        }
+    }
+
     @Test
     public void testDESedeCbcNoPadding()
         throws NoSuchProviderException, NoSuchAlgorithmException,
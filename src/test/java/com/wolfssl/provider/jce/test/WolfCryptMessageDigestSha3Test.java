@@ -0,0 +1,143 @@
+/* wolfCryptMessageDigestSha512Test.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.provider.jce.test;
+
+import static org.junit.Assert.*;
+import org.junit.Test;
+import org.junit.Assume;
+import org.junit.BeforeClass;
+
+import java.security.Security;
+import java.security.Provider;
+import java.security.MessageDigest;
+import java.security.NoSuchProviderException;
+import java.security.NoSuchAlgorithmException;
+
+import com.wolfssl.provider.jce.WolfCryptProvider;
+import com.wolfssl.wolfcrypt.FeatureDetect;
+import com.wolfssl.wolfcrypt.test.Util;
+
+public class WolfCryptMessageDigestSha3Test {
+
+    /* algorithms under test, with their digest of "abc" below */
+    private static final String[] algos = new String[] {
+        "SHA3-224", "SHA3-256", "SHA3-384", "SHA3-512",
+        "SHAKE128", "SHAKE256"
+    };
+
+    private static final String[] abcVector = new String[] {
+        "e642824c3f8cf24ad09234ee7d3c766fc9a3a5168d0c94ad73b46fdf",
+        "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532",
+        "ec01498288516fc926459f58e2c6ad8df9b473cb0fc08c2596da7cf0e49be4b2" +
+        "98d88cea927ac7f539f1edf228376d25",
+        "b751850b1a57168a5693cd924b6b096e08f621827444f70d884f5d0240d2712e" +
+        "10e116e9192af3c91a7ec57647e3934057340b4cf408d5a56592f8274eec53f0",
+        "5881092dd818bf5cf8a3ddb793fbcba74097d5c526a6d35f97b83351940f2cc8",
+        "483366601360a8771c6863080cc4114d8db44530f8f1e1ee4f94ea37e78b5739" +
+        "d5a15bef186a5386c75744c0527e1faa9f8726e462a12a4feb06bd8801e751e4"
+    };
+
+    private static boolean enabled(int i) {
+        switch (i) {
+            case 0: return FeatureDetect.Sha3_224Enabled();
+            case 1: return FeatureDetect.Sha3_256Enabled();
+            case 2: return FeatureDetect.Sha3_384Enabled();
+            case 3: return FeatureDetect.Sha3_512Enabled();
+            case 4: return FeatureDetect.Shake128Enabled();
+            default: return FeatureDetect.Shake256Enabled();
+        }
+    }
+
+    @BeforeClass
+    public static void testProviderInstallationAtRuntime()
+        throws NoSuchProviderException {
+
+        /* install wolfJCE provider at runtime */
+        Security.addProvider(new WolfCryptProvider());
+
+        Provider p = Security.getProvider("wolfJCE");
+        assertNotNull(p);
+
+        if (FeatureDetect.Sha3_256Enabled() == false &&
+            FeatureDetect.Shake128Enabled() == false) {
+            System.out.println("JCE SHA-3 Test skipped");
+            Assume.assumeTrue(false);
+        }
+    }
+
+    @Test
+    public void testSha3SingleUpdate()
+        throws NoSuchProviderException, NoSuchAlgorithmException {
+
+        for (int i = 0; i < algos.length; i++) {
+            if (!enabled(i)) {
+                continue;
+            }
+
+            byte[] expected = Util.h2b(abcVector[i]);
+            MessageDigest md = MessageDigest.getInstance(algos[i], "wolfJCE");
+
+            assertEquals(expected.length, md.getDigestLength());
+            assertArrayEquals(algos[i], expected,
+                md.digest(new String("abc").getBytes()));
+        }
+    }
+
+    @Test
+    public void testSha3Clone()
+        throws NoSuchProviderException, NoSuchAlgorithmException,
+               CloneNotSupportedException {
+
+        for (int i = 0; i < algos.length; i++) {
+            if (!enabled(i)) {
+                continue;
+            }
+
+            byte[] expected = Util.h2b(abcVector[i]);
+            MessageDigest md = MessageDigest.getInstance(algos[i], "wolfJCE");
+            md.update((byte)'a');
+
+            /* Try to clone existing MessageDigest, should copy over same
+             * state */
+            MessageDigest mdCopy = (MessageDigest)md.clone();
+            md.update(new String("bc").getBytes());
+            mdCopy.update(new String("bc").getBytes());
+
+            assertArrayEquals(algos[i], expected, md.digest());
+            assertArrayEquals(algos[i], expected, mdCopy.digest());
+        }
+    }
+
+    @Test
+    public void testShakeAliases()
+        throws NoSuchProviderException, NoSuchAlgorithmException {
+
+        if (FeatureDetect.Shake128Enabled()) {
+            assertEquals(32, MessageDigest.getInstance("SHAKE128-256",
+                "wolfJCE").getDigestLength());
+        }
+        if (FeatureDetect.Shake256Enabled()) {
+            assertEquals(64, MessageDigest.getInstance("SHAKE256-512",
+                "wolfJCE").getDigestLength());
+        }
+    }
+}
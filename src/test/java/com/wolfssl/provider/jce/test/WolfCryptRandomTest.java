@@ -60,6 +60,17 @@ public class WolfCryptRandomTest {
         SecureRandom rand = SecureRandom.getInstance("HashDRBG", "wolfJCE");
     }
 
+    @Test
+    public void testThreadSafeAttribute() {
+
+        Provider p = Security.getProvider("wolfJCE");
+        assertNotNull(p);
+
+        /* lets SecureRandom skip locking around our engine (JDK 9+) */
+        assertEquals("true",
+            p.getProperty("SecureRandom.HashDRBG ThreadSafe"));
+    }
+
     @Test
     public void testNextBytes()
         throws NoSuchProviderException, NoSuchAlgorithmException {
@@ -124,6 +135,45 @@ public class WolfCryptRandomTest {
         }
     }
 
+    @Test
+    public void testBufferedNextBytes()
+        throws NoSuchProviderException, NoSuchAlgorithmException {
+
+        String old = System.getProperty("wolfjce.rng.bufferSize");
+        System.setProperty("wolfjce.rng.bufferSize", "256");
+
+        try {
+            SecureRandom rand = SecureRandom.getInstance(
+                                    "HashDRBG", "wolfJCE");
+            byte[] valuesA = new byte[16];
+            byte[] valuesB = new byte[16];
+
+            /* crosses several buffer refills */
+            rand.nextBytes(valuesA);
+            for (int i = 0; i < 100; i++) {
+                rand.nextBytes(valuesB);
+
+                if (Arrays.equals(valuesA, valuesB))
+                    fail("SecureRandom generated two equal " +
+                         "consecutive arrays in buffered mode");
+
+                valuesA = Arrays.copyOf(valuesB, valuesB.length);
+            }
+
+            /* larger than buffer threshold, generated directly */
+            byte[] large = new byte[1024];
+            rand.nextBytes(large);
+            assertFalse(Arrays.equals(new byte[1024], large));
+
+        } finally {
+            if (old == null) {
+                System.clearProperty("wolfjce.rng.bufferSize");
+            } else {
+                System.setProperty("wolfjce.rng.bufferSize", old);
+            }
+        }
+    }
+
     @Test
     public void testGenerateSeed()
         throws NoSuchProviderException, NoSuchAlgorithmException {
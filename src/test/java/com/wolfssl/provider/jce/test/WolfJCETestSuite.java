@@ -31,6 +31,7 @@ import org.junit.runners.Suite.SuiteClasses;
                 WolfCryptMessageDigestSha256Test.class,
                 WolfCryptMessageDigestSha384Test.class,
                 WolfCryptMessageDigestSha512Test.class,
+                WolfCryptMessageDigestSha3Test.class,
                 WolfCryptRandomTest.class,
                 WolfCryptSignatureTest.class,
                 WolfCryptMacTest.class,
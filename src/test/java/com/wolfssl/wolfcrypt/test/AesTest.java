@@ -425,6 +425,332 @@ public class AesTest {
         dec.releaseNativeStruct();
     }
 
+    @Test
+    public void largeUpdateShouldMatchIncrementalUpdates() {
+
+        /* larger than the native critical-region limit, processed
+         * natively in chunks; must match encrypting in small pieces */
+        byte[] in = new byte[(256 * 1024) + Aes.BLOCK_SIZE];
+        new Random(0).nextBytes(in);
+
+        Aes enc = new Aes(KEY, IV, Aes.ENCRYPT_MODE);
+        byte[] cipher = enc.update(in, 0, in.length);
+
+        Aes enc2 = new Aes(KEY, IV, Aes.ENCRYPT_MODE);
+        byte[] expected = new byte[in.length];
+        for (int i = 0; i < in.length; i += 1024) {
+            int len = Math.min(1024, in.length - i);
+            byte[] part = enc2.update(in, i, len);
+            System.arraycopy(part, 0, expected, i, len);
+        }
+        assertArrayEquals(expected, cipher);
+
+        Aes dec = new Aes(KEY, IV, Aes.DECRYPT_MODE);
+        byte[] plain = dec.update(cipher, 0, cipher.length);
+        assertArrayEquals(in, plain);
+
+        enc.releaseNativeStruct();
+        enc2.releaseNativeStruct();
+        dec.releaseNativeStruct();
+    }
+
+    @Test
+    public void overlappingUpdateShouldMatchSeparateBuffers()
+        throws ShortBufferException {
+
+        /* input and output ranges of the same array, output ahead of and
+         * behind the input, must match using a separate output array */
+        int[] sizes = new int[] { 4 * Aes.BLOCK_SIZE, 1024,
+            (256 * 1024) + Aes.BLOCK_SIZE };
+        int[] shifts = new int[] { Aes.BLOCK_SIZE, 5, -Aes.BLOCK_SIZE };
+        Random rand = new Random(0);
+
+        for (int size : sizes) {
+            for (int shift : shifts) {
+                int inPos = (shift < 0) ? -shift : 0;
+                int outPos = (shift < 0) ? 0 : shift;
+                byte[] in = new byte[size];
+                rand.nextBytes(in);
+
+                Aes enc = new Aes(KEY, IV, Aes.ENCRYPT_MODE);
+                byte[] expected = enc.update(in, 0, size);
+
+                byte[] buf = new byte[size + Math.abs(shift)];
+                System.arraycopy(in, 0, buf, inPos, size);
+                Aes enc2 = new Aes(KEY, IV, Aes.ENCRYPT_MODE);
+                assertEquals(size, enc2.update(buf, inPos, size, buf, outPos));
+                assertArrayEquals(expected,
+                    Arrays.copyOfRange(buf, outPos, outPos + size));
+
+                enc.releaseNativeStruct();
+                enc2.releaseNativeStruct();
+            }
+        }
+    }
+
+    @Test
+    public void gcmShouldMatchTestVectors() {
+
+        /* NIST GCM test cases 3 (no AAD) and 4 (with AAD) */
+        byte[] key = Util.h2b("feffe9928665731c6d6a8f9467308308");
+        byte[] iv  = Util.h2b("cafebabefacedbaddecaf888");
+        byte[] aad = Util.h2b("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+        byte[] p3 = Util.h2b(
+            "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72" +
+            "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255");
+        byte[] c3 = Util.h2b(
+            "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e" +
+            "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985");
+        byte[] t3 = Util.h2b("4d5c2af327cd64a62cf35abd2ba6fab4");
+        byte[] p4 = Arrays.copyOfRange(p3, 0, 60);
+        byte[] c4 = Arrays.copyOfRange(c3, 0, 60);
+        byte[] t4 = Util.h2b("5bc94fbc3221a5db94fae95ae7121a47");
+
+        Aes aes = null;
+        byte[] tag = new byte[Aes.GCM_TAG_SIZE];
+
+        try {
+            aes = new Aes();
+            aes.gcmSetKey(key);
+        } catch (WolfCryptException e) {
+            if (e.getError() == WolfCryptError.NOT_COMPILED_IN) {
+                /* AES-GCM not compiled in */
+                return;
+            }
+            throw e;
+        }
+
+        assertArrayEquals(c3, aes.gcmEncrypt(p3, iv, tag, null));
+        assertArrayEquals(t3, tag);
+        assertArrayEquals(p3, aes.gcmDecrypt(c3, iv, t3, null));
+
+        assertArrayEquals(c4, aes.gcmEncrypt(p4, iv, tag, aad));
+        assertArrayEquals(t4, tag);
+        assertArrayEquals(p4, aes.gcmDecrypt(c4, iv, t4, aad));
+
+        /* modified tag should fail verification */
+        tag = t4.clone();
+        tag[0] ^= 0x01;
+        try {
+            aes.gcmDecrypt(c4, iv, tag, aad);
+            fail("gcmDecrypt should fail with bad auth tag");
+        } catch (WolfCryptException e) {
+            assertEquals(WolfCryptError.AES_GCM_AUTH_E, e.getError());
+        }
+
+        aes.releaseNativeStruct();
+    }
+
+    @Test
+    public void gcmDecryptShouldNotLeakPlaintextOnBadTag()
+        throws ShortBufferException {
+
+        byte[] key = Util.h2b("feffe9928665731c6d6a8f9467308308");
+        byte[] iv  = Util.h2b("cafebabefacedbaddecaf888");
+        byte[] aad = Util.h2b("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+        byte[] in = new byte[100];
+        byte[] tag = new byte[Aes.GCM_TAG_SIZE];
+        byte[] out = new byte[in.length + 16];
+        byte[] cipher;
+
+        Aes aes = null;
+
+        new Random().nextBytes(in);
+
+        try {
+            aes = new Aes();
+            aes.gcmSetKey(key);
+        } catch (WolfCryptException e) {
+            if (e.getError() == WolfCryptError.NOT_COMPILED_IN) {
+                /* AES-GCM not compiled in */
+                return;
+            }
+            throw e;
+        }
+
+        cipher = aes.gcmEncrypt(in, iv, tag, aad);
+        tag[tag.length - 1] ^= 0x01;
+
+        try {
+            aes.gcmDecrypt(cipher, 0, cipher.length, out, 8, iv, tag, aad);
+            fail("gcmDecrypt should fail with bad auth tag");
+        } catch (WolfCryptException e) {
+            assertEquals(WolfCryptError.AES_GCM_AUTH_E, e.getError());
+        }
+
+        /* unverified plaintext must not be left in the output range */
+        assertArrayEquals(new byte[out.length], out);
+
+        aes.releaseNativeStruct();
+    }
+
+    @Test
+    public void gcmStreamShouldMatchOneShot() throws ShortBufferException {
+
+        byte[] key = Util.h2b("feffe9928665731c6d6a8f9467308308");
+        byte[] iv  = Util.h2b("cafebabefacedbaddecaf888");
+        byte[] aad = Util.h2b("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+        byte[] in = new byte[(128 * 1024) + 7];
+        byte[] expectedTag = new byte[Aes.GCM_TAG_SIZE];
+        byte[] tag = new byte[Aes.GCM_TAG_SIZE];
+        byte[] cipher = new byte[in.length];
+        byte[] plain = new byte[in.length];
+        byte[] expected = null;
+        Aes aes = new Aes();
+
+        new Random(0).nextBytes(in);
+
+        try {
+            aes.gcmSetKey(key);
+            aes.gcmInit(iv, Aes.ENCRYPT_MODE);
+        } catch (WolfCryptException e) {
+            if (e.getError() == WolfCryptError.NOT_COMPILED_IN) {
+                /* AES-GCM streaming not compiled in */
+                return;
+            }
+            throw e;
+        }
+
+        expected = aes.gcmEncrypt(in, iv, expectedTag, aad);
+
+        /* encrypt in odd sized pieces */
+        aes.gcmInit(iv, Aes.ENCRYPT_MODE);
+        aes.gcmUpdateAad(aad, 0, aad.length);
+        for (int i = 0; i < in.length; i += 1000) {
+            int len = Math.min(1000, in.length - i);
+            assertEquals(len, aes.gcmUpdate(in, i, len, cipher, i));
+        }
+        aes.gcmFinal(tag);
+        assertArrayEquals(expected, cipher);
+        assertArrayEquals(expectedTag, tag);
+
+        /* decrypt in one update */
+        aes.gcmInit(iv, Aes.DECRYPT_MODE);
+        aes.gcmUpdateAad(aad, 0, aad.length);
+        aes.gcmUpdate(cipher, 0, cipher.length, plain, 0);
+        aes.gcmFinal(tag);
+        assertArrayEquals(in, plain);
+
+        /* modified tag should fail verification */
+        tag[0] ^= 0x01;
+        aes.gcmInit(iv, Aes.DECRYPT_MODE);
+        aes.gcmUpdateAad(aad, 0, aad.length);
+        aes.gcmUpdate(cipher, 0, cipher.length, plain, 0);
+        try {
+            aes.gcmFinal(tag);
+            fail("gcmFinal should fail with bad auth tag");
+        } catch (WolfCryptException e) {
+            assertEquals(WolfCryptError.AES_GCM_AUTH_E, e.getError());
+        }
+
+        aes.releaseNativeStruct();
+    }
+
+    @Test
+    public void ctrShouldMatchTestVectorWithOddLengths()
+        throws ShortBufferException {
+
+        /* NIST SP 800-38A F.5.1, CTR-AES128.Encrypt */
+        byte[] key = Util.h2b("2b7e151628aed2a6abf7158809cf4f3c");
+        byte[] iv  = Util.h2b("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+        byte[] in  = Util.h2b(
+            "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51" +
+            "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+        byte[] expected = Util.h2b(
+            "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff" +
+            "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+        byte[] out = new byte[in.length];
+        int[] splits = new int[] { 5, 20, 39 };
+        int pos = 0;
+        Aes aes = new Aes();
+
+        try {
+            aes.ctrSetKey(key, iv);
+            aes.ctrUpdate(in, 0, in.length, out, 0);
+        } catch (WolfCryptException e) {
+            if (e.getError() == WolfCryptError.NOT_COMPILED_IN) {
+                /* AES-CTR not compiled in */
+                return;
+            }
+            throw e;
+        }
+        assertArrayEquals(expected, out);
+
+        /* keystream position carries across non-block-aligned calls */
+        aes.ctrSetKey(key, iv);
+        Arrays.fill(out, (byte)0);
+        for (int i = 0; i < splits.length; i++) {
+            pos += aes.ctrUpdate(in, pos, splits[i], out, pos);
+        }
+        aes.ctrUpdate(in, pos, in.length - pos, out, pos);
+        assertArrayEquals(expected, out);
+
+        /* decrypt using direct ByteBuffers */
+        ByteBuffer cipher = ByteBuffer.allocateDirect(expected.length);
+        ByteBuffer plain = ByteBuffer.allocateDirect(in.length);
+        cipher.put(expected).flip();
+
+        aes.ctrSetKey(key, iv);
+        cipher.limit(7);
+        assertEquals(7, aes.ctrUpdate(cipher, plain));
+        cipher.limit(expected.length);
+        assertEquals(expected.length - 7, aes.ctrUpdate(cipher, plain));
+
+        byte[] result = new byte[in.length];
+        plain.flip();
+        plain.get(result);
+        assertArrayEquals(in, result);
+
+        aes.releaseNativeStruct();
+    }
+
+    @Test
+    public void ctrUpdateAtShouldMatchSequentialKeystream()
+        throws ShortBufferException {
+
+        /* NIST SP 800-38A F.5.1, CTR-AES128.Encrypt */
+        byte[] key = Util.h2b("2b7e151628aed2a6abf7158809cf4f3c");
+        byte[] iv  = Util.h2b("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+        byte[] in  = Util.h2b(
+            "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51" +
+            "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+        byte[] expected = Util.h2b(
+            "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff" +
+            "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+        byte[] out = new byte[in.length];
+        int[] positions = new int[] { 37, 0, 16, 5, 50 };
+        Aes aes = new Aes();
+
+        try {
+            aes.ctrSetKey(key, iv);
+        } catch (WolfCryptException e) {
+            if (e.getError() == WolfCryptError.NOT_COMPILED_IN) {
+                /* AES-CTR not compiled in */
+                return;
+            }
+            throw e;
+        }
+
+        /* slices processed out of order match the sequential output */
+        for (int i = 0; i < positions.length; i++) {
+            int pos = positions[i];
+            int len = Math.min(11, in.length - pos);
+            assertEquals(len,
+                aes.ctrUpdateAt(pos, in, pos, len, out, pos));
+            assertArrayEquals(Arrays.copyOfRange(expected, pos, pos + len),
+                Arrays.copyOfRange(out, pos, pos + len));
+        }
+
+        /* streaming continues from the seek position */
+        aes.ctrSeek(21);
+        Arrays.fill(out, (byte)0);
+        aes.ctrUpdate(in, 21, in.length - 21, out, 21);
+        assertArrayEquals(Arrays.copyOfRange(expected, 21, in.length),
+            Arrays.copyOfRange(out, 21, in.length));
+
+        aes.releaseNativeStruct();
+    }
+
     @Test
     public void testPadPKCS7() {
 
@@ -0,0 +1,135 @@
+/* AesXtsTest.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.test;
+
+import static org.junit.Assert.*;
+
+import java.util.Arrays;
+
+import javax.crypto.ShortBufferException;
+
+import org.junit.Assume;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import com.wolfssl.wolfcrypt.AesXts;
+import com.wolfssl.wolfcrypt.WolfCryptError;
+import com.wolfssl.wolfcrypt.WolfCryptException;
+
+public class AesXtsTest {
+
+    @BeforeClass
+    public static void checkAvailability() {
+        try {
+            new AesXts();
+        } catch (WolfCryptException e) {
+            if (e.getError() == WolfCryptError.NOT_COMPILED_IN)
+                System.out.println("AesXts test skipped: " + e.getError());
+            Assume.assumeNoException(e);
+        }
+    }
+
+    @Test
+    public void sectorsShouldMatchTestVectors() {
+
+        /* IEEE 1619-2007 XTS-AES-128 vectors 1 and 2 */
+        byte[] key1 = new byte[AesXts.KEY_SIZE_256];
+        byte[] pt1  = new byte[32];
+        byte[] ct1  = Util.h2b(
+            "917cf69ebd68b2ec9b9fe9a3eadda692cd43d2f59598ed858c02c2652fbf922e");
+
+        byte[] key2 = Util.h2b(
+            "1111111111111111111111111111111122222222222222222222222222222222");
+        byte[] pt2  = Util.h2b(
+            "4444444444444444444444444444444444444444444444444444444444444444");
+        byte[] ct2  = Util.h2b(
+            "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0");
+
+        AesXts enc = new AesXts(key1, AesXts.ENCRYPT_MODE);
+        AesXts dec = new AesXts(key1, AesXts.DECRYPT_MODE);
+
+        assertArrayEquals(ct1, enc.encryptSector(0, pt1));
+        assertArrayEquals(pt1, dec.decryptSector(0, ct1));
+
+        enc.setKey(key2, AesXts.ENCRYPT_MODE);
+        dec.setKey(key2, AesXts.DECRYPT_MODE);
+
+        assertArrayEquals(ct2, enc.encryptSector(0x3333333333L, pt2));
+        assertArrayEquals(pt2, dec.decryptSector(0x3333333333L, ct2));
+
+        enc.releaseNativeStruct();
+        dec.releaseNativeStruct();
+    }
+
+    @Test
+    public void sectorsShouldBeIndependent() throws ShortBufferException {
+
+        byte[] key = Util.h2b(
+            "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+        int sectorSz = 37; /* not a multiple of the block size */
+        int sectors = 4;
+        byte[] plain = new byte[sectorSz * sectors];
+        byte[] cipher = new byte[plain.length];
+        byte[] result = new byte[plain.length];
+
+        for (int i = 0; i < plain.length; i++)
+            plain[i] = (byte)i;
+
+        AesXts enc = new AesXts(key, AesXts.ENCRYPT_MODE);
+        AesXts dec = new AesXts(key, AesXts.DECRYPT_MODE);
+
+        for (int i = 0; i < sectors; i++) {
+            assertEquals(sectorSz, enc.encryptSector(i, plain, i * sectorSz,
+                sectorSz, cipher, i * sectorSz));
+        }
+
+        /* decrypt in reverse order, each sector only needs its number */
+        for (int i = sectors - 1; i >= 0; i--) {
+            assertEquals(sectorSz, dec.decryptSector(i, cipher, i * sectorSz,
+                sectorSz, result, i * sectorSz));
+        }
+        assertArrayEquals(plain, result);
+
+        /* same data under different sector numbers differs */
+        byte[] s0 = Arrays.copyOfRange(plain, 0, sectorSz);
+        assertFalse(Arrays.equals(enc.encryptSector(0, s0),
+            enc.encryptSector(1, s0)));
+
+        try {
+            enc.encryptSector(0, new byte[AesXts.MIN_SECTOR_SIZE - 1]);
+            fail("sector smaller than one block should fail");
+        } catch (IllegalArgumentException e) {
+            /* expected */
+        }
+
+        try {
+            dec.encryptSector(0, s0);
+            fail("decrypt object should not encrypt");
+        } catch (IllegalStateException e) {
+            /* expected */
+        }
+
+        enc.releaseNativeStruct();
+        dec.releaseNativeStruct();
+    }
+}
+
@@ -210,6 +210,36 @@ public class Des3Test {
         dec.releaseNativeStruct();
     }
 
+    @Test
+    public void overlappingUpdateShouldMatchSeparateBuffers()
+        throws ShortBufferException {
+
+        byte[] key = Util.h2b("e61a38548694f1fd8cef251c518" +
+                              "cc70bb613751c1ce52aa8");
+        byte[] iv = Util.h2b("48a8ceb8551fd4ad");
+        int[] shifts = new int[] { Des3.BLOCK_SIZE, 3, -Des3.BLOCK_SIZE };
+        byte[] in = new byte[1024];
+        new Random(0).nextBytes(in);
+
+        Des3 enc = new Des3(key, iv, Des3.ENCRYPT_MODE);
+        byte[] expected = enc.update(in, 0, in.length);
+        enc.releaseNativeStruct();
+
+        /* output ahead of and behind input in the same array */
+        for (int shift : shifts) {
+            int inPos = (shift < 0) ? -shift : 0;
+            int outPos = (shift < 0) ? 0 : shift;
+            byte[] buf = new byte[in.length + Math.abs(shift)];
+            System.arraycopy(in, 0, buf, inPos, in.length);
+
+            enc = new Des3(key, iv, Des3.ENCRYPT_MODE);
+            enc.update(buf, inPos, in.length, buf, outPos);
+            assertArrayEquals(expected,
+                Arrays.copyOfRange(buf, outPos, outPos + in.length));
+            enc.releaseNativeStruct();
+        }
+    }
+
     @Test
     public void reuseObject() {
 
@@ -44,6 +44,7 @@ import java.security.InvalidAlgorithmParameterException;
 import java.security.NoSuchAlgorithmException;
 
 import com.wolfssl.wolfcrypt.Ecc;
+import com.wolfssl.wolfcrypt.CryptoEvents;
 import com.wolfssl.wolfcrypt.Rng;
 import com.wolfssl.wolfcrypt.NativeStruct;
 import com.wolfssl.wolfcrypt.WolfCryptError;
@@ -100,6 +101,42 @@ public class EccTest {
         assertArrayEquals(sharedSecretA, alice2.makeSharedSecret(bob));
     }
 
+    @Test
+    public void signShouldEmitEventWithKeySizeAndCurve() {
+        final LinkedBlockingQueue<Object[]> events =
+            new LinkedBlockingQueue<Object[]>();
+        CryptoEvents.Sink saved = CryptoEvents.getSink();
+        Ecc key = new Ecc();
+
+        synchronized (rngLock) {
+            key.makeKeyOnCurve(rng, 32, "secp256r1");
+        }
+
+        CryptoEvents.setSink(new CryptoEvents.Sink() {
+            public Object begin(int type) {
+                return (type == CryptoEvents.ECC_SIGN) ? new Object() : null;
+            }
+            public void commit(Object event, String algorithm, int keySize,
+                String curve) {
+                events.add(new Object[] { algorithm, keySize, curve });
+            }
+        });
+
+        try {
+            synchronized (rngLock) {
+                key.sign(new byte[32], rng);
+            }
+        } finally {
+            CryptoEvents.setSink(saved);
+        }
+
+        assertEquals(1, events.size());
+        Object[] event = events.poll();
+        assertEquals("ECDSA", event[0]);
+        assertEquals(256, event[1]);
+        assertEquals("SECP256R1", event[2]);
+    }
+
     @Test
     public void signatureShouldMatchDecodingKeys() {
         Ecc alice = new Ecc();
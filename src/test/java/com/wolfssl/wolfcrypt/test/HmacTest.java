@@ -23,6 +23,8 @@ package com.wolfssl.wolfcrypt.test;
 
 import static org.junit.Assert.*;
 
+import java.io.File;
+import java.io.FileOutputStream;
 import java.nio.ByteBuffer;
 
 import org.junit.Assume;
@@ -333,6 +335,36 @@ public class HmacTest {
         }
     }
 
+    @Test
+    public void macFileShouldMatchUpdate() throws Exception {
+
+        if (Hmac.SHA256 == -1) {
+            return;
+        }
+
+        byte[] key = new byte[32];
+        byte[] data = new byte[(200 * 1024) + 5];
+        new Random(0).nextBytes(key);
+        new Random(1).nextBytes(data);
+
+        File file = File.createTempFile("hmac", ".bin");
+        file.deleteOnExit();
+        try {
+            FileOutputStream out = new FileOutputStream(file);
+            out.write(data);
+            out.close();
+
+            Hmac hmac = new Hmac(Hmac.SHA256, key);
+            hmac.update(data);
+            byte[] expected = hmac.doFinal();
+
+            assertArrayEquals(expected,
+                Hmac.macFile(Hmac.SHA256, key, file.toPath()));
+        } finally {
+            file.delete();
+        }
+    }
+
     @Test
     public void testThreadedHmac() throws InterruptedException {
 
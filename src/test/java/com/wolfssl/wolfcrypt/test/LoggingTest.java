@@ -0,0 +1,103 @@
+/* LoggingTest.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.test;
+
+import static org.junit.Assert.*;
+import static org.junit.Assume.assumeTrue;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+import com.wolfssl.wolfcrypt.Logging;
+import com.wolfssl.wolfcrypt.Sha256;
+
+public class LoggingTest {
+
+    private int savedLevel;
+
+    @Before
+    public void saveLevel() {
+        savedLevel = Logging.getNativeLogLevel();
+        Logging.getNativeLog();
+    }
+
+    @After
+    public void restoreLevel() {
+        Logging.setNativeLogLevel(savedLevel);
+    }
+
+    @Test
+    public void disabledNativeLogShouldStayEmpty() {
+        Logging.setNativeLogLevel(Logging.JNI_LOG_OFF);
+
+        new Sha256().update(new byte[16]);
+
+        assertEquals(0, Logging.getNativeLog().length);
+    }
+
+    @Test
+    public void infoLevelShouldRecordOperations() {
+        assumeTrue(Logging.getNativeMaxLogLevel() >= Logging.JNI_LOG_INFO);
+
+        Logging.setNativeLogLevel(Logging.JNI_LOG_INFO);
+        assertEquals(Logging.JNI_LOG_INFO, Logging.getNativeLogLevel());
+
+        new Sha256().update(new byte[16]);
+        Logging.setNativeLogLevel(Logging.JNI_LOG_OFF);
+
+        boolean found = false;
+        for (String line : Logging.getNativeLog()) {
+            if (line.equals("[INFO] wc_Sha256Update(len 16) = 0")) {
+                found = true;
+            }
+        }
+        assertTrue(found);
+
+        /* drained records are not returned again */
+        assertEquals(0, Logging.getNativeLog().length);
+    }
+
+    @Test
+    public void levelShouldBeClamped() {
+        Logging.setNativeLogLevel(42);
+        assertEquals(Logging.JNI_LOG_DEBUG, Logging.getNativeLogLevel());
+
+        Logging.setNativeLogLevel(-1);
+        assertEquals(Logging.JNI_LOG_OFF, Logging.getNativeLogLevel());
+    }
+
+    @Test
+    public void isLogLevelEnabledShouldFollowRuntimeLevel() {
+        Logging.setNativeLogLevel(Logging.JNI_LOG_INFO);
+        assertTrue(Logging.isLogLevelEnabled(Logging.JNI_LOG_ERROR));
+        assertTrue(Logging.isLogLevelEnabled(Logging.JNI_LOG_INFO));
+        assertFalse(Logging.isLogLevelEnabled(Logging.JNI_LOG_DEBUG));
+
+        Logging.setNativeLogLevel(42);
+        assertTrue(Logging.isLogLevelEnabled(Logging.JNI_LOG_DEBUG));
+
+        Logging.setNativeLogLevel(Logging.JNI_LOG_OFF);
+        assertFalse(Logging.isLogLevelEnabled(Logging.JNI_LOG_ERROR));
+        assertFalse(Logging.isLogLevelEnabled(Logging.JNI_LOG_OFF));
+    }
+}
@@ -0,0 +1,211 @@
+/* MessageDigestTest.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.test;
+
+import static org.junit.Assert.*;
+
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import java.util.Random;
+import javax.crypto.ShortBufferException;
+
+import org.junit.Test;
+
+import com.wolfssl.wolfcrypt.Md5;
+import com.wolfssl.wolfcrypt.MessageDigest;
+import com.wolfssl.wolfcrypt.Sha;
+import com.wolfssl.wolfcrypt.Sha256;
+import com.wolfssl.wolfcrypt.Sha384;
+import com.wolfssl.wolfcrypt.Sha512;
+import com.wolfssl.wolfcrypt.WolfCryptException;
+import com.wolfssl.wolfcrypt.WolfCryptError;
+
+/* Tests of the static hash() and hashBatch() methods shared by the
+ * MessageDigest classes, run against each class in turn */
+public class MessageDigestTest {
+
+    private static final Class<?>[] classes = new Class<?>[] {
+        Md5.class, Sha.class, Sha256.class, Sha384.class, Sha512.class
+    };
+
+    /* new object of cls, or null if the algorithm is not compiled in */
+    private static MessageDigest newDigest(Class<?> cls) throws Exception {
+        try {
+            return (MessageDigest)cls.newInstance();
+        } catch (WolfCryptException e) {
+            if (e.getError() == WolfCryptError.NOT_COMPILED_IN) {
+                return null;
+            }
+            throw e;
+        }
+    }
+
+    /* invoke static method, rethrowing what the method itself threw */
+    private static Object invoke(Method m, Object... args) throws Exception {
+        try {
+            return m.invoke(null, args);
+        } catch (InvocationTargetException e) {
+            if (e.getCause() instanceof Exception) {
+                throw (Exception)e.getCause();
+            }
+            throw e;
+        }
+    }
+
+    @Test
+    public void staticHashShouldMatchInstanceDigest() throws Exception {
+
+        int[] sizes = new int[] { 0, 1, 55, 64, 1000, (128 * 1024) + 1 };
+
+        for (Class<?> cls : classes) {
+            if (newDigest(cls) == null) {
+                continue;
+            }
+
+            int digestSize = cls.getField("DIGEST_SIZE").getInt(null);
+            Method hashArray = cls.getMethod("hash", byte[].class, int.class,
+                int.class, byte[].class, int.class);
+            Method hashExact = cls.getMethod("hash", byte[].class);
+            Method hashBuffer = cls.getMethod("hash", ByteBuffer.class,
+                ByteBuffer.class);
+            Random rand = new Random(0);
+
+            for (int size : sizes) {
+                byte[] data = new byte[size + 2];
+                rand.nextBytes(data);
+
+                MessageDigest md = newDigest(cls);
+                md.update(data, 1, size);
+                byte[] expected = md.digest();
+
+                byte[] out = new byte[digestSize + 3];
+                invoke(hashArray, data, 1, size, out, 3);
+                assertArrayEquals(cls.getSimpleName(), expected,
+                    Arrays.copyOfRange(out, 3, out.length));
+
+                byte[] exact = Arrays.copyOfRange(data, 1, size + 1);
+                assertArrayEquals(cls.getSimpleName(), expected,
+                    (byte[])invoke(hashExact, exact));
+
+                ByteBuffer in = ByteBuffer.allocateDirect(size);
+                ByteBuffer hash = ByteBuffer.allocateDirect(digestSize);
+                in.put(data, 1, size).flip();
+                invoke(hashBuffer, in, hash);
+                assertEquals(0, in.remaining());
+                assertEquals(0, hash.remaining());
+                byte[] result = new byte[digestSize];
+                hash.flip();
+                hash.get(result);
+                assertArrayEquals(cls.getSimpleName(), expected, result);
+
+                ByteBuffer heapIn = ByteBuffer.wrap(data, 1, size);
+                ByteBuffer heapHash = ByteBuffer.allocate(digestSize);
+                invoke(hashBuffer, heapIn, heapHash);
+                assertArrayEquals(cls.getSimpleName(), expected,
+                    heapHash.array());
+            }
+
+            try {
+                invoke(hashArray, new byte[16], 0, 16,
+                    new byte[digestSize - 1], 0);
+                fail(cls.getSimpleName() +
+                    ": short output buffer should be rejected");
+            } catch (ShortBufferException e) {
+                /* expected */
+            }
+        }
+    }
+
+    @Test
+    public void hashBatchShouldMatchOneShotHash() throws Exception {
+
+        /* includes messages over the native critical-region limit */
+        int[] lengths = new int[] { 0, 1, 32, 1000, 64, (96 * 1024), 7 };
+        int[] offsets = new int[lengths.length];
+        int total = 0;
+
+        for (int i = 0; i < lengths.length; i++) {
+            offsets[i] = total + 1;
+            total += lengths[i] + 1;
+        }
+        byte[] data = new byte[total];
+        new Random(1).nextBytes(data);
+
+        for (Class<?> cls : classes) {
+            if (newDigest(cls) == null) {
+                continue;
+            }
+
+            String name = cls.getSimpleName();
+            int digestSize = cls.getField("DIGEST_SIZE").getInt(null);
+            Method hashArray = cls.getMethod("hash", byte[].class, int.class,
+                int.class, byte[].class, int.class);
+            Method batchArray = cls.getMethod("hashBatch", byte[].class,
+                int[].class, int[].class, byte[].class, int.class);
+            Method batchBuffers = cls.getMethod("hashBatch",
+                ByteBuffer[].class, ByteBuffer.class);
+
+            byte[] out = new byte[2 + (lengths.length * digestSize)];
+            invoke(batchArray, data, offsets, lengths, out, 2);
+
+            ByteBuffer[] buffers = new ByteBuffer[lengths.length];
+            ByteBuffer hash = ByteBuffer.allocateDirect(
+                lengths.length * digestSize);
+
+            for (int i = 0; i < lengths.length; i++) {
+                byte[] expected = new byte[digestSize];
+                invoke(hashArray, data, offsets[i], lengths[i], expected, 0);
+
+                int pos = 2 + (i * digestSize);
+                assertArrayEquals(name, expected,
+                    Arrays.copyOfRange(out, pos, pos + digestSize));
+
+                buffers[i] = ByteBuffer.allocateDirect(lengths[i] + 3);
+                buffers[i].position(3);
+                buffers[i].put(data, offsets[i], lengths[i]);
+                buffers[i].position(3);
+            }
+
+            invoke(batchBuffers, buffers, hash);
+            assertEquals(0, hash.remaining());
+            for (ByteBuffer b : buffers) {
+                assertEquals(0, b.remaining());
+            }
+
+            byte[] result = new byte[lengths.length * digestSize];
+            hash.flip();
+            hash.get(result);
+            assertArrayEquals(name, Arrays.copyOfRange(out, 2, out.length),
+                result);
+
+            try {
+                invoke(batchArray, data, offsets, lengths,
+                    new byte[out.length - 3], 0);
+                fail(name + ": short output buffer should be rejected");
+            } catch (ShortBufferException e) {
+                /* expected */
+            }
+        }
+    }
+}
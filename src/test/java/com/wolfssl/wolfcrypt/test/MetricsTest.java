@@ -0,0 +1,137 @@
+/* MetricsTest.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.test;
+
+import static org.junit.Assert.*;
+
+import org.junit.After;
+import org.junit.Assume;
+import org.junit.Before;
+import org.junit.Test;
+import java.lang.management.ManagementFactory;
+import javax.management.ObjectName;
+
+import com.wolfssl.wolfcrypt.FeatureDetect;
+import com.wolfssl.wolfcrypt.Metrics;
+import com.wolfssl.wolfcrypt.Sha256;
+import com.wolfssl.wolfcrypt.Sha3;
+import com.wolfssl.wolfcrypt.Sha3_256;
+import com.wolfssl.wolfcrypt.Sha3_512;
+
+public class MetricsTest {
+
+    private boolean wasEnabled;
+
+    @Before
+    public void saveState() {
+        wasEnabled = Metrics.isEnabled();
+    }
+
+    @After
+    public void restoreState() {
+        Metrics.setEnabled(wasEnabled);
+    }
+
+    @Test
+    public void enabledMetricsShouldCountOperations() {
+        Metrics.Operation update = Metrics.operation(Sha256.class, "update");
+        Metrics.Operation digest = Metrics.operation(Sha256.class, "digest");
+        Sha256 sha = new Sha256();
+
+        Metrics.setEnabled(true);
+        update.reset();
+        digest.reset();
+
+        sha.update(new byte[100]);
+        sha.update(new byte[28]);
+        sha.digest();
+
+        assertEquals(2, update.getCount());
+        assertEquals(128, update.getBytes());
+        assertEquals(0, update.getErrors());
+        assertEquals(1, digest.getCount());
+        assertTrue(Metrics.getOperations().contains(update));
+
+        long total = 0;
+        for (long count : update.getLatencyHistogram()) {
+            total += count;
+        }
+        assertEquals(2, total);
+        assertEquals(Metrics.LATENCY_BUCKETS,
+            Metrics.getLatencyBucketBounds().length);
+
+        update.reset();
+        assertEquals(0, update.getCount());
+        assertEquals(0, update.getBytes());
+    }
+
+    @Test
+    public void disabledMetricsShouldNotCountOperations() {
+        Metrics.Operation update = Metrics.operation(Sha256.class, "update");
+        Sha256 sha = new Sha256();
+
+        Metrics.setEnabled(false);
+        update.reset();
+
+        sha.update(new byte[64]);
+
+        assertEquals(0, update.getCount());
+        assertEquals(0, update.getBytes());
+    }
+
+    @Test
+    public void sha3VariantsShouldBeCountedSeparately() {
+        Assume.assumeTrue(FeatureDetect.Sha3_256Enabled() &&
+            FeatureDetect.Sha3_512Enabled());
+
+        Metrics.Operation update256 =
+            Metrics.operation(Sha3_256.class, "update");
+        Metrics.Operation update512 =
+            Metrics.operation(Sha3_512.class, "update");
+        Metrics.Operation hash256 = Metrics.operation(Sha3_256.class, "hash");
+        Metrics.Operation hash512 = Metrics.operation(Sha3_512.class, "hash");
+
+        Metrics.setEnabled(true);
+        update256.reset();
+        update512.reset();
+        hash256.reset();
+        hash512.reset();
+
+        /* Sha3 objects record under the class of their variant */
+        new Sha3(Sha3.SHA3_256).update(new byte[10]);
+        new Sha3_512().update(new byte[20]);
+        Sha3.hash(Sha3.SHA3_512, new byte[30]);
+
+        assertEquals(10, update256.getBytes());
+        assertEquals(20, update512.getBytes());
+        assertEquals(0, hash256.getCount());
+        assertEquals(30, hash512.getBytes());
+    }
+
+    @Test
+    public void enabledMetricsShouldRegisterMBean() throws Exception {
+        Metrics.setEnabled(true);
+
+        assertTrue(ManagementFactory.getPlatformMBeanServer().isRegistered(
+            new ObjectName("com.wolfssl.wolfcrypt:type=Metrics")));
+    }
+}
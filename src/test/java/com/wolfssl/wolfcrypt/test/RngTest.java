@@ -33,6 +33,8 @@ import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.LinkedBlockingQueue;
 
 import com.wolfssl.wolfcrypt.Rng;
+import com.wolfssl.wolfcrypt.RngPool;
+import com.wolfssl.wolfcrypt.BufferedRng;
 import com.wolfssl.wolfcrypt.NativeStruct;
 import com.wolfssl.wolfcrypt.WolfCryptException;
 
@@ -59,6 +61,104 @@ public class RngTest {
         wcRng.free();
     }
 
+    @Test
+    public void closeShouldReleaseNativeStruct() {
+        Rng ref = null;
+
+        try (Rng wcRng = new Rng()) {
+            wcRng.init();
+            wcRng.generateBlock(new byte[16]);
+            ref = wcRng;
+        }
+
+        assertEquals(NativeStruct.NULL, ref.getNativeStruct());
+
+        /* closing or releasing again should be ok */
+        ref.close();
+        ref.releaseNativeStruct();
+    }
+
+    @Test
+    public void unreleasedObjectsShouldNotLeak() {
+        /* native memory of these is freed by the cleanup thread once
+         * collected, this only checks nothing fails along the way */
+        for (int i = 0; i < 1000; i++) {
+            new Rng().init();
+        }
+        System.gc();
+    }
+
+    @Test
+    public void rngPoolShouldReuseReleasedRng() {
+        Rng a = RngPool.acquire();
+        assertNotNull(a);
+
+        /* nested acquire on same thread must not share a */
+        Rng b = RngPool.acquire();
+        assertNotSame(a, b);
+
+        RngPool.release(b);
+        RngPool.release(a);
+
+        /* one Rng is cached per thread, the other is released */
+        Rng c = RngPool.acquire();
+        assertSame(b, c);
+        assertEquals(NativeStruct.NULL, a.getNativeStruct());
+
+        byte[] block = c.generateBlock(32);
+        assertEquals(32, block.length);
+
+        RngPool.release(c);
+        RngPool.release(null);
+    }
+
+    @Test
+    public void bufferedRngShouldServeSmallRequests() {
+        Rng rng = new Rng();
+        rng.init();
+
+        BufferedRng buffered = new BufferedRng(rng, 64);
+        byte[] tmpBlockA = new byte[12];
+        byte[] tmpBlockB = new byte[12];
+
+        /* 12 byte reads do not divide buffer, test reads across refill */
+        buffered.nextBytes(tmpBlockA);
+        for (int i = 0; i < 20; i++) {
+            buffered.nextBytes(tmpBlockB, 0, tmpBlockB.length);
+            assertFalse(Arrays.equals(tmpBlockA, tmpBlockB));
+            tmpBlockA = Arrays.copyOf(tmpBlockB, tmpBlockB.length);
+        }
+
+        buffered.nextBytes(new byte[0]);
+        buffered.clear();
+        buffered.nextBytes(tmpBlockB);
+        assertFalse(Arrays.equals(tmpBlockA, tmpBlockB));
+
+        try {
+            buffered.nextBytes(tmpBlockA, 8, 8);
+            fail("nextBytes() should fail when length exceeds buffer");
+        } catch (ArrayIndexOutOfBoundsException e) {
+            /* expected */
+        }
+
+        try {
+            new BufferedRng(rng, 0);
+            fail("BufferedRng should reject zero buffer size");
+        } catch (IllegalArgumentException e) {
+            /* expected */
+        }
+
+        /* without an Rng, output is drawn from RngPool */
+        BufferedRng pooled = new BufferedRng(64);
+        pooled.nextBytes(tmpBlockA);
+        assertFalse(Arrays.equals(tmpBlockA, tmpBlockB));
+        pooled.clear();
+
+        assertEquals(0, Rng.getForkGeneration());
+
+        rng.releaseNativeStruct();
+    }
+
     @Test
     public void testGenerateBlockByteBuffer() {
         ByteBuffer tmpBlockA = ByteBuffer.allocateDirect(32);
@@ -23,6 +23,8 @@ package com.wolfssl.wolfcrypt.test;
 
 import static org.junit.Assert.*;
 
+import java.io.File;
+import java.io.FileOutputStream;
 import java.nio.ByteBuffer;
 import java.util.Random;
 import java.util.Arrays;
@@ -94,6 +96,30 @@ public class Sha256Test {
         }
     }
 
+    @Test
+    public void hashFileShouldMatchByteArray() throws Exception {
+        byte[] data = new byte[(300 * 1024) + 9];
+        new Random(3).nextBytes(data);
+
+        File file = File.createTempFile("sha256", ".bin");
+        File empty = File.createTempFile("sha256", ".empty");
+        file.deleteOnExit();
+        empty.deleteOnExit();
+        try {
+            FileOutputStream out = new FileOutputStream(file);
+            out.write(data);
+            out.close();
+
+            assertArrayEquals(Sha256.hash(data),
+                Sha256.hashFile(file.toPath()));
+            assertArrayEquals(Sha256.hash(new byte[0]),
+                Sha256.hashFile(empty.toPath()));
+        } finally {
+            file.delete();
+            empty.delete();
+        }
+    }
+
     @Test
     public void hashShouldMatchUsingByteArray() {
         String[] dataVector = new String[] { "", "8bf43fbc59b1cefb",
@@ -120,6 +146,27 @@ public class Sha256Test {
         }
     }
 
+    @Test
+    public void largeInputShouldMatchIncrementalUpdates() {
+
+        /* larger than the native critical-region limit, hashed natively
+         * in chunks; must match hashing the same data in small pieces */
+        byte[] data = new byte[(256 * 1024) + 3];
+        new Random(0).nextBytes(data);
+
+        Sha256 sha = new Sha256();
+        sha.update(data, 1, data.length - 1);
+        byte[] result = sha.digest();
+
+        for (int i = 1; i < data.length; i += 1000) {
+            sha.update(data, i, Math.min(1000, data.length - i));
+        }
+        byte[] expected = sha.digest();
+
+        assertArrayEquals(expected, result);
+        sha.releaseNativeStruct();
+    }
+
     @Test
     public void releaseAndReInitObject() {
 
@@ -142,6 +189,47 @@ public class Sha256Test {
         sha.releaseNativeStruct();
     }
 
+    @Test
+    public void releasedStructShouldBeReusedFromPool() {
+
+        byte[] data = new byte[] { 0x00, 0x01, 0x02, 0x03, 0x04 };
+        byte[] expected = Util.h2b("08BB5E5D6EAAC1049EDE0893D30ED022" +
+                                   "B1A4D9B5B48DB414871F51C9CB35283D");
+        int oldSize = NativeStruct.getPoolSize();
+
+        try {
+            NativeStruct.setPoolSize(NativeStruct.DEFAULT_POOL_SIZE);
+
+            /* leave partial state in struct before release */
+            Sha256 sha = new Sha256();
+            sha.update(new byte[] { 0x0a, 0x0b, 0x0c });
+            sha.releaseNativeStruct();
+            assertTrue(NativeStruct.getPoolCount(Sha256.class) > 0);
+
+            long hits = NativeStruct.getPoolHits(Sha256.class);
+            sha = new Sha256();
+            assertEquals(hits + 1, NativeStruct.getPoolHits(Sha256.class));
+
+            /* reused struct should behave as a fresh one */
+            sha.update(data);
+            assertArrayEquals(expected, sha.digest());
+            sha.releaseNativeStruct();
+
+            /* size 0 disables pooling and empties existing pools */
+            NativeStruct.setPoolSize(0);
+            assertEquals(0, NativeStruct.getPoolCount(Sha256.class));
+
+            long misses = NativeStruct.getPoolMisses(Sha256.class);
+            sha = new Sha256();
+            assertEquals(misses + 1, NativeStruct.getPoolMisses(Sha256.class));
+            sha.releaseNativeStruct();
+            assertEquals(0, NativeStruct.getPoolCount(Sha256.class));
+
+        } finally {
+            NativeStruct.setPoolSize(oldSize);
+        }
+    }
+
     @Test
     public void reuseObject() {
 
@@ -0,0 +1,228 @@
+/* Sha3Test.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.test;
+
+import static org.junit.Assert.*;
+
+import java.nio.ByteBuffer;
+import java.util.Random;
+import javax.crypto.ShortBufferException;
+
+import org.junit.Test;
+import org.junit.Assume;
+import org.junit.BeforeClass;
+
+import com.wolfssl.wolfcrypt.FeatureDetect;
+import com.wolfssl.wolfcrypt.Sha3;
+import com.wolfssl.wolfcrypt.Sha3_224;
+import com.wolfssl.wolfcrypt.Sha3_256;
+import com.wolfssl.wolfcrypt.Sha3_384;
+import com.wolfssl.wolfcrypt.Sha3_512;
+import com.wolfssl.wolfcrypt.Shake;
+import com.wolfssl.wolfcrypt.Shake128;
+import com.wolfssl.wolfcrypt.Shake256;
+import com.wolfssl.wolfcrypt.NativeStruct;
+
+public class Sha3Test {
+
+    private static final int[] types = new int[] {
+        Sha3.SHA3_224, Sha3.SHA3_256, Sha3.SHA3_384, Sha3.SHA3_512 };
+
+    /* SHA3-224/256/384/512 of "" and "abc", FIPS 202 */
+    private static final String[] emptyVector = new String[] {
+        "6b4e03423667dbb73b6e15454f0eb1abd4597f9a1b078e3f5b5a6bc7",
+        "a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a",
+        "0c63a75b845e4f7d01107d852e4c2485c51a50aaaa94fc61995e71bbee983a2a"
+            + "c3713831264adb47fb6bd1e058d5f004",
+        "a69f73cca23a9ac5c8b567dc185a756e97c982164fe25859e0d1dcc1475c80a6"
+            + "15b2123af1f5f94c11e3e9402c3ac558f500199d95b6d3e301758586281dcd26"
+    };
+
+    private static final String[] abcVector = new String[] {
+        "e642824c3f8cf24ad09234ee7d3c766fc9a3a5168d0c94ad73b46fdf",
+        "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532",
+        "ec01498288516fc926459f58e2c6ad8df9b473cb0fc08c2596da7cf0e49be4b2"
+            + "98d88cea927ac7f539f1edf228376d25",
+        "b751850b1a57168a5693cd924b6b096e08f621827444f70d884f5d0240d2712e"
+            + "10e116e9192af3c91a7ec57647e3934057340b4cf408d5a56592f8274eec53f0"
+    };
+
+    private static final byte[] abc = new byte[] { 'a', 'b', 'c' };
+
+    @BeforeClass
+    public static void checkSha3IsAvailable() {
+        if (!FeatureDetect.Sha3_256Enabled() &&
+            !FeatureDetect.Shake128Enabled()) {
+            System.out.println("Sha3Test skipped: SHA-3 not compiled in");
+            Assume.assumeTrue(false);
+        }
+    }
+
+    private static boolean enabled(int type) {
+        switch (type) {
+            case Sha3.SHA3_224: return FeatureDetect.Sha3_224Enabled();
+            case Sha3.SHA3_256: return FeatureDetect.Sha3_256Enabled();
+            case Sha3.SHA3_384: return FeatureDetect.Sha3_384Enabled();
+            default:            return FeatureDetect.Sha3_512Enabled();
+        }
+    }
+
+    @Test
+    public void constructorShouldInitializeNativeStruct() {
+        Assume.assumeTrue(FeatureDetect.Sha3_256Enabled());
+
+        assertNotEquals(NativeStruct.NULL, new Sha3_256().getNativeStruct());
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void constructorShouldRejectInvalidType() {
+        new Sha3(160);
+    }
+
+    @Test
+    public void hashShouldMatchKnownVectors() throws ShortBufferException {
+
+        for (int i = 0; i < types.length; i++) {
+            if (!enabled(types[i])) {
+                continue;
+            }
+
+            Sha3 sha = new Sha3(types[i]);
+            assertEquals(types[i] / 8, sha.digestSize());
+            assertArrayEquals(Util.h2b(emptyVector[i]), sha.digest());
+
+            /* digest() resets, object can be reused */
+            sha.update(abc);
+            assertArrayEquals(Util.h2b(abcVector[i]), sha.digest());
+
+            assertArrayEquals(Util.h2b(abcVector[i]),
+                Sha3.hash(types[i], abc));
+
+            ByteBuffer data = ByteBuffer.allocateDirect(abc.length);
+            ByteBuffer out = ByteBuffer.allocateDirect(types[i] / 8);
+            data.put(abc).flip();
+            Sha3.hash(types[i], data, out);
+            out.flip();
+            assertEquals(ByteBuffer.wrap(Util.h2b(abcVector[i])), out);
+        }
+    }
+
+    @Test
+    public void variantClassesShouldMatchGenericClass() {
+
+        if (FeatureDetect.Sha3_224Enabled()) {
+            assertArrayEquals(Util.h2b(abcVector[0]), Sha3_224.hash(abc));
+            assertArrayEquals(Util.h2b(abcVector[0]),
+                new Sha3_224(abc).digest());
+        }
+        if (FeatureDetect.Sha3_256Enabled()) {
+            assertArrayEquals(Util.h2b(abcVector[1]), Sha3_256.hash(abc));
+            assertArrayEquals(Util.h2b(abcVector[1]),
+                new Sha3_256(abc).digest());
+        }
+        if (FeatureDetect.Sha3_384Enabled()) {
+            assertArrayEquals(Util.h2b(abcVector[2]), Sha3_384.hash(abc));
+            assertArrayEquals(Util.h2b(abcVector[2]),
+                new Sha3_384(abc).digest());
+        }
+        if (FeatureDetect.Sha3_512Enabled()) {
+            assertArrayEquals(Util.h2b(abcVector[3]), Sha3_512.hash(abc));
+            assertArrayEquals(Util.h2b(abcVector[3]),
+                new Sha3_512(abc).digest());
+        }
+    }
+
+    @Test
+    public void copyShouldContinueFromSameState() {
+        Assume.assumeTrue(FeatureDetect.Sha3_256Enabled());
+
+        Sha3_256 sha = new Sha3_256();
+        sha.update(abc, 0, 1);
+
+        Sha3_256 copy = new Sha3_256(sha);
+        sha.update(abc, 1, 2);
+        copy.update(abc, 1, 2);
+
+        assertArrayEquals(Util.h2b(abcVector[1]), sha.digest());
+        assertArrayEquals(Util.h2b(abcVector[1]), copy.digest());
+    }
+
+    @Test
+    public void staticHashShouldMatchInstanceDigest()
+        throws ShortBufferException {
+
+        Assume.assumeTrue(FeatureDetect.Sha3_512Enabled());
+
+        int[] sizes = new int[] { 0, 1, 71, 72, 1000, (128 * 1024) + 1 };
+        Random rand = new Random(0);
+
+        for (int size : sizes) {
+            byte[] data = new byte[size + 2];
+            rand.nextBytes(data);
+
+            Sha3_512 sha = new Sha3_512();
+            sha.update(data, 1, size);
+            byte[] expected = sha.digest();
+
+            byte[] out = new byte[Sha3_512.DIGEST_SIZE];
+            Sha3_512.hash(data, 1, size, out, 0);
+            assertArrayEquals(expected, out);
+        }
+    }
+
+    @Test
+    public void shakeShouldMatchKnownVectors() {
+
+        if (FeatureDetect.Shake128Enabled()) {
+            Shake128 shake = new Shake128();
+            assertEquals(32, shake.digestSize());
+            assertArrayEquals(Util.h2b(
+                "7f9c2ba4e88f827d616045507605853e"
+                + "d73b8093f6efbc88eb1a6eacfa66ef26"), shake.digest());
+
+            /* output longer than one Keccak block, 168 bytes */
+            String abc200 = "5881092dd818bf5cf8a3ddb793fbcba7"
+                + "4097d5c526a6d35f97b83351940f2cc8"
+                + "44c50af32acd3f2cdd066568706f509b"
+                + "c1bdde58295dae3f891a9a0fca578378"
+                + "9a41f8611214ce612394df286a62d1a2"
+                + "252aa94db9c538956c717dc2bed4f232"
+                + "a0294c85";
+            assertArrayEquals(Util.h2b(abc200), Shake128.hash(abc, 100));
+
+            shake.update(abc);
+            assertArrayEquals(Util.h2b(abc200), shake.digest(100));
+        }
+
+        if (FeatureDetect.Shake256Enabled()) {
+            Shake256 shake = new Shake256();
+            assertEquals(64, shake.digestSize());
+            assertArrayEquals(Util.h2b(
+                "46b9dd2b0ba88d13233b3feb743eeb24"
+                + "3fcd52ea62b81b82b50c27646ed5762f"
+                + "d75dc4ddd8c0f200cb05019d67b592f6"
+                + "fc821c49479ab48640292eacb3b7c4be"), shake.digest());
+            assertArrayEquals(shake.digest(),
+                Shake.hash(Shake.SHAKE256, new byte[0], 64));
+        }
+    }
+}
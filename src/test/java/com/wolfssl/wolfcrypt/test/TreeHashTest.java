@@ -0,0 +1,137 @@
+/* TreeHashTest.java
+ *
+ * Copyright (C) 2006-2022 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL. (formerly known as CyaSSL)
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+package com.wolfssl.wolfcrypt.test;
+
+import static org.junit.Assert.*;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.util.Arrays;
+import java.util.Random;
+import java.util.concurrent.ForkJoinPool;
+
+import org.junit.Test;
+
+import com.wolfssl.wolfcrypt.Sha256;
+import com.wolfssl.wolfcrypt.Sha512;
+import com.wolfssl.wolfcrypt.TreeHash;
+
+public class TreeHashTest {
+
+    private static byte[] leaf(byte[] data, int from, int to) {
+        Sha256 sha = new Sha256();
+        sha.update(new byte[] { 0x00 });
+        sha.update(Arrays.copyOfRange(data, from, to));
+        return sha.digest();
+    }
+
+    private static byte[] node(byte[] left, byte[] right) {
+        Sha256 sha = new Sha256();
+        sha.update(new byte[] { 0x01 });
+        sha.update(left);
+        sha.update(right);
+        return sha.digest();
+    }
+
+    @Test
+    public void rootShouldMatchManualTree() {
+        byte[] data = new byte[(4 * 16) + 5];
+        new Random(0).nextBytes(data);
+
+        byte[] l0 = leaf(data, 0, 16);
+        byte[] l1 = leaf(data, 16, 32);
+        byte[] l2 = leaf(data, 32, 48);
+        byte[] l3 = leaf(data, 48, 64);
+        byte[] l4 = leaf(data, 64, 69);
+        byte[] expected = node(node(node(l0, l1), node(l2, l3)), l4);
+
+        TreeHash tree = new TreeHash(Sha256.TYPE, 16, new ForkJoinPool(3));
+        TreeHash.Result result = tree.hash(data, 0, data.length);
+
+        assertArrayEquals(expected, result.getRoot());
+        assertTrue(result.matches(expected));
+        assertEquals(5, result.getLeafCount());
+        assertEquals(data.length, result.getLength());
+        assertArrayEquals(l4, result.getLeafDigest(4));
+
+        ByteBuffer direct = ByteBuffer.allocateDirect(data.length);
+        direct.put(data).flip();
+        assertArrayEquals(expected, tree.hash(direct).getRoot());
+        assertEquals(0, direct.position());
+    }
+
+    @Test
+    public void changedLeafShouldBeDetectedFromLeafDigests() {
+        byte[] data = new byte[(10 * 1000) + 1];
+        new Random(1).nextBytes(data);
+
+        TreeHash tree = new TreeHash(Sha512.TYPE, 1000, null);
+        TreeHash.Result original = tree.hash(data, 0, data.length);
+        assertEquals(11, original.getLeafCount());
+
+        data[3500] ^= 1;
+        byte[][] leaves = original.getLeafDigests();
+        ByteBuffer changed = ByteBuffer.wrap(data, 3000, 1000);
+        assertFalse(Arrays.equals(leaves[3], tree.hashLeaf(changed)));
+
+        leaves[3] = tree.hashLeaf(changed);
+        byte[] root = TreeHash.combine(Sha512.TYPE, leaves);
+
+        assertFalse(original.matches(root));
+        assertArrayEquals(tree.hash(data, 0, data.length).getRoot(), root);
+    }
+
+    @Test
+    public void fileChannelShouldMatchByteArray() throws Exception {
+        byte[] data = new byte[(300 * 1024) + 17];
+        new Random(2).nextBytes(data);
+
+        File file = File.createTempFile("treehash", ".bin");
+        file.deleteOnExit();
+        FileOutputStream out = new FileOutputStream(file);
+        out.write(data);
+        out.close();
+
+        TreeHash tree = new TreeHash(Sha256.TYPE, 4096, null);
+        RandomAccessFile raf = new RandomAccessFile(file, "r");
+        try {
+            FileChannel channel = raf.getChannel();
+            assertArrayEquals(tree.hash(data, 0, data.length).getRoot(),
+                tree.hash(channel).getRoot());
+        } finally {
+            raf.close();
+            file.delete();
+        }
+    }
+
+    @Test
+    public void emptyInputShouldBeSingleLeaf() {
+        TreeHash tree = new TreeHash(Sha256.TYPE);
+        TreeHash.Result result = tree.hash(new byte[0], 0, 0);
+
+        assertEquals(1, result.getLeafCount());
+        assertArrayEquals(leaf(new byte[0], 0, 0), result.getRoot());
+    }
+}
@@ -28,6 +28,7 @@ import org.junit.runners.Suite.SuiteClasses;
 @RunWith(Suite.class)
 @SuiteClasses({
         AesTest.class,
+        AesXtsTest.class,
         Des3Test.class,
         ChachaTest.class,
         Md5Test.class,
@@ -35,11 +36,16 @@ import org.junit.runners.Suite.SuiteClasses;
         Sha256Test.class,
         Sha384Test.class,
         Sha512Test.class,
+        MessageDigestTest.class,
         HmacTest.class,
         RngTest.class,
         RsaTest.class,
         DhTest.class,
-        EccTest.class
+        EccTest.class,
+        MetricsTest.class,
+        LoggingTest.class,
+        TreeHashTest.class,
+        Sha3Test.class
         })
 public class WolfCryptTestSuite {
 